@@ -1,126 +1,171 @@
-#ifndef SFSF_CONFIG_H_
-#define SFSF_CONFIG_H_
-/**
- * @file	sfsf_config.h
- * @brief	SFSF Services Configurations
-
-
-SFSF Services Configurations
-============================
-The SFSF services require a configuration file to work.
-This is the only file from library that the user needs to modify.
-The file contains configurations that modifies the behavior of
-each service. Each configuration has its owns description.
-*/
-
-/** @name Enable and Disable Macros
- *  Some configurations may be enabled or disabled with this macros.
- */
-//@{
-#define  ENABLE		1						/**< Enable a configuration. */
-#define  DISABLE	0						/**< Disable a configuration. */
-//@}
-
-
-//////////////////////////////////////////////
-/////	OS CONFIGURATIOS		//////////////
-//////////////////////////////////////////////
-/** @name OS CONFIGURATIOS
- *  Some OS, like FreeRTOS, require to define the stack size for creating Tasks
- *  If your OS don't requires to define the stack size, comment the following lines
- */
-//@{
-#define	CONF_MINIMAL_STACK_SIZE				256
-//@}
-
-//////////////////////////////////////////////
-/////		CSP					//////////////
-//////////////////////////////////////////////
-/** @name CSP Configurations
- *  It is necessary to know the size assigned to the CSP buffers.
- *  Set the same value used for csp_buffer_init().
- */
-//@{
-#define CONF_CSP_BUFF_SIZE                  300
-//@}
-
-//////////////////////////////////////////////
-/////		DEBUGGING			//////////////
-//////////////////////////////////////////////
-/** @name Debug Configurations
- *	Uncomment to print debug info of each service.
- *  @note Debug functions should be implemented by user.
- *  @see  sfsf_port.h
- */
-//@{
-#define CONF_CMD_DEBUG						ENABLE			/**< Print cmd queue debug info to debug output. */
-#define CONF_HK_DEBUG						ENABLE			/**< Print beacons to debug output.*/
-#define CONF_LOG_DEBUG						ENABLE			/**< Print log messages to debug output. */
-#define CONF_PARAM_DEBUG					ENABLE			/**< Print param debug info to debug output. */
-#define CONF_TIME_DEBUG						ENABLE			/**< Print software watchdog timer debug info to debug output. */
-//@}
-
-//////////////////////////////////////////////
-/////		PARAM SERVICE		//////////////
-//////////////////////////////////////////////
-/** @name Param Service Configurations
- *  Configurations for sfsf_param.h
- */
-//@{
-#define CONF_PARAM_PERSIST_ENABLE			ENABLE			/**< Enable or disable the Param task, which stores Params in file. */
-#define CONF_PARAM_FILE_NAME				"params.txt"	/**< File name where params will be stored in persistent memory. */
-#define CONF_PARAM_NAME_SIZE				16				/**< Max size of params names in bytes. */
-#define CONF_PARAM_MAX_PARAM_SIZE			64				/**< Max size of Parameter of type STRING_PARAM. */
-//@}
-
-//////////////////////////////////////////////
-/////		COMAND SERVICE		//////////////
-//////////////////////////////////////////////
-/** @name Command Service Configurations
- */
-//@{
-#define CONF_CMD_QUEUE_ENABLE				ENABLE			/**< Enable or Disable the Command Queue. */ // <=== Not Implemented!!!
-#define CONF_CMD_QUEUE_SIZE					10				/**< Max amount of commands in queue waiting to be executed. */
-#define CONF_CMD_ARGS_DELIMITERS			",;"			/**< Separators chars of Command Arguments within Command packet */
-//@}
-
-//////////////////////////////////////////////
-/////		HK SERVICE			//////////////
-//////////////////////////////////////////////
-/** @name Housekeeping Service Configurations
- */
-//@{
-#define CONF_HK_ENABLE						ENABLE			/**< Enable or disable the Beacon transmission and storage. */
-#define CONF_HK_BEACONS_FILE				"beacons.txt"	/**< Name of the file where beacons will be stored if CONF_HK_STORE_BEACONS is ENABLE. */
-#define CONF_HK_SPORT						10				/**< CSP source port for Beacons. */
-#define CONF_HK_DPORT						10				/**< CSP destination port for Beacons. */
-#define CONF_HK_BEACON_PACKET_PRIORITY		2				/**< CSP Packet Priority for beacons. */
-#define CONF_HK_BEACON_PERIOD_MS			20000			/**< Period between beacons in ms. */
-//@}
-
-//////////////////////////////////////////////
-/////		LOG SERVICE			//////////////
-//////////////////////////////////////////////
-/** @name Log Service Configurations
- */
-//@{
-#define CONF_LOG_PERSIST_ENABLE				ENABLE			/**< Enable or disable the Log task, which stores log messages in file. */
-#define CONF_LOG_FILE_NAME					"log.txt"		/**< Name of Log file. */
-#define CONF_LOG_QUEUE_SIZE					10				/**< Max Log messages waiting to be stored. */
-#define CONF_LOG_MESSAGE_SIZE				128				/**< Max size of a Log message. */
-//@}
-
-//////////////////////////////////////////////
-/////		TIME SERVICE		//////////////
-//////////////////////////////////////////////
-/** @name Time Service Configurations
- */
-//@{
-#define CONF_TIME_SW_WDT_ENABLE				ENABLE			/**< Enable or disable the Software Watchdog Timer. */
-#define CONF_TIME_SW_WDT_TIMEOUT_MS			10000			/**< Timeout of the software Watchdog timer. */
-#define CONF_TIME_TIMESTAMP_FORMT			"%Y-%m-%d %T"	/**< Timestamp string format, see strftime() Posix function for more info. */
-//@}
-
-
-
-#endif /* SFSF_CONFIG_H_ */
+#ifndef SFSF_CONFIG_H_
+#define SFSF_CONFIG_H_
+/**
+ * @file	sfsf_config.h
+ * @brief	SFSF Services Configurations
+
+
+SFSF Services Configurations
+============================
+The SFSF services require a configuration file to work.
+This is the only file from library that the user needs to modify.
+The file contains configurations that modifies the behavior of
+each service. Each configuration has its owns description.
+*/
+
+/** @name Enable and Disable Macros
+ *  Some configurations may be enabled or disabled with this macros.
+ */
+//@{
+#define  ENABLE		1						/**< Enable a configuration. */
+#define  DISABLE	0						/**< Disable a configuration. */
+//@}
+
+
+//////////////////////////////////////////////
+/////	OS CONFIGURATIOS		//////////////
+//////////////////////////////////////////////
+/** @name OS CONFIGURATIOS
+ *  Some OS, like FreeRTOS, require to define the stack size for creating Tasks
+ *  If your OS don't requires to define the stack size, comment the following lines
+ */
+//@{
+#define	CONF_MINIMAL_STACK_SIZE				256
+//@}
+
+//////////////////////////////////////////////
+/////		CSP					//////////////
+//////////////////////////////////////////////
+/** @name CSP Configurations
+ *  It is necessary to know the size assigned to the CSP buffers.
+ *  Set the same value used for csp_buffer_init().
+ */
+//@{
+#define CONF_CSP_BUFF_SIZE                  300
+//@}
+
+//////////////////////////////////////////////
+/////		DEBUGGING			//////////////
+//////////////////////////////////////////////
+/** @name Debug Configurations
+ *	Uncomment to print debug info of each service.
+ *  @note Debug functions should be implemented by user.
+ *  @see  sfsf_port.h
+ */
+//@{
+#define CONF_CMD_DEBUG						ENABLE			/**< Print cmd queue debug info to debug output. */
+#define CONF_HK_DEBUG						ENABLE			/**< Print beacons to debug output.*/
+#define CONF_LOG_DEBUG						ENABLE			/**< Print log messages to debug output. */
+#define CONF_PARAM_DEBUG					ENABLE			/**< Print param debug info to debug output. */
+#define CONF_HISTORY_DEBUG					ENABLE			/**< Print history debug info to debug output. */
+#define CONF_TIME_DEBUG						ENABLE			/**< Print software watchdog timer debug info to debug output. */
+//@}
+
+//////////////////////////////////////////////
+/////		PARAM SERVICE		//////////////
+//////////////////////////////////////////////
+/** @name Param Service Configurations
+ *  Configurations for sfsf_param.h
+ */
+//@{
+#define CONF_PARAM_PERSIST_ENABLE			ENABLE			/**< Enable or disable the Param task, which stores Params in file. */
+#define CONF_PARAM_PERSIST_FORMAT			PARAM_PERSIST_IMAGE	/**< Format to store params, PARAM_PERSIST_IMAGE or PARAM_PERSIST_TEXT, see sfsf_param.h. */
+#define CONF_PARAM_IMAGE_FILE_A				"params_a.bin"	/**< File of the first slot for binary param images. */
+#define CONF_PARAM_IMAGE_FILE_B				"params_b.bin"	/**< File of the second slot for binary param images. */
+#define CONF_PARAM_FILE_NAME				"params.txt"	/**< File name where params will be stored in persistent memory. */
+#define CONF_PARAM_FILE_MAX_RECORDS			100				/**< Records appended to the param file before rewriting it with only the latest values. */
+#define CONF_PARAM_NAME_SIZE				16				/**< Max size of params names in bytes. */
+#define CONF_PARAM_PREFIX_SIZE				8				/**< Max size of the prefix of a table with the separator, see register_param_table(). */
+#define CONF_PARAM_MAX_TABLES				8				/**< Max tables registered with register_param_table(). */
+#define CONF_PARAM_MAX_PARAM_SIZE			64				/**< Max size of Parameter of type STRING_PARAM. */
+#define CONF_PARAM_TYPE_CHECK				ENABLE			/**< Check the param type in typed accessors, e.g. param_get_u32(). DISABLE for single load/store accessors. */
+#define CONF_PARAM_NOTIFY_ENABLE			ENABLE			/**< Enable or disable the task that delivers param changes to subscribers, see param_subscribe(). */
+#define CONF_PARAM_MAX_SUBSCRIPTIONS		16				/**< Max subscriptions to param changes. */
+#define CONF_PARAM_NOTIFY_QUEUE_SIZE		16				/**< Param changes waiting to be delivered, more are dropped. */
+#define CONF_PARAM_EVENT_VALUE_SIZE			8				/**< Bytes of the old and new value in a param change. */
+#define CONF_PARAM_MAX_DERIVED				8				/**< Max derived and hardware backed params, see param_set_derived() and param_set_backed(). */
+#define CONF_PARAM_SNAPSHOT					ENABLE			/**< Telemetry and persistence work from a point-in-time copy of the values, see param_snapshot_take(). */
+#define CONF_PARAM_SNAPSHOT_RETRIES			3				/**< Times a snapshot is copied again if params are written meanwhile. */
+#define CONF_PARAM_STATS					DISABLE			/**< Count reads, writes and name lookups of each param, see print_param_stats(). */
+#define CONF_PARAM_DELTA					DISABLE			/**< Keep the last values sent, for delta beacons, see collect_telemetry_params_delta(). */
+#define CONF_PARAM_DELTA_KEYFRAME_PERIOD	10				/**< Delta beacons between keyframes with all the values. */
+#define CONF_PARAM_MAX_DEADBANDS			8				/**< Max float params with a deadband in delta beacons, see param_set_deadband(). */
+//@}
+
+//////////////////////////////////////////////
+/////		HISTORY SERVICE		//////////////
+//////////////////////////////////////////////
+/** @name History Service Configurations
+ *  Configurations for sfsf_history.h
+ */
+//@{
+#define CONF_HISTORY_ENABLE					ENABLE			/**< Enable or disable the task that samples params with HISTORY option. */
+#define CONF_HISTORY_PERIOD_MS				1000			/**< Period between samples in ms. */
+#define CONF_HISTORY_SAMPLES				600				/**< Samples kept per param. */
+#define CONF_HISTORY_BUCKET_SAMPLES			60				/**< Samples reduced to a min/max/mean bucket. */
+#define CONF_HISTORY_BUCKETS				360				/**< Buckets kept per param. */
+//@}
+
+//////////////////////////////////////////////
+/////		COMAND SERVICE		//////////////
+//////////////////////////////////////////////
+/** @name Command Service Configurations
+ */
+//@{
+#define CONF_CMD_QUEUE_ENABLE				ENABLE			/**< Enable or Disable the Command Queue. */ // <=== Not Implemented!!!
+#define CONF_CMD_QUEUE_SIZE					10				/**< Max amount of commands in queue waiting to be executed. */
+#define CONF_CMD_ARGS_DELIMITERS			",;"			/**< Separators chars of Command Arguments within Command packet */
+//@}
+
+//////////////////////////////////////////////
+/////		HK SERVICE			//////////////
+//////////////////////////////////////////////
+/** @name Housekeeping Service Configurations
+ */
+//@{
+#define CONF_HK_ENABLE						ENABLE			/**< Enable or disable the Beacon transmission and storage. */
+#define CONF_HK_BEACONS_FILE				"beacons.txt"	/**< Name of the file where beacons will be stored if CONF_HK_STORE_BEACONS is ENABLE. */
+#define CONF_HK_SPORT						10				/**< CSP source port for Beacons. */
+#define CONF_HK_DPORT						10				/**< CSP destination port for Beacons. */
+#define CONF_HK_BEACON_PACKET_PRIORITY		2				/**< CSP Packet Priority for beacons. */
+#define CONF_HK_BEACON_PERIOD_MS			20000			/**< Period between beacons in ms. */
+#define CONF_HK_BEACON_FORMAT				BEACON_FORMAT_TEXT	/**< Format of the beacons collected by default, BEACON_FORMAT_TEXT, BEACON_FORMAT_BINARY or BEACON_FORMAT_DELTA, see sfsf_hk.h. */
+#define CONF_HK_MAX_STREAMS					8				/**< Max telemetry streams, with the main beacon, see hk_add_stream(). */
+#define CONF_HK_FRAME_SIZE					1024			/**< Max size of a beacon, split in segments if bigger than a CSP packet, see sfsf_hk.h. */
+#define CONF_HK_ARCHIVE_BUFF_SIZE			1024			/**< RAM buffer of stored beacons, written into file when full. */
+#define CONF_HK_ARCHIVE_FLUSH_MS			120000			/**< Max time a stored beacon is kept in RAM before writing it into file. */
+#define CONF_HK_ARCHIVE_SYNC_MS				0				/**< Max time the beacons written are not synced to the media, 0 to sync on every write. */
+#define CONF_HK_BEACONS_BUDGET				1048576			/**< Bytes of beacons kept in CONF_HK_BEACONS_FILE, a circular file, 0 for a text file without limit. */
+#define CONF_HK_SEGMENT_ARCHIVE				DISABLE			/**< Store beacons in a segmented archive with a time index instead of CONF_HK_BEACONS_FILE, see sfsf_hk.h. */
+#define CONF_HK_SEGMENT_PREFIX				"tlm"			/**< Prefix of the names of the segment files. */
+#define CONF_HK_SEGMENT_SIZE				65536			/**< Size of a segment file in bytes. */
+#define CONF_HK_SEGMENTS					16				/**< Amount of segment files, the oldest is removed when all are full. */
+//@}
+
+//////////////////////////////////////////////
+/////		LOG SERVICE			//////////////
+//////////////////////////////////////////////
+/** @name Log Service Configurations
+ */
+//@{
+#define CONF_LOG_PERSIST_ENABLE				ENABLE			/**< Enable or disable the Log task, which stores log messages in file. */
+#define CONF_LOG_FILE_NAME					"log.txt"		/**< Name of Log file. */
+#define CONF_LOG_FILE_BUDGET				262144			/**< Bytes of messages kept in the Log file, a circular file, 0 for a text file without limit. */
+#define CONF_LOG_QUEUE_SIZE					10				/**< Max Log messages waiting to be stored. */
+#define CONF_LOG_MESSAGE_SIZE				128				/**< Max size of a Log message. */
+//@}
+
+//////////////////////////////////////////////
+/////		TIME SERVICE		//////////////
+//////////////////////////////////////////////
+/** @name Time Service Configurations
+ */
+//@{
+#define CONF_TIME_SW_WDT_ENABLE				ENABLE			/**< Enable or disable the Software Watchdog Timer. */
+#define CONF_TIME_SW_WDT_TIMEOUT_MS			10000			/**< Timeout of the software Watchdog timer. */
+#define CONF_TIME_TIMESTAMP_FORMT			"%Y-%m-%d %T"	/**< Timestamp string format, see strftime() Posix function for more info. */
+//@}
+
+
+
+#endif /* SFSF_CONFIG_H_ */
@@ -50,10 +50,42 @@ SOFTWARE.
 #define CMD_GET_PARAM       0x02
 #define CMD_SET_PARAM       0x03
 #define CMD_REBOOT_OBC      0x04
+#define CMD_GET_PARAMS_BIN  0x05
+#define CMD_SET_PARAMS_BIN  0x06
+#define CMD_GET_HISTORY     0x07
 
 // Command execution option
 #define ON_REAL_TIME        0x01
 
+// Binary Beacons, see sfsf_hk.h
+#define BEACON_BINARY_MARKER    0xB1
+#define BEACON_FLAG_LE          0x01
+#define BEACON_FLAG_DELTA       0x02
+#define BEACON_FLAG_KEYFRAME    0x04
+#define BEACON_HEADER_SIZE      10
+
+// Segmented Beacons, see sfsf_hk.h
+#define BEACON_SEGMENT_MARKER       0xB2
+#define BEACON_SEGMENT_HEADER_SIZE  5
+#define MAX_BEACON_FRAME_SIZE       8192
+// Beacon being reassembled from its segments, they come in order
+uint8_t beacon_frame[MAX_BEACON_FRAME_SIZE + 1];
+int beacon_frame_length;
+uint16_t beacon_frame_id;
+// Index of the next segment, -1 if no beacon being reassembled
+int beacon_frame_next;
+
+// Delta Beacons decoding, sizes of the TELEMETRY params given at start
+#define MAX_TELEMETRY_PARAMS    256
+#define MAX_TELEMETRY_SIZE      2048
+int telemetry_sizes[MAX_TELEMETRY_PARAMS];
+int telemetry_params_num;
+// Last value of each TELEMETRY param, one after the other
+uint8_t telemetry_values[MAX_TELEMETRY_SIZE];
+// Set by a keyframe, cleared if a delta beacon is lost
+int telemetry_synced;
+uint8_t telemetry_next_seq;
+
 
 // Wair for unser input
 bool kbhit()
@@ -77,16 +109,220 @@ void print_help_info()
     printf("dummy                                 Send a dummy command \n");
     printf("get       [parameter name]            Get the value of a parameter\n");
     printf("set       [parameter name],[value]    Set the value of a parameter\n" );
+    printf("getidx    [index],[index]...          Get the values of parameters by index, as hex\n");
+    printf("setidx    [index]:[hex value],...     Set the values of parameters by index, all or none\n");
+    printf("history   [index],[from],[to]         Get the history of a parameter between two timestamps, as hex\n");
     printf("reboot                                Reboot the OBC\n" );
     printf("\n\n");
 }
 
 
+// Print the header and the values of a binary beacon
+void print_binary_beacon(const uint8_t * data, int data_len)
+{
+    int i;
+    uint16_t params_num, length;
+    uint32_t schema;
+    if(data_len < BEACON_HEADER_SIZE)
+    {
+        printf("> Client: Binary Beacon too short!\n");
+        return;
+    }
+    // Header fields are in network byte order
+    params_num = (data[2] << 8) | data[3];
+    length = (data[4] << 8) | data[5];
+    schema = ((uint32_t)data[6] << 24) | ((uint32_t)data[7] << 16) |
+             ((uint32_t)data[8] << 8) | data[9];
+    printf("> Client: Binary Beacon Received: schema:%08X params:%u %s values:",
+           schema, params_num, (data[1] & BEACON_FLAG_LE) ? "LE" : "BE");
+    // Values are printed as hex, decoding them requires the param table of the OBC
+    for(i = BEACON_HEADER_SIZE; i < BEACON_HEADER_SIZE + length && i < data_len; i++)
+        printf("%02X", data[i]);
+    printf("\n");
+}
+
+
+// Parse the sizes of the TELEMETRY params, "size,size,...", in table order
+int parse_telemetry_sizes(char * arg)
+{
+    int total = 0;
+    char * token;
+    for(token = strtok(arg, ","); token != NULL && telemetry_params_num < MAX_TELEMETRY_PARAMS; token = strtok(NULL, ","))
+    {
+        telemetry_sizes[telemetry_params_num] = atoi(token);
+        total += telemetry_sizes[telemetry_params_num++];
+    }
+    return (total <= MAX_TELEMETRY_SIZE) ? 0 : -1;
+}
+
+
+// Apply a delta beacon to the last values, print the values of all TELEMETRY params
+void print_delta_beacon(const uint8_t * data, int data_len)
+{
+    int i, j, length, bitmap_size, params_num, offset, value_offset;
+    uint8_t seq, flags;
+    const uint8_t * bitmap;
+    flags = data[1];
+    params_num = (data[2] << 8) | data[3];
+    length = (data[4] << 8) | data[5];
+    bitmap_size = (params_num + 7) / 8;
+    if(BEACON_HEADER_SIZE + length > data_len || length < 1 + bitmap_size)
+    {
+        printf("> Client: Delta Beacon too short!\n");
+        return;
+    }
+    seq = data[BEACON_HEADER_SIZE];
+    bitmap = &data[BEACON_HEADER_SIZE + 1];
+    // Without the sizes of the params the values can not be split
+    if(telemetry_params_num == 0 || params_num != telemetry_params_num)
+    {
+        printf("> Client: Delta Beacon Received: seq:%u params:%u%s bitmap:", seq, params_num, (flags & BEACON_FLAG_KEYFRAME) ? " keyframe" : "");
+        for(i = 0; i < bitmap_size; i++) printf("%02X", bitmap[i]);
+        printf(" values:");
+        for(i = BEACON_HEADER_SIZE + 1 + bitmap_size; i < BEACON_HEADER_SIZE + length; i++) printf("%02X", data[i]);
+        printf("\n");
+        if(telemetry_params_num != 0) printf("> Client: Delta Beacon has %u params, %d sizes given!\n", params_num, telemetry_params_num);
+        return;
+    }
+    // A keyframe syncs, a gap in the sequence means lost beacons
+    if(flags & BEACON_FLAG_KEYFRAME) telemetry_synced = 1;
+    else if(seq != telemetry_next_seq) telemetry_synced = 0;
+    telemetry_next_seq = seq + 1;
+    // Take the present values
+    offset = BEACON_HEADER_SIZE + 1 + bitmap_size;
+    value_offset = 0;
+    for(i = 0; i < params_num; i++)
+    {
+        if(bitmap[i >> 3] & (1 << (i & 7)))
+        {
+            if(offset + telemetry_sizes[i] > BEACON_HEADER_SIZE + length)
+            {
+                printf("> Client: Delta Beacon values do not match the sizes!\n");
+                telemetry_synced = 0;
+                return;
+            }
+            memcpy(&telemetry_values[value_offset], &data[offset], telemetry_sizes[i]);
+            offset += telemetry_sizes[i];
+        }
+        value_offset += telemetry_sizes[i];
+    }
+    printf("> Client: Delta Beacon Received: seq:%u%s%s values:", seq, (flags & BEACON_FLAG_KEYFRAME) ? " keyframe" : "",
+           telemetry_synced ? "" : " (stale until keyframe)");
+    // Values are printed as hex, changed ones marked with '*'
+    value_offset = 0;
+    for(i = 0; i < params_num; i++)
+    {
+        printf(" %s", (bitmap[i >> 3] & (1 << (i & 7))) ? "*" : "");
+        for(j = 0; j < telemetry_sizes[i]; j++) printf("%02X", telemetry_values[value_offset + j]);
+        value_offset += telemetry_sizes[i];
+    }
+    printf("\n");
+}
+
+
+// Encode the arguments of a binary param command, "index,index" or "index:hexvalue,index:hexvalue"
+// Returns the length of the encoded arguments
+int encode_params_bin(char * args, uint8_t * out_buff, int buff_size)
+{
+    int len = 0;
+    unsigned int byte;
+    long index;
+    char * token;
+    char * value;
+    for(token = strtok(args, ","); token != NULL; token = strtok(NULL, ","))
+    {
+        if(len + 2 > buff_size) break;
+        // Index in network byte order
+        index = strtol(token, &value, 10);
+        out_buff[len++] = (index >> 8) & 0xFF;
+        out_buff[len++] = index & 0xFF;
+        if(*value != ':') continue;
+        // Value as hex bytes, in the byte order of the OBC
+        for(value++; len < buff_size && sscanf(value, "%2x", &byte) == 1; value += 2)
+            out_buff[len++] = byte;
+    }
+    return len;
+}
+
+
+// Print the response of a binary param command
+void print_params_bin_response(uint8_t * inbuf, int len)
+{
+    int i;
+    if(len < 1)
+    {
+        printf("> Client: Transaction Failed, no Response from Server!!!\n");
+        return;
+    }
+    printf("> Client: Response from server: status %u", inbuf[0]);
+    if(len > 1) printf(" values:");
+    for(i = 1; i < len; i++) printf("%02X", inbuf[i]);
+    printf("\n");
+}
+
+
+// Print a beacon, text or binary
+void print_beacon(uint8_t * data, int data_len)
+{
+    // Binary beacons start with a marker
+    if ( data_len > 0 && data[0] == BEACON_BINARY_MARKER )
+    {
+        if ( data_len >= BEACON_HEADER_SIZE && (data[1] & BEACON_FLAG_DELTA) ) print_delta_beacon(data, data_len);
+        else print_binary_beacon(data, data_len);
+        return;
+    }
+    // Truncate the beacon at the end, to avoid read trash
+    data[data_len] = '\0';
+    // Print the beacon data
+    printf("> Client: Beacon Received:%s\n", data);
+}
+
+
+// Add a segment to the beacon being reassembled, print the beacon when it has all of them
+void add_beacon_segment(const uint8_t * data, int data_len)
+{
+    uint16_t frame_id;
+    uint8_t index, count;
+    if(data_len < BEACON_SEGMENT_HEADER_SIZE || data[4] == 0) return;
+    frame_id = (data[1] << 8) | data[2];
+    index = data[3];
+    count = data[4];
+    // The first segment starts a beacon, a lost segment drops it
+    if(index == 0)
+    {
+        if(beacon_frame_next >= 0) printf("> Client: Segmented Beacon %u lost, missing segments!\n", beacon_frame_id);
+        beacon_frame_id = frame_id;
+        beacon_frame_length = 0;
+        beacon_frame_next = 0;
+    }
+    if(beacon_frame_next < 0 || frame_id != beacon_frame_id || index != beacon_frame_next)
+    {
+        if(beacon_frame_next >= 0) printf("> Client: Segmented Beacon %u lost, missing segments!\n", beacon_frame_id);
+        beacon_frame_next = -1;
+        return;
+    }
+    if(beacon_frame_length + data_len - BEACON_SEGMENT_HEADER_SIZE > MAX_BEACON_FRAME_SIZE)
+    {
+        printf("> Client: Segmented Beacon %u too large!\n", frame_id);
+        beacon_frame_next = -1;
+        return;
+    }
+    memcpy(&beacon_frame[beacon_frame_length], &data[BEACON_SEGMENT_HEADER_SIZE], data_len - BEACON_SEGMENT_HEADER_SIZE);
+    beacon_frame_length += data_len - BEACON_SEGMENT_HEADER_SIZE;
+    if(++beacon_frame_next < count) return;
+    // All the segments, the beacon is complete
+    beacon_frame_next = -1;
+    printf("> Client: Segmented Beacon %u, %u segments\n", frame_id, count);
+    print_beacon(beacon_frame, beacon_frame_length);
+}
+
+
 // This task wait to receive a beacon
 void * task_hk_client(void* parameter)
 {
     csp_packet_t *beacon_packet;
     csp_socket_t * beacon_socket;
+    (void) parameter;
     beacon_socket = csp_socket( CSP_SO_CONN_LESS ); // Create socket for receive beacons
     csp_bind(beacon_socket, 10);
     // Loop that receive beacons
@@ -96,10 +332,9 @@ void * task_hk_client(void* parameter)
         beacon_packet = csp_recvfrom( beacon_socket, 200 );
         // Wait until a Beacon is received
         if ( beacon_packet == NULL ) continue;
-        // Truncate the packet at the end, to avoid read trash
-        beacon_packet->data[ beacon_packet->length] = '\0';
-        // Print the beacon data
-        printf("> Client: Beacon Received:%s\n", beacon_packet->data);
+        // Beacons bigger than a packet come in segments
+        if ( beacon_packet->length > 0 && beacon_packet->data[0] == BEACON_SEGMENT_MARKER ) add_beacon_segment(beacon_packet->data, beacon_packet->length);
+        else print_beacon(beacon_packet->data, beacon_packet->length);
         //Free Beacon packet
         csp_buffer_free(beacon_packet);
 
@@ -121,6 +356,7 @@ void * task_client(void* parameter)
     char outbuf[256];
     char inbuf[1024];
     char aux_buffer[254];
+    (void) parameter;
 
 
     // Need stdin for read user imput
@@ -203,6 +439,44 @@ void * task_client(void* parameter)
             else printf("> Client: Transaction Failed, no Response from Server!!!\n");
         }
 
+        //////// GET PARAMS BY INDEX  /////////////////
+        else if(strcmp( line, "getidx" ) == 0 || strcmp( line, "setidx" ) == 0)
+        {
+            printf("> Client: Sending message %d to server...\n", i);
+            // Encode Command, arguments are binary
+            outbuf[0] = (strcmp( line, "getidx" ) == 0) ? CMD_GET_PARAMS_BIN : CMD_SET_PARAMS_BIN;
+            outbuf[1] = ON_REAL_TIME;
+            c = 2 + encode_params_bin(aux_buffer, (uint8_t*) outbuf + 2, sizeof(outbuf) - 2);
+            // Send Command, the response length is returned
+            transaction_result = csp_transaction(PACKET_PRIO, DEST_ADDRESS, CMD_PORT, TRANSACTION_TIMEOUT, &outbuf, c, inbuf, -1);
+            print_params_bin_response((uint8_t*) inbuf, transaction_result);
+        }
+
+        //////// GET PARAM HISTORY  /////////////////
+        else if(strcmp( line, "history" ) == 0)
+        {
+            unsigned int index, from_s, to_s;
+            printf("> Client: Sending message %d to server...\n", i);
+            if(sscanf(aux_buffer, "%u,%u,%u", &index, &from_s, &to_s) != 3)
+            {
+                printf("> Client: Usage: history [index],[from],[to]\n");
+                continue;
+            }
+            // Encode Command, arguments are binary in network byte order
+            outbuf[0] = CMD_GET_HISTORY;
+            outbuf[1] = ON_REAL_TIME;
+            outbuf[2] = (index >> 8) & 0xFF;
+            outbuf[3] = index & 0xFF;
+            for(c = 0; c < 4; c++)
+            {
+                outbuf[4+c] = (from_s >> (24 - 8*c)) & 0xFF;
+                outbuf[8+c] = (to_s >> (24 - 8*c)) & 0xFF;
+            }
+            // Send Command, the response length is returned
+            transaction_result = csp_transaction(PACKET_PRIO, DEST_ADDRESS, CMD_PORT, TRANSACTION_TIMEOUT, &outbuf, 12, inbuf, -1);
+            print_params_bin_response((uint8_t*) inbuf, transaction_result);
+        }
+
          //////// Restart OBC  /////////////////
         else if(strcmp( line, "reboot" ) == 0)
         {
@@ -239,10 +513,16 @@ int main(int argc, char **argv)
 {
 
     // Check that user assigned serial port
-    if(argc != 2)
+    if(argc != 2 && argc != 3)
     {
         printf("Missing Serial Port!\n");
-        printf("Usage: ./ground_station SERIAL_PORT_NAME\n\n");
+        printf("Usage: ./ground_station SERIAL_PORT_NAME [TELEMETRY_SIZES]\n");
+        printf("TELEMETRY_SIZES: sizes in bytes of the TELEMETRY params, in table order, e.g. 1,20,12,4, to decode delta beacons\n\n");
+        exit(1);
+    }
+    if(argc == 3 && parse_telemetry_sizes(argv[2]) != 0)
+    {
+        printf("TELEMETRY_SIZES too large!\n");
         exit(1);
     }
 
@@ -291,6 +571,7 @@ int main(int argc, char **argv)
   	printf("Interfaces\r\n");
   	csp_route_print_interfaces();
 
+    beacon_frame_next = -1;
     csp_thread_handle_t handle_hk_client;
     csp_thread_create(task_hk_client, "HK_CLIENT", 1000, NULL, 0, &handle_hk_client);
 
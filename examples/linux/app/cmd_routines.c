@@ -1,202 +1,419 @@
-/*
-Copyright 2018 olmanqj
-Permission is hereby granted, free of charge, to any person obtaining a copy of
-this software and associated documentation files (the "Software"), to deal in
-the Software without restriction, including without limitation the rights to
-use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
-of the Software, and to permit persons to whom the Software is furnished to do
-so, subject to the following conditions:
-
-The above copyright notice and this permission notice shall be included in all
-copies or substantial portions of the Software.
-
-THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
-IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
-FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
-AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
-LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
-OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
-SOFTWARE.
- */
-
-/**
- * @brief	Command Routines
- * @example cmd_routines.c
- * Command Routines Example
-
-
-Command Routines
-================
-This is an example of how to create a Command Routines.
-
-
-
-*/
-
-#include <stdio.h>
-#include <stdlib.h>
-#include <string.h>
-
-// CSP Includes
-#include <csp/csp.h>
-#include <csp/arch/csp_system.h>
-#include <csp/arch/csp_thread.h>
-#include <csp/arch/csp_queue.h>
-
-// Framework Services Includes
-#include <sfsf.h>
-#include <sfsf_param.h>
-#include <sfsf_cmd.h>
-#include <sfsf_log.h>
-
-// Mission config
-#include <mission_config.h>
-
-
-// DEFINE_CMD_ROUTINE receives (csp_conn_t *conn, cmd_packet_t * cmd_packet)
-DEFINE_CMD_ROUTINE(dummy)
-{
-	csp_packet_t * response_packet;
-	if((response_packet = csp_buffer_get(CSP_BUFFER_SIZE))==NULL) return CMD_FAIL;
-	if(send_message(conn, response_packet, "OK")!= EXIT_SUCCESS) return CMD_SEND_FAIL;
-	return CMD_OK;
-}
-
-
-
-
-DEFINE_CMD_ROUTINE(cmd_get_param)
-{
-	csp_packet_t * response_packet;
-	param_handle_t param_h;
-	char arg_value_buff[64]={0};
-	char param_name[CONF_PARAM_NAME_SIZE]={0};
-	int arg_size;
-	// Get new Packet
-	if((response_packet = csp_buffer_get(CSP_BUFFER_SIZE))==NULL) return CMD_FAIL;
-	// Clear packet
-	bzero(response_packet->data, CSP_BUFFER_SIZE);
-	// Look for next command arguments until no args
-	while( (arg_size=get_next_arg(cmd_packet, param_name))!=0 )
-	{
-		// look if exists requested param
-		if((param_h =  get_param_handle_by_name(param_name))==NULL)
-		{
-			// If param not found, respond with error
-			snprintf(arg_value_buff, sizeof(arg_value_buff), "not_found");
-		}
-		else
-		{
-			// If found, convert value into arg_value_buff
-			param_to_str(param_h, arg_value_buff, sizeof(arg_value_buff));
-		}
-		// If no more space in csp response packet then finish
-		if((strlen(response_packet->data)+arg_size+2) >= CSP_BUFFER_SIZE) break;
-		// Separate by comma, except if first
-		if(strlen(response_packet->data) != 0)strcat(response_packet->data,   "," );
-		// Concatenate name of param into response packet
-		strcat(response_packet->data,   param_name);
-		strcat(response_packet->data,   ":" );
-		// Concatenate value as str into response packet
-		strcat(response_packet->data,  arg_value_buff );
-		// Clear buffers for next arg
-		bzero(arg_value_buff, sizeof(arg_value_buff));
-		bzero(param_name, sizeof(param_name));
-	}
-	// Store message size
-	response_packet->length = strlen(response_packet->data);
-	// Send message
-	if(csp_send(conn, response_packet, 1000) == 0)
-	{
-		csp_buffer_free(response_packet);
-		return CMD_SEND_FAIL;
-	}
-	return CMD_OK;
-}
-
-
-
-
-
-DEFINE_CMD_ROUTINE(cmd_set_param)
-{
-	csp_packet_t * response_packet;
-	param_handle_t param_h;
-	char arg_value_buff[64]={0};
-	char param_name[CONF_PARAM_NAME_SIZE]={0};
-	int arg_size;
-	// Get new Packet
-	if((response_packet = csp_buffer_get(CSP_BUFFER_SIZE))==NULL) return EXIT_FAILURE;
-	// Clear packet
-	bzero(response_packet->data, CSP_BUFFER_SIZE);
-	// Look for next command arguments until no args,
-	while( (arg_size=get_next_arg(cmd_packet, param_name))!=0 )
-	{
-		// Get another Argument, set_command need two Arguments (param name and the value)
-		if(get_next_arg(cmd_packet, arg_value_buff)==0 )
-		{
-			// If not second argument, respond with error
-			bzero(arg_value_buff, sizeof(arg_value_buff));
-			snprintf(arg_value_buff, sizeof(arg_value_buff), "too_few_args");
-
-		}
-		// Look if exists requested param
-		else if((param_h =  get_param_handle_by_name(param_name))==NULL)
-		{
-			// If param not found, respond with error
-			bzero(arg_value_buff, sizeof(arg_value_buff));
-			snprintf(arg_value_buff, sizeof(arg_value_buff), "not_found");
-		}
-		else
-		{
-			// If found, try set arg_value_buff to param
-			if(str_to_param(param_h, arg_value_buff)==EXIT_SUCCESS)
-			{
-				// if OK, Response with OK
-				bzero(arg_value_buff, sizeof(arg_value_buff));
-				snprintf(arg_value_buff, sizeof(arg_value_buff), "ok");
-			}
-			else
-			{
-				// Else  Response with FAIL
-				bzero(arg_value_buff, sizeof(arg_value_buff));
-				snprintf(arg_value_buff, sizeof(arg_value_buff), "fail");
-			}
-		}
-		// If no more space in csp response packet then finish
-		if((strlen(response_packet->data)+strlen(arg_value_buff)+strlen(param_name)+2) >= CSP_BUFFER_SIZE) break;
-		// Separate by comma, except if first
-		if(strlen(response_packet->data) != 0)strcat(response_packet->data,   "," );
-		// Concatenate name of param into response packet
-		strcat(response_packet->data,   param_name);
-		strcat(response_packet->data,   ":" );
-		// Concatenate set_param exit status as str into response packet
-		strcat(response_packet->data,  arg_value_buff );
-		// Clear buffers for next arg
-		bzero(arg_value_buff, sizeof(arg_value_buff));
-		bzero(param_name, sizeof(param_name));
-	}
-	// Store message size
-	response_packet->length = strlen(response_packet->data);
-	// Send message
-	if(csp_send(conn, response_packet, 1000) == 0)
-	{
-		csp_buffer_free(response_packet);
-		return CMD_SEND_FAIL;
-	}
-	return CMD_OK;
-}
-
-
-
-// Reboots the OBC, requires 1 arg the password
-DEFINE_CMD_ROUTINE(cmd_reboot_obc)
-{
-	log_print("Rebooting OBC by command request");
-	// TODO check if first argument is the password
-
-	// Call CSP reboot
-	csp_sys_reboot();
-	// IF reboot should never reach here
-	return CMD_SEND_FAIL;
-}
+/*
+Copyright 2018 olmanqj
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+of the Software, and to permit persons to whom the Software is furnished to do
+so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+ */
+
+/**
+ * @brief	Command Routines
+ * @example cmd_routines.c
+ * Command Routines Example
+
+
+Command Routines
+================
+This is an example of how to create a Command Routines.
+
+
+
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// CSP Includes
+#include <csp/csp.h>
+#include <csp/arch/csp_system.h>
+#include <csp/arch/csp_thread.h>
+#include <csp/arch/csp_queue.h>
+
+// Framework Services Includes
+#include <sfsf.h>
+#include <sfsf_param.h>
+#include <sfsf_history.h>
+#include <sfsf_cmd.h>
+#include <sfsf_log.h>
+#include <sfsf_hk.h>
+
+// Mission config
+#include <mission_config.h>
+
+
+// DEFINE_CMD_ROUTINE receives (csp_conn_t *conn, cmd_packet_t * cmd_packet)
+DEFINE_CMD_ROUTINE(dummy)
+{
+	csp_packet_t * response_packet;
+	if((response_packet = csp_buffer_get(CSP_BUFFER_SIZE))==NULL) return CMD_FAIL;
+	if(send_message(conn, response_packet, "OK")!= EXIT_SUCCESS) return CMD_SEND_FAIL;
+	return CMD_OK;
+}
+
+
+
+
+DEFINE_CMD_ROUTINE(cmd_get_param)
+{
+	csp_packet_t * response_packet;
+	param_handle_t param_h;
+	char arg_value_buff[64]={0};
+	char param_name[PARAM_FULL_NAME_SIZE+1]={0};
+	int arg_size;
+	// Get new Packet
+	if((response_packet = csp_buffer_get(CSP_BUFFER_SIZE))==NULL) return CMD_FAIL;
+	// Clear packet
+	bzero(response_packet->data, CSP_BUFFER_SIZE);
+	// Look for next command arguments until no args
+	while( (arg_size=get_next_arg(cmd_packet, param_name))!=0 )
+	{
+		// look if exists requested param
+		if((param_h =  get_param_handle_by_name(param_name))==NULL)
+		{
+			// If param not found, respond with error
+			snprintf(arg_value_buff, sizeof(arg_value_buff), "not_found");
+		}
+		else
+		{
+			// If found, convert value into arg_value_buff
+			param_to_str(param_h, arg_value_buff, sizeof(arg_value_buff));
+		}
+		// If no more space in csp response packet then finish
+		if((strlen(response_packet->data)+arg_size+2) >= CSP_BUFFER_SIZE) break;
+		// Separate by comma, except if first
+		if(strlen(response_packet->data) != 0)strcat(response_packet->data,   "," );
+		// Concatenate name of param into response packet
+		strcat(response_packet->data,   param_name);
+		strcat(response_packet->data,   ":" );
+		// Concatenate value as str into response packet
+		strcat(response_packet->data,  arg_value_buff );
+		// Clear buffers for next arg
+		bzero(arg_value_buff, sizeof(arg_value_buff));
+		bzero(param_name, sizeof(param_name));
+	}
+	// Store message size
+	response_packet->length = strlen(response_packet->data);
+	// Send message
+	if(csp_send(conn, response_packet, 1000) == 0)
+	{
+		csp_buffer_free(response_packet);
+		return CMD_SEND_FAIL;
+	}
+	return CMD_OK;
+}
+
+
+
+
+
+DEFINE_CMD_ROUTINE(cmd_set_param)
+{
+	csp_packet_t * response_packet;
+	param_handle_t param_h;
+	char arg_value_buff[64]={0};
+	char param_name[PARAM_FULL_NAME_SIZE+1]={0};
+	int arg_size;
+	// Get new Packet
+	if((response_packet = csp_buffer_get(CSP_BUFFER_SIZE))==NULL) return EXIT_FAILURE;
+	// Clear packet
+	bzero(response_packet->data, CSP_BUFFER_SIZE);
+	// Look for next command arguments until no args,
+	while( (arg_size=get_next_arg(cmd_packet, param_name))!=0 )
+	{
+		// Get another Argument, set_command need two Arguments (param name and the value)
+		if(get_next_arg(cmd_packet, arg_value_buff)==0 )
+		{
+			// If not second argument, respond with error
+			bzero(arg_value_buff, sizeof(arg_value_buff));
+			snprintf(arg_value_buff, sizeof(arg_value_buff), "too_few_args");
+
+		}
+		// Look if exists requested param
+		else if((param_h =  get_param_handle_by_name(param_name))==NULL)
+		{
+			// If param not found, respond with error
+			bzero(arg_value_buff, sizeof(arg_value_buff));
+			snprintf(arg_value_buff, sizeof(arg_value_buff), "not_found");
+		}
+		else
+		{
+			// If found, try set arg_value_buff to param
+			if(str_to_param(param_h, arg_value_buff)==EXIT_SUCCESS)
+			{
+				// if OK, Response with OK
+				bzero(arg_value_buff, sizeof(arg_value_buff));
+				snprintf(arg_value_buff, sizeof(arg_value_buff), "ok");
+			}
+			else
+			{
+				// Else  Response with FAIL
+				bzero(arg_value_buff, sizeof(arg_value_buff));
+				snprintf(arg_value_buff, sizeof(arg_value_buff), "fail");
+			}
+		}
+		// If no more space in csp response packet then finish
+		if((strlen(response_packet->data)+strlen(arg_value_buff)+strlen(param_name)+2) >= CSP_BUFFER_SIZE) break;
+		// Separate by comma, except if first
+		if(strlen(response_packet->data) != 0)strcat(response_packet->data,   "," );
+		// Concatenate name of param into response packet
+		strcat(response_packet->data,   param_name);
+		strcat(response_packet->data,   ":" );
+		// Concatenate set_param exit status as str into response packet
+		strcat(response_packet->data,  arg_value_buff );
+		// Clear buffers for next arg
+		bzero(arg_value_buff, sizeof(arg_value_buff));
+		bzero(param_name, sizeof(param_name));
+	}
+	// Store message size
+	response_packet->length = strlen(response_packet->data);
+	// Send message
+	if(csp_send(conn, response_packet, 1000) == 0)
+	{
+		csp_buffer_free(response_packet);
+		return CMD_SEND_FAIL;
+	}
+	return CMD_OK;
+}
+
+
+
+// Reboots the OBC, requires 1 arg the password
+DEFINE_CMD_ROUTINE(cmd_reboot_obc)
+{
+	log_print("Rebooting OBC by command request");
+	// TODO check if first argument is the password
+
+	// Write the buffered beacons into file
+	flush_hk_storage();
+	// Call CSP reboot
+	csp_sys_reboot();
+	// IF reboot should never reach here
+	return CMD_SEND_FAIL;
+}
+
+
+
+
+// Max params in a binary param command, each index takes 2 bytes
+#define PARAMS_BIN_MAX						(CSP_BUFFER_SIZE/2)
+
+// Send the status and values of a binary param command
+static cmd_exit_status_t send_params_bin(csp_conn_t *conn, uint8_t status, const uint8_t * values, int values_size)
+{
+	csp_packet_t * response_packet;
+	if((response_packet = csp_buffer_get(CSP_BUFFER_SIZE))==NULL) return CMD_FAIL;
+	response_packet->data[0] = status;
+	if(values_size > 0) memcpy(response_packet->data + 1, values, values_size);
+	response_packet->length = 1 + values_size;
+	if(csp_send(conn, response_packet, 1000) == 0)
+	{
+		csp_buffer_free(response_packet);
+		return CMD_SEND_FAIL;
+	}
+	return CMD_OK;
+}
+
+
+// Get the values of params by index, in one response
+// Args: indexes as uint16_t in network byte order
+// Response: status byte, then the values in the order of the indexes, in the byte order of the OBC
+DEFINE_CMD_ROUTINE(cmd_get_params_bin)
+{
+	int i, count, size;
+	uint16_t index;
+	param_index_t indexes[PARAMS_BIN_MAX];
+	uint8_t values[CSP_BUFFER_SIZE-1];
+	// Args should be a list of indexes
+	count = cmd_packet->cmd_arg_len / sizeof(uint16_t);
+	if(count == 0 || cmd_packet->cmd_arg_len % sizeof(uint16_t) != 0) return send_params_bin(conn, PARAMS_BIN_BAD_REQUEST, NULL, 0);
+	for(i = 0; i < count; i++)
+	{
+		memcpy(&index, cmd_packet->cmd_arg_list + i*sizeof(uint16_t), sizeof(uint16_t));
+		indexes[i] = csp_ntoh16(index);
+	}
+	// All values should fit in the response, never truncate it
+	if((size = param_get_many_size(indexes, count)) < 0) return send_params_bin(conn, PARAMS_BIN_BAD_REQUEST, NULL, 0);
+	if(size > (int) sizeof(values)) return send_params_bin(conn, PARAMS_BIN_TOO_BIG, NULL, 0);
+	// Values of the same bulk set, e.g. a quaternion, are read together
+	param_get_many(indexes, count, values, sizeof(values));
+	return send_params_bin(conn, PARAMS_BIN_OK, values, size);
+}
+
+
+// Set the values of params by index, all of them or none
+// Args: indexes as uint16_t in network byte order, each followed by the value in the byte order of the OBC
+// Response: status byte
+DEFINE_CMD_ROUTINE(cmd_set_params_bin)
+{
+	int count, offset, values_size;
+	uint16_t index;
+	param_handle_t param_h;
+	param_index_t indexes[PARAMS_BIN_MAX];
+	uint8_t values[CSP_BUFFER_SIZE];
+	// Split indexes and values
+	count = 0;
+	offset = 0;
+	values_size = 0;
+	while(offset + (int) sizeof(uint16_t) <= cmd_packet->cmd_arg_len && count < PARAMS_BIN_MAX)
+	{
+		memcpy(&index, cmd_packet->cmd_arg_list + offset, sizeof(uint16_t));
+		offset += sizeof(uint16_t);
+		if((param_h = get_param_handle_by_index(csp_ntoh16(index))) == NULL) break;
+		if(offset + param_h->size > cmd_packet->cmd_arg_len) break;
+		indexes[count++] = csp_ntoh16(index);
+		memcpy(values + values_size, cmd_packet->cmd_arg_list + offset, param_h->size);
+		values_size += param_h->size;
+		offset += param_h->size;
+	}
+	// The whole request should be valid
+	if(count == 0 || offset != cmd_packet->cmd_arg_len) return send_params_bin(conn, PARAMS_BIN_BAD_REQUEST, NULL, 0);
+	if(param_set_many(indexes, count, values, values_size) != EXIT_SUCCESS) return send_params_bin(conn, PARAMS_BIN_BAD_REQUEST, NULL, 0);
+	return send_params_bin(conn, PARAMS_BIN_OK, NULL, 0);
+}
+
+
+
+// Get the history of a param in a time range
+// Args: index as uint16_t, then from and to timestamps as uint32_t, all in network byte order
+// Response: status byte, then the series, see param_history_query()
+DEFINE_CMD_ROUTINE(cmd_get_history)
+{
+	int size;
+	uint16_t index;
+	uint32_t from_s, to_s;
+	uint8_t series[CSP_BUFFER_SIZE-1];
+	if(cmd_packet->cmd_arg_len != sizeof(index) + sizeof(from_s) + sizeof(to_s)) return send_params_bin(conn, PARAMS_BIN_BAD_REQUEST, NULL, 0);
+	memcpy(&index, cmd_packet->cmd_arg_list, sizeof(index));
+	memcpy(&from_s, cmd_packet->cmd_arg_list + sizeof(index), sizeof(from_s));
+	memcpy(&to_s, cmd_packet->cmd_arg_list + sizeof(index) + sizeof(from_s), sizeof(to_s));
+	// Only the first records that fit in the response are sent, ground asks again from the next one
+	size = param_history_query(get_param_handle_by_index(csp_ntoh16(index)), csp_ntoh32(from_s), csp_ntoh32(to_s), series, sizeof(series));
+	if(size < 0) return send_params_bin(conn, PARAMS_BIN_BAD_REQUEST, NULL, 0);
+	return send_params_bin(conn, PARAMS_BIN_OK, series, size);
+}
+
+
+
+// Get the access statistics of the params, from an index
+// Args: optional first index as uint16_t in network byte order, 0 if not given
+// Response: status byte, then for each param the index as uint16_t and reads, writes,
+// last write timestamp and lookups as uint32_t, all in network byte order
+DEFINE_CMD_ROUTINE(cmd_get_param_stats)
+{
+	int size;
+	uint16_t index, first, net_index;
+	uint32_t field;
+	param_stats_t stats;
+	uint8_t records[CSP_BUFFER_SIZE-1];
+	first = 0;
+	if(cmd_packet->cmd_arg_len == sizeof(first)) memcpy(&first, cmd_packet->cmd_arg_list, sizeof(first));
+	else if(cmd_packet->cmd_arg_len != 0) return send_params_bin(conn, PARAMS_BIN_BAD_REQUEST, NULL, 0);
+	// Only the params that fit in the response are sent, ground asks again from the next one
+	size = 0;
+	for(index = csp_ntoh16(first); size + sizeof(index) + 4*sizeof(field) <= sizeof(records); index++)
+	{
+		if(param_get_stats(index, &stats) != EXIT_SUCCESS) break;
+		net_index = csp_hton16(index);
+		memcpy(records + size, &net_index, sizeof(net_index));
+		size += sizeof(net_index);
+		field = csp_hton32(stats.reads);
+		memcpy(records + size, &field, sizeof(field));
+		size += sizeof(field);
+		field = csp_hton32(stats.writes);
+		memcpy(records + size, &field, sizeof(field));
+		size += sizeof(field);
+		field = csp_hton32(stats.last_write_s);
+		memcpy(records + size, &field, sizeof(field));
+		size += sizeof(field);
+		field = csp_hton32(stats.lookups);
+		memcpy(records + size, &field, sizeof(field));
+		size += sizeof(field);
+	}
+	// Disabled statistics or first index out of the table
+	if(size == 0) return send_params_bin(conn, PARAMS_BIN_BAD_REQUEST, NULL, 0);
+	return send_params_bin(conn, PARAMS_BIN_OK, records, size);
+}
+
+
+
+// Size of a beacon header in the response of cmd_get_archive: timestamp and length
+#define ARCHIVE_RECORD_HEADER_SIZE			(sizeof(uint32_t) + sizeof(uint16_t))
+
+// Send the stored beacons of a time range, in as many packets as needed
+// Args: from and to timestamps as uint32_t, in network byte order
+// Response: packets with a status byte, then beacons, each with its timestamp as uint32_t and
+// its length as uint16_t in network byte order, then the beacon. A beacon may span packets,
+// ground joins the data after the status byte of the packets. The status of the last packet
+// is ARCHIVE_REPLAY_END, ARCHIVE_REPLAY_CUT if the next beacon does not fit in
+// ARCHIVE_REPLAY_MAX_PACKETS, or ARCHIVE_REPLAY_FAIL if a beacon could not be read
+DEFINE_CMD_ROUTINE(cmd_get_archive)
+{
+	int len, size, total, offset, chunk, packets;
+	uint8_t status;
+	uint16_t length;
+	uint32_t from_s, to_s, time_s, field;
+	storage_archive_cursor_t cursor;
+	uint8_t records[CSP_BUFFER_SIZE-1];
+	// A whole beacon with its header, static as commands are served one at a time by the CMD task
+	static uint8_t beacon[ARCHIVE_RECORD_HEADER_SIZE + CONF_HK_FRAME_SIZE];
+	if(cmd_packet->cmd_arg_len != sizeof(from_s) + sizeof(to_s)) return send_params_bin(conn, PARAMS_BIN_BAD_REQUEST, NULL, 0);
+	memcpy(&from_s, cmd_packet->cmd_arg_list, sizeof(from_s));
+	memcpy(&to_s, cmd_packet->cmd_arg_list + sizeof(from_s), sizeof(to_s));
+	// No beacons in the range
+	if(hk_replay_start(csp_ntoh32(from_s), csp_ntoh32(to_s), &cursor) != EXIT_SUCCESS) return send_params_bin(conn, ARCHIVE_REPLAY_END, NULL, 0);
+	size = 0;
+	packets = 0;
+	status = ARCHIVE_REPLAY_END;
+	while((len = hk_replay_next(&cursor, &time_s, beacon + ARCHIVE_RECORD_HEADER_SIZE, CONF_HK_FRAME_SIZE)) != 0)
+	{
+		if(len < 0)
+		{
+			status = ARCHIVE_REPLAY_FAIL;
+			break;
+		}
+		total = ARCHIVE_RECORD_HEADER_SIZE + len;
+		// Cut before a beacon that would end beyond the last packet, ground asks again from its time
+		if(packets + (size + total + (int) sizeof(records) - 1) / (int) sizeof(records) > ARCHIVE_REPLAY_MAX_PACKETS)
+		{
+			status = ARCHIVE_REPLAY_CUT;
+			break;
+		}
+		field = csp_hton32(time_s);
+		memcpy(beacon, &field, sizeof(field));
+		length = csp_hton16(len);
+		memcpy(beacon + sizeof(field), &length, sizeof(length));
+		for(offset = 0; offset < total; offset += chunk)
+		{
+			// Send the packet when full and more data follows, csp_send() waits while the link is busy
+			if(size == sizeof(records))
+			{
+				if(send_params_bin(conn, PARAMS_BIN_OK, records, size) != CMD_OK)
+				{
+					hk_replay_stop(&cursor);
+					return CMD_SEND_FAIL;
+				}
+				packets++;
+				size = 0;
+			}
+			chunk = (total - offset < (int) sizeof(records) - size) ? total - offset : (int) sizeof(records) - size;
+			memcpy(records + size, beacon + offset, chunk);
+			size += chunk;
+		}
+	}
+	hk_replay_stop(&cursor);
+	return send_params_bin(conn, status, records, size);
+}
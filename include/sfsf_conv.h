@@ -0,0 +1,152 @@
+/*
+Copyright 2018 olmanqj
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+of the Software, and to permit persons to whom the Software is furnished to do
+so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+ */
+#ifndef SFSF_CONV_H_
+#define SFSF_CONV_H_
+
+#ifndef SFSF_H_
+#error Include sfsf.h before sfsf_conv.h!
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+/**
+ * @file	sfsf_conv.h
+ * @brief	API for numeric conversions
+
+Numeric Conversions
+===================
+
+Features Summary
+-------------
+- Integer to string and string to integer, for all param widths
+- Range check when parsing integers
+- Shortest float and double strings that read back to the same value
+- Decimal point is always '.', whatever the C locale
+
+
+Module Description
+-----------------
+Values are converted between numbers and strings whenever a param is set or
+read by name from ground, collected as text telemetry or stored as text. The
+Param Service uses this module instead of snprintf() and atoi() in those
+paths.
+
+Functions converting to string write a null-terminated string and return its
+length, or -1 if the buffer is too small. Functions parsing a string skip
+leading white-space, accept a sign and return the number of chars consumed,
+or -1 if no number was found or the value is out of range. Parsing stops at
+the first char that is not part of the number, the caller decides if the
+rest of the string is an error.
+
+Integers are written two digits at a time. A uint64_t is split in 9 digit
+chunks, so only two 64-bit divisions are needed on a 32-bit OBC. Floats and
+doubles are written with the least significant digits that read back to the
+same value, e.g. 0.1 and not 0.100000001. Values with up to 9 decimals, as
+most values set from ground, are written in fixed point without printf. The
+others take their exact digits from a single printf, rounded to the fewest
+that read back. Decimal strings with few digits
+are parsed exactly with a single multiplication or division, longer ones
+fall back to strtod() and strtof().
+ */
+
+
+/**
+ * @brief	Write an unsigned integer as decimal string
+ * @param	value		Value to write
+ * @param	out_buff	Destination buffer
+ * @param	buff_size	Size of the destination buffer
+ * @return	Length of the string, -1 if the buffer is too small
+ */
+int conv_u32_to_str(uint32_t value, char * out_buff, int buff_size);
+
+/**
+ * @brief	Write a signed integer as decimal string
+ * @see		conv_u32_to_str()
+ */
+int conv_i32_to_str(int32_t value, char * out_buff, int buff_size);
+
+/**
+ * @brief	Write a 64-bit unsigned integer as decimal string
+ * @see		conv_u32_to_str()
+ */
+int conv_u64_to_str(uint64_t value, char * out_buff, int buff_size);
+
+/**
+ * @brief	Write a 64-bit signed integer as decimal string
+ * @see		conv_u32_to_str()
+ */
+int conv_i64_to_str(int64_t value, char * out_buff, int buff_size);
+
+/**
+ * @brief	Write a float with the shortest string that reads back to the same value
+ *
+ * Uses exponent notation for very large or small values, e.g. 1.5e+20.
+ * @see		conv_u32_to_str()
+ */
+int conv_float_to_str(float value, char * out_buff, int buff_size);
+
+/**
+ * @brief	Write a double with the shortest string that reads back to the same value
+ * @see		conv_float_to_str()
+ */
+int conv_double_to_str(double value, char * out_buff, int buff_size);
+
+/**
+ * @brief	Parse an unsigned decimal integer
+ * @param	in_buff		String to parse
+ * @param	max			Max value allowed, e.g. UINT16_MAX
+ * @param	value		Where to store the value
+ * @return	Chars consumed, -1 if no number or greater than max
+ */
+int conv_str_to_uint(const char * in_buff, uint64_t max, uint64_t * value);
+
+/**
+ * @brief	Parse a signed decimal integer
+ * @param	in_buff		String to parse
+ * @param	min			Min value allowed, e.g. INT16_MIN
+ * @param	max			Max value allowed, e.g. INT16_MAX
+ * @param	value		Where to store the value
+ * @return	Chars consumed, -1 if no number or out of range
+ */
+int conv_str_to_int(const char * in_buff, int64_t min, int64_t max, int64_t * value);
+
+/**
+ * @brief	Parse a double
+ *
+ * Reads decimal numbers with '.' as decimal point whatever the locale, and inf and nan
+ * as written by conv_double_to_str(). Numbers too big for the type are rejected.
+ * @param	in_buff		String to parse
+ * @param	value		Where to store the value
+ * @return	Chars consumed, -1 if no number or out of range
+ */
+int conv_str_to_double(const char * in_buff, double * value);
+
+/**
+ * @brief	Parse a float
+ * @see		conv_str_to_double()
+ */
+int conv_str_to_float(const char * in_buff, float * value);
+
+#ifdef __cplusplus
+}
+#endif
+#endif /* SFSF_CONV_H_ */
@@ -0,0 +1,180 @@
+/*
+Copyright 2018 olmanqj
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+of the Software, and to permit persons to whom the Software is furnished to do
+so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+ */
+#ifndef SFSF_HISTORY_H_
+#define SFSF_HISTORY_H_
+
+#ifndef SFSF_H_
+#error Include sfsf.h before sfsf_history.h!
+#endif
+#ifndef SFSF_PARAM_H_
+#error Include sfsf_param.h before sfsf_history.h!
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+/**
+ * @file	sfsf_history.h
+ * @brief	API for History Service
+
+
+History Service
+===============
+
+Features Summary
+-------------
+- Samples params with HISTORY option at a fixed period.
+- Keeps recent samples, and min/max/mean buckets of older ones.
+- Bounded RAM, allocated once at init.
+- Query a time range as a compact binary series.
+
+Module Description
+------------------
+Beacons give the value of the TELEMETRY params every CONF_HK_BEACON_PERIOD_MS,
+but only the latest one. The History Service keeps the evolution of selected
+params on board, so ground can ask for it, e.g. the temperatures during the
+last pass without link.
+
+Params with the HISTORY option are sampled every CONF_HISTORY_PERIOD_MS, into
+a ring of CONF_HISTORY_SAMPLES samples per param. Every
+CONF_HISTORY_BUCKET_SAMPLES samples are also reduced to a bucket with their
+min, max and mean, kept in a ring of CONF_HISTORY_BUCKETS buckets per param.
+With the default configuration that is 10 minutes of samples and 6 hours of
+1 minute buckets, in about 6.7 KB per param:
+
+	bytes per param = 4 * CONF_HISTORY_SAMPLES + 12 * CONF_HISTORY_BUCKETS
+
+Numeric params only, values are kept as float. STRING_PARAM and arrays with HISTORY
+option are ignored.
+
+@b Example:
+@code
+param_table_t mission_param_table = {
+	{.name="temp_obc",	.type=FLOAT_PARAM,	.size=FLOAT_SIZE,	.opts=TELEMETRY|HISTORY},
+	...
+};
+@endcode
+
+Querying
+--------
+param_history_query() copies the history of a param between two timestamps
+into a buffer, a history_header_t followed by the records. If the recent
+samples cover the start of the range the records are samples (float),
+otherwise buckets (history_bucket_t). The header fields are in network byte
+order, the records in the byte order of the OBC, see HISTORY_FLAG_LE. The time
+of record i is first_time_s + i * period_ms / 1000.
+
+Times of samples are derived from the sample period, and converted to
+timestamps with get_timestamp_s() at the time of the query.
+*/
+
+
+
+/** @name Parameterizable Variables
+ *
+ * Use the parameterize() Macro to add this variables to the Parameters Table.
+ * @see sfsf_param.h.
+ */
+///@{
+extern uint32_t history_sample_count;	/**< Samples taken of each HISTORY param since init. */
+///@}
+
+
+#ifndef CONF_HISTORY_PERIOD_MS
+#define CONF_HISTORY_PERIOD_MS			1000
+#endif
+#ifndef CONF_HISTORY_SAMPLES
+#define CONF_HISTORY_SAMPLES			600
+#endif
+#ifndef CONF_HISTORY_BUCKET_SAMPLES
+#define CONF_HISTORY_BUCKET_SAMPLES		60
+#endif
+#ifndef CONF_HISTORY_BUCKETS
+#define CONF_HISTORY_BUCKETS			360
+#endif
+
+/** @name History Series Definitions
+ */
+///@{
+#define HISTORY_FORMAT_SAMPLES		0		/**< Records are samples, float. */
+#define HISTORY_FORMAT_BUCKETS		1		/**< Records are buckets, history_bucket_t. */
+#define HISTORY_FLAG_LE				0x01	/**< Records are little endian, if not set big endian. */
+///@}
+
+/**
+ * @struct	history_bucket_t
+ * @brief	Summary of CONF_HISTORY_BUCKET_SAMPLES consecutive samples
+ */
+typedef struct
+{
+	float min;		/**< Lowest sample. */
+	float max;		/**< Highest sample. */
+	float mean;		/**< Mean of the samples. */
+} history_bucket_t;
+
+/**
+ * @struct	history_header_t
+ * @brief	Header of a series returned by param_history_query()
+ *
+ * Multi-byte fields are in network byte order.
+ */
+typedef struct __attribute__((__packed__))
+{
+	uint8_t format;			/**< Type of the records, HISTORY_FORMAT_x. */
+	uint8_t flags;			/**< Series flags, HISTORY_FLAG_x. */
+	uint16_t index;			/**< Index of the param in the table. */
+	uint16_t count;			/**< Amount of records after the header. */
+	uint32_t first_time_s;	/**< Timestamp of the first record. */
+	uint32_t period_ms;		/**< Time between records. */
+} history_header_t;
+
+/**
+ * @brief	Init the task that samples params with HISTORY option
+ *
+ * The Param Table should be set before, with set_param_table().
+ * @return	-1 if error, 0 if OK
+ */
+int init_history_service(void);
+
+/**
+ * @brief	Get the history of a param in a time range
+ *
+ * If the records do not fit in out_buff, only the first ones are copied, the
+ * header tells how many.
+ * @param	param_h				Handle of the param, with HISTORY option
+ * @param	from_s				Timestamp of the start of the range
+ * @param	to_s				Timestamp of the end of the range
+ * @param	out_buff			Destination buffer
+ * @param	buff_size			Size of the destination buffer
+ * @return	Bytes stored in out_buff, -1 if error (not a HISTORY param or buffer too small)
+ */
+int param_history_query(param_handle_t param_h, uint32_t from_s, uint32_t to_s, void * out_buff, size_t buff_size);
+
+/**
+ * @brief	Get History Task Handle
+ * @return	csp_thread_handle_t
+ */
+csp_thread_handle_t get_history_task_handle(void);
+
+#ifdef __cplusplus
+}
+#endif
+#endif /* SFSF_HISTORY_H_ */
@@ -1,159 +1,437 @@
-/*
-Copyright 2018 olmanqj
-Permission is hereby granted, free of charge, to any person obtaining a copy of
-this software and associated documentation files (the "Software"), to deal in
-the Software without restriction, including without limitation the rights to
-use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
-of the Software, and to permit persons to whom the Software is furnished to do
-so, subject to the following conditions:
-
-The above copyright notice and this permission notice shall be included in all
-copies or substantial portions of the Software.
-
-THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
-IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
-FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
-AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
-LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
-OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
-SOFTWARE.
- */
-#ifndef SFSF_HK_H_
-#define SFSF_HK_H_
-
-#ifndef SFSF_H_
-#error Include sfsf.h before sfsf_hk.h!
-#endif
-
-#ifdef __cplusplus
-extern "C" {
-#endif
-/**
- * @file	sfsf_hk.h
- * @brief	API for Housekeeping Service
-
-
-Housekeeping Service
-====================
-
-Features Summary
--------------
-- Transmits telemetry data periodically.
-- Stores telemetry data periodically.
-
-Module Description
-------------------
-The Housekeeping (HK) Service is in charge of providing the ground segment with
-telemetry data about the state and health of the spacecraft.This service is able
-to automatically collect, store and transmit telemetry data. Storing telemetry
-data may be of interest for the mission, if it is required to know the state of
-the spacecraft even during the section of the orbit without a communication link
-with ground.
-
-*/
-
-
-
-
-/** @name Parameterizable Variables
- *
- * Use the parateerize() Macro to parameterize this variables into the Parameters Table,
- * this will simplify the control of HK Service, by providing a way to change the behavior .
- * See sfsf_param.h.
- *
- * Example:
- * @code
- * param_t param_table[]= {
- *	 ...
- *	 parameterize(  "beacon_count",		UINT32_PARAM,	UINT32_SIZE,	TELEMETRY|PERSISTENT|READ_ONLY, beacon_counter ),
- *	 parameterize(  "beacon_period",	UINT32_PARAM,	UINT32_SIZE,	PERSISTENT,						beacon_period ),
- *	 ...
- * }
- * @endcode
- *
- */
-///@{
-extern uint32_t beacon_counter;		/**< Counts the amount of beacons sent. */
-extern uint32_t beacon_period;		/**< The period between each beacon transmission. */
-extern uint8_t beacon_packet_prio;	/**< CSP Priority of Bacon packets. */
-extern uint8_t beacon_dport;		/**< CSP Destination Port of Bacon packets. */
-extern uint8_t beacon_sport;		/**< CSP Source Port of Bacon packets. */
-extern uint8_t beacon_broadcast_padlock;	/**< For pausing a resuming Beacon Transmission. Paused if 0, Resumed if 1. */
-extern uint8_t beacon_storage_padlock;		/**< For pausing a resuming Beacon Storage. Paused if 0, Resumed if 1. */
-///@}
-
-
-
-/**
- * @typedef	telemetry_collector_t
- * @brief	Typedef of a Telemetry Data Collector function
- *
- * If set, this function will be called automatically by the service to collect telemetry data.
- * It should be set during initialization with set_telemetry_collector().
-*/
-typedef void (*telemetry_collector_t) (char * dest_buf, size_t buf_len);
-
-/**
- * @brief Init HK task, collects, stores and broadcasts telemetry data periodically.
- *
- * @note When the Flight Software starts Beacons wont be stored neither broadcasted, this for
- * avoid radio transmissions during deployment of the satellite.  App should start Beacons
- * transmission and storage with resume_hk_broadcast() and resume_hk_storage().
- * @note For the HK service to collect Telemetry Data automatically a collector function
- * should by set during initialization with set_telemetry_collector().
- *
- * @return	-1 if error , 0 if OK
- */
-int init_hk_service(void);
-
-/**
- * @brief	Broadcast a CSP packet as a Beacon
- * @param	beacon_packet			CSP packet with telemetry data to broadcast
- * @return	-1 if error , 0 if OK exit status
- */
-int send_beacon(csp_packet_t * beacon_packet);
-
-/**
- * @brief	Set the Telemetry Collector function
- * @note	collect_telemetry_params() fomr Param Service is situable for this.
- * @see		sfsf_param.h
- * @param	telemetry_collector_p		Function that collects telemetry data into dest_buf
- */
-void set_telemetry_collector( telemetry_collector_t telemetry_collector_p);
-
-/**
- * @brief Stop Beacons broadcasting
- */
-void stop_hk_broadcast(void);
-
-/**
- * @brief Resume Beacons broadcasting
- */
-void resume_hk_broadcast(void);
-
-/**
- * @brief Resume Beacons storage
- */
-void resume_hk_storage(void);
-
-/**
- * @brief Stop Beacons storage
- */
-void stop_hk_storage(void);
-
-/**
- * @brief	Returns the count of Beacons sent
- * @return	Count of Beacons sent
- */
-uint32_t get_beacon_count(void);
-
-/**
- * @brief	Get HK Handle
- * @return	csp_thread_handle_t
- */
-csp_thread_handle_t get_hk_task_handle(void);
-
-#ifdef __cplusplus
-}
-#endif
-#endif /* SFSF_HK_H_ */
+/*
+Copyright 2018 olmanqj
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+of the Software, and to permit persons to whom the Software is furnished to do
+so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+ */
+#ifndef SFSF_HK_H_
+#define SFSF_HK_H_
+
+#ifndef SFSF_H_
+#error Include sfsf.h before sfsf_hk.h!
+#endif
+
+#include <sfsf_param.h>
+#include <sfsf_storage.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+/**
+ * @file	sfsf_hk.h
+ * @brief	API for Housekeeping Service
+
+
+Housekeeping Service
+====================
+
+Features Summary
+-------------
+- Transmits telemetry data periodically.
+- Stores telemetry data periodically.
+- Text, compact binary or delta beacons.
+- Several telemetry streams, each with its own period, params and CSP port.
+- Segmented archive of beacons, replayed by time range.
+
+Module Description
+------------------
+The Housekeeping (HK) Service is in charge of providing the ground segment with
+telemetry data about the state and health of the spacecraft.This service is able
+to automatically collect, store and transmit telemetry data. Storing telemetry
+data may be of interest for the mission, if it is required to know the state of
+the spacecraft even during the section of the orbit without a communication link
+with ground.
+
+Beacon Formats
+--------------
+The content of a beacon is produced by the telemetry collector function, see
+set_telemetry_collector(). The Param Service provides two collectors:
+- collect_telemetry_params(): text beacon, "TAG:value,TAG:value,...".
+- collect_telemetry_params_bin(): binary beacon, a beacon_header_t followed by
+ the value of each TELEMETRY param, in table order, with the native width of
+ its type (STRING_PARAM with its full size). The header fields are in network
+ byte order, the values in the byte order of the OBC, see BEACON_FLAG_LE.
+ The schema field is a hash of the names, types and sizes of the TELEMETRY
+ params, so ground can check it is decoding with the same table.
+
+- collect_telemetry_params_delta(): delta beacon, a binary beacon with
+ BEACON_FLAG_DELTA that carries only the TELEMETRY params changed since the
+ previous beacon. After the header: a sequence number (1 byte), a presence
+ bitmap of params_num bits (bit i of byte i/8 for the i-th TELEMETRY param)
+ and the values of the present params, in table order. A keyframe, flagged
+ BEACON_FLAG_KEYFRAME, carries all of them, every
+ CONF_PARAM_DELTA_KEYFRAME_PERIOD beacons. Ground keeps the last value of
+ each param and applies the present ones, a gap in the sequence number means
+ a beacon was lost and the values may be stale until the next keyframe.
+ Needs CONF_PARAM_DELTA enabled, see sfsf_param.h.
+
+The format used by default is selected with CONF_HK_BEACON_FORMAT. Binary
+beacons start with BEACON_BINARY_MARKER, which is never the first char of a
+text beacon, this way the HK Service knows the length of the beacon.
+Binary beacons are stored in file as a line of hex digits.
+
+Segmented Beacons
+-----------------
+The beacon is collected into a frame buffer of CONF_HK_FRAME_SIZE bytes, which
+may be bigger than a CSP packet. A beacon that fits in a packet of
+CONF_CSP_BUFF_SIZE bytes is sent as is, a bigger one is split over a sequence
+of packets, each from the CSP buffer pool, that start with a
+beacon_segment_header_t: BEACON_SEGMENT_MARKER, the frame ID of the beacon,
+the index of the segment and the amount of segments. The data of the segments,
+one after the other, is the beacon. Ground keeps the segments of a frame ID
+until it has all of them, a beacon with a lost segment is dropped. This way
+the telemetry grows to hundreds of params without bigger CSP buffers.
+The packets of a beacon are made with get_beacon_segments() and
+get_beacon_segment(). The beacon is stored whole, both in CONF_HK_BEACONS_FILE
+and in the segmented archive.
+
+Beacons Archive
+---------------
+The file CONF_HK_BEACONS_FILE is kept open, and the stored beacons are
+collected in a RAM buffer of CONF_HK_ARCHIVE_BUFF_SIZE bytes. The buffer is
+written into the file when it fills, or when its oldest beacon is
+CONF_HK_ARCHIVE_FLUSH_MS old, and the file is synced to the media at most every
+CONF_HK_ARCHIVE_SYNC_MS. On a reset the beacons of the last
+CONF_HK_ARCHIVE_FLUSH_MS + CONF_HK_ARCHIVE_SYNC_MS may be lost, call
+flush_hk_storage() before a planned reboot or shutdown. See the Buffered Writer
+of sfsf_storage.h.
+
+With CONF_HK_BEACONS_BUDGET greater than 0, CONF_HK_BEACONS_FILE is a circular
+file with room for that many bytes of beacons, the oldest overwritten when
+full, see the Circular File of sfsf_storage.h. Read it with tools/read_ring.py.
+With 0 it is a text file appended without limit. A text CONF_HK_BEACONS_FILE
+of an older build is created again as a circular file on the first boot, its
+beacons lost.
+
+With CONF_HK_SEGMENT_ARCHIVE enabled, the beacons are stored instead in a
+segmented archive, see the Segmented Archive of sfsf_storage.h: each beacon
+whole, text or binary, with its timestamp, in a ring of CONF_HK_SEGMENTS files of
+CONF_HK_SEGMENT_SIZE bytes named "<CONF_HK_SEGMENT_PREFIX><slot>.seg". Stored
+beacons of a time range are read with hk_replay_start() and hk_replay_next(),
+e.g. by a command that sends them to ground.
+
+Telemetry Streams
+-----------------
+Some telemetry is needed fast, e.g. attitude every second, other slow, e.g.
+temperatures every few minutes. Besides the beacon of the telemetry
+collector, sent every beacon_period, the app can add up to
+CONF_HK_MAX_STREAMS - 1 streams with hk_add_stream(). Each stream has its own
+period, list of params, CSP destination port and priority, and its beacons
+are binary beacons of those params, see collect_params_bin(). Ground tells the
+streams apart by the port and the schema in the header.
+
+@b Example:
+@code
+static const param_index_t attitude_params[] = {QUATERNION_INDEX, RATES_INDEX};
+hk_stream_t attitude_stream = {.period_ms = 1000, .params = attitude_params, .params_num = 2, .dport = 12, .prio = CSP_PRIO_NORM};
+int attitude_id = hk_add_stream(&attitude_stream);
+@endcode
+
+A single task serves all streams. Their deadlines are kept in a timer heap,
+the task sleeps until the earliest one, sends the beacon of that stream and
+schedules its next one a period later. A stream that falls behind skips the
+missed beacons instead of sending them in a burst. Beacons of all streams are
+stored and broadcast as the main beacon, see resume_hk_storage() and
+resume_hk_broadcast().
+
+*/
+
+
+
+
+/** @name Parameterizable Variables
+ *
+ * Use the parateerize() Macro to parameterize this variables into the Parameters Table,
+ * this will simplify the control of HK Service, by providing a way to change the behavior .
+ * See sfsf_param.h.
+ *
+ * Example:
+ * @code
+ * param_t param_table[]= {
+ *	 ...
+ *	 parameterize(  "beacon_count",		UINT32_PARAM,	UINT32_SIZE,	TELEMETRY|PERSISTENT|READ_ONLY, beacon_counter ),
+ *	 parameterize(  "beacon_period",	UINT32_PARAM,	UINT32_SIZE,	PERSISTENT,						beacon_period ),
+ *	 ...
+ * }
+ * @endcode
+ *
+ */
+///@{
+extern uint32_t beacon_counter;		/**< Counts the amount of beacons sent. */
+extern uint32_t beacon_period;		/**< The period between each beacon transmission. */
+extern uint8_t beacon_packet_prio;	/**< CSP Priority of Bacon packets. */
+extern uint8_t beacon_dport;		/**< CSP Destination Port of Bacon packets. */
+extern uint8_t beacon_sport;		/**< CSP Source Port of Bacon packets. */
+extern uint8_t beacon_broadcast_padlock;	/**< For pausing a resuming Beacon Transmission. Paused if 0, Resumed if 1. */
+extern uint8_t beacon_storage_padlock;		/**< For pausing a resuming Beacon Storage. Paused if 0, Resumed if 1. */
+///@}
+
+
+
+/** @name Beacon Formats
+ *  Values for CONF_HK_BEACON_FORMAT.
+ */
+///@{
+#define BEACON_FORMAT_TEXT			0		/**< Text beacons, collected with collect_telemetry_params(). */
+#define BEACON_FORMAT_BINARY		1		/**< Binary beacons, collected with collect_telemetry_params_bin(). */
+#define BEACON_FORMAT_DELTA			2		/**< Delta beacons, collected with collect_telemetry_params_delta(). */
+///@}
+
+#ifndef CONF_HK_BEACON_FORMAT
+#define CONF_HK_BEACON_FORMAT		BEACON_FORMAT_TEXT
+#endif
+
+/** @name Binary Beacon Definitions
+ */
+///@{
+#define BEACON_BINARY_MARKER		0xB1	/**< First byte of a binary beacon. */
+#define BEACON_FLAG_LE				0x01	/**< Values are little endian, if not set big endian. */
+#define BEACON_FLAG_DELTA			0x02	/**< Only the changed values, after a sequence number and a presence bitmap. */
+#define BEACON_FLAG_KEYFRAME		0x04	/**< Delta beacon with all the values, ground can start decoding from it. */
+#define BEACON_SEGMENT_MARKER		0xB2	/**< First byte of a segment of a beacon bigger than a packet. */
+///@}
+
+/**
+ * @struct	beacon_header_t
+ * @brief	Header of a binary beacon
+ *
+ * Multi-byte fields are in network byte order.
+ */
+typedef struct __attribute__((__packed__))
+{
+	uint8_t marker;			/**< Always BEACON_BINARY_MARKER. */
+	uint8_t flags;			/**< Beacon flags, BEACON_FLAG_x. */
+	uint16_t params_num;	/**< Amount of param values in the beacon. */
+	uint16_t length;		/**< Size in bytes of the values after the header. */
+	uint32_t schema;		/**< Hash of the TELEMETRY params definition. */
+} beacon_header_t;
+
+/**
+ * @struct	beacon_segment_header_t
+ * @brief	Header of a segment of a beacon bigger than a packet
+ *
+ * Multi-byte fields are in network byte order.
+ */
+typedef struct __attribute__((__packed__))
+{
+	uint8_t marker;			/**< Always BEACON_SEGMENT_MARKER. */
+	uint16_t frame_id;		/**< ID of the beacon, the same in all its segments. */
+	uint8_t index;			/**< Index of the segment, from 0. */
+	uint8_t count;			/**< Amount of segments of the beacon. */
+} beacon_segment_header_t;
+
+#ifndef CONF_HK_MAX_STREAMS
+#define CONF_HK_MAX_STREAMS			8
+#endif
+
+#ifndef CONF_HK_FRAME_SIZE
+#define CONF_HK_FRAME_SIZE			CONF_CSP_BUFF_SIZE
+#endif
+
+#ifndef CONF_HK_ARCHIVE_BUFF_SIZE
+#define CONF_HK_ARCHIVE_BUFF_SIZE	1024
+#endif
+
+#ifndef CONF_HK_ARCHIVE_FLUSH_MS
+#define CONF_HK_ARCHIVE_FLUSH_MS	120000
+#endif
+
+#ifndef CONF_HK_ARCHIVE_SYNC_MS
+#define CONF_HK_ARCHIVE_SYNC_MS		0
+#endif
+
+#ifndef CONF_HK_BEACONS_BUDGET
+#define CONF_HK_BEACONS_BUDGET		1048576
+#endif
+
+#ifndef CONF_HK_SEGMENT_ARCHIVE
+#define CONF_HK_SEGMENT_ARCHIVE		DISABLE
+#endif
+
+#ifndef CONF_HK_SEGMENT_PREFIX
+#define CONF_HK_SEGMENT_PREFIX		"tlm"
+#endif
+
+#ifndef CONF_HK_SEGMENT_SIZE
+#define CONF_HK_SEGMENT_SIZE		65536
+#endif
+
+#ifndef CONF_HK_SEGMENTS
+#define CONF_HK_SEGMENTS			16
+#endif
+
+/**
+ * @struct	hk_stream_t
+ * @brief	A telemetry stream, see hk_add_stream()
+ */
+typedef struct
+{
+	uint32_t period_ms;				/**< Period between beacons of the stream. */
+	const param_index_t * params;	/**< Indexes of the params in its beacons, kept by reference. */
+	uint16_t params_num;			/**< Amount of params. */
+	uint8_t dport;					/**< CSP destination port of its beacons. */
+	uint8_t prio;					/**< CSP priority of its beacons. */
+} hk_stream_t;
+
+/**
+ * @typedef	telemetry_collector_t
+ * @brief	Typedef of a Telemetry Data Collector function
+ *
+ * If set, this function will be called automatically by the service to collect telemetry data.
+ * It should be set during initialization with set_telemetry_collector().
+*/
+typedef void (*telemetry_collector_t) (char * dest_buf, size_t buf_len);
+
+/**
+ * @brief Init HK task, collects, stores and broadcasts telemetry data periodically.
+ *
+ * @note When the Flight Software starts Beacons wont be stored neither broadcasted, this for
+ * avoid radio transmissions during deployment of the satellite.  App should start Beacons
+ * transmission and storage with resume_hk_broadcast() and resume_hk_storage().
+ * @note For the HK service to collect Telemetry Data automatically a collector function
+ * should by set during initialization with set_telemetry_collector().
+ *
+ * @return	-1 if error , 0 if OK
+ */
+int init_hk_service(void);
+
+/**
+ * @brief	Broadcast a CSP packet as a Beacon
+ * @param	beacon_packet			CSP packet with telemetry data to broadcast
+ * @return	-1 if error , 0 if OK exit status
+ */
+int send_beacon(csp_packet_t * beacon_packet);
+
+/**
+ * @brief	Broadcast a CSP packet as a Beacon, with a priority and destination port
+ * @param	beacon_packet			CSP packet with telemetry data to broadcast
+ * @param	prio					CSP priority
+ * @param	dport					CSP destination port
+ * @return	-1 if error (the packet is freed), 0 if OK
+ */
+int send_stream_beacon(csp_packet_t * beacon_packet, uint8_t prio, uint8_t dport);
+
+/**
+ * @brief	Add a telemetry stream, served by the HK task
+ *
+ * The first beacon is sent a period after it is added. The stream is copied,
+ * the list of params is kept by reference.
+ * @param	stream					Period, params and CSP port of the stream
+ * @return	-1 if error (HK Service not started, or CONF_HK_MAX_STREAMS reached), id of the stream if OK
+ */
+int hk_add_stream(const hk_stream_t * stream);
+
+/**
+ * @brief	Remove a telemetry stream added with hk_add_stream()
+ * @param	stream_id				Id returned by hk_add_stream()
+ * @return	-1 if error (not found), 0 if OK
+ */
+int hk_remove_stream(int stream_id);
+
+/**
+ * @brief	Amount of packets a beacon is sent in
+ * @param	length					Size of the beacon
+ * @return	1 if the beacon fits in a packet and is sent as is, else the amount of segments
+ */
+uint8_t get_beacon_segments(uint16_t length);
+
+/**
+ * @brief	Make a packet of a beacon, the beacon itself or one of its segments
+ * @param	frame					Beacon
+ * @param	length					Size of the beacon
+ * @param	frame_id				Frame ID of the beacon, written in the header of its segments
+ * @param	index					Index of the packet, from 0 to get_beacon_segments() - 1
+ * @param	out_buff				Destination buffer of the packet data, of CONF_CSP_BUFF_SIZE bytes
+ * @return	Size of the packet data, 0 if index is out of range
+ */
+uint16_t get_beacon_segment(const uint8_t * frame, uint16_t length, uint16_t frame_id, uint8_t index, uint8_t * out_buff);
+
+/**
+ * @brief	Find the first stored beacon of a time range, needs CONF_HK_SEGMENT_ARCHIVE enabled
+ * @param	from_s					Timestamp of the start of the range
+ * @param	to_s					Timestamp of the end of the range
+ * @param	cursor					Cursor to read the beacons with hk_replay_next()
+ * @return	-1 if error (no beacons in the range), 0 if OK
+ */
+int hk_replay_start(uint32_t from_s, uint32_t to_s, storage_archive_cursor_t * cursor);
+
+/**
+ * @brief	Read the next stored beacon of a time range
+ * @param	cursor					Cursor set by hk_replay_start()
+ * @param	time_s					Destination of the timestamp of the beacon
+ * @param	buff					Destination buffer of the beacon
+ * @param	buff_size				Size of buff
+ * @return	Size of the beacon, 0 if no more beacons in the range, -1 if error (a beacon bigger than buff_size is an error, the next call goes on after it)
+ */
+int hk_replay_next(storage_archive_cursor_t * cursor, uint32_t * time_s, void * buff, size_t buff_size);
+
+/**
+ * @brief	End a replay of stored beacons, started with hk_replay_start()
+ * @param	cursor					Cursor set by hk_replay_start()
+ */
+void hk_replay_stop(storage_archive_cursor_t * cursor);
+
+/**
+ * @brief	Set the Telemetry Collector function
+ * @note	collect_telemetry_params() fomr Param Service is situable for this.
+ * @see		sfsf_param.h
+ * @param	telemetry_collector_p		Function that collects telemetry data into dest_buf
+ */
+void set_telemetry_collector( telemetry_collector_t telemetry_collector_p);
+
+/**
+ * @brief Stop Beacons broadcasting
+ */
+void stop_hk_broadcast(void);
+
+/**
+ * @brief Resume Beacons broadcasting
+ */
+void resume_hk_broadcast(void);
+
+/**
+ * @brief Resume Beacons storage
+ */
+void resume_hk_storage(void);
+
+/**
+ * @brief Stop Beacons storage, the buffered beacons are written into file
+ */
+void stop_hk_storage(void);
+
+/**
+ * @brief	Write the buffered beacons into file and sync it
+ * @return	-1 if error , 0 if OK
+ */
+int flush_hk_storage(void);
+
+/**
+ * @brief	Returns the count of Beacons sent
+ * @return	Count of Beacons sent
+ */
+uint32_t get_beacon_count(void);
+
+/**
+ * @brief	Get HK Handle
+ * @return	csp_thread_handle_t
+ */
+csp_thread_handle_t get_hk_task_handle(void);
+
+#ifdef __cplusplus
+}
+#endif
+#endif /* SFSF_HK_H_ */
@@ -1,553 +1,1577 @@
-/*
-Copyright 2018 olmanqj
-Permission is hereby granted, free of charge, to any person obtaining a copy of
-this software and associated documentation files (the "Software"), to deal in
-the Software without restriction, including without limitation the rights to
-use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
-of the Software, and to permit persons to whom the Software is furnished to do
-so, subject to the following conditions:
-
-The above copyright notice and this permission notice shall be included in all
-copies or substantial portions of the Software.
-
-THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
-IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
-FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
-AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
-LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
-OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
-SOFTWARE.
- */
-#ifndef SFSF_PARAM_H_
-#define SFSF_PARAM_H_
-
-#ifndef SFSF_H_
-#error Include sfsf.h before sfsf_param.h!
-#endif
-
-#ifdef __cplusplus
-extern "C" {
-#endif
-/**
- * @file	sfsf_param.h
- * @brief	API for Parameter Service
-
-Parameter Service
-=================
-
-To avoid confusion:
-- Variable: variables from programming language, a storage location with an
- associated name.
-- Argument: one of the pieces of data provided as input to a function.
-- Parameter: a characteristic that models or describes a system.
-
-
-Features Summary
--------------
-- Set and get parameters.
-- Supports any type of parameter.
-- Definitions to create the parameter table.
-- Automatically collects parameters with Telemetry option.
-- Automatically stores parameters in persistent memory. (Still not implemented)
-- Parameters protection with read only option.
-
-
-Module Description
------------------
-The Parameter Service acts as a database for the spacecraft's parameters,
-provides an easy way to set and get the value of any parameter. A parameter
-can be described as a variable that helps model or describe a system, it can
-be for example the pointing direction of the ADCS, or the output voltage of
-the EPS, or even if the communication system is on or off.
-
-Implementing the mission specific application using the Parameters Service
-instead of built-in variables from the platform, facilitates the control and
-monitoring of the spacecraft, because any parameter value can be modified or
-retrieved at any time. Parameters can be accessed by a name or by an index,
-this gives the ability to modify or retrieve the value of a parameter from
-the ground.
-
-The Parameter Table
--------------------
-Parameters are stored in a table, the "Parameters Table". Each entry of the
-table is of type param_t, which contains the name, type, size, options and
-a pointer to the value of the parameter. In other words the Parameters Table
-is an array of param_t.
-
-There can only be one table and should be created by the user, with the type
-param_table_t. It should be registered at init with the function
-set_param_table(). The table isstatic and it is created at compilation, this
-means new parameters can not be added at run time. Therefore, users should
-include in the table, all required parameters during coding. There are two
- ways to add parameters to the table:
-
-- When the parameter does not exist, a new memory space can be created to store
-its value. This is done by adding a param_t struct to the table, as following:
-@code
-{.param_name = "example1", .type = UINT8_PARAM, .size = UINT8_SIZE,	.opts = TELEMETRY|PERSISTENT },
-@endcode
-
-- When the parameter is an existing variable, the variable can be "parameterized"
-and added to the table. This is done with the macro parameterize(), by adding a
-line as the following to the table:
-@code
-{.param_name = "example1", .type = UINT8_PARAM, .size = UINT8_SIZE,	.opts = TELEMETRY|PERSISTENT, parameterize(variable_name) },
-@endcode
-
-As shown in the two last examples, parameters require:
-- A unique name, the max name size is determined by the configuration
- CONF_PARAM_NAME_SIZE.
-- Type: all supported types are enlisted in enum param_type_t.
-- Sze: size can be assigned with the macro sizeof(), or with the values of enum
- param_size_t. For a parameter of type STRING_PARAM the size can be any, it
- should be decided by the user.
-- Options: there are some special options that can be assigned to parameters,
- these are enlisted in enum param_opts_t. Options are not mandatory,
- parameters can have no options. All parameters with option TELEMTRY can be
- collected into a string with the function collect_telemetry_params().
- All parameters with option PERSITENT will be stored in persistent memory. This
- is useful for restoring the configuration after a reboot from OBC. Note that
- init_param_persistence() should be called at init and Storage Service functions
- should be ported to make effective the PERSOSTENT option. The option READ_ONLY
- is only applicable for parameters created with the parameterize() macro, this
- inhibits the parameter value to be modified throughout the Parameter Service
- API. This option is useful when there are parameters that should not be
- modified from the ground, but retrieved, like a counter, or the output of a
- sensor.
-
-An example of a Parameters Table:
-@code
-// Variables to be parameterized
-uint32_t	variable_name;
-float		variable2_name;
-// Parameters Table
-param_table_t mission_param_table = {
-	//	NAME					TYPE				Size				Options							Variable
-	{.name="example1",	.type=UINT8_PARAM,	.size=UINT8_SIZE,	.opts=TELEMETRY},
-	{.name="example2",	.type=STRING_PARAM,	.size=20,			.opts=TELEMETRY|PERSISTENT|READ_ONLY},
-	{.name="example3",	.type=UINT32_PARAM,	.size=UINT32_SIZE,}, // Params may have no options
-	{.name="example4",	.type=UINT32_PARAM,	.size=UINT32_SIZE,	.opts=TELEMETRY|PERSISTENT,				.value=parameterize(variable_name)},
-	{.name="example5",	.type=FLOAT_PARAM,	.size=FLOAT_SIZE,											.value=parameterize(variable2_name)}
-};
-@endcode
-
-Then register the table during initialization, in init_services() function
-at init_functions.c.
-@code
-set_param_table(&mission_param_table,  sizeof( mission_param_table)/sizeof(*mission_param_table));
-@endcode
-
-Handling Parameters
--------------------
-Whit a Parameter Table populated and registered, we can retrieve
-and modify the value of parameters. You may not access the param_t
-structures from table directly. Use the a Parameter Handle instead,
-the typedef param_handle_t, which is a pointer to a table entry. So
-once you have a handle pointing to a param, the access to the value
-is in immediate, there is no need to look-up through the table for
-the parameter. There are two ways to obtain a handle, by the name
-of the parameter, or by the index on the table.
-
-The easiest, by the name, with the function get_param_handle_by_name().
-This functions scans the table for a parameter with the name. If the
-parameter is accessed very frequently, is not efficient.
-
-@b Example:
-@code
-param_handle_t example1_h = get_param_handle_by_name("example1");
-@endcode
-
-The other way is by the index in table, using the function
-get_param_handle_by_index(). This functions is way more efficient
-that the previous one, because there is not need to scan the table,
-the access is directly, but you need to keep track of the indexes
-in table.
-
-@b Example:
-@code
-#define EXAMPLE1_INDEX	1	// Recommended to keep indexes as macros
-param_handle_t example1_h = get_param_handle_by_index(EXAMPLE1_INDEX);
-@endcode
-
-Once with the handle of a param, in other words a pointer to it, the
-acces to its value can be done with two functions: get_param_val()
-and set_param_val().
-
-To retreive the value of a parameter use get_param_val().
-
-@b Example:
-@code
-uint8_t aux_var;	// Variable where param value will be stored
-param_handle_t example1_h = get_param_handle("example1");
-get_param_val(example1_h, (void*)&aux_var );
-@endcode
-
-To modify the value of a parameter use set_param_val().
-
-@b Example:
-@code
-uint8_t example1 = 4;	// Value to set to param
-param_handle_t example1_h = get_param_handle("example1");
-set_param_val(example1_h, (void*)&example1 );
-@endcode
-
-Also you can use the macros get_param() and set_param(),
-which require less code.
-
-@b Example:
-@code
-// Set the value, note for set_param() you can place the value as argument
-set_param(example1_h, int8_t, -4);
-
-// Get the value
-uint8_t example1 = 4;
-get_param( example1_h, example1 );
-@endcode
-
-
-The true advantage from the Param Service is the ability to
-access values by a string, the name. This way the ground segment
-can modify or retrieve variables in the spacecraft by knowing the
-name. Incoming and outgoing messages from ground may contain
-the value of parameters as strings, therefore you can also
-use the functions str_to_param() and param_to_str().
-
-To set the value of a parameter with a string with the value
-use str_to_param().
-
-@b Example:
-@code
-str_to_param(example_handle, "example string");
-@endcode
-
-
-To retrieve the value of a parameter as a string use
-param_to_str().
-
-@b Example:
-@code
-char buffer[20];
-param_to_str(example_handle, buffer, 20);
-@endcode
-
-*/
-
-
-
-/**
- * @enum	param_type_t
- * @brief	Parameter Types
- *
- * Supported types for parameters
-*/
-typedef enum
-{
-	UINT8_PARAM,
-	INT8_PARAM,
-	UINT16_PARAM,
-	INT16_PARAM,
-	UINT32_PARAM,
-	INT32_PARAM,
-	UINT64_PARAM,
-	INT64_PARAM,
-	FLOAT_PARAM,
-	DOUBLE_PARAM,
-	STRING_PARAM
-} param_type_t;
-
-/**
- * @enum	param_size_t
- * @brief	Parameter Sizes
- *
- * Macros for assigning the size in Parameters Table, note that STRING_PARAM
- * can have any size, is decision from user to assign the size.
-*/
-typedef enum
-{
-	UINT8_SIZE		= sizeof(uint8_t),
-	INT8_SIZE		= sizeof(int8_t),
-	UINT16_SIZE		= sizeof(uint16_t),
-	INT16_SIZE		= sizeof(int16_t),
-	UINT32_SIZE		= sizeof(uint32_t),
-	INT32_SIZE		= sizeof(int32_t),
-	UINT64_SIZE		= sizeof(uint64_t),
-	INT64_SIZE		= sizeof(int64_t),
-	FLOAT_SIZE		= sizeof(float),
-	DOUBLE_SIZE		= sizeof(double)
-	// String Size should be decided by user.
-} param_size_t;
-
-/**
- * @enum	param_opts_t
- * @brief	Parameter Options
- * @note	READ_ONLY is only applicable for parameterized variables.
- *
- * Macros for assigning the options in Parameters Table
-*/
-typedef enum
-{
-	TELEMETRY	= 0b00000001,		/**< Automatic collect this param for telemetry. */
-	PERSISTENT	= 0b00000010,		/**< Persist the value on non volatile memory. */
-	READ_ONLY	= 0b00000100		/**< Prohibited to write with param_service functions, only applicable for parameterized variables. */
-} param_opts_t;
-
-/**
- * @struct	param_t
- * @brief	Parameter struct
- *
- * Holds the data for a parameter in the table. The Parameter Table
- * is composed by a collection of this struct.
- * @see param_table_t
- *
- * Do not handle this struct directly, use instead param_handle_t type
- * and the API defined functions.
- * @see param_handle_t
-*/
-typedef struct
-{
-	const char name[CONF_PARAM_NAME_SIZE];	/**< Name of the param.	*/
-	const param_type_t type;				/**< Param Type, from param_type_t. */
-	const uint8_t size;						/**< Size in bytes, from param_size_t, or custom if STRING_PARAM.*/
-	uint8_t opts;							/**< Special options, from param_opts_t.*/
-	void* value;							/**< Pointer to param space where value is stored. */
-}param_t;
-
-/**
- * @typedef	param_table_t
- * @brief	Parameters Table Type
- *
- * Type to define the parameters table.
- * @note The table should be register during initialization with set_param_table()
- *
- * **Example**:
- * @code
- * // Variables to be parameterized
- * uint32_t	variable_name;
- * float		variable2_name;
- * // Parameters Table
- * param_table_t mission_param_table = {
- *	//	NAME					TYPE				Size				Options							Variable
- *	{.name="example1",	.type=UINT8_PARAM,	.size=UINT8_SIZE,	.opts=TELEMETRY},
- *	{.name="example2",	.type=STRING_PARAM,	.size=20,			.opts=TELEMETRY|PERSISTENT|READ_ONLY},
- *	{.name="example3",	.type=UINT32_PARAM,	.size=UINT32_SIZE,}, // Params may have no options
- *	{.name="example4",	.type=UINT32_PARAM,	.size=UINT32_SIZE,	.opts=TELEMETRY|PERSISTENT,				.value=parameterize(variable_name)},
- *	{.name="example5",	.type=FLOAT_PARAM,	.size=FLOAT_SIZE,											.value=parameterize(variable2_name)}
- * };
- * @endcode
-*/
-typedef param_t param_table_t[];
-
-/**
- * @typedef	param_handle_t
- * @brief	Parameter Handle Type
- *
- * Pointer to a parameter struct, i.e: entry in parameters table.
- * Use this type and the API functions for handling parameters.
- * @see set_param_val(), get_param_val(), set_param(), get_param()
-*/
-typedef param_t* param_handle_t;
-
-/**
- * @typedef	param_index_t
- * @brief	Index to a parameter Type
- *
- * Type to retrieve a parameter handler by the index in table.
-*/
-typedef int16_t param_index_t;
-
-
-
-/**
- * @brief	Load parameters in a file to the Parameter Table
- *
- * When enabling the Parameter persistence Service with  init_param_persistence(), prameters
- * are stored in a file. After a rebbot form OBC, to restore the Parameter Table use this
- * function. The Param Table should be created befor, using  set_param_table().
- * @note 	Param Table should be created befor!
- * @see 	set_param_table()
- * @note	Storage Service functions should be ported. See simle_port.h.
- * @see		sfsf_port.h
- * @param 	file_name 		Name of file where parameters are stored in persistent memory
- * @return	-1 if error, 0 if OK
- */
-int load_param_table(char* file_name);
-
-
-/**
- * @brief	Init the task that stores parameters in persistent memory.
- * @note	Storage Service functions should be ported. See simle_port.h.
- * @see		sfsf_port.h
- * @return	-1 if error, 0 if OK
- */
-int init_param_persistence(void);
-
-/**
- * @brief	Set the parameter table
- *
- * Call this function during initialization, in init_services() function
- * at init_functions.c.
- * @param	param_table				Pointer to the param table
- * @param	param_table_size		Num of entries of param_table
- * @return	-1 if error, 0 if OK
- */
-int set_param_table(param_table_t* param_table, uint16_t param_table_size);
-
-/**
- * @def  parameterize
- * @brief Macro to parameterize a variable into the Parameters Table.
- *
- * Use this macro to create parameters into the Parameters Table using a variable.
- * Variable should be visible in the scope where the Table is declared, this can be
- * done with the "extern" keyword.
- *
- * **Example:**
- * @code
- * uint32_t example_var;	// Variable to parameterize
- * // The Parameter Table
- * param_table_t param_table= {
- *		{.name="example",	.type=UINT32_PARAM,	.size=UINT32_SIZE,	.opts=TELEMETRY	.value=parameterize(example_var),
- * }
- * @endcode
- * @param	variable_name			Name of the variable to parameterize
- */
-#define parameterize(variable_name)  (void*)&variable_name
-
-/**
- * @brief	Get the handle of a Parameter by the name
- * @param	name					Name of the parameter
- * @return	handle to param if OK, NULL if error or not found
- */
-param_handle_t get_param_handle_by_name(const char * name);
-
-/**
- * @brief	Get the index in table of a Parameter by the name
- * @param	name					Name of the parameter
- * @return	index to param if OK, -1 if error (not found)
- */
-param_index_t get_param_index(const char * name);
-
-/**
- * @brief	Get the handle of a Parameter by the index
- * @param	index					Index in table of the parameter
- * @return	handle to param if OK, NULL if error (not found)
- */
-param_handle_t get_param_handle_by_index(param_index_t index);
-
-/**
- * @brief	Set the value of a Parameter
- * @warning	Not thread-safe, user shall use mutex if sharing a param between many tasks, as with variables
- * @param	param_h				Handle of the param
- * @param	in_p 				Void pointer to memory where value is stored
- * @return	0 if OK, -1 if error ( Param no exists, or buffer too small)
- */
-int set_param_val(param_handle_t param_h, void * in_p);
-
-/**
- * @brief	Get the value of a Parameter
- * @param	param_h				Handle of the parameter
- * @param	out_p 				Void pointer to buffer to store param value, should be enough to store value
- * @return	0 if OK, -1 if error or Param no exists, or buffer too small
- */
-int get_param_val(param_handle_t param_h, void * out_p);
-
-/**
- * @brief	Macro for easing setting the value of a Parameters
- *
- * @code
- * //Example:
- * param_handle_t example_handle_uint16 = get_param_handle("example_uint16");	// get handle
- * set_param(example_handle_uint16, uint16, 100);								// Set value with macro
- * @endcode
- *
- * @param	handle				Handle of the parameter
- * @param	type				C build in type of the value, NOT a param_type_t, (i.e. uin8_t, int32_t, float, etc.)
- * @param	value				Value or variable with value to be assigned
- */
-#define set_param(handle, type, value)	{ type aux_var = value; set_param_val(handle, (void*)&aux_var);}
-
-/**
- * @brief	Macro for easing getting the value of a Parameters
- *
- * @code
- * Example:
- * param_handle_t example_handle_uint16 = get_param_handle("example_uint16");	// get handle
- * uint16_t other_var;
- * get_param( example_handle_uint16, other_var );				// get value with macro
- * @endcode
- *
- * @param	handle				Handle of the parameter
- * @param	dest_var			Destination variable where value will be stored
- */
-#define get_param( handle, dest_var ) { get_param_val(handle, (void*)&dest_var);}
-
-/**
- * @brief	Store the value of a param as string in a buffer
- * @param	param_handle		Handle of the param
- * @param	out_buff			Destination buffer
- * @param	buff_size 			Size of the destination buffer
- * @return	0 if OK, -1 if error
- */
-int param_to_str(param_handle_t param_handle, char* out_buff, int buff_size);
-
-/**
- * @brief	Set the value of a string to a param
- *
- * Convert the value of a string to the type of the param, and store it in the param value space
- * @param	param_handle		Handle of the param
- * @param	in_buff				Buffer with the value as string, to be assigned to the param
- * @return	0 if OK, -1 if error
- */
-int str_to_param(param_handle_t param_handle, char* in_buff);
-
-/**
- * @brief	Get amount of params in table
- * @return	Number of params in table
- */
-uint16_t get_table_size(void);
-
-/**
- * @brief	Collect all params with TEMELETRY
- *
- * Collects all params with TEMELETRY option and store the value with a tag
- * into dest_buff, if buff is not big enough, not all params will be collected.
- * Format: "TAG:value,TAG:value,TAG:value"
- * Example: "A:123,B:-3,C:0.001234"
- * Where "TAG" is a incremental alphabetical character (A,B,C,...,AA,AB,...)
- * and "value" is the value of the corresponding param.
- * For getting the reference between TAG and param see collect_telemtry_header()
- * @see collect_telemtry_header
- * @param	dest_buff			Buffer where telemetry data will be stored
- * @param	buff_size			Size of dest_buff
- */
-void collect_telemetry_params(char * dest_buff, size_t buff_size);
-
-/**
- * @brief	Collect the references between TAG and params with TELEMETRY
- *
- * Collect the references between TAG and params with TELEMETRY option into
- * dest_buff, if buff is not big enough, not all params will be collected.
- * Format: "TAG:param_name,TAG:param_name,TAG:param_name"
- * Example: "A:reset_cause,B:temperature,C:gps_lat"
- * Where "TAG" is a incremental alphabetical character (A,B,C,...,AA,AB,...)
- * and "param_name" is the name of the param assigned in the params table.
- *
- * @param	dest_buff			Buffer where telemetry data will be stored
- * @param	buff_size			Size of dest_buff
- * @return	-1 if error, size of string if OK
- */
-int collect_telemtry_header(char * dest_buff, int buff_size);
-
-/**
- * @brief	Print all params names and values in debug output.
- * @note	Debug Service function should be ported.
- * @see		sfsf_port.h
- */
-void print_pram_table(void);
-
-// Get Task Handle from parameters persistent task
-csp_thread_handle_t get_param_task_handle(void);
-
-#ifdef __cplusplus
-}
-#endif
-#endif /* SFSF_PARAM_H_ */
+/*
+Copyright 2018 olmanqj
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+of the Software, and to permit persons to whom the Software is furnished to do
+so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+ */
+#ifndef SFSF_PARAM_H_
+#define SFSF_PARAM_H_
+
+#ifndef SFSF_H_
+#error Include sfsf.h before sfsf_param.h!
+#endif
+
+#include <stdlib.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+/**
+ * @file	sfsf_param.h
+ * @brief	API for Parameter Service
+
+Parameter Service
+=================
+
+To avoid confusion:
+- Variable: variables from programming language, a storage location with an
+ associated name.
+- Argument: one of the pieces of data provided as input to a function.
+- Parameter: a characteristic that models or describes a system.
+
+
+Features Summary
+-------------
+- Set and get parameters.
+- Supports any type of parameter, and arrays with element and slice access.
+- Definitions to create the parameter table, or one table per subsystem.
+- Automatically collects parameters with Telemetry option, as text, binary or delta.
+- Automatically stores parameters in persistent memory, only when they change.
+- Derived and hardware backed parameters, computed or fetched only when read and cached.
+- Parameters protection with read only option.
+
+
+Module Description
+-----------------
+The Parameter Service acts as a database for the spacecraft's parameters,
+provides an easy way to set and get the value of any parameter. A parameter
+can be described as a variable that helps model or describe a system, it can
+be for example the pointing direction of the ADCS, or the output voltage of
+the EPS, or even if the communication system is on or off.
+
+Implementing the mission specific application using the Parameters Service
+instead of built-in variables from the platform, facilitates the control and
+monitoring of the spacecraft, because any parameter value can be modified or
+retrieved at any time. Parameters can be accessed by a name or by an index,
+this gives the ability to modify or retrieve the value of a parameter from
+the ground.
+
+The Parameter Table
+-------------------
+Parameters are stored in a table, the "Parameters Table". Each entry of the
+table is of type param_t, which contains the name, type, size, options and
+a pointer to the value of the parameter. In other words the Parameters Table
+is an array of param_t.
+
+The table should be created by the user, with the type param_table_t. It
+should be registered at init with the function set_param_table(), or as one
+of several tables, see Multiple Tables. The table isstatic and it is created
+at compilation, this means new parameters can not be added at run time.
+Therefore, users should include in the table, all required parameters during
+coding. There are two ways to add parameters to the table:
+
+- When the parameter does not exist, a new memory space can be created to store
+its value. This is done by adding a param_t struct to the table, as following:
+@code
+{.param_name = "example1", .type = UINT8_PARAM, .size = UINT8_SIZE,	.opts = TELEMETRY|PERSISTENT },
+@endcode
+
+- When the parameter is an existing variable, the variable can be "parameterized"
+and added to the table. This is done with the macro parameterize(), by adding a
+line as the following to the table:
+@code
+{.param_name = "example1", .type = UINT8_PARAM, .size = UINT8_SIZE,	.opts = TELEMETRY|PERSISTENT, parameterize(variable_name) },
+@endcode
+
+As shown in the two last examples, parameters require:
+- A unique name, the max name size is determined by the configuration
+ CONF_PARAM_NAME_SIZE.
+- Type: all supported types are enlisted in enum param_type_t.
+- Sze: size can be assigned with the macro sizeof(), or with the values of enum
+ param_size_t. For a parameter of type STRING_PARAM the size can be any, it
+ should be decided by the user.
+- Options: there are some special options that can be assigned to parameters,
+ these are enlisted in enum param_opts_t. Options are not mandatory,
+ parameters can have no options. All parameters with option TELEMTRY can be
+ collected into a string with the function collect_telemetry_params().
+ All parameters with option PERSITENT will be stored in persistent memory. This
+ is useful for restoring the configuration after a reboot from OBC. Note that
+ init_param_persistence() should be called at init and Storage Service functions
+ should be ported to make effective the PERSOSTENT option. The option READ_ONLY
+ is only applicable for parameters created with the parameterize() macro, this
+ inhibits the parameter value to be modified throughout the Parameter Service
+ API. This option is useful when there are parameters that should not be
+ modified from the ground, but retrieved, like a counter, or the output of a
+ sensor. Parameters with option HISTORY are sampled periodically by the
+ History Service, see sfsf_history.h.
+
+An example of a Parameters Table:
+@code
+// Variables to be parameterized
+uint32_t	variable_name;
+float		variable2_name;
+// Parameters Table
+param_table_t mission_param_table = {
+	//	NAME					TYPE				Size				Options							Variable
+	{.name="example1",	.type=UINT8_PARAM,	.size=UINT8_SIZE,	.opts=TELEMETRY},
+	{.name="example2",	.type=STRING_PARAM,	.size=20,			.opts=TELEMETRY|PERSISTENT|READ_ONLY},
+	{.name="example3",	.type=UINT32_PARAM,	.size=UINT32_SIZE,}, // Params may have no options
+	{.name="example4",	.type=UINT32_PARAM,	.size=UINT32_SIZE,	.opts=TELEMETRY|PERSISTENT,				.value=parameterize(variable_name)},
+	{.name="example5",	.type=FLOAT_PARAM,	.size=FLOAT_SIZE,											.value=parameterize(variable2_name)}
+};
+@endcode
+
+Then register the table during initialization, in init_services() function
+at init_functions.c.
+@code
+set_param_table(&mission_param_table,  sizeof( mission_param_table)/sizeof(*mission_param_table));
+@endcode
+
+set_param_table() copies the type, size, options and value pointer of each
+param into compact arrays, the names into a string pool, and lists the params
+with TELEMETRY and PERSISTENT options. Telemetry collection and persistence
+scan only these lists, without going through the names. Changes to the table
+entries after set_param_table() are not seen by the service.
+
+The table can also be generated at build time. Write it as a definition file,
+param_table.def in the app sources, with one param per line:
+@code
+# NAME			TYPE			SIZE	OPTIONS						VARIABLE
+example1		UINT8_PARAM		-		TELEMETRY
+example2		STRING_PARAM	20		TELEMETRY|PERSISTENT|READ_ONLY
+example4		UINT32_PARAM	-		TELEMETRY|PERSISTENT		variable_name
+@endcode
+
+The build runs tools/gen_param_table.py on it, which writes
+param_table_gen.h, with a PARAM_IDX_<NAME> macro with the index of each param,
+and param_table_gen.c, with the table, static storage for the values, and
+what set_param_table() would compute: layout, metadata, name index and schemas.
+Register it with set_param_table_prebuilt(), so booting takes no processing of
+the table and no heap.
+@code
+#include <param_table_gen.h>
+set_param_table_prebuilt(&mission_param_prebuilt);
+@endcode
+
+Multiple Tables
+---------------
+Instead of one table shared by everyone, each subsystem can define its own
+table and register it at init with register_param_table(), under a prefix
+such as "eps", "adcs" or "com". Once all are registered, mount_param_tables()
+places them one after the other in a single Parameter Table, so all the
+services work as with one table. Params are named "<prefix>.<name>", e.g.
+"eps.battery_v", the name in each table stays local and short, up to
+CONF_PARAM_NAME_SIZE, and the prefix takes up to CONF_PARAM_PREFIX_SIZE - 1.
+A table registered with the prefix "" keeps its names as they are.
+@code
+int eps_table_id = register_param_table("eps", &eps_param_table, EPS_PARAMS_NUM);
+int adcs_table_id = register_param_table("adcs", &adcs_param_table, ADCS_PARAMS_NUM);
+mount_param_tables();
+param_handle_t battery_h = get_param_handle_by_name("eps.battery_v");
+param_handle_t gain_h = get_param_handle_by_ref(adcs_table_id, ADCS_GAIN_INDEX);
+@endcode
+
+get_param_handle_by_ref() takes the table and the index of the param in it,
+so each subsystem keeps its own indexes. get_param_table_info() gives where a
+table starts in the Parameter Table. With more than one table, the entries
+are copied, so handles should be taken from the service and not from the
+registered tables. Lookups by name go through the name index of the whole
+table, so they do not slow down with more tables. The Parameter Table holds
+up to 32767 params in total.
+
+Each table is collected into telemetry and stored in persistent memory on its
+own: set_param_table_opts() turns TELEMETRY or PERSISTENT off for all the
+params of a table, e.g. to leave a subsystem out of the beacons while it is
+powered off. Binary beacons then carry a schema with the params collected.
+The changes of a table with PERSISTENT off are stored when it is turned on
+again. set_param_table() is the same as registering a single table with the
+prefix "" and mounting it.
+
+The definition file of a generated table starts a table with a line
+"%table <prefix>", tools/gen_param_table.py also takes several definition
+files, one per subsystem, and writes a PARAM_TABLE_<PREFIX> macro with the id
+of each table.
+
+Handling Parameters
+-------------------
+Whit a Parameter Table populated and registered, we can retrieve
+and modify the value of parameters. You may not access the param_t
+structures from table directly. Use the a Parameter Handle instead,
+the typedef param_handle_t, which is a pointer to a table entry. So
+once you have a handle pointing to a param, the access to the value
+is in immediate, there is no need to look-up through the table for
+the parameter. There are two ways to obtain a handle, by the name
+of the parameter, or by the index on the table.
+
+The easiest, by the name, with the function get_param_handle_by_name().
+This functions looks up the name in a hash index built by set_param_table(),
+so the cost does not grow with the size of the table. Still, it hashes and
+compares the name on every call, if the parameter is accessed very
+frequently keep the handle.
+
+@b Example:
+@code
+param_handle_t example1_h = get_param_handle_by_name("example1");
+@endcode
+
+The other way is by the index in table, using the function
+get_param_handle_by_index(). This functions is way more efficient
+that the previous one, because there is not need to scan the table,
+the access is directly, but you need to keep track of the indexes
+in table.
+
+@b Example:
+@code
+#define EXAMPLE1_INDEX	1	// Recommended to keep indexes as macros
+param_handle_t example1_h = get_param_handle_by_index(EXAMPLE1_INDEX);
+@endcode
+
+Once with the handle of a param, in other words a pointer to it, the
+acces to its value can be done with two functions: get_param_val()
+and set_param_val().
+
+To retreive the value of a parameter use get_param_val().
+
+@b Example:
+@code
+uint8_t aux_var;	// Variable where param value will be stored
+param_handle_t example1_h = get_param_handle("example1");
+get_param_val(example1_h, (void*)&aux_var );
+@endcode
+
+To modify the value of a parameter use set_param_val().
+
+@b Example:
+@code
+uint8_t example1 = 4;	// Value to set to param
+param_handle_t example1_h = get_param_handle("example1");
+set_param_val(example1_h, (void*)&example1 );
+@endcode
+
+Also you can use the macros get_param() and set_param(),
+which require less code.
+
+@b Example:
+@code
+// Set the value, note for set_param() you can place the value as argument
+set_param(example1_h, int8_t, -4);
+
+// Get the value
+uint8_t example1 = 4;
+get_param( example1_h, example1 );
+@endcode
+
+When the type is known, the typed accessors such as param_get_u32() and
+param_set_float() read or write the value directly, see
+PARAM_TYPED_ACCESSORS. For this set_param_table() lays out the values in
+param space by the size of their type, 8 byte values first, then 4, 2 and 1
+byte values and strings, so every value and array element is naturally
+aligned without padding. The layout can be printed with print_param_layout().
+
+
+The true advantage from the Param Service is the ability to
+access values by a string, the name. This way the ground segment
+can modify or retrieve variables in the spacecraft by knowing the
+name. Incoming and outgoing messages from ground may contain
+the value of parameters as strings, therefore you can also
+use the functions str_to_param() and param_to_str().
+
+To set the value of a parameter with a string with the value
+use str_to_param().
+
+@b Example:
+@code
+str_to_param(example_handle, "example string");
+@endcode
+
+
+To retrieve the value of a parameter as a string use
+param_to_str().
+
+@b Example:
+@code
+char buffer[20];
+param_to_str(example_handle, buffer, 20);
+@endcode
+
+Concurrent Access
+-----------------
+Params are shared by the app, the HK task, the persistence task and command
+routines. Each param has a sequence counter, odd while its value is being
+written. set_param_val() makes it odd, copies the value and makes it even
+again. get_param_val() copies the value and retries if the counter was odd
+or changed meanwhile, so a reader never gets a torn 64-bit, double or string
+value, and never blocks a writer. Only writers of the same param wait for
+each other. param_to_str(), str_to_param() and the telemetry collectors go
+through these functions. A task waiting on a busy param spins
+CONF_PARAM_SEQ_SPINS times and then sleeps 1 ms, so a preempted lower
+priority writer can finish.
+
+Parameterized variables written directly by the app, and values written
+through the value pointer of a handle, are not covered. Write them with
+set_param_val() if other tasks read them.
+
+Bulk Access
+-----------
+param_get_many() and param_set_many() read or write several params given by
+their indexes, with the values packed one after the other in a buffer. A bulk
+set is applied as a whole: a bulk get never sees part of it, e.g. the four
+components of a quaternion always belong to the same set. A bulk set is
+checked before writing anything, if an index is not valid or a param is
+READ_ONLY nothing is written.
+
+@b Example:
+@code
+const param_index_t quaternion[] = {Q0_INDEX, Q1_INDEX, Q2_INDEX, Q3_INDEX};
+float q[4] = {1, 0, 0, 0};
+param_set_many(quaternion, 4, q, sizeof(q));
+param_get_many(quaternion, 4, q, sizeof(q));
+@endcode
+
+Array Parameters
+----------------
+A param of a numeric type with a size of several elements is an array, e.g.
+a 3-axis vector, a quaternion or a calibration table. Sizes are 16 bits, so a
+param may take up to 65535 bytes.
+@code
+{.name="gyro_bias",	.type=FLOAT_PARAM,	.size=3*FLOAT_SIZE,	.opts=TELEMETRY|PERSISTENT},
+{.name="temp_cal",	.type=INT16_PARAM,	.size=512*INT16_SIZE,	.opts=PERSISTENT},
+@endcode
+
+get_param_val() and set_param_val() copy the whole array. param_get_elems()
+and param_set_elems() copy only a slice, from the value in param space to the
+caller buffer and back, and the typed accessors with the _at suffix, e.g.
+param_get_float_at(), a single element. param_elem_count() gives the amount
+of elements. A slice set is stored and notified as set_param_val(), and a
+slice get never sees part of a set.
+
+Binary beacons, param images and bulk access carry the elements packed one
+after the other. As text, elements are separated by PARAM_ARRAY_SEPARATOR,
+e.g. "0.1;-0.2;0.03". str_to_param() sets the given elements from the first
+one, the rest are not changed. param_to_str() writes only the elements that
+fit in the buffer, so large arrays should be PERSISTENT with
+PARAM_PERSIST_IMAGE. Arrays can not be sampled into the history.
+
+Change Notifications
+--------------------
+Instead of polling a param, a task can register a callback with
+param_subscribe(). When set_param_val() or str_to_param() changes the value
+of a subscribed param, a param_change_t with the old and the new value is
+copied into a queue, the writer does not allocate memory nor wait. The
+notification task, started with init_param_notifications(), takes all
+pending events at once and calls the callbacks. Several changes of the same
+param in one batch are delivered as one, from the first old value to the
+last new value, and not delivered at all if the value ends as it was.
+
+@b Example:
+@code
+void on_mode_change(param_handle_t param_h, const param_change_t * change, void * ctx)
+{
+	uint8_t new_mode;
+	memcpy(&new_mode, change->new_value, sizeof(new_mode));
+	...
+}
+param_subscribe(get_param_handle_by_name("adcs_mode"), on_mode_change, NULL);
+@endcode
+
+Callbacks run in the notification task. Parameterized variables written
+directly by the app do not notify.
+
+Derived Parameters
+------------------
+A value computed from others, e.g. a power from a voltage and a current, or
+the time as text, does not need to be written by the app on every loop. Give
+the param a compute function with param_set_derived(), and the service
+computes it only when read, by get_param_val(), param_get_elems(),
+param_get_many(), param_to_str() or the telemetry collectors. The value is
+cached until invalidated, by a TTL, by a write of one of its dependencies, or
+both. With no TTL and no dependencies it is computed on every read.
+
+@b Example:
+@code
+int compute_power(param_handle_t param_h, void * out_p, void * ctx)
+{
+	float power = param_get_float(voltage_h) * param_get_float(current_h);
+	memcpy(out_p, &power, sizeof(power));
+	return EXIT_SUCCESS;
+}
+static const param_index_t power_deps[] = {VOLTAGE_INDEX, CURRENT_INDEX};
+param_set_derived(power_h, compute_power, NULL, 0, power_deps, 2);
+@endcode
+
+The compute function runs in the task that reads, with the param held as
+being written, so it may read other params but never its own. Writes to a
+derived param are ignored, as READ_ONLY. Dependencies invalidate the value
+only when written through the service, parameterized variables written
+directly by the app should use a TTL.
+
+Hardware Backed Parameters
+--------------------------
+A param can hold the value of a sensor or a setting of a device, instead of
+the app polling the hardware and copying the value into the table. Give it a
+driver fetch function with param_set_backed(), and a store function to write
+it through. The value is fetched when read, as a derived param, and served
+from the cache while younger than its max age, so the HK collector and a
+command reading the same sensor within the budget do a single bus transaction.
+set_param_val(), param_set_elems() and str_to_param() update the cache and
+call store with the whole value, the value written is cached.
+
+@b Example:
+@code
+int fetch_temp(param_handle_t param_h, void * out_p, void * ctx)
+{
+	int16_t temp;
+	if(tmp100_read(ctx, &temp) != 0) return EXIT_FAILURE;
+	memcpy(out_p, &temp, sizeof(temp));
+	return EXIT_SUCCESS;
+}
+param_set_backed(temp_h, fetch_temp, NULL, &tmp100_dev, 500);
+@endcode
+
+If fetch fails the last value is kept, get_param_val() and param_get_elems()
+return -1 and the next read tries again. If store fails the setter returns
+-1 and the next read fetches what the hardware has. Without store, writes are
+ignored. Changes of derived and backed params do not notify subscribers.
+
+Snapshots
+---------
+With CONF_PARAM_SNAPSHOT enabled, the telemetry collectors and the
+persistence task work from a point-in-time copy of the values, so a beacon or
+an image does not mix values written before and after a control cycle. Each
+write through the service sets a bit of the param in a bitmap.
+param_snapshot_take() copies only the params with the bit set since the last
+snapshot, so its cost follows what changed, not the size of the table. If a
+write or a bulk set started while copying, the copy is repeated with the
+params written meanwhile, up to CONF_PARAM_SNAPSHOT_RETRIES times. Writers
+never wait for a snapshot, consumers wait for each other with a mutex.
+
+@b Example:
+@code
+param_snapshot_take();
+param_snapshot_get(VOLTAGE_INDEX, &voltage);
+param_snapshot_get(CURRENT_INDEX, &current);
+param_snapshot_release();
+@endcode
+
+Parameterized variables are copied on every snapshot. The typed accessors go
+through set_param_val() when snapshots are enabled. The snapshot takes as much
+RAM as the values.
+
+Persistence
+-----------
+init_param_persistence() restores the stored params with PERSISTENT option,
+and starts the persistence task. Writes through set_param_val() and
+str_to_param() mark the param as dirty, parameterized variables are compared
+with their last stored value. Every CONF_PARAM_PERSIST_PERIOD the task stores
+the params, only if something changed, otherwise the storage is not touched
+at all. The format is selected with CONF_PARAM_PERSIST_FORMAT:
+
+- PARAM_PERSIST_IMAGE: a binary image with the values of all PERSISTENT
+ params, in table order, written alternately to two slots (files
+ CONF_PARAM_IMAGE_FILE_A and CONF_PARAM_IMAGE_FILE_B). Each slot has a header
+ with a sequence number, a hash of the PERSISTENT params definition and a
+ CRC-32. A slot is only written when the other one holds the latest image,
+ and it becomes the latest once synced to the media with file_sync(), so a
+ reset while writing never loses the stored params. load_param_image()
+ takes the newest valid slot and copies the values straight into the params,
+ including READ_ONLY ones. An image from a different table is ignored.
+- PARAM_PERSIST_TEXT: the file CONF_PARAM_FILE_NAME, one "name,value" record
+ per line. The task appends a record for each dirty param only. After
+ CONF_PARAM_FILE_MAX_RECORDS records the file is rewritten with only the
+ latest value of each param. load_param_table() applies the records in
+ order, so the last record of a param wins. A value longer than
+ CONF_PARAM_MAX_PARAM_SIZE - 1 chars is not stored, keep big arrays in
+ PARAM_PERSIST_IMAGE.
+
+Delta Telemetry
+---------------
+Most housekeeping values do not change between beacons. With CONF_PARAM_DELTA
+enabled, collect_telemetry_params_delta() writes a binary beacon with only the
+TELEMETRY params that changed since the previous beacon, and a bitmap of which
+ones are present, see sfsf_hk.h for the format. The service keeps the last
+value sent of each TELEMETRY param, as much RAM as their values. Every
+CONF_PARAM_DELTA_KEYFRAME_PERIOD beacons, and when the TELEMETRY params
+change, e.g. by set_param_table_opts(), all values are sent in a keyframe, so
+ground recovers from lost beacons. param_delta_keyframe() asks for one now.
+
+Noisy float params can be given a deadband with param_set_deadband(): they are
+sent only when an element moves more than the deadband from the value last
+sent, small changes are not lost but accumulate until they pass it.
+
+Access Statistics
+-----------------
+With CONF_PARAM_STATS enabled, the service counts per param the calls to
+get_param_val(), param_get_elems() and param_get_many() as reads, the calls to
+set_param_val() and param_set_elems() as writes, with the get_timestamp_s() of
+the last one, and the times it was found by get_param_handle_by_name() or
+get_param_index(). Reads done by the framework, e.g. for telemetry,
+persistence, history or param_to_str(), go through
+param_get_elems_uncounted() and are not counted. The counters are not atomic, a few counts may be
+lost under concurrent access. Use them to find the hot params, e.g. to look
+them up once at init or give them a compile-time index, and the params never
+used. See param_get_stats() and print_param_stats(). With CONF_PARAM_STATS
+disabled the counting compiles to nothing, and the typed accessors keep their
+single access fast path, which is not counted.
+
+*/
+
+
+
+/** @name Parameterizable Variables
+ *
+ * Persistence statistics, use the parameterize() Macro to add them to the
+ * Parameters Table.
+ */
+///@{
+extern uint32_t param_persist_period;	/**< Period in ms to store changed params. */
+extern uint32_t param_persist_bytes;	/**< Bytes written to the param file. */
+extern uint32_t param_persist_skipped;	/**< Periods without changes, where nothing was written. */
+extern uint32_t param_persist_failed;	/**< Params left dirty, their value as text does not fit in CONF_PARAM_MAX_PARAM_SIZE. */
+extern uint32_t param_notify_dropped;	/**< Change events lost because the notification queue was full. */
+extern uint32_t param_ram_bytes;		/**< RAM taken by the Param Service, values and metadata. */
+///@}
+
+
+/**
+ * @enum	param_type_t
+ * @brief	Parameter Types
+ *
+ * Supported types for parameters
+*/
+typedef enum
+{
+	UINT8_PARAM,
+	INT8_PARAM,
+	UINT16_PARAM,
+	INT16_PARAM,
+	UINT32_PARAM,
+	INT32_PARAM,
+	UINT64_PARAM,
+	INT64_PARAM,
+	FLOAT_PARAM,
+	DOUBLE_PARAM,
+	STRING_PARAM
+} param_type_t;
+
+/**
+ * @enum	param_size_t
+ * @brief	Parameter Sizes
+ *
+ * Macros for assigning the size in Parameters Table, note that STRING_PARAM
+ * can have any size, is decision from user to assign the size.
+*/
+typedef enum
+{
+	UINT8_SIZE		= sizeof(uint8_t),
+	INT8_SIZE		= sizeof(int8_t),
+	UINT16_SIZE		= sizeof(uint16_t),
+	INT16_SIZE		= sizeof(int16_t),
+	UINT32_SIZE		= sizeof(uint32_t),
+	INT32_SIZE		= sizeof(int32_t),
+	UINT64_SIZE		= sizeof(uint64_t),
+	INT64_SIZE		= sizeof(int64_t),
+	FLOAT_SIZE		= sizeof(float),
+	DOUBLE_SIZE		= sizeof(double)
+	// String Size should be decided by user.
+} param_size_t;
+
+/**
+ * @enum	param_opts_t
+ * @brief	Parameter Options
+ * @note	READ_ONLY is only applicable for parameterized variables.
+ *
+ * Macros for assigning the options in Parameters Table
+*/
+typedef enum
+{
+	TELEMETRY	= 0b00000001,		/**< Automatic collect this param for telemetry. */
+	PERSISTENT	= 0b00000010,		/**< Persist the value on non volatile memory. */
+	READ_ONLY	= 0b00000100,		/**< Prohibited to write with param_service functions, only applicable for parameterized variables. */
+	HISTORY		= 0b00001000,		/**< Sample this param into the on-board history, see sfsf_history.h. */
+	DERIVED		= 0b00010000,		/**< Set by param_set_derived(), do not use in the table. */
+	BACKED		= 0b00100000,		/**< Set by param_set_backed() if written through, do not use in the table. */
+	DEPENDENCY	= 0b01000000,		/**< Set by param_set_derived() on the dependencies, do not use in the table. */
+	SUBSCRIBED	= 0b10000000		/**< Set by param_subscribe(), do not use in the table. */
+} param_opts_t;
+
+/**
+ * @struct	param_t
+ * @brief	Parameter struct
+ *
+ * Holds the data for a parameter in the table. The Parameter Table
+ * is composed by a collection of this struct.
+ * @see param_table_t
+ *
+ * Do not handle this struct directly, use instead param_handle_t type
+ * and the API defined functions.
+ * @see param_handle_t
+*/
+typedef struct
+{
+	const char name[CONF_PARAM_NAME_SIZE];	/**< Name of the param.	*/
+	const param_type_t type;				/**< Param Type, from param_type_t. */
+	const uint16_t size;					/**< Size in bytes, from param_size_t, count * element size if array, or custom if STRING_PARAM.*/
+	uint8_t opts;							/**< Special options, from param_opts_t.*/
+	void* value;							/**< Pointer to param space where value is stored. */
+}param_t;
+
+/**
+ * @typedef	param_table_t
+ * @brief	Parameters Table Type
+ *
+ * Type to define the parameters table.
+ * @note The table should be register during initialization with set_param_table()
+ *
+ * **Example**:
+ * @code
+ * // Variables to be parameterized
+ * uint32_t	variable_name;
+ * float		variable2_name;
+ * // Parameters Table
+ * param_table_t mission_param_table = {
+ *	//	NAME					TYPE				Size				Options							Variable
+ *	{.name="example1",	.type=UINT8_PARAM,	.size=UINT8_SIZE,	.opts=TELEMETRY},
+ *	{.name="example2",	.type=STRING_PARAM,	.size=20,			.opts=TELEMETRY|PERSISTENT|READ_ONLY},
+ *	{.name="example3",	.type=UINT32_PARAM,	.size=UINT32_SIZE,}, // Params may have no options
+ *	{.name="example4",	.type=UINT32_PARAM,	.size=UINT32_SIZE,	.opts=TELEMETRY|PERSISTENT,				.value=parameterize(variable_name)},
+ *	{.name="example5",	.type=FLOAT_PARAM,	.size=FLOAT_SIZE,											.value=parameterize(variable2_name)}
+ * };
+ * @endcode
+*/
+typedef param_t param_table_t[];
+
+/**
+ * @typedef	param_handle_t
+ * @brief	Parameter Handle Type
+ *
+ * Pointer to a parameter struct, i.e: entry in parameters table.
+ * Use this type and the API functions for handling parameters.
+ * @see set_param_val(), get_param_val(), set_param(), get_param()
+*/
+typedef param_t* param_handle_t;
+
+/**
+ * @typedef	param_index_t
+ * @brief	Index to a parameter Type
+ *
+ * Type to retrieve a parameter handler by the index in table.
+*/
+typedef int16_t param_index_t;
+
+/**
+ * @typedef	param_table_id_t
+ * @brief	Id of a table registered with register_param_table()
+*/
+typedef int8_t param_table_id_t;
+
+/**
+ * @struct	param_table_info_t
+ * @brief	A table of the Parameter Table, see register_param_table()
+ */
+typedef struct
+{
+	const char * prefix;			/**< Prefix of the names, without separator, "" for none. */
+	param_t * table;				/**< Table as registered, NULL if prebuilt. */
+	param_index_t first;			/**< Index of its first param in the Parameter Table. */
+	uint16_t size;					/**< Num of entries of the table. */
+	uint16_t telemetry_first;		/**< Position of its first TELEMETRY param in the TELEMETRY list. */
+	uint16_t telemetry_num;			/**< Amount of its TELEMETRY params. */
+	uint16_t persistent_first;		/**< Position of its first PERSISTENT param in the PERSISTENT list. */
+	uint16_t persistent_num;		/**< Amount of its PERSISTENT params. */
+	uint8_t opts;					/**< TELEMETRY and PERSISTENT if collected and stored, see set_param_table_opts(). */
+} param_table_info_t;
+
+/**
+ * @struct	param_meta_t
+ * @brief	Hot metadata of the params
+ *
+ * Parallel arrays indexed as the table, the lists of TELEMETRY and
+ * PERSISTENT params and the name pool. Built by set_param_table(), or
+ * generated at build time, see param_prebuilt_t.
+ */
+typedef struct
+{
+	void ** value;					/**< Pointer to the value of each param. */
+	uint32_t * name;				/**< Offset of the name of each param in names. */
+	param_index_t * telemetry;		/**< Indexes of params with TELEMETRY option, in table order. */
+	param_index_t * persistent;		/**< Indexes of params with PERSISTENT option, in table order. */
+	uint8_t * type;					/**< param_type_t of each param. */
+	uint16_t * size;				/**< Size of each param. */
+	uint8_t * opts;					/**< Options of each param, as in the table. */
+	char * names;					/**< Pool with the names, null terminated one after the other. */
+	uint16_t telemetry_num;			/**< Amount of TELEMETRY params. */
+	uint16_t persistent_num;		/**< Amount of PERSISTENT params. */
+} param_meta_t;
+
+/**
+ * @struct	param_snapshot_t
+ * @brief	Point-in-time copy of the values, see param_snapshot_take()
+ */
+typedef struct
+{
+	uint8_t * values;				/**< Copy of the values, params in param space at the same offset. */
+	uint32_t * offset;				/**< Offset of the value of each param in values. */
+	uint32_t * changed;				/**< Bitmap of params written since the last snapshot. */
+	uint32_t * vars;				/**< Bitmap of parameterized variables, copied on every snapshot. */
+} param_snapshot_t;
+
+/**
+ * @struct	param_stats_t
+ * @brief	Access statistics of a param, see param_get_stats()
+ */
+typedef struct
+{
+	uint32_t reads;					/**< Reads by get_param_val(), param_get_elems() and param_get_many(). */
+	uint32_t writes;				/**< Writes by set_param_val() and param_set_elems(), changed or not. */
+	uint32_t last_write_s;			/**< get_timestamp_s() of the last write, 0 if never written. */
+	uint32_t lookups;				/**< Times found by get_param_handle_by_name() or get_param_index(). */
+} param_stats_t;
+
+/**
+ * @struct	param_prebuilt_t
+ * @brief	Parameter Table generated at build time
+ *
+ * The table with its value storage, and everything set_param_table() computes
+ * at boot, generated by tools/gen_param_table.py. Register it with
+ * set_param_table_prebuilt(). All arrays are statically allocated.
+ */
+typedef struct
+{
+	param_t * table;				/**< The Parameter Table, value pointers already set. */
+	uint16_t table_size;			/**< Num of entries of table. */
+	void * space;					/**< Storage of the values, laid out by alignment. */
+	uint32_t space_size;			/**< Size of space. */
+	param_meta_t meta;				/**< Hot metadata. */
+	param_index_t * name_index;		/**< Name index, see param_name_hash(). */
+	uint32_t name_index_slots;		/**< Amount of slots in name_index. */
+	volatile uint32_t * seq;		/**< Sequence counters, one per param, zeroed. */
+	uint8_t * dirty;				/**< Dirty flags, one per param, zeroed. */
+	uint8_t * shadow;				/**< Copy of parameterized PERSISTENT variables, NULL if none. */
+	uint8_t * image;				/**< Buffer of a param image, NULL if not PARAM_PERSIST_IMAGE. */
+	uint32_t image_size;			/**< Size of the values in a param image. */
+	uint32_t telemetry_schema;		/**< Hash of the TELEMETRY params definition. */
+	uint32_t image_schema;			/**< Hash of the PERSISTENT params definition. */
+	param_snapshot_t snapshot;		/**< Snapshot, all NULL if CONF_PARAM_SNAPSHOT is disabled. */
+	param_stats_t * stats;			/**< Access statistics, one per param, zeroed, NULL if CONF_PARAM_STATS is disabled. */
+	uint8_t * delta;				/**< Last values sent in delta beacons, size of the TELEMETRY values, NULL if CONF_PARAM_DELTA is disabled. */
+	const param_table_info_t * tables;	/**< Tables, in the order of the Parameter Table. */
+	uint8_t tables_num;				/**< Amount of tables. */
+	uint32_t ram_bytes;				/**< RAM taken by all of the above. */
+} param_prebuilt_t;
+
+
+
+/** @name Persistence Formats
+ *  Values for CONF_PARAM_PERSIST_FORMAT.
+ */
+///@{
+#define PARAM_PERSIST_TEXT			0		/**< Text records in CONF_PARAM_FILE_NAME. */
+#define PARAM_PERSIST_IMAGE			1		/**< Binary image in two alternating slots. */
+///@}
+
+#ifndef CONF_PARAM_PERSIST_FORMAT
+#define CONF_PARAM_PERSIST_FORMAT	PARAM_PERSIST_TEXT
+#endif
+#ifndef CONF_PARAM_IMAGE_FILE_A
+#define CONF_PARAM_IMAGE_FILE_A		"params_a.bin"
+#endif
+#ifndef CONF_PARAM_IMAGE_FILE_B
+#define CONF_PARAM_IMAGE_FILE_B		"params_b.bin"
+#endif
+#ifndef CONF_PARAM_MAX_TABLES
+#define CONF_PARAM_MAX_TABLES		8
+#endif
+#ifndef CONF_PARAM_PREFIX_SIZE
+#define CONF_PARAM_PREFIX_SIZE		8
+#endif
+
+/** @name Table Prefixes
+ */
+///@{
+#define PARAM_TABLE_SEPARATOR		'.'		/**< Between the prefix of the table and the name of a param. */
+#define PARAM_FULL_NAME_SIZE		(CONF_PARAM_PREFIX_SIZE + CONF_PARAM_NAME_SIZE)	/**< Max size of a name with its prefix. */
+///@}
+
+/**
+ * @brief	Load parameters in a file to the Parameter Table
+ *
+ * When enabling the Parameter persistence Service with  init_param_persistence(), prameters
+ * are stored in a file. After a rebbot form OBC, to restore the Parameter Table use this
+ * function. The Param Table should be created befor, using  set_param_table().
+ * @note 	Param Table should be created befor!
+ * @see 	set_param_table()
+ * @note	Storage Service functions should be ported. See simle_port.h.
+ * @see		sfsf_port.h
+ * @param 	file_name 		Name of file where parameters are stored in persistent memory
+ * @return	-1 if error, 0 if OK
+ */
+int load_param_table(char* file_name);
+
+/**
+ * @brief	Load the latest valid binary image of PERSISTENT params
+ *
+ * Used when CONF_PARAM_PERSIST_FORMAT is PARAM_PERSIST_IMAGE, called by
+ * init_param_persistence(). Checks both slots and copies the values of the
+ * newest one with a valid CRC into the params.
+ * @note	Storage Service functions should be ported. See sfsf_port.h.
+ * @return	-1 if error or no valid image, 0 if OK
+ */
+int load_param_image(void);
+
+
+#ifndef CONF_PARAM_EVENT_VALUE_SIZE
+#define CONF_PARAM_EVENT_VALUE_SIZE		8
+#endif
+#ifndef CONF_PARAM_MAX_SUBSCRIPTIONS
+#define CONF_PARAM_MAX_SUBSCRIPTIONS	16
+#endif
+#ifndef CONF_PARAM_NOTIFY_QUEUE_SIZE
+#define CONF_PARAM_NOTIFY_QUEUE_SIZE	16
+#endif
+#ifndef CONF_PARAM_MAX_DERIVED
+#define CONF_PARAM_MAX_DERIVED			8
+#endif
+
+/**
+ * @struct	param_change_t
+ * @brief	Change of the value of a param, delivered to subscribers
+ *
+ * Values longer than CONF_PARAM_EVENT_VALUE_SIZE, e.g. strings, carry only the
+ * first size bytes.
+ */
+typedef struct
+{
+	param_index_t index;											/**< Index of the param in the table. */
+	uint8_t size;													/**< Bytes in old_value and new_value. */
+	uint8_t old_value[CONF_PARAM_EVENT_VALUE_SIZE] __attribute__((aligned(8)));	/**< Value before the change. */
+	uint8_t new_value[CONF_PARAM_EVENT_VALUE_SIZE] __attribute__((aligned(8)));	/**< Value after the change. */
+} param_change_t;
+
+/**
+ * @typedef	param_callback_t
+ * @brief	Function called when a subscribed param changes
+ * @param	param_h				Handle of the param
+ * @param	change				The change, only valid during the call
+ * @param	ctx					Pointer given to param_subscribe()
+ */
+typedef void (*param_callback_t)(param_handle_t param_h, const param_change_t * change, void * ctx);
+
+/**
+ * @brief	Init the task that delivers param changes to subscribers
+ * @return	-1 if error, 0 if OK
+ */
+int init_param_notifications(void);
+
+/**
+ * @brief	Call a function each time the value of a param changes
+ * @note	Callbacks may call param_subscribe() and param_unsubscribe(), the change being
+ * 			delivered still goes to the subscribers it had when its delivery started.
+ * @param	param_h				Handle of the param
+ * @param	callback			Function to call
+ * @param	ctx					Pointer passed to the callback
+ * @return	-1 if error (notifications not started or CONF_PARAM_MAX_SUBSCRIPTIONS reached), 0 if OK
+ */
+int param_subscribe(param_handle_t param_h, param_callback_t callback, void * ctx);
+
+/**
+ * @brief	Remove a subscription made with param_subscribe()
+ * @param	param_h				Handle of the param
+ * @param	callback			Function given to param_subscribe()
+ * @param	ctx					Pointer given to param_subscribe()
+ * @return	-1 if error (not found), 0 if OK
+ */
+int param_unsubscribe(param_handle_t param_h, param_callback_t callback, void * ctx);
+
+/**
+ * @typedef	param_compute_t
+ * @brief	Function that computes the value of a derived param
+ * @param	param_h				Handle of the param
+ * @param	out_p				Where to write the value, param_h->size bytes
+ * @param	ctx					Pointer given to param_set_derived()
+ * @return	-1 if error (the previous value is kept), 0 if OK
+ */
+typedef int (*param_compute_t)(param_handle_t param_h, void * out_p, void * ctx);
+
+/**
+ * @brief	Compute the value of a param when read, and cache it
+ *
+ * Call it at init, after the table is set. The value is computed again when
+ * read if older than ttl_ms, or if a dependency was written since computed.
+ * @note	compute should not read the derived param itself.
+ * @param	param_h				Handle of the param
+ * @param	compute				Function that computes the value, NULL to make it a plain param again
+ * @param	ctx					Pointer passed to compute
+ * @param	ttl_ms				Max age of the cached value in ms, 0 for no limit
+ * @param	deps				Indexes of the params it is computed from, kept by reference, NULL if none
+ * @param	deps_num			Amount of deps
+ * @return	-1 if error (CONF_PARAM_MAX_DERIVED reached), 0 if OK
+ */
+int param_set_derived(param_handle_t param_h, param_compute_t compute, void * ctx, uint32_t ttl_ms, const param_index_t * deps, uint8_t deps_num);
+
+/**
+ * @typedef	param_store_t
+ * @brief	Function that writes the value of a hardware backed param to the hardware
+ * @param	param_h				Handle of the param
+ * @param	in_p				The whole value to write, param_h->size bytes
+ * @param	ctx					Pointer given to param_set_backed()
+ * @return	-1 if error, 0 if OK
+ */
+typedef int (*param_store_t)(param_handle_t param_h, const void * in_p, void * ctx);
+
+/**
+ * @brief	Fetch the value of a param from the hardware when read, and write it through
+ *
+ * Call it at init, after the table is set. Reads within max_age_ms of the
+ * last fetch or write are served from the cache. Backed params count in
+ * CONF_PARAM_MAX_DERIVED.
+ * @note	fetch and store should not read nor write the param itself.
+ * @param	param_h				Handle of the param
+ * @param	fetch				Driver function that reads the value, NULL to make it a plain param again
+ * @param	store				Driver function that writes the value, NULL if writes are ignored
+ * @param	ctx					Pointer passed to fetch and store, e.g. the device
+ * @param	max_age_ms			Max age of the cached value in ms, 0 to fetch on every read
+ * @return	-1 if error (CONF_PARAM_MAX_DERIVED reached), 0 if OK
+ */
+int param_set_backed(param_handle_t param_h, param_compute_t fetch, param_store_t store, void * ctx, uint32_t max_age_ms);
+
+
+/**
+ * @brief	Init the task that stores parameters in persistent memory.
+ *
+ * Restores the stored params first, see CONF_PARAM_PERSIST_FORMAT.
+ * @note	Storage Service functions should be ported. See simle_port.h.
+ * @see		sfsf_port.h
+ * @return	-1 if error, 0 if OK
+ */
+int init_param_persistence(void);
+
+/**
+ * @brief	Set the parameter table
+ *
+ * Call this function during initialization, in init_services() function
+ * at init_functions.c.
+ * @param	param_table				Pointer to the param table
+ * @param	param_table_size		Num of entries of param_table
+ * @return	-1 if error, 0 if OK
+ */
+int set_param_table(param_table_t* param_table, uint16_t param_table_size);
+
+/**
+ * @brief	Set a parameter table generated at build time
+ *
+ * Use instead of set_param_table() with the table generated by
+ * tools/gen_param_table.py. Nothing is computed nor allocated, the generated
+ * layout, metadata, name index and schemas are taken as they are.
+ * @param	prebuilt				Generated table, i.e. &mission_param_prebuilt
+ * @return	-1 if error, 0 if OK
+ */
+int set_param_table_prebuilt(const param_prebuilt_t * prebuilt);
+
+/**
+ * @brief	Register a table of a subsystem
+ *
+ * Call it during initialization for each table, then mount_param_tables().
+ * Up to CONF_PARAM_MAX_TABLES tables. The table starts with TELEMETRY and
+ * PERSISTENT on.
+ * @param	prefix					Prefix of the names, e.g. "eps", shorter than CONF_PARAM_PREFIX_SIZE, "" for none
+ * @param	param_table				Pointer to the param table
+ * @param	param_table_size		Num of entries of param_table
+ * @return	Id of the table, -1 if error (full, prefix too long or already registered)
+ */
+int register_param_table(const char * prefix, param_table_t * param_table, uint16_t param_table_size);
+
+/**
+ * @brief	Set the registered tables as the Parameter Table
+ *
+ * The tables are placed one after the other, in the order they were
+ * registered. A single table is used in place, as set_param_table() does,
+ * several are copied into a new table. Mounting again frees the memory taken
+ * for the tables mounted before.
+ * @return	-1 if error, 0 if OK
+ */
+int mount_param_tables(void);
+
+/**
+ * @brief	Get the id of a table by its prefix
+ * @param	prefix					Prefix of the table, without separator
+ * @return	Id of the table, -1 if not found
+ */
+param_table_id_t get_param_table_id(const char * prefix);
+
+/**
+ * @brief	Get a table of the Parameter Table
+ * @param	table_id				Id of the table
+ * @return	The table, NULL if error (not found)
+ */
+const param_table_info_t * get_param_table_info(param_table_id_t table_id);
+
+/**
+ * @brief	Get the amount of tables in the Parameter Table
+ * @return	Amount of tables
+ */
+uint8_t get_param_tables_num(void);
+
+/**
+ * @brief	Get the handle of a Parameter by its table and its index in that table
+ * @param	table_id				Id of the table
+ * @param	index					Index of the param in the table
+ * @return	handle to param if OK, NULL if error (not found)
+ */
+param_handle_t get_param_handle_by_ref(param_table_id_t table_id, param_index_t index);
+
+/**
+ * @brief	Turn telemetry and persistence of a table on or off
+ *
+ * Params of a table without TELEMETRY are left out of the beacons and the
+ * telemetry schema, without PERSISTENT they are not stored until it is set
+ * again. The options of each param are not changed.
+ * @param	table_id				Id of the table
+ * @param	opts					TELEMETRY and/or PERSISTENT to turn on, the others are turned off
+ * @return	-1 if error, 0 if OK
+ */
+int set_param_table_opts(param_table_id_t table_id, uint8_t opts);
+
+/**
+ * @def  parameterize
+ * @brief Macro to parameterize a variable into the Parameters Table.
+ *
+ * Use this macro to create parameters into the Parameters Table using a variable.
+ * Variable should be visible in the scope where the Table is declared, this can be
+ * done with the "extern" keyword.
+ *
+ * **Example:**
+ * @code
+ * uint32_t example_var;	// Variable to parameterize
+ * // The Parameter Table
+ * param_table_t param_table= {
+ *		{.name="example",	.type=UINT32_PARAM,	.size=UINT32_SIZE,	.opts=TELEMETRY	.value=parameterize(example_var),
+ * }
+ * @endcode
+ * @param	variable_name			Name of the variable to parameterize
+ */
+#define parameterize(variable_name)  (void*)&variable_name
+
+/**
+ * @brief	Hash of a parameter name, as used by the name index
+ *
+ * FNV-1a (32 bits) over the chars of the name with the prefix of its table,
+ * up to the null-character or PARAM_FULL_NAME_SIZE chars. A param is placed
+ * in the name index at slot (hash & (slots - 1)), or at the next free slot
+ * (linear probing).
+ * @param	name					Name of the parameter
+ * @return	hash of the name
+ */
+uint32_t param_name_hash(const char * name);
+
+/**
+ * @brief	Set a prebuilt name index
+ *
+ * By default set_param_table() builds the name index in the heap. A name
+ * index generated at build time can be set instead, with this function,
+ * before calling set_param_table(). Each slot holds the index in table of a
+ * param, or -1 if empty. Params are placed as described in param_name_hash().
+ * set_param_table() fails if the index does not match the table. It is used
+ * by the next set_param_table() only, later ones build their own index.
+ * @param	name_index				Array of slots
+ * @param	slots					Amount of slots, should be a power of two
+ * @return	-1 if error, 0 if OK
+ */
+int set_param_name_index(param_index_t * name_index, uint32_t slots);
+
+/**
+ * @brief	Get the handle of a Parameter by the name
+ * @param	name					Name of the parameter
+ * @return	handle to param if OK, NULL if error or not found
+ */
+param_handle_t get_param_handle_by_name(const char * name);
+
+/**
+ * @brief	Get the index in table of a Parameter by the name
+ * @param	name					Name of the parameter
+ * @return	index to param if OK, -1 if error (not found)
+ */
+param_index_t get_param_index(const char * name);
+
+/**
+ * @brief	Get the handle of a Parameter by the index
+ * @param	index					Index in table of the parameter
+ * @return	handle to param if OK, NULL if error (not found)
+ */
+param_handle_t get_param_handle_by_index(param_index_t index);
+
+/**
+ * @brief	Set the value of a Parameter
+ *
+ * Thread-safe, concurrent readers retry instead of reading a half written value.
+ * Waits only for other writers of the same param.
+ * @param	param_h				Handle of the param
+ * @param	in_p 				Void pointer to memory where value is stored
+ * @return	0 if OK, -1 if error ( Param no exists, or buffer too small)
+ */
+int set_param_val(param_handle_t param_h, void * in_p);
+
+/**
+ * @brief	Get the value of a Parameter
+ *
+ * Thread-safe, never blocks writers. Retries if the value changes while copying it.
+ * @param	param_h				Handle of the parameter
+ * @param	out_p 				Void pointer to buffer to store param value, should be enough to store value
+ * @return	0 if OK, -1 if error or Param no exists, or buffer too small
+ */
+int get_param_val(param_handle_t param_h, void * out_p);
+
+/** Separator of the elements of an array param as text. */
+#define PARAM_ARRAY_SEPARATOR		';'
+
+/**
+ * @brief	Get the size of an element of a Parameter
+ * @param	param_h				Handle of the param
+ * @return	Size of the type of the param, 1 if STRING_PARAM, 0 if error
+ */
+uint16_t param_elem_size(param_handle_t param_h);
+
+/**
+ * @brief	Get the amount of elements of a Parameter
+ * @param	param_h				Handle of the param
+ * @return	Elements in the value, 1 if not an array, chars if STRING_PARAM, 0 if error
+ */
+uint16_t param_elem_count(param_handle_t param_h);
+
+/**
+ * @brief	Get some elements of an array Parameter
+ *
+ * Thread-safe as get_param_val(), copies only the slice.
+ * @param	param_h				Handle of the param
+ * @param	first				Index of the first element
+ * @param	count				Amount of elements
+ * @param	out_p				Buffer for count elements
+ * @return	0 if OK, -1 if error or the slice is out of the array
+ */
+int param_get_elems(param_handle_t param_h, uint16_t first, uint16_t count, void * out_p);
+
+/**
+ * @brief	Get some elements of a Parameter without counting the read
+ *
+ * As param_get_elems(), for the services of the framework, e.g. the history,
+ * so their reads are not counted in the access statistics.
+ * @see		param_get_elems()
+ */
+int param_get_elems_uncounted(param_handle_t param_h, uint16_t first, uint16_t count, void * out_p);
+
+/**
+ * @brief	Set some elements of an array Parameter
+ *
+ * Thread-safe as set_param_val(), copies only the slice. The param is stored
+ * and notified as with set_param_val().
+ * @param	param_h				Handle of the param
+ * @param	first				Index of the first element
+ * @param	count				Amount of elements
+ * @param	in_p				Buffer with count elements
+ * @return	0 if OK, -1 if error or the slice is out of the array
+ */
+int param_set_elems(param_handle_t param_h, uint16_t first, uint16_t count, const void * in_p);
+
+/**
+ * @brief	Take a snapshot of the values
+ *
+ * Copies the params written since the last snapshot, and holds the snapshot
+ * until param_snapshot_release(). Writers are never held, other consumers
+ * wait in param_snapshot_take().
+ * @return	0 if OK, -1 if CONF_PARAM_SNAPSHOT is disabled
+ */
+int param_snapshot_take(void);
+
+/**
+ * @brief	Get the value of a param from the snapshot
+ *
+ * Should be called between param_snapshot_take() and param_snapshot_release().
+ * Without snapshot the value is read as get_param_val().
+ * @param	index				Index of the param in table
+ * @param	out_p				Buffer to store the value, as get_param_val()
+ * @return	0 if OK, -1 if error
+ */
+int param_snapshot_get(param_index_t index, void * out_p);
+
+/**
+ * @brief	Release the snapshot taken with param_snapshot_take()
+ */
+void param_snapshot_release(void);
+
+/**
+ * @brief	Get the size of the values of several params
+ * @param	indexes				Indexes of the params in table
+ * @param	count				Amount of indexes
+ * @return	Sum of the sizes of the params, -1 if an index is not valid
+ */
+int param_get_many_size(const param_index_t * indexes, uint16_t count);
+
+/**
+ * @brief	Get the values of several params at once
+ *
+ * Values are stored one after the other in out_buff, in the order of indexes,
+ * each with the size of the param. Never sees part of a param_set_many().
+ * @param	indexes				Indexes of the params in table
+ * @param	count				Amount of indexes
+ * @param	out_buff			Destination buffer
+ * @param	buff_size			Size of the destination buffer
+ * @return	Bytes stored in out_buff, -1 if error (index not valid or buffer too small)
+ */
+int param_get_many(const param_index_t * indexes, uint16_t count, void * out_buff, size_t buff_size);
+
+/**
+ * @brief	Set the values of several params at once
+ *
+ * Values are taken one after the other from in_buff, as stored by param_get_many().
+ * param_get_many() sees all the new values or none. Hardware backed params
+ * are written through first, the store of a backed param stored before a
+ * failed one is not undone, its next read fetches it again.
+ * @param	indexes				Indexes of the params in table
+ * @param	count				Amount of indexes
+ * @param	in_buff				Buffer with the values
+ * @param	in_size				Bytes in in_buff, should be param_get_many_size()
+ * @return	0 if OK, -1 if error (index not valid, READ_ONLY param, wrong size or a store failed), then nothing is written
+ */
+int param_set_many(const param_index_t * indexes, uint16_t count, const void * in_buff, size_t in_size);
+
+/**
+ * @brief	Macro for easing setting the value of a Parameters
+ *
+ * @code
+ * //Example:
+ * param_handle_t example_handle_uint16 = get_param_handle("example_uint16");	// get handle
+ * set_param(example_handle_uint16, uint16, 100);								// Set value with macro
+ * @endcode
+ *
+ * @param	handle				Handle of the parameter
+ * @param	type				C build in type of the value, NOT a param_type_t, (i.e. uin8_t, int32_t, float, etc.)
+ * @param	value				Value or variable with value to be assigned
+ */
+#define set_param(handle, type, value)	{ type aux_var = value; set_param_val(handle, (void*)&aux_var);}
+
+/**
+ * @brief	Macro for easing getting the value of a Parameters
+ *
+ * @code
+ * Example:
+ * param_handle_t example_handle_uint16 = get_param_handle("example_uint16");	// get handle
+ * uint16_t other_var;
+ * get_param( example_handle_uint16, other_var );				// get value with macro
+ * @endcode
+ *
+ * @param	handle				Handle of the parameter
+ * @param	dest_var			Destination variable where value will be stored
+ */
+#define get_param( handle, dest_var ) { get_param_val(handle, (void*)&dest_var);}
+
+#ifndef CONF_PARAM_TYPE_CHECK
+#define CONF_PARAM_TYPE_CHECK		DISABLE
+#endif
+
+#ifndef CONF_PARAM_SNAPSHOT
+#define CONF_PARAM_SNAPSHOT			DISABLE
+#endif
+#ifndef CONF_PARAM_SNAPSHOT_RETRIES
+#define CONF_PARAM_SNAPSHOT_RETRIES	3
+#endif
+
+#ifndef CONF_PARAM_STATS
+#define CONF_PARAM_STATS			DISABLE
+#endif
+
+#ifndef CONF_PARAM_DELTA
+#define CONF_PARAM_DELTA			DISABLE
+#endif
+#ifndef CONF_PARAM_DELTA_KEYFRAME_PERIOD
+#define CONF_PARAM_DELTA_KEYFRAME_PERIOD	10
+#endif
+#ifndef CONF_PARAM_MAX_DEADBANDS
+#define CONF_PARAM_MAX_DEADBANDS	8
+#endif
+
+/**
+ * @brief	Report a typed accessor used with a param of other type
+ *
+ * Called by the typed accessors when CONF_PARAM_TYPE_CHECK is ENABLE.
+ * @param	param_h				Handle of the param
+ * @param	type				Type expected by the accessor
+ * @return	-1 always
+ */
+int param_type_mismatch(param_handle_t param_h, param_type_t type);
+
+/**
+ * @brief	Define a typed getter and setter for a param type
+ *
+ * Defines param_get_<suffix>(handle) and param_set_<suffix>(handle, value).
+ * Values up to the word size of the OBC are read and written with a single
+ * access, wider ones on a 32-bit OBC go through param_get_elems() and
+ * param_set_elems(), so they are never torn. Getting a derived param goes
+ * through param_get_elems(), to be computed. Setting a PERSISTENT, READ_ONLY,
+ * subscribed or derived param, or a dependency, goes through param_set_elems(),
+ * to be stored, rejected, notified or invalidated. With CONF_PARAM_SNAPSHOT or
+ * CONF_PARAM_STATS enabled all writes go through param_set_elems(), and with
+ * CONF_PARAM_STATS all reads through param_get_elems(), so they are marked and
+ * counted. These copy only the first element, so arrays are safe too.
+ *
+ * With CONF_PARAM_TYPE_CHECK as ENABLE the handle and the type are checked,
+ * on mismatch getters return 0 and setters return -1. Getters also return 0
+ * if the value can not be read.
+ */
+#if CONF_PARAM_TYPE_CHECK == ENABLE
+#define PARAM_CHECK_TYPE(handle, param_type, error_value)	\
+	if((handle) == NULL || (handle)->type != (param_type)) return param_type_mismatch(handle, param_type), (error_value);
+#else
+#define PARAM_CHECK_TYPE(handle, param_type, error_value)
+#endif
+
+#define PARAM_TYPED_ACCESSORS(suffix, c_type, param_type)								\
+static inline c_type param_get_##suffix(param_handle_t param_h)							\
+{																						\
+	c_type value = 0;																	\
+	PARAM_CHECK_TYPE(param_h, param_type, (c_type) 0)									\
+	if(sizeof(c_type) > sizeof(void*) || CONF_PARAM_STATS == ENABLE || (param_h->opts & DERIVED)) param_get_elems(param_h, 0, 1, (void*)&value);	\
+	else value = *(volatile c_type *) param_h->value;									\
+	return value;																		\
+}																						\
+static inline int param_set_##suffix(param_handle_t param_h, c_type value)				\
+{																						\
+	PARAM_CHECK_TYPE(param_h, param_type, EXIT_FAILURE)									\
+	if(sizeof(c_type) > sizeof(void*) || CONF_PARAM_SNAPSHOT == ENABLE || CONF_PARAM_STATS == ENABLE || (param_h->opts & (PERSISTENT|READ_ONLY|SUBSCRIBED|DERIVED|DEPENDENCY)))	\
+		return param_set_elems(param_h, 0, 1, (void*)&value);							\
+	*(volatile c_type *) param_h->value = value;										\
+	return EXIT_SUCCESS;																\
+}																						\
+static inline c_type param_get_##suffix##_at(param_handle_t param_h, uint16_t elem)		\
+{																						\
+	c_type value = 0;																	\
+	PARAM_CHECK_TYPE(param_h, param_type, (c_type) 0)									\
+	param_get_elems(param_h, elem, 1, (void*)&value);									\
+	return value;																		\
+}																						\
+static inline int param_set_##suffix##_at(param_handle_t param_h, uint16_t elem, c_type value)	\
+{																						\
+	PARAM_CHECK_TYPE(param_h, param_type, EXIT_FAILURE)									\
+	return param_set_elems(param_h, elem, 1, (void*)&value);							\
+}
+
+/** @name Typed Accessors
+ *
+ * Read or write a param of a known type without the void pointer and the
+ * copy of get_param_val() and set_param_val(), e.g. in control loops.
+ * @code
+ * param_handle_t period_h = get_param_handle_by_name("beacon_period");
+ * uint32_t period = param_get_u32(period_h);
+ * param_set_u32(period_h, period * 2);
+ * @endcode
+ * The _at variants read or write one element of an array param, e.g.
+ * param_get_float_at(gyro_bias_h, 2), the others the first element.
+ * Available: u8, i8, u16, i16, u32, i32, u64, i64, float and double.
+ * @see PARAM_TYPED_ACCESSORS
+ */
+///@{
+PARAM_TYPED_ACCESSORS(u8,		uint8_t,	UINT8_PARAM)
+PARAM_TYPED_ACCESSORS(i8,		int8_t,		INT8_PARAM)
+PARAM_TYPED_ACCESSORS(u16,		uint16_t,	UINT16_PARAM)
+PARAM_TYPED_ACCESSORS(i16,		int16_t,	INT16_PARAM)
+PARAM_TYPED_ACCESSORS(u32,		uint32_t,	UINT32_PARAM)
+PARAM_TYPED_ACCESSORS(i32,		int32_t,	INT32_PARAM)
+PARAM_TYPED_ACCESSORS(u64,		uint64_t,	UINT64_PARAM)
+PARAM_TYPED_ACCESSORS(i64,		int64_t,	INT64_PARAM)
+PARAM_TYPED_ACCESSORS(float,	float,		FLOAT_PARAM)
+PARAM_TYPED_ACCESSORS(double,	double,		DOUBLE_PARAM)
+///@}
+
+/**
+ * @brief	Store the value of a param as string in a buffer
+ *
+ * Floats and doubles are written with the shortest string that reads back to
+ * the same value, see sfsf_conv.h. Elements of arrays are separated by
+ * PARAM_ARRAY_SEPARATOR. If the value does not fit it fails, the buffer then
+ * holds the part that fits.
+ * @param	param_handle		Handle of the param
+ * @param	out_buff			Destination buffer
+ * @param	buff_size 			Size of the destination buffer
+ * @return	0 if OK, -1 if error or the value does not fit in the buffer
+ */
+int param_to_str(param_handle_t param_handle, char* out_buff, int buff_size);
+
+/**
+ * @brief	Set the value of a string to a param
+ *
+ * Convert the value of a string to the type of the param, and store it in the param value space.
+ * Integers are range checked for the type, e.g. "300" fails for a UINT8_PARAM. Only
+ * white-space may follow the value. The param is not changed if the string is not valid.
+ * Elements of arrays are separated by PARAM_ARRAY_SEPARATOR, the given ones are set
+ * from the first element. A string longer than the size of a STRING_PARAM is not valid.
+ * @param	param_handle		Handle of the param
+ * @param	in_buff				Buffer with the value as string, to be assigned to the param
+ * @return	0 if OK, -1 if error or not a valid value
+ */
+int str_to_param(param_handle_t param_handle, char* in_buff);
+
+/**
+ * @brief	Get amount of params in table
+ * @return	Number of params in table
+ */
+uint16_t get_table_size(void);
+
+/**
+ * @brief	Collect all params with TEMELETRY
+ *
+ * Collects all params with TEMELETRY option and store the value with a tag
+ * into dest_buff, if buff is not big enough, not all params will be collected.
+ * Format: "TAG:value,TAG:value,TAG:value"
+ * Example: "A:123,B:-3,C:0.001234"
+ * Where "TAG" is a incremental alphabetical character (A,B,C,...,AA,AB,...)
+ * and "value" is the value of the corresponding param.
+ * For getting the reference between TAG and param see collect_telemtry_header()
+ * @see collect_telemtry_header
+ * @param	dest_buff			Buffer where telemetry data will be stored
+ * @param	buff_size			Size of dest_buff
+ */
+void collect_telemetry_params(char * dest_buff, size_t buff_size);
+
+/**
+ * @brief	Collect all params with TEMELETRY as a binary beacon
+ *
+ * Compact alternative to collect_telemetry_params(), with the same signature,
+ * so it can be set with set_telemetry_collector(). Writes a beacon_header_t
+ * followed by the value of each param with TELEMETRY option, in table order,
+ * with the native width of its type. If buff is not big enough, not all
+ * params will be collected, the header tells how many.
+ * @see sfsf_hk.h for the format
+ * @param	dest_buff			Buffer where telemetry data will be stored
+ * @param	buff_size			Size of dest_buff
+ */
+void collect_telemetry_params_bin(char * dest_buff, size_t buff_size);
+
+/**
+ * @brief	Collect some params as a binary beacon
+ *
+ * As collect_telemetry_params_bin(), with the given params instead of the
+ * TELEMETRY ones. The schema in the header is the hash of their names, types
+ * and sizes. Used by the telemetry streams of the HK Service.
+ * @param	indexes				Indexes of the params, in the order they are collected
+ * @param	count				Amount of indexes
+ * @param	dest_buff			Buffer where telemetry data will be stored
+ * @param	buff_size			Size of dest_buff
+ */
+void collect_params_bin(const param_index_t * indexes, uint16_t count, char * dest_buff, size_t buff_size);
+
+/**
+ * @brief	Collect the params with TELEMETRY changed since the last beacon
+ *
+ * Same signature as collect_telemetry_params(), so it can be set with
+ * set_telemetry_collector(). Writes a binary beacon with BEACON_FLAG_DELTA,
+ * with only the values changed since the previous call, or all of them in a
+ * keyframe. A changed value that does not fit in buff is sent in a later
+ * beacon. Writes nothing if CONF_PARAM_DELTA is disabled.
+ * @see sfsf_hk.h for the format
+ * @param	dest_buff			Buffer where telemetry data will be stored
+ * @param	buff_size			Size of dest_buff
+ */
+void collect_telemetry_params_delta(char * dest_buff, size_t buff_size);
+
+/**
+ * @brief	Send all TELEMETRY params in the next delta beacon
+ *
+ * E.g. when ground reports lost beacons, instead of waiting for the next
+ * periodic keyframe.
+ */
+void param_delta_keyframe(void);
+
+/**
+ * @brief	Send a float param in delta beacons only when it moves more than a deadband
+ *
+ * The value is compared with the value last sent, element by element.
+ * @param	param_h				Handle of a FLOAT_PARAM or DOUBLE_PARAM
+ * @param	deadband			Max change not sent, 0 to send every change
+ * @return	-1 if error (not a float param or CONF_PARAM_MAX_DEADBANDS reached), 0 if OK
+ */
+int param_set_deadband(param_handle_t param_h, double deadband);
+
+/**
+ * @brief	Get the hash of the TELEMETRY params definition
+ *
+ * Hash of the name, type and size of all params with TELEMETRY option, in
+ * table order. It is sent in the header of binary beacons.
+ * @return	schema hash
+ */
+uint32_t get_telemetry_schema(void);
+
+/**
+ * @brief	Collect the references between TAG and params with TELEMETRY
+ *
+ * Collect the references between TAG and params with TELEMETRY option into
+ * dest_buff, if buff is not big enough, not all params will be collected.
+ * Format: "TAG:param_name,TAG:param_name,TAG:param_name"
+ * Example: "A:reset_cause,B:temperature,C:gps_lat"
+ * Where "TAG" is a incremental alphabetical character (A,B,C,...,AA,AB,...)
+ * and "param_name" is the name of the param assigned in the params table.
+ *
+ * @param	dest_buff			Buffer where telemetry data will be stored
+ * @param	buff_size			Size of dest_buff
+ * @return	-1 if error, size of string if OK
+ */
+int collect_telemtry_header(char * dest_buff, int buff_size);
+
+/**
+ * @brief	Print all params names and values in debug output.
+ * @note	Debug Service function should be ported.
+ * @see		sfsf_port.h
+ */
+void print_pram_table(void);
+
+/**
+ * @brief	Print the offset in param space and the size of all params, and the RAM used, in debug output.
+ * @note	Debug Service function should be ported.
+ * @see		sfsf_port.h
+ */
+void print_param_layout(void);
+
+/**
+ * @brief	Get the access statistics of a param
+ * @param	index				Index of the param in table
+ * @param	stats				Where to store the statistics
+ * @return	0 if OK, -1 if error or CONF_PARAM_STATS is disabled
+ */
+int param_get_stats(param_index_t index, param_stats_t * stats);
+
+/**
+ * @brief	Get the times a name was not found by get_param_handle_by_name() or get_param_index()
+ * @return	Count of failed lookups, 0 if CONF_PARAM_STATS is disabled
+ */
+uint32_t param_get_lookup_misses(void);
+
+/**
+ * @brief	Clear the access statistics of all params
+ */
+void param_reset_stats(void);
+
+/**
+ * @brief	Print the access statistics of all params, and the failed lookups, in debug output.
+ * @note	Debug Service function should be ported.
+ * @see		sfsf_port.h
+ */
+void print_param_stats(void);
+
+// Get Task Handle from parameters persistent task
+csp_thread_handle_t get_param_task_handle(void);
+
+#ifdef __cplusplus
+}
+#endif
+#endif /* SFSF_PARAM_H_ */
@@ -1,102 +1,591 @@
-/*
-Copyright 2018 olmanqj
-Permission is hereby granted, free of charge, to any person obtaining a copy of
-this software and associated documentation files (the "Software"), to deal in
-the Software without restriction, including without limitation the rights to
-use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
-of the Software, and to permit persons to whom the Software is furnished to do
-so, subject to the following conditions:
-
-The above copyright notice and this permission notice shall be included in all
-copies or substantial portions of the Software.
-
-THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
-IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
-FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
-AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
-LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
-OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
-SOFTWARE.
- */
-#ifndef SFSF_STORAGE_H_
-#define SFSF_STORAGE_H_
-
-#ifndef SFSF_H_
-#error Include sfsf.h before sfsf_storage.h!
-#endif
-
-#ifdef __cplusplus
-extern "C" {
-#endif
-/**
- * @file	sfsf_storage.h
- * @brief	API for Storage Service
-
-Storage Service
-=================
-
-Features Summary
--------------
-- Open and close files
-- Write and read bytes into files
-- Retrieve file stats
-
-
-Module Description
------------------
-The storage service provides the essential functions for handling files.
-Other services, like the Param Service, Log Service, Housekeeping Service,
-may require this functions for providing persistence features, if so
-specific in the configuration file. Note that all the functions for
-managing files shall be ported, see sfsf_port.h.
-
-*/
-
-
-/**
- * @brief	Open or create a file
- * @param	fp			Pointer to a File descriptor to store file info
- * @param	path		Pathname of file to open or create
- * @param	mode		Mode to open or create file
- * @return	-1 if fails, 0 if OK
-*/
-int file_open(FILE_T * fp, const char *path, FILE_MODE_T mode);
-
-/**
- * @brief	Close a file descriptor
- * @param	fp		File descriptor of open file
- * @return	-1 if fails, 0 if OK
-*/
-int file_close(FILE_T * fp);
-
-/**
- * @brief	Read a string (until new-line or end-of-file) from a file descriptor
- * @param	fp		File descriptor of open file
- * @param	buff	Destination buffer to store read bytes
- * @param	len		Limit bytes to read
- * @return	-1 if fails, the number of bytes read if OK
-*/
-char * file_read( FILE_T * fp, char * buff,  int len);
-
-/**
- * @brief	Write a string to a file descriptor
- * @param	fp		File descriptor of open file
- * @param	str		Source buffer whit sting to write into file
- * @return	-1 if fails, the number of bytes written if OK
-*/
-int file_write( FILE_T* fp, const char* str );
-
-
-/**
- * @brief	Remove a file
- * @param	path		Pathname of file to remove
- * @return	-1 if fails, 0 if OK
-*/
-int file_remove(const char *path);
-
-
-#ifdef __cplusplus
-}
-#endif
-
-#endif /* SFSF_STORAGE_H_ */
+/*
+Copyright 2018 olmanqj
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+of the Software, and to permit persons to whom the Software is furnished to do
+so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+ */
+#ifndef SFSF_STORAGE_H_
+#define SFSF_STORAGE_H_
+
+#ifndef SFSF_H_
+#error Include sfsf.h before sfsf_storage.h!
+#endif
+
+#include <sfsf_port.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+/**
+ * @file	sfsf_storage.h
+ * @brief	API for Storage Service
+
+Storage Service
+=================
+
+Features Summary
+-------------
+- Open and close files
+- Write and read bytes into files
+- Retrieve file stats
+- CRC-32 for checking stored data
+- Buffered writer, for files appended periodically
+- Segmented archive of timestamped records, with a time index
+- Circular file with a byte budget, overwriting the oldest records
+
+
+Module Description
+-----------------
+The storage service provides the essential functions for handling files.
+Other services, like the Param Service, Log Service, Housekeeping Service,
+may require this functions for providing persistence features, if so
+specific in the configuration file. Note that all the functions for
+managing files shall be ported, see sfsf_port.h.
+
+Buffered Writer
+---------------
+Opening, writing and closing a file for each record, e.g. one beacon every
+period, costs a directory lookup, FAT updates and a metadata flush each time.
+A storage_writer_t keeps the file open and collects the records in a RAM
+buffer. The buffer is written into the file when the next record does not fit
+in it, when its oldest record is older than flush_ms, or on demand with
+storage_writer_flush(). The written data is synced to the media with
+file_sync() when it was not synced for sync_ms, 0 to sync on every flush.
+
+On a power loss, the records not synced are lost: at most the records of the
+last flush_ms + sync_ms, and never more than the size of the buffer plus the
+flushes done in sync_ms. storage_writer_poll() should be called periodically
+for the time limits to apply when no records are written.
+
+@b Example:
+@code
+static char archive_buff[1024];
+storage_writer_t archive;
+storage_writer_init(&archive, "beacons.txt", archive_buff, sizeof(archive_buff), 60000, 0);
+storage_writer_write_line(&archive, beacon);
+storage_writer_poll(&archive);
+@endcode
+
+Circular File
+-------------
+A file appended for months, e.g. the log, eventually fills the volume. A
+storage_ring_t is a file of a fixed size, preallocated when created: two
+copies of a storage_ring_meta_t, each in its own STORAGE_RING_META_SIZE block,
+and a data area of budget bytes. The data area is a ring of chunks, each a
+storage_ring_chunk_t and its data. The metadata has the offset of the oldest
+chunk (tail) and the bytes used, the newest chunk ends at tail + used, modulo
+budget.
+
+When a chunk does not fit, the oldest chunks are reclaimed, at least
+budget/STORAGE_RING_RECLAIM_DIV bytes at a time, and the metadata is synced
+before their space is overwritten. Otherwise the metadata is only written
+with storage_ring_sync(), alternating the copies, so a reset while writing one
+leaves the other. On open the newest valid copy is read, the file is never
+scanned. Chunks written after the last sync are lost on a reset.
+
+A buffered writer writes into a ring with storage_writer_set_ring(), each
+flush a chunk. Rings are read with storage_ring_read(), or on ground with
+tools/read_ring.py.
+
+Segmented Archive
+-----------------
+A storage_archive_t stores timestamped binary records, e.g. beacons, in a ring
+of segments_num segment files of segment_size bytes, named
+"<prefix><slot>.seg". When a segment is full, the oldest segment is removed
+and its slot reused, so the archive never takes more than
+segments_num * segment_size bytes.
+
+A segment file starts with a storage_segment_header_t, followed by the
+records, each a storage_record_header_t and its data. The last
+sizeof(storage_segment_footer_t) bytes of the file are the footer, written
+when the segment is full. It has the time span of the segment and a sparse
+index: the time and offset of a record every 1/STORAGE_SEGMENT_INDEX_SIZE of
+the segment. All fields are in network byte order.
+
+At init the header and footer of each slot are read once into a segment table
+in RAM. A segment without footer, because of a reset while it was written, is
+scanned once and sealed. The new records go always into a new segment.
+
+storage_archive_seek() finds the first record of a time range with a binary
+search of the segment table and of the index of that segment, reading only
+its footer, then storage_archive_next() reads the records in order. Records
+are found by time only if their timestamps do not go backwards.
+
+@b Example:
+@code
+static char archive_buff[1024];
+static storage_segment_t segments[16];
+storage_archive_t archive;
+storage_archive_cursor_t cursor;
+storage_archive_init(&archive, "tlm", 65536, segments, 16, archive_buff, sizeof(archive_buff), 60000, 0);
+storage_archive_append(&archive, get_timestamp_s(), beacon, beacon_len);
+...
+if(storage_archive_seek(&archive, from_s, to_s, &cursor) == 0)
+{
+	while((len = storage_archive_next(&archive, &cursor, &time_s, buff, sizeof(buff))) > 0) ...
+	storage_archive_end(&cursor);
+}
+@endcode
+
+*/
+
+
+/**
+ * @brief	Open or create a file
+ * @param	fp			Pointer to a File descriptor to store file info
+ * @param	path		Pathname of file to open or create
+ * @param	mode		Mode to open or create file
+ * @return	-1 if fails, 0 if OK
+*/
+int file_open(FILE_T * fp, const char *path, FILE_MODE_T mode);
+
+/**
+ * @brief	Close a file descriptor
+ * @param	fp		File descriptor of open file
+ * @return	-1 if fails, 0 if OK
+*/
+int file_close(FILE_T * fp);
+
+/**
+ * @brief	Read a string (until new-line or end-of-file) from a file descriptor
+ * @param	fp		File descriptor of open file
+ * @param	buff	Destination buffer to store read bytes
+ * @param	len		Limit bytes to read
+ * @return	-1 if fails, the number of bytes read if OK
+*/
+char * file_read( FILE_T * fp, char * buff,  int len);
+
+/**
+ * @brief	Write a string to a file descriptor
+ * @param	fp		File descriptor of open file
+ * @param	str		Source buffer whit sting to write into file
+ * @return	-1 if fails, the number of bytes written if OK
+*/
+int file_write( FILE_T* fp, const char* str );
+
+/**
+ * @brief	Write bytes to a file descriptor
+ * @param	fp		File descriptor of open file
+ * @param	data	Source buffer
+ * @param	len		Bytes to write
+ * @return	-1 if fails, the number of bytes written if OK
+*/
+int file_write_bin( FILE_T* fp, const void* data, size_t len );
+
+/**
+ * @brief	Read bytes from a file descriptor
+ * @param	fp		File descriptor of open file
+ * @param	buff	Destination buffer
+ * @param	len		Bytes to read
+ * @return	-1 if fails, the number of bytes read if OK
+*/
+int file_read_bin( FILE_T* fp, void* buff, size_t len );
+
+/**
+ * @brief	Move the read/write position of a file descriptor
+ * @param	fp		File descriptor of open file
+ * @param	offset	Position from the start of the file
+ * @return	-1 if fails, 0 if OK
+*/
+int file_seek( FILE_T* fp, uint32_t offset );
+
+/**
+ * @brief	Sync the data written into a file descriptor to the storage media
+ * @param	fp		File descriptor of open file
+ * @return	-1 if fails, 0 if OK
+*/
+int file_sync( FILE_T* fp );
+
+
+/**
+ * @brief	Remove a file
+ * @param	path		Pathname of file to remove
+ * @return	-1 if fails, 0 if OK
+*/
+int file_remove(const char *path);
+
+/**
+ * @brief	Calculate the CRC-32 of a buffer
+ *
+ * CRC-32 as used by IEEE 802.3 and zlib. To calculate the CRC of data in
+ * several buffers, pass the result of the previous call as crc.
+ * @param	crc		0 for the first buffer, or the CRC of the previous buffers
+ * @param	data	Buffer with the data
+ * @param	len		Size of data in bytes
+ * @return	the CRC-32
+*/
+uint32_t storage_crc32(uint32_t crc, const void * data, size_t len);
+
+
+/** @name Circular File Definitions
+ */
+///@{
+#define STORAGE_RING_MAGIC			0x52494E47	/**< "RING", first field of the metadata. */
+#define STORAGE_RING_META_SIZE		512			/**< Size of the block of each copy of the metadata. */
+#define STORAGE_RING_RECLAIM_DIV	16			/**< Reclaim at least 1/STORAGE_RING_RECLAIM_DIV of the budget at a time. */
+///@}
+
+/**
+ * @struct	storage_ring_meta_t
+ * @brief	Metadata of a circular file, at offset 0 and STORAGE_RING_META_SIZE
+ *
+ * Fields are in network byte order.
+ */
+typedef struct __attribute__((__packed__))
+{
+	uint32_t magic;			/**< Always STORAGE_RING_MAGIC. */
+	uint32_t budget;		/**< Size of the data area. */
+	uint32_t tail;			/**< Offset in the data area of the oldest chunk. */
+	uint32_t used;			/**< Bytes of the chunks. */
+	uint32_t seq;			/**< Incremented on each write of the metadata, the copy is seq % 2. */
+	uint32_t crc;			/**< storage_crc32() of the fields before. */
+} storage_ring_meta_t;
+
+/**
+ * @struct	storage_ring_chunk_t
+ * @brief	Header of a chunk of a circular file, followed by its data
+ */
+typedef struct __attribute__((__packed__))
+{
+	uint16_t length;		/**< Size in bytes of the data. */
+	uint32_t crc;			/**< storage_crc32() of the data. */
+} storage_ring_chunk_t;
+
+/**
+ * @struct	storage_ring_t
+ * @brief	Circular file, see storage_ring_open()
+ *
+ * Not thread safe, the caller should protect it if used from several tasks.
+ */
+typedef struct
+{
+	FILE_T fd;				/**< File descriptor, valid if opened. */
+	uint8_t opened;			/**< 1 if the file is open. */
+	uint8_t dirty;			/**< 1 if chunks were written after the last write of the metadata. */
+	uint32_t budget;		/**< Size of the data area. */
+	uint32_t tail;			/**< Offset in the data area of the oldest chunk. */
+	uint32_t used;			/**< Bytes of the chunks. */
+	uint32_t seq;			/**< Sequence number of the last metadata written. */
+	uint32_t reclaimed;		/**< Bytes of old chunks overwritten since open. */
+} storage_ring_t;
+
+/**
+ * @struct	storage_writer_t
+ * @brief	Buffered writer of a file, see storage_writer_init()
+ *
+ * Not thread safe, the caller should protect it if used from several tasks.
+ */
+typedef struct
+{
+	const char * path;			/**< Pathname of the file, appended. */
+	FILE_T fd;					/**< File descriptor, valid if opened. */
+	uint8_t opened;				/**< 1 if the file is open. */
+	char * buff;				/**< RAM buffer. */
+	size_t buff_size;			/**< Size of buff. */
+	size_t used;				/**< Bytes in buff. */
+	uint32_t flush_ms;			/**< Max age of a record in buff. */
+	uint32_t sync_ms;			/**< Max time data written is not synced, 0 to sync on every flush. */
+	uint32_t oldest_ms;			/**< time_since_boot_ms() of the oldest record in buff. */
+	uint32_t synced_ms;			/**< time_since_boot_ms() of the last sync. */
+	uint8_t unsynced;			/**< 1 if data was written after the last sync. */
+	uint32_t writes;			/**< Count of writes into the file. */
+	uint32_t syncs;				/**< Count of syncs of the file. */
+	uint32_t dropped;			/**< Count of failed writes, their records are lost. */
+	storage_ring_t * ring;		/**< Circular file written instead of path, if not NULL. */
+} storage_writer_t;
+
+/**
+ * @brief	Init a buffered writer, the file is opened with the first flush
+ * @param	writer		Writer to init
+ * @param	path		Pathname of the file, the records are appended
+ * @param	buff		RAM buffer for the records, kept by reference
+ * @param	buff_size	Size of buff, records bigger than it are written directly
+ * @param	flush_ms	Max time a record is kept in buff
+ * @param	sync_ms		Max time written data is not synced, 0 to sync on every flush
+ * @return	-1 if fails, 0 if OK
+*/
+int storage_writer_init(storage_writer_t * writer, const char * path, char * buff, size_t buff_size, uint32_t flush_ms, uint32_t sync_ms);
+
+/**
+ * @brief	Write bytes, flushes the buffer if they do not fit
+ * @param	writer		Buffered writer
+ * @param	data		Bytes to write
+ * @param	len			Amount of bytes
+ * @return	-1 if fails (the record or buffered records lost), 0 if OK
+*/
+int storage_writer_write(storage_writer_t * writer, const void * data, size_t len);
+
+/**
+ * @brief	Write a string and a new-line, flushes the buffer if it does not fit
+ * @param	writer		Buffered writer
+ * @param	str			String to write
+ * @return	-1 if fails (the record or buffered records lost), 0 if OK
+*/
+int storage_writer_write_line(storage_writer_t * writer, const char * str);
+
+/**
+ * @brief	Write the buffered records into the file
+ * @param	writer		Buffered writer
+ * @param	sync		1 to sync the file after writing, 0 to follow sync_ms
+ * @return	-1 if fails, 0 if OK
+*/
+int storage_writer_flush(storage_writer_t * writer, uint8_t sync);
+
+/**
+ * @brief	Flush or sync if flush_ms or sync_ms expired, call it periodically
+ * @param	writer		Buffered writer
+ * @return	-1 if fails, 0 if OK
+*/
+int storage_writer_poll(storage_writer_t * writer);
+
+/**
+ * @brief	Time until storage_writer_poll() has something to do
+ * @param	writer		Buffered writer
+ * @return	ms until the next flush or sync, UINT32_MAX if nothing pending
+*/
+uint32_t storage_writer_due_ms(const storage_writer_t * writer);
+
+/**
+ * @brief	Flush, sync and close the file of a buffered writer
+ * @param	writer		Buffered writer
+ * @return	-1 if fails, 0 if OK
+*/
+int storage_writer_close(storage_writer_t * writer);
+
+/**
+ * @brief	Write the records of a buffered writer into a circular file, instead of appending to its path
+ * @param	writer		Buffered writer, after storage_writer_init()
+ * @param	ring		Circular file opened with storage_ring_open(), kept by reference
+ * @return	-1 if fails, 0 if OK
+*/
+int storage_writer_set_ring(storage_writer_t * writer, storage_ring_t * ring);
+
+/**
+ * @brief	Open a circular file, created and preallocated if it does not exist
+ *
+ * If the file exists with another budget, it is created again, its chunks lost.
+ * @param	ring		Circular file to open
+ * @param	path		Pathname of the file
+ * @param	budget		Size of the data area, the file takes 2*STORAGE_RING_META_SIZE more
+ * @return	-1 if fails, 0 if OK
+*/
+int storage_ring_open(storage_ring_t * ring, const char * path, uint32_t budget);
+
+/**
+ * @brief	Write a chunk into a circular file, overwriting the oldest ones if needed
+ * @param	ring		Circular file
+ * @param	data		Data of the chunk
+ * @param	len			Size of data, up to budget/2
+ * @return	-1 if fails, 0 if OK
+*/
+int storage_ring_write(storage_ring_t * ring, const void * data, uint16_t len);
+
+/**
+ * @brief	Write the metadata of a circular file and sync it to the media
+ * @param	ring		Circular file
+ * @return	-1 if fails, 0 if OK
+*/
+int storage_ring_sync(storage_ring_t * ring);
+
+/**
+ * @brief	Read the next chunk of a circular file, from the oldest
+ *
+ * Chunks with bad CRC are skipped.
+ * @param	ring		Circular file
+ * @param	pos			Position of the chunk in bytes from the oldest, 0 for the first, updated to the next
+ * @param	buff		Destination buffer
+ * @param	buff_size	Size of buff
+ * @return	Size of the chunk, 0 if no more chunks, -1 if fails (or the chunk does not fit in buff)
+*/
+int storage_ring_read(storage_ring_t * ring, uint32_t * pos, void * buff, size_t buff_size);
+
+/**
+ * @brief	Sync and close a circular file
+ * @param	ring		Circular file
+ * @return	-1 if fails, 0 if OK
+*/
+int storage_ring_close(storage_ring_t * ring);
+
+
+/** @name Segmented Archive Definitions
+ */
+///@{
+#define STORAGE_SEGMENT_MAGIC		0x53454731	/**< "SEG1", first field of a segment and last but one of its footer. */
+#define STORAGE_SEGMENT_INDEX_SIZE	32			/**< Entries of the index of a segment. */
+#define STORAGE_ARCHIVE_PATH_SIZE	32			/**< Max size of the pathname of a segment. */
+#define STORAGE_SEGMENT_EMPTY		0			/**< Slot without segment. */
+#define STORAGE_SEGMENT_SEALED		1			/**< Full segment, with footer. */
+#define STORAGE_SEGMENT_OPEN		2			/**< Segment being written. */
+///@}
+
+/**
+ * @struct	storage_segment_header_t
+ * @brief	First bytes of a segment file
+ */
+typedef struct __attribute__((__packed__))
+{
+	uint32_t magic;			/**< Always STORAGE_SEGMENT_MAGIC. */
+	uint32_t seq;			/**< Sequence number of the segment, slot is seq % segments_num. */
+} storage_segment_header_t;
+
+/**
+ * @struct	storage_record_header_t
+ * @brief	Header of a record in a segment, followed by its data
+ */
+typedef struct __attribute__((__packed__))
+{
+	uint32_t time_s;		/**< Timestamp of the record. */
+	uint16_t length;		/**< Size in bytes of the data. */
+	uint32_t crc;			/**< storage_crc32() of the data. */
+} storage_record_header_t;
+
+/**
+ * @struct	storage_index_entry_t
+ * @brief	Entry of the index of a segment
+ */
+typedef struct __attribute__((__packed__))
+{
+	uint32_t time_s;		/**< Timestamp of the record. */
+	uint32_t offset;		/**< Offset of the record in the segment file. */
+} storage_index_entry_t;
+
+/**
+ * @struct	storage_segment_footer_t
+ * @brief	Last bytes of a full segment file
+ */
+typedef struct __attribute__((__packed__))
+{
+	storage_index_entry_t index[STORAGE_SEGMENT_INDEX_SIZE];	/**< Sparse index, index_num entries used. */
+	uint16_t index_num;		/**< Entries used of the index. */
+	uint32_t seq;			/**< Sequence number of the segment. */
+	uint32_t records;		/**< Amount of records. */
+	uint32_t first_s;		/**< Timestamp of the first record. */
+	uint32_t last_s;		/**< Timestamp of the last record. */
+	uint32_t end;			/**< Offset of the end of the last record. */
+	uint32_t magic;			/**< Always STORAGE_SEGMENT_MAGIC. */
+	uint32_t crc;			/**< storage_crc32() of the fields before. */
+} storage_segment_footer_t;
+
+/**
+ * @struct	storage_segment_t
+ * @brief	Entry of the segment table of an archive, one per slot
+ */
+typedef struct
+{
+	uint32_t seq;			/**< Sequence number of the segment in the slot. */
+	uint32_t records;		/**< Amount of records. */
+	uint32_t first_s;		/**< Timestamp of the first record. */
+	uint32_t last_s;		/**< Timestamp of the last record. */
+	uint32_t end;			/**< Offset of the end of the last record. */
+	uint8_t state;			/**< STORAGE_SEGMENT_x. */
+} storage_segment_t;
+
+/**
+ * @struct	storage_archive_t
+ * @brief	Segmented archive, see storage_archive_init()
+ *
+ * Not thread safe, the caller should protect it if used from several tasks.
+ */
+typedef struct
+{
+	const char * prefix;				/**< Prefix of the pathnames of the segments. */
+	uint32_t segment_size;				/**< Size of a segment file. */
+	storage_segment_t * segments;		/**< Segment table, segments_num entries. */
+	uint16_t segments_num;				/**< Amount of slots. */
+	uint8_t opened;						/**< 1 if a segment is open for writing. */
+	uint32_t seq;						/**< Sequence number of the newest segment. */
+	uint32_t next_index;				/**< Offset from which the next record is indexed. */
+	storage_segment_footer_t footer;	/**< Footer of the open segment, in host byte order. */
+	char path[STORAGE_ARCHIVE_PATH_SIZE];	/**< Pathname of the open segment. */
+	storage_writer_t writer;			/**< Buffered writer of the open segment. */
+} storage_archive_t;
+
+/**
+ * @struct	storage_archive_cursor_t
+ * @brief	Position of a query in an archive, see storage_archive_seek()
+ */
+typedef struct
+{
+	uint32_t seq;			/**< Segment of the next record. */
+	uint32_t offset;		/**< Offset of the next record. */
+	uint32_t from_s;		/**< Start of the time range. */
+	uint32_t to_s;			/**< End of the time range. */
+	FILE_T fd;				/**< File descriptor of the segment, valid if opened. */
+	uint8_t opened;			/**< 1 if the segment file is open. */
+} storage_archive_cursor_t;
+
+/**
+ * @brief	Init a segmented archive, loads the segment table from the segment files
+ * @param	archive			Archive to init
+ * @param	prefix			Prefix of the pathnames of the segments, kept by reference
+ * @param	segment_size	Size of a segment file
+ * @param	segments		Segment table, kept by reference
+ * @param	segments_num	Entries of segments, the amount of segment files
+ * @param	buff			RAM buffer for the records, kept by reference
+ * @param	buff_size		Size of buff
+ * @param	flush_ms		Max time a record is kept in buff
+ * @param	sync_ms			Max time written data is not synced, 0 to sync on every flush
+ * @return	-1 if fails, 0 if OK
+*/
+int storage_archive_init(storage_archive_t * archive, const char * prefix, uint32_t segment_size, storage_segment_t * segments, uint16_t segments_num, char * buff, size_t buff_size, uint32_t flush_ms, uint32_t sync_ms);
+
+/**
+ * @brief	Add a record to an archive, starts a new segment if it does not fit
+ * @param	archive		Segmented archive
+ * @param	time_s		Timestamp of the record
+ * @param	data		Data of the record
+ * @param	len			Size of data
+ * @return	-1 if fails, 0 if OK
+*/
+int storage_archive_append(storage_archive_t * archive, uint32_t time_s, const void * data, uint16_t len);
+
+/**
+ * @brief	Find the first record of an archive in a time range
+ * @param	archive		Segmented archive
+ * @param	from_s		Start of the time range
+ * @param	to_s		End of the time range
+ * @param	cursor		Cursor to read the records with storage_archive_next()
+ * @return	-1 if fails or no records in the range, 0 if OK
+*/
+int storage_archive_seek(storage_archive_t * archive, uint32_t from_s, uint32_t to_s, storage_archive_cursor_t * cursor);
+
+/**
+ * @brief	Read the next record of a query
+ *
+ * A record bigger than buff_size is an error, the cursor is then past it and
+ * time_s has its timestamp, so the query can go on with the next record.
+ * @param	archive		Segmented archive
+ * @param	cursor		Cursor set by storage_archive_seek()
+ * @param	time_s		Destination of the timestamp of the record
+ * @param	buff		Destination buffer of the data of the record
+ * @param	buff_size	Size of buff
+ * @return	Size of the record, 0 if no more records in the range, -1 if fails or the record does not fit in buff
+*/
+int storage_archive_next(storage_archive_t * archive, storage_archive_cursor_t * cursor, uint32_t * time_s, void * buff, size_t buff_size);
+
+/**
+ * @brief	End a query, closes the segment file of a cursor
+ * @param	cursor		Cursor set by storage_archive_seek()
+*/
+void storage_archive_end(storage_archive_cursor_t * cursor);
+
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SFSF_STORAGE_H_ */
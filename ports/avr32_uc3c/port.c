@@ -121,6 +121,34 @@ int file_write_port( FILE_T* fp, const char* str )
 }
 
 
+int file_write_bin_port( FILE_T* fp, const void* data, size_t len )
+{
+	UINT written;
+	if(f_write(fp, data, len, &written) != FR_OK) return -1;
+	return written;
+}
+
+
+int file_read_bin_port( FILE_T* fp, void* buff, size_t len )
+{
+	UINT read;
+	if(f_read(fp, buff, len, &read) != FR_OK) return -1;
+	return read;
+}
+
+
+int file_seek_port( FILE_T* fp, uint32_t offset )
+{
+	return (f_lseek(fp, offset) == FR_OK) ? 0 : -1;
+}
+
+
+int file_sync_port( FILE_T* fp )
+{
+	return f_sync ( fp );
+}
+
+
 int file_remove_port(const char *path)
 {
 	return f_unlink ( path );
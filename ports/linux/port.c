@@ -20,6 +20,8 @@ SOFTWARE.
  */
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
 
 #include <sfsf_port.h>
 
@@ -73,13 +75,63 @@ void print_debug_uint_port(unsigned int n)
 ///////////////////////////////////////////////
 /////			FILE SYSTEM				//////////////
 //////////////////////////////////////////////
-/*
+int file_open_port(FILE_T * fp, const char *path, FILE_MODE_T mode)
+{
+	*fp = fopen(path, mode);
+	return (*fp) ? 0 : -1;
+}
+
+
+int file_close_port(FILE_T * fp)
+{
+	int ret = fclose(*fp);
+	*fp = NULL;
+	return (ret == 0) ? 0 : -1;
+}
+
 
-FILE * fopen(const char *_name, const char *_type)
-int fclose(FILE *)
-char * fgets (char *,  int,  FILE *)
-int fprintf(FILE *, const char *, ...)
+char * file_read_port( FILE_T * fp, char * buff,  int len)
+{
+	return fgets(buff, len, *fp);
+}
+
+
+int file_write_port( FILE_T* fp, const char* str )
+{
+	if(fputs(str, *fp) < 0) return -1;
+	return strlen(str);
+}
 
 
+int file_write_bin_port( FILE_T* fp, const void* data, size_t len )
+{
+	return (fwrite(data, 1, len, *fp) == len) ? (int) len : -1;
+}
 
-*/
+
+int file_read_bin_port( FILE_T* fp, void* buff, size_t len )
+{
+	size_t read = fread(buff, 1, len, *fp);
+	if(read < len && ferror(*fp)) return -1;
+	return read;
+}
+
+
+int file_seek_port( FILE_T* fp, uint32_t offset )
+{
+	return (fseek(*fp, offset, SEEK_SET) == 0) ? 0 : -1;
+}
+
+
+// Flush the stdio buffer and sync the file to disk
+int file_sync_port( FILE_T* fp )
+{
+	if(fflush(*fp) != 0) return -1;
+	return (fsync(fileno(*fp)) == 0) ? 0 : -1;
+}
+
+
+int file_remove_port(const char *path)
+{
+	return (remove(path) == 0) ? 0 : -1;
+}
@@ -0,0 +1,612 @@
+/*
+Copyright 2018 olmanqj
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+of the Software, and to permit persons to whom the Software is furnished to do
+so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+ */
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <math.h>
+#include <locale.h>
+
+// Framework Includes
+#include <sfsf.h>
+#include <sfsf_conv.h>
+
+
+// Digit pairs "00" to "99", to write two digits at a time
+static const char conv_digit_pairs[200] =
+	"00010203040506070809"
+	"10111213141516171819"
+	"20212223242526272829"
+	"30313233343536373839"
+	"40414243444546474849"
+	"50515253545556575859"
+	"60616263646566676869"
+	"70717273747576777879"
+	"80818283848586878889"
+	"90919293949596979899";
+
+// Powers of ten exactly representable as double and float
+static const double conv_pow10_double[] =
+{
+	1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+	1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+};
+static const float conv_pow10_float[] =
+{
+	1e0f, 1e1f, 1e2f, 1e3f, 1e4f, 1e5f, 1e6f, 1e7f, 1e8f, 1e9f, 1e10f
+};
+#define CONV_DOUBLE_EXACT_EXP		22
+#define CONV_FLOAT_EXACT_EXP		10
+#define CONV_DOUBLE_EXACT_MANT		(1ULL << 53)
+#define CONV_FLOAT_EXACT_MANT		(1ULL << 24)
+// Max significant digits kept when scanning a decimal number
+#define CONV_MAX_DIGITS				19
+// Max length of a decimal number handed to libc for rounding
+#define CONV_PARSE_BUFF_SIZE		64
+// Size of the buffer to write a float or double
+#define CONV_FLOAT_BUFF_SIZE		32
+// Max decimals written as fixed point, smaller values use exponent notation
+#define CONV_FIXED_MAX_DECIMALS		9
+// Significant digits with which any float and double reads back
+#define CONV_FLOAT_MAX_DIGITS		9
+#define CONV_DOUBLE_MAX_DIGITS		17
+// Digits taken after the last significant one, to round as printf would
+#define CONV_GUARD_DIGITS			6
+
+
+
+// Count the decimal digits of a value
+static inline int count_digits(uint32_t value)
+{
+	int digits = 1;
+	while(value >= 10000) { value /= 10000; digits += 4; }
+	if(value >= 10) digits++;
+	if(value >= 100) digits++;
+	if(value >= 1000) digits++;
+	return digits;
+}
+
+
+// Write the digits of a value, the last one at end - 1
+static inline void write_digits(uint32_t value, char * end)
+{
+	uint32_t pair;
+	while(value >= 100)
+	{
+		pair = (value % 100) * 2;
+		value /= 100;
+		*--end = conv_digit_pairs[pair + 1];
+		*--end = conv_digit_pairs[pair];
+	}
+	if(value >= 10)
+	{
+		*--end = conv_digit_pairs[value * 2 + 1];
+		*--end = conv_digit_pairs[value * 2];
+	}
+	else *--end = '0' + value;
+}
+
+
+// Write exactly 9 digits of a value lower than 10^9, with leading zeros
+static inline void write_9_digits(uint32_t value, char * out_buff)
+{
+	int i;
+	uint32_t pair;
+	for(i = 8; i > 0; i -= 2)
+	{
+		pair = (value % 100) * 2;
+		value /= 100;
+		out_buff[i] = conv_digit_pairs[pair + 1];
+		out_buff[i - 1] = conv_digit_pairs[pair];
+	}
+	out_buff[0] = '0' + value;
+}
+
+
+int conv_u32_to_str(uint32_t value, char * out_buff, int buff_size)
+{
+	int len = count_digits(value);
+	if(out_buff == NULL || len >= buff_size) return -1;
+	write_digits(value, out_buff + len);
+	out_buff[len] = '\0';
+	return len;
+}
+
+
+int conv_i32_to_str(int32_t value, char * out_buff, int buff_size)
+{
+	int len;
+	if(value >= 0) return conv_u32_to_str(value, out_buff, buff_size);
+	if(out_buff == NULL || buff_size < 2) return -1;
+	out_buff[0] = '-';
+	// Negate as unsigned, INT32_MIN has no positive counterpart
+	len = conv_u32_to_str(0u - (uint32_t) value, out_buff + 1, buff_size - 1);
+	return (len < 0) ? -1 : len + 1;
+}
+
+
+int conv_u64_to_str(uint64_t value, char * out_buff, int buff_size)
+{
+	int len;
+	uint64_t high;
+	uint32_t low, top;
+	if(value <= UINT32_MAX) return conv_u32_to_str((uint32_t) value, out_buff, buff_size);
+	// Split in chunks of 9 digits, the lower ones are written with leading zeros
+	high = value / 1000000000;
+	low = (uint32_t) (value - high * 1000000000);
+	if(high <= UINT32_MAX)
+	{
+		len = conv_u32_to_str((uint32_t) high, out_buff, buff_size);
+		if(len < 0 || len + 9 >= buff_size) return -1;
+	}
+	else
+	{
+		top = (uint32_t) (high / 1000000000);
+		len = conv_u32_to_str(top, out_buff, buff_size);
+		if(len < 0 || len + 18 >= buff_size) return -1;
+		write_9_digits((uint32_t) (high - (uint64_t) top * 1000000000), out_buff + len);
+		len += 9;
+	}
+	write_9_digits(low, out_buff + len);
+	len += 9;
+	out_buff[len] = '\0';
+	return len;
+}
+
+
+int conv_i64_to_str(int64_t value, char * out_buff, int buff_size)
+{
+	int len;
+	if(value >= 0) return conv_u64_to_str(value, out_buff, buff_size);
+	if(out_buff == NULL || buff_size < 2) return -1;
+	out_buff[0] = '-';
+	len = conv_u64_to_str(0u - (uint64_t) value, out_buff + 1, buff_size - 1);
+	return (len < 0) ? -1 : len + 1;
+}
+
+
+// Write inf and nan, returns 0 if the value is finite
+static int write_non_finite(double value, char * out_buff, int buff_size)
+{
+	const char * str;
+	if(isnan(value)) str = "nan";
+	else if(isinf(value)) str = (value < 0) ? "-inf" : "inf";
+	else return 0;
+	if((int) strlen(str) >= buff_size) return -1;
+	strcpy(out_buff, str);
+	return strlen(str);
+}
+
+
+// Exact significant digits of a value and the exponent of 10 of the first one, from a single printf
+// Returns the amount of digits written in digits, -1 if printf failed
+static int get_digits(double value, int max_digits, char * digits, int * exponent)
+{
+	int i, num;
+	int64_t exp_value;
+	char str[CONV_FLOAT_BUFF_SIZE];
+	if(snprintf(str, sizeof(str), "%.*e", max_digits - 1, fabs(value)) >= (int) sizeof(str)) return -1;
+	// Digits before the 'e', whatever the decimal point of the locale
+	for(i = 0, num = 0; str[i] != 'e' && str[i] != '\0'; i++)
+	{
+		if(str[i] >= '0' && str[i] <= '9' && num < max_digits) digits[num++] = str[i];
+	}
+	if(str[i] != 'e' || conv_str_to_int(str + i + 1, INT16_MIN, INT16_MAX, &exp_value) < 0) return -1;
+	*exponent = (int) exp_value;
+	return num;
+}
+
+
+// Round digits to precision digits into rounded, ties to even as printf, digits has num of them
+// Returns the exponent of the rounded digits, one more if all were 9, e.g. 9.96 to 2 digits is 1.0e1
+static int round_digits(const char * digits, int num, int precision, int exponent, char * rounded)
+{
+	int i;
+	memcpy(rounded, digits, precision);
+	if(digits[precision] < '5') return exponent;
+	// A tie, only the 5 and zeros after the last digit kept
+	if(digits[precision] == '5' && (digits[precision - 1] - '0') % 2 == 0)
+	{
+		for(i = precision + 1; i < num && digits[i] == '0'; i++);
+		if(i == num) return exponent;
+	}
+	for(i = precision - 1; i >= 0 && rounded[i] == '9'; i--) rounded[i] = '0';
+	if(i >= 0)
+	{
+		rounded[i]++;
+		return exponent;
+	}
+	rounded[0] = '1';
+	return exponent + 1;
+}
+
+
+// Write significant digits as printf %g with a precision, e.g. "15" and exponent 20 as 1.5e+20
+static int write_general(int negative, const char * digits, int precision, int exponent, char * out_buff)
+{
+	int i, num, pos;
+	// Trailing zeros are not written
+	for(num = precision; num > 1 && digits[num - 1] == '0'; num--);
+	pos = 0;
+	if(negative) out_buff[pos++] = '-';
+	if(exponent < -4 || exponent >= precision)
+	{
+		// Exponent notation, with at least two digits in the exponent
+		out_buff[pos++] = digits[0];
+		if(num > 1)
+		{
+			out_buff[pos++] = '.';
+			memcpy(out_buff + pos, digits + 1, num - 1);
+			pos += num - 1;
+		}
+		out_buff[pos++] = 'e';
+		out_buff[pos++] = (exponent < 0) ? '-' : '+';
+		if(exponent < 0) exponent = -exponent;
+		if(exponent < 10) out_buff[pos++] = '0';
+		write_digits(exponent, out_buff + pos + count_digits(exponent));
+		pos += count_digits(exponent);
+	}
+	else if(exponent >= 0)
+	{
+		// Integer part, then the decimals left
+		for(i = 0; i <= exponent; i++) out_buff[pos++] = (i < num) ? digits[i] : '0';
+		if(num > exponent + 1)
+		{
+			out_buff[pos++] = '.';
+			memcpy(out_buff + pos, digits + exponent + 1, num - exponent - 1);
+			pos += num - exponent - 1;
+		}
+	}
+	else
+	{
+		// Leading zeros after the point, e.g. 0.00015
+		out_buff[pos++] = '0';
+		out_buff[pos++] = '.';
+		for(i = -1; i > exponent; i--) out_buff[pos++] = '0';
+		memcpy(out_buff + pos, digits, num);
+		pos += num;
+	}
+	out_buff[pos] = '\0';
+	return pos;
+}
+
+
+// Write mantissa / 10^decimals in fixed point, e.g. 1234 and 3 as 1.234
+static int write_fixed(int negative, uint64_t mantissa, int decimals, char * out_buff, int buff_size)
+{
+	int len, digits, pos;
+	char digits_buff[24];
+	// Trailing zeros in the decimals are not needed, e.g. 1234560 and 3 is 1234.56
+	while(decimals > 0 && mantissa % 10 == 0)
+	{
+		mantissa /= 10;
+		decimals--;
+	}
+	digits = conv_u64_to_str(mantissa, digits_buff, sizeof(digits_buff));
+	// Sign, integer part (at least "0"), point and decimals
+	len = negative + ((digits > decimals) ? digits : decimals + 1) + (decimals > 0);
+	if(len >= buff_size) return -1;
+	pos = 0;
+	if(negative) out_buff[pos++] = '-';
+	if(digits > decimals)
+	{
+		memcpy(out_buff + pos, digits_buff, digits - decimals);
+		pos += digits - decimals;
+	}
+	else out_buff[pos++] = '0';
+	if(decimals > 0)
+	{
+		out_buff[pos++] = '.';
+		// Leading zeros of the decimals, e.g. 0.001
+		for(; digits < decimals; decimals--) out_buff[pos++] = '0';
+		memcpy(out_buff + pos, digits_buff + digits - decimals, decimals);
+	}
+	out_buff[len] = '\0';
+	return len;
+}
+
+
+// Copy a written value to the destination buffer, if it fits
+static int copy_written(const char * str, int len, char * out_buff, int buff_size)
+{
+	if(len < 0 || len >= buff_size) return -1;
+	memcpy(out_buff, str, len + 1);
+	return len;
+}
+
+
+int conv_float_to_str(float value, char * out_buff, int buff_size)
+{
+	int len, precision, exponent, rounded_exp;
+	float read_back;
+	char str[CONV_FLOAT_BUFF_SIZE];
+	char digits[CONV_FLOAT_MAX_DIGITS + CONV_GUARD_DIGITS], rounded[CONV_FLOAT_MAX_DIGITS];
+	if(out_buff == NULL || buff_size < 1) return -1;
+	if(!isfinite(value)) return write_non_finite(value, out_buff, buff_size);
+	// Values with few decimals, e.g. 12.5, are an integer divided by a power of ten.
+	// The fewest decimals that give back the value exactly are the shortest string
+	for(precision = 0; precision <= CONV_FIXED_MAX_DECIMALS; precision++)
+	{
+		float scaled = fabsf(value) * conv_pow10_float[precision];
+		if(scaled >= CONV_FLOAT_EXACT_MANT) break;
+		if(scaled == (float) (uint32_t) scaled && scaled / conv_pow10_float[precision] == fabsf(value))
+			return write_fixed(signbit(value) != 0, (uint32_t) scaled, precision, out_buff, buff_size);
+	}
+	// The exact digits from a single printf, the fewest of them that read back to the value are written.
+	// Most values read back with 6 digits, 9 digits always do
+	if(get_digits(value, CONV_FLOAT_MAX_DIGITS + CONV_GUARD_DIGITS, digits, &exponent) != CONV_FLOAT_MAX_DIGITS + CONV_GUARD_DIGITS) return -1;
+	for(precision = 6; precision <= CONV_FLOAT_MAX_DIGITS; precision++)
+	{
+		rounded_exp = round_digits(digits, sizeof(digits), precision, exponent, rounded);
+		len = write_general(value < 0, rounded, precision, rounded_exp, str);
+		if(precision == CONV_FLOAT_MAX_DIGITS) break;
+		if(conv_str_to_float(str, &read_back) > 0 && read_back == value) break;
+	}
+	return copy_written(str, len, out_buff, buff_size);
+}
+
+
+int conv_double_to_str(double value, char * out_buff, int buff_size)
+{
+	int len, precision, exponent, rounded_exp;
+	double read_back;
+	char str[CONV_FLOAT_BUFF_SIZE];
+	char digits[CONV_DOUBLE_MAX_DIGITS + CONV_GUARD_DIGITS], rounded[CONV_DOUBLE_MAX_DIGITS];
+	if(out_buff == NULL || buff_size < 1) return -1;
+	if(!isfinite(value)) return write_non_finite(value, out_buff, buff_size);
+	// Values with few decimals, as for floats
+	for(precision = 0; precision <= CONV_FIXED_MAX_DECIMALS; precision++)
+	{
+		double scaled = fabs(value) * conv_pow10_double[precision];
+		if(scaled >= CONV_DOUBLE_EXACT_MANT) break;
+		if(scaled == (double) (uint64_t) scaled && scaled / conv_pow10_double[precision] == fabs(value))
+			return write_fixed(signbit(value) != 0, (uint64_t) scaled, precision, out_buff, buff_size);
+	}
+	// The exact digits from a single printf, as for floats.
+	// Most values read back with 15 digits, 17 digits always do
+	if(get_digits(value, CONV_DOUBLE_MAX_DIGITS + CONV_GUARD_DIGITS, digits, &exponent) != CONV_DOUBLE_MAX_DIGITS + CONV_GUARD_DIGITS) return -1;
+	for(precision = 15; precision <= CONV_DOUBLE_MAX_DIGITS; precision++)
+	{
+		rounded_exp = round_digits(digits, sizeof(digits), precision, exponent, rounded);
+		len = write_general(value < 0, rounded, precision, rounded_exp, str);
+		if(precision == CONV_DOUBLE_MAX_DIGITS) break;
+		if(conv_str_to_double(str, &read_back) > 0 && read_back == value) break;
+	}
+	return copy_written(str, len, out_buff, buff_size);
+}
+
+
+// Skip white-space and an optional sign, set negative if '-'
+static inline const char * skip_sign(const char * in_buff, int * negative)
+{
+	while(*in_buff == ' ' || (*in_buff >= '\t' && *in_buff <= '\r')) in_buff++;
+	*negative = (*in_buff == '-');
+	if(*in_buff == '-' || *in_buff == '+') in_buff++;
+	return in_buff;
+}
+
+
+// Parse decimal digits up to limit, returns digits consumed, 0 if none, -1 if greater than limit
+static int parse_digits(const char * in_buff, uint64_t limit, uint64_t * value)
+{
+	int i;
+	uint32_t digit;
+	uint64_t result = 0;
+	const uint64_t limit_div = limit / 10;
+	const uint32_t limit_mod = (uint32_t) (limit % 10);
+	for(i = 0; (digit = (uint8_t) in_buff[i] - '0') <= 9; i++)
+	{
+		if(result > limit_div || (result == limit_div && digit > limit_mod)) return -1;
+		result = result * 10 + digit;
+	}
+	*value = result;
+	return i;
+}
+
+
+int conv_str_to_uint(const char * in_buff, uint64_t max, uint64_t * value)
+{
+	int negative, digits;
+	const char * start;
+	if(in_buff == NULL || value == NULL) return -1;
+	start = skip_sign(in_buff, &negative);
+	digits = parse_digits(start, max, value);
+	if(digits <= 0) return -1;
+	// Only zero may have a minus sign
+	if(negative && *value != 0) return -1;
+	return (start - in_buff) + digits;
+}
+
+
+int conv_str_to_int(const char * in_buff, int64_t min, int64_t max, int64_t * value)
+{
+	int negative, digits;
+	uint64_t magnitude;
+	const char * start;
+	if(in_buff == NULL || value == NULL) return -1;
+	start = skip_sign(in_buff, &negative);
+	// Negative values are limited by min, as unsigned so INT64_MIN fits
+	if(negative) digits = parse_digits(start, (min < 0) ? 0u - (uint64_t) min : 0, &magnitude);
+	else digits = parse_digits(start, (max > 0) ? (uint64_t) max : 0, &magnitude);
+	if(digits <= 0) return -1;
+	*value = negative ? (int64_t) (0u - magnitude) : (int64_t) magnitude;
+	return (start - in_buff) + digits;
+}
+
+
+// Scan a decimal number, as significant digits and exponent of 10
+// Returns chars consumed, 0 if not a plain decimal number (e.g. inf, nan)
+// With more than CONV_MAX_DIGITS significant digits the mantissa is UINT64_MAX, i.e. not exact
+static int scan_decimal(const char * in_buff, int * negative, uint64_t * mantissa, int * exponent)
+{
+	int digits, seen_digit, exp_negative, exp_value;
+	const char * p;
+	const char * exp_start;
+	p = skip_sign(in_buff, negative);
+	*mantissa = 0;
+	*exponent = 0;
+	digits = 0;
+	seen_digit = 0;
+	// Integer part, leading zeros are not significant
+	for(; *p >= '0' && *p <= '9'; p++)
+	{
+		seen_digit = 1;
+		if(*mantissa == 0 && *p == '0') continue;
+		if(++digits > CONV_MAX_DIGITS) *mantissa = UINT64_MAX;
+		else *mantissa = *mantissa * 10 + (*p - '0');
+	}
+	// Fraction part, each digit lowers the exponent
+	if(*p == '.')
+	{
+		for(p++; *p >= '0' && *p <= '9'; p++)
+		{
+			seen_digit = 1;
+			(*exponent)--;
+			if(*mantissa == 0 && *p == '0') continue;
+			if(++digits > CONV_MAX_DIGITS) *mantissa = UINT64_MAX;
+			else *mantissa = *mantissa * 10 + (*p - '0');
+		}
+	}
+	if(!seen_digit) return 0;
+	// Exponent, only consumed if it has digits
+	if(*p == 'e' || *p == 'E')
+	{
+		exp_start = p + 1;
+		exp_negative = (*exp_start == '-');
+		if(*exp_start == '-' || *exp_start == '+') exp_start++;
+		if(*exp_start >= '0' && *exp_start <= '9')
+		{
+			exp_value = 0;
+			for(p = exp_start; *p >= '0' && *p <= '9'; p++)
+			{
+				if(exp_value < 10000) exp_value = exp_value * 10 + (*p - '0');
+			}
+			*exponent += exp_negative ? -exp_value : exp_value;
+		}
+	}
+	return p - in_buff;
+}
+
+
+// Match a lower case word ignoring case, returns its length, 0 if no match
+static int match_word(const char * in_buff, const char * word)
+{
+	int i;
+	for(i = 0; word[i] != '\0'; i++)
+	{
+		if((in_buff[i] | 0x20) != word[i]) return 0;
+	}
+	return i;
+}
+
+
+// Scan inf, infinity and nan as written by write_non_finite()
+// Returns chars consumed, 0 if none
+static int scan_non_finite(const char * in_buff, double * value)
+{
+	int negative, len;
+	const char * p;
+	p = skip_sign(in_buff, &negative);
+	if((len = match_word(p, "infinity")) > 0 || (len = match_word(p, "inf")) > 0) *value = negative ? -HUGE_VAL : HUGE_VAL;
+	else if((len = match_word(p, "nan")) > 0) *value = NAN;
+	else return 0;
+	return (p - in_buff) + len;
+}
+
+
+// Copy a scanned decimal number for strtod() and strtof(), with the decimal point of the current locale
+// Returns 0 if ok, -1 if the number is too long
+static int copy_for_libc(const char * in_buff, int len, char * out_buff)
+{
+	int i;
+	const char * point;
+	if(len >= CONV_PARSE_BUFF_SIZE) return -1;
+	point = localeconv()->decimal_point;
+	for(i = 0; i < len; i++)
+	{
+		out_buff[i] = (in_buff[i] == '.' && point != NULL && point[0] != '\0') ? point[0] : in_buff[i];
+	}
+	out_buff[len] = '\0';
+	return 0;
+}
+
+
+int conv_str_to_double(const char * in_buff, double * value)
+{
+	int consumed, negative, exponent;
+	uint64_t mantissa;
+	char buff[CONV_PARSE_BUFF_SIZE];
+	char * end;
+	if(in_buff == NULL || value == NULL) return -1;
+	consumed = scan_decimal(in_buff, &negative, &mantissa, &exponent);
+	if(consumed == 0)
+	{
+		consumed = scan_non_finite(in_buff, value);
+		return (consumed > 0) ? consumed : -1;
+	}
+	// Exact with a single operation if mantissa and power of ten are exact doubles
+	if(mantissa < CONV_DOUBLE_EXACT_MANT && exponent >= -CONV_DOUBLE_EXACT_EXP && exponent <= CONV_DOUBLE_EXACT_EXP)
+	{
+		*value = (double) mantissa;
+		if(exponent < 0) *value /= conv_pow10_double[-exponent];
+		else *value *= conv_pow10_double[exponent];
+		if(negative) *value = -*value;
+		return consumed;
+	}
+	// Otherwise let libc round it, a finite number that overflows is out of range
+	if(copy_for_libc(in_buff, consumed, buff) != 0) return -1;
+	*value = strtod(buff, &end);
+	if(end != buff + consumed || isinf(*value)) return -1;
+	return consumed;
+}
+
+
+int conv_str_to_float(const char * in_buff, float * value)
+{
+	int consumed, negative, exponent;
+	uint64_t mantissa;
+	double non_finite;
+	char buff[CONV_PARSE_BUFF_SIZE];
+	char * end;
+	if(in_buff == NULL || value == NULL) return -1;
+	consumed = scan_decimal(in_buff, &negative, &mantissa, &exponent);
+	if(consumed == 0)
+	{
+		consumed = scan_non_finite(in_buff, &non_finite);
+		if(consumed == 0) return -1;
+		*value = (float) non_finite;
+		return consumed;
+	}
+	// Exact with a single operation if mantissa and power of ten are exact floats
+	if(mantissa < CONV_FLOAT_EXACT_MANT && exponent >= -CONV_FLOAT_EXACT_EXP && exponent <= CONV_FLOAT_EXACT_EXP)
+	{
+		*value = (float) mantissa;
+		if(exponent < 0) *value /= conv_pow10_float[-exponent];
+		else *value *= conv_pow10_float[exponent];
+		if(negative) *value = -*value;
+		return consumed;
+	}
+	// Otherwise let libc round it, a finite number that overflows is out of range
+	if(copy_for_libc(in_buff, consumed, buff) != 0) return -1;
+	*value = strtof(buff, &end);
+	if(end != buff + consumed || isinf(*value)) return -1;
+	return consumed;
+}
@@ -31,19 +31,19 @@ void print_debug(const char *str)
 void print_debug_char(char c)
 {
 	extern void print_debug_char_port(char c) __attribute__((__weak__));
-	if(print_debug_char) print_debug_char(c);
+	if(print_debug_char_port) print_debug_char_port(c);
 }
 
 // Print a char as hex representation on the  debug output.
 void print_debug_hex(char c)
 {
 	extern void print_debug_hex_port(char c) __attribute__((__weak__));
-	if(print_debug_hex) print_debug_hex(c);
+	if(print_debug_hex_port) print_debug_hex_port(c);
 }
 
 // Prints an unsigned integer on the debug output.
 void print_debug_uint(unsigned int n)
 {
 	extern void print_debug_uint_port(unsigned int n) __attribute__((__weak__));
-	if(print_debug_uint) print_debug_uint(n);
+	if(print_debug_uint_port) print_debug_uint_port(n);
 }
@@ -0,0 +1,283 @@
+/*
+Copyright 2018 olmanqj
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+of the Software, and to permit persons to whom the Software is furnished to do
+so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+ */
+ 
+#include <stdlib.h>
+#include <string.h>
+
+// CSP Includes
+#include <csp/csp.h>
+#include <csp/arch/csp_thread.h>
+#include <csp/arch/csp_semaphore.h>
+#include <csp/arch/csp_malloc.h>
+
+// Framework Includes
+#include <sfsf.h>
+#include <sfsf_debug.h>
+#include <sfsf_param.h>
+#include <sfsf_time.h>
+#include <sfsf_history.h>
+
+
+// History of a param
+typedef struct
+{
+	param_handle_t param_h;
+	param_index_t index;			// Index of the param in the Parameter Table
+	float * samples;				// Ring with the last CONF_HISTORY_SAMPLES samples
+	history_bucket_t * buckets;		// Ring with the last CONF_HISTORY_BUCKETS buckets
+	float acc_min;					// Bucket being filled
+	float acc_max;
+	double acc_sum;
+} history_series_t;
+
+// Task handler
+csp_thread_handle_t handle_history_service_task;
+// Series of all params with HISTORY option
+history_series_t * history_series_p;
+// Amount of series
+uint16_t history_series_num;
+// Samples taken of each series, sample n is at samples[n % CONF_HISTORY_SAMPLES],
+// and belongs to bucket n / CONF_HISTORY_BUCKET_SAMPLES
+uint32_t history_sample_count;
+// Time since boot in ms when sample 0 was taken, sample n is taken at history_start_ms + n*CONF_HISTORY_PERIOD_MS
+uint32_t history_start_ms;
+// Protects the series, while sampling or querying
+csp_mutex_t history_mutex;
+
+
+// Only numeric params can be sampled, not arrays
+static inline int is_history_param(param_handle_t param_h)
+{
+	return param_h != NULL && (param_h->opts & HISTORY) && param_h->type != STRING_PARAM && param_elem_count(param_h) == 1;
+}
+
+
+// Get the value of a param as float
+static float get_history_value(param_handle_t param_h)
+{
+	union
+	{
+		uint8_t u8; int8_t i8; uint16_t u16; int16_t i16; uint32_t u32; int32_t i32;
+		uint64_t u64; int64_t i64; float f; double d;
+	} value;
+	if(param_h->size > sizeof(value) || param_get_elems_uncounted(param_h, 0, param_elem_count(param_h), (void*)&value) != EXIT_SUCCESS) return 0;
+	switch(param_h->type)
+	{
+		case UINT8_PARAM:	return value.u8;
+		case INT8_PARAM:	return value.i8;
+		case UINT16_PARAM:	return value.u16;
+		case INT16_PARAM:	return value.i16;
+		case UINT32_PARAM:	return value.u32;
+		case INT32_PARAM:	return value.i32;
+		case UINT64_PARAM:	return value.u64;
+		case INT64_PARAM:	return value.i64;
+		case FLOAT_PARAM:	return value.f;
+		case DOUBLE_PARAM:	return value.d;
+		default:			return 0;
+	}
+}
+
+
+// Sample all series, and close the bucket when complete
+static void take_history_sample(void)
+{
+	int i;
+	float value;
+	history_series_t * series;
+	history_bucket_t * bucket;
+	uint32_t n = history_sample_count;
+	csp_mutex_lock(&history_mutex, CSP_MAX_DELAY);
+	for(i = 0; i < history_series_num; i++)
+	{
+		series = &history_series_p[i];
+		value = get_history_value(series->param_h);
+		series->samples[n % CONF_HISTORY_SAMPLES] = value;
+		// First sample of a bucket
+		if(n % CONF_HISTORY_BUCKET_SAMPLES == 0)
+		{
+			series->acc_min = value;
+			series->acc_max = value;
+			series->acc_sum = 0;
+		}
+		if(value < series->acc_min) series->acc_min = value;
+		if(value > series->acc_max) series->acc_max = value;
+		series->acc_sum += value;
+		// Last sample of a bucket, reduce it
+		if(n % CONF_HISTORY_BUCKET_SAMPLES == CONF_HISTORY_BUCKET_SAMPLES - 1)
+		{
+			bucket = &series->buckets[(n / CONF_HISTORY_BUCKET_SAMPLES) % CONF_HISTORY_BUCKETS];
+			bucket->min = series->acc_min;
+			bucket->max = series->acc_max;
+			bucket->mean = series->acc_sum / CONF_HISTORY_BUCKET_SAMPLES;
+		}
+	}
+	history_sample_count = n + 1;
+	csp_mutex_unlock(&history_mutex);
+}
+
+
+// History Service Task
+CSP_DEFINE_TASK( history_service_task )
+{
+	int32_t delay;
+	while(1)
+	{
+		// Sleep until the time of the next sample, late samples do not delay the following ones
+		delay = (int32_t)(history_start_ms + history_sample_count * CONF_HISTORY_PERIOD_MS - time_since_boot_ms());
+		if(delay > 0) csp_sleep_ms(delay);
+		take_history_sample();
+	}
+	return CSP_TASK_RETURN;
+}
+
+
+// Init History Service
+int init_history_service(void)
+{
+	int i, series_i;
+	param_handle_t param_h;
+	if(history_series_p != NULL) return EXIT_SUCCESS;
+	// Count params with HISTORY option
+	history_series_num = 0;
+	for(i = 0; i < get_table_size(); i++)
+	{
+		if(is_history_param(get_param_handle_by_index(i))) history_series_num++;
+	}
+	if(history_series_num == 0)
+	{
+		#if CONF_HISTORY_DEBUG == ENABLE
+		print_debug("HISTORY>\tNo params with HISTORY option\n");
+		#endif
+		return EXIT_SUCCESS;
+	}
+	// All the memory is taken now, the service never allocates again
+	if(csp_mutex_create(&history_mutex) != CSP_MUTEX_OK) return EXIT_FAILURE;
+	if((history_series_p = csp_malloc(history_series_num * sizeof(history_series_t))) == NULL) return EXIT_FAILURE;
+	series_i = 0;
+	for(i = 0; i < get_table_size(); i++)
+	{
+		param_h = get_param_handle_by_index(i);
+		if(!is_history_param(param_h)) continue;
+		history_series_p[series_i].param_h = param_h;
+		history_series_p[series_i].index = i;
+		history_series_p[series_i].samples = csp_malloc(CONF_HISTORY_SAMPLES * sizeof(float));
+		history_series_p[series_i].buckets = csp_malloc(CONF_HISTORY_BUCKETS * sizeof(history_bucket_t));
+		if(history_series_p[series_i].samples == NULL || history_series_p[series_i].buckets == NULL) return EXIT_FAILURE;
+		series_i++;
+	}
+	history_sample_count = 0;
+	history_start_ms = time_since_boot_ms();
+	// Create History Service Task
+	return csp_thread_create(history_service_task, "HISTORY_TASK", CONF_HISTORY_TASK_STACK_SIZE, NULL, CONF_HISTORY_TASK_PRIORITY, &handle_history_service_task);
+}
+
+
+// Get the series of a param
+static history_series_t * get_history_series(param_handle_t param_h)
+{
+	int i;
+	for(i = 0; i < history_series_num; i++)
+	{
+		if(history_series_p[i].param_h == param_h) return &history_series_p[i];
+	}
+	return NULL;
+}
+
+
+// Get the history of a param in a time range
+int param_history_query(param_handle_t param_h, uint32_t from_s, uint32_t to_s, void * out_buff, size_t buff_size)
+{
+	int64_t from_age_ms, to_age_ms, newest_age_ms, newest, first, last, oldest, first_sample;
+	uint32_t now_s, count, record_size, i;
+	history_series_t * series;
+	history_header_t header;
+	const uint16_t endian_test = 1;
+	uint8_t * dest = (uint8_t *) out_buff;
+	if(out_buff == NULL || buff_size < sizeof(header) || (series = get_history_series(param_h)) == NULL) return -1;
+	csp_mutex_lock(&history_mutex, CSP_MAX_DELAY);
+	// Work with ages, the time before now, sample times are relative to boot and the range is in timestamps
+	now_s = get_timestamp_s();
+	from_age_ms = from_s < now_s ? (int64_t)(now_s - from_s) * 1000 : 0;
+	to_age_ms = to_s < now_s ? (int64_t)(now_s - to_s) * 1000 : 0;
+	// The age of sample n is newest_age_ms + (newest - n) * CONF_HISTORY_PERIOD_MS
+	newest = (int64_t) history_sample_count - 1;
+	newest_age_ms = (uint32_t)(time_since_boot_ms() - (history_start_ms + (uint32_t) newest * CONF_HISTORY_PERIOD_MS));
+	// Samples in the range
+	first = 0;
+	last = -1;
+	if(newest >= 0 && from_age_ms >= newest_age_ms && from_age_ms >= to_age_ms)
+	{
+		first = newest - (from_age_ms - newest_age_ms) / CONF_HISTORY_PERIOD_MS;
+		if(first < 0) first = 0;
+		last = newest;
+		if(to_age_ms > newest_age_ms) last -= (to_age_ms - newest_age_ms + CONF_HISTORY_PERIOD_MS - 1) / CONF_HISTORY_PERIOD_MS;
+	}
+	// Samples if still kept, otherwise the complete buckets
+	oldest = (int64_t) history_sample_count - CONF_HISTORY_SAMPLES;
+	if(first >= oldest || first > last)
+	{
+		header.format = HISTORY_FORMAT_SAMPLES;
+		header.period_ms = CONF_HISTORY_PERIOD_MS;
+		record_size = sizeof(float);
+		first_sample = first;
+	}
+	else
+	{
+		header.format = HISTORY_FORMAT_BUCKETS;
+		header.period_ms = CONF_HISTORY_PERIOD_MS * CONF_HISTORY_BUCKET_SAMPLES;
+		record_size = sizeof(history_bucket_t);
+		// From here first and last are buckets
+		first /= CONF_HISTORY_BUCKET_SAMPLES;
+		last /= CONF_HISTORY_BUCKET_SAMPLES;
+		if(last >= (int64_t) history_sample_count / CONF_HISTORY_BUCKET_SAMPLES) last = history_sample_count / CONF_HISTORY_BUCKET_SAMPLES - 1;
+		oldest = (int64_t) history_sample_count / CONF_HISTORY_BUCKET_SAMPLES - CONF_HISTORY_BUCKETS;
+		if(first < oldest) first = oldest;
+		first_sample = first * CONF_HISTORY_BUCKET_SAMPLES;
+	}
+	// Records that fit in the buffer
+	count = (first <= last) ? last - first + 1 : 0;
+	if(count > (buff_size - sizeof(header)) / record_size) count = (buff_size - sizeof(header)) / record_size;
+	if(count > UINT16_MAX) count = UINT16_MAX;
+	for(i = 0; i < count; i++)
+	{
+		if(header.format == HISTORY_FORMAT_SAMPLES)
+			memcpy(dest + sizeof(header) + i*record_size, &series->samples[(first + i) % CONF_HISTORY_SAMPLES], record_size);
+		else
+			memcpy(dest + sizeof(header) + i*record_size, &series->buckets[(first + i) % CONF_HISTORY_BUCKETS], record_size);
+	}
+	// Fill the header
+	header.flags = (*(const uint8_t *) &endian_test) ? HISTORY_FLAG_LE : 0;
+	header.index = csp_hton16(series->index);
+	header.count = csp_hton16(count);
+	if(count > 0) header.first_time_s = csp_hton32(now_s - (uint32_t)((newest_age_ms + (newest - first_sample) * CONF_HISTORY_PERIOD_MS + 500) / 1000));
+	else header.first_time_s = csp_hton32(from_s);
+	header.period_ms = csp_hton32(header.period_ms);
+	memcpy(dest, &header, sizeof(header));
+	csp_mutex_unlock(&history_mutex);
+	return sizeof(header) + count * record_size;
+}
+
+
+// Get History Task Handle
+csp_thread_handle_t get_history_task_handle(void)
+{
+	return handle_history_service_task;
+}
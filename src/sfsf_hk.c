@@ -1,203 +1,578 @@
-/*
-Copyright 2018 olmanqj
-Permission is hereby granted, free of charge, to any person obtaining a copy of
-this software and associated documentation files (the "Software"), to deal in
-the Software without restriction, including without limitation the rights to
-use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
-of the Software, and to permit persons to whom the Software is furnished to do
-so, subject to the following conditions:
-
-The above copyright notice and this permission notice shall be included in all
-copies or substantial portions of the Software.
-
-THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
-IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
-FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
-AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
-LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
-OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
-SOFTWARE.
- */
-
-#include <stdlib.h>
-#include <stdio.h>
-
-// CSP Includes
-#include <csp/csp.h>
-#include <csp/arch/csp_thread.h>
-#include <csp/arch/csp_queue.h>
-#include <csp/arch/csp_semaphore.h>
-
-// Framework Includes
-#include <sfsf.h>
-#include <sfsf_debug.h>
-#include <sfsf_storage.h>
-#include <sfsf_hk.h>
-
-
-// Frequency between beacons
-uint32_t beacon_period;
-// CSP Priority of Bacon packets
-uint8_t beacon_packet_prio;
-// CSP Destination Port of Bacon packets
-uint8_t beacon_dport;
-// CSP Source Port of Bacon packets
-uint8_t beacon_sport;
-// Packet to store Beacon
-csp_packet_t *beacon_packet;
-// Task handler
-csp_thread_handle_t handle_hk_service_task;
-// Beacon counter
-uint32_t beacon_counter;
-//For blocking Beacon Transmission
-uint8_t beacon_broadcast_padlock;
-//For blocking Beacon storage
-uint8_t beacon_storage_padlock;
-#define BEACON_BLOCKED	 0
-#define BEACON_UNBLOCKED 1
-// Pointer to the function that collects all telemetry data into a buffer,
-// should be set at init set_telemetry_collector()
-telemetry_collector_t telemetry_collector_fun;
-
-
-
-// HK Service Task
-FILE *beacon_fd;				// beacon file Descritor
-CSP_DEFINE_TASK( hk_service_task )
-{
-	while(1)
-	{
-		// Sleep for a while
-		csp_sleep_ms(beacon_period);
-		// Get a new packet
-		beacon_packet = csp_buffer_get( CONF_CSP_BUFF_SIZE );
-		if( beacon_packet == NULL )	continue;
-		// Clear packet
-		bzero(beacon_packet->data,  CONF_CSP_BUFF_SIZE );
-		// Collect telemetry data automatically with the telemetry_collector function, should be assigned at init
-		if (telemetry_collector_fun != NULL) telemetry_collector_fun(beacon_packet->data,  CONF_CSP_BUFF_SIZE );
-		beacon_packet->length = strlen( (char *) beacon_packet->data);
-		// Store Beacon in file if not blocked
-		if(beacon_storage_padlock == BEACON_UNBLOCKED)
-		{
-			// If debug enabled, print storage action
-			#if	CONF_HK_DEBUG == ENABLE
-			print_debug("HK>\tStoring Beacon\n");
-			#endif
-			beacon_fd = fopen(CONF_HK_BEACONS_FILE, "at"); // Try to Open
-			if (!beacon_fd) beacon_fd = fopen(CONF_HK_BEACONS_FILE, "wt"); // Create if not opened
-			// if file opened, write Bacon in file
-			if (beacon_fd)
-			{
-				fprintf(beacon_fd, "%s\n",  beacon_packet->data );	// Write beacon in file
-				fclose(beacon_fd);		// Close file
-			}
-		}
-		// Broadcast Beacon if not blocked
-		if( beacon_broadcast_padlock == BEACON_UNBLOCKED) 		// For blocking signals while Deploy
-		{
-			// If debug enabled, print action
-			#if	CONF_HK_DEBUG == ENABLE
-			print_debug("HK>\tBroadcasting Beacon:");
-			print_debug(beacon_packet->data);
-			print_debug("\n");
-			#endif
-			// Broadcast beacon
-			send_beacon(beacon_packet);
-			// increment beacon counter
-			beacon_counter++;
-		}
-
-
-		// If the packet was not used, should be freed manually
-		else csp_buffer_free(beacon_packet);
-
-
-
-	}
-	return CSP_TASK_RETURN;
-}
-
-
-
-// Init HK Service for space segment
-// Note:  Beacons Transmission and Storage start blocked, App should resume it
-int init_hk_service(void)
-{
-	// Set Options
-	beacon_period = CONF_HK_BEACON_PERIOD_MS;
-	beacon_packet_prio = CONF_HK_BEACON_PACKET_PRIORITY;
-	beacon_dport = CONF_HK_DPORT;
-	beacon_sport = CONF_HK_SPORT;
-	//Create hk Service Task
-    return csp_thread_create(hk_service_task, "HK_TASK", CONF_HK_TASK_STACK_SIZE, NULL, CONF_HK_TASK_PRIORITY, &handle_hk_service_task);
-}
-
-
-
-
-void set_telemetry_collector( telemetry_collector_t telemetry_collector)
-{
-	telemetry_collector_fun = telemetry_collector;
-}
-
-
-
-
-int send_beacon(csp_packet_t * beacon_packet)
-{
-	 // Send a packet without previously opening a connection				// TODO pass PRIO, and ports as params
-	 // @return -1 if error (you must free packet), 0 if OK (you must discard pointer)
-	if (csp_sendto( beacon_packet_prio,			// @param prio CSP_PRIO_x
-	                CSP_BROADCAST_ADDR,         // @param dest destination node TODO Broadcast address
-	                beacon_dport,				// @param dport destination port
-	                beacon_sport,				// @param src_port source port
-	                CSP_O_NONE,                 // @param opts CSP_O_x
-	                beacon_packet,              // @param packet pointer to packet
-	                200							// timeout timeout used by interfaces with blocking send
-	                ) < 0)
-	{
-		// TODO Handle error
-		csp_buffer_free(beacon_packet);
-	    return EXIT_FAILURE;
-	}
-	return EXIT_SUCCESS;
-}
-
-
-
-void resume_hk_broadcast(void)
-{
-	// Resume Beacon Transmission
-	beacon_broadcast_padlock = BEACON_UNBLOCKED;
-}
-
-void stop_hk_broadcast(void)
-{
-	//Stop beacons
-	beacon_broadcast_padlock = BEACON_BLOCKED;
-}
-
-// Resume Beacons storage
-void resume_hk_storage(void)
-{
-	beacon_storage_padlock = BEACON_UNBLOCKED;
-}
-
-// Stop Beacons storage
-void stop_hk_storage(void)
-{
-	beacon_storage_padlock = BEACON_BLOCKED;
-}
-
-
-uint32_t get_beacon_count(void)
-{
-	return beacon_counter;
-}
-
-
-csp_thread_handle_t get_hk_task_handle(void)
-{
-	return handle_hk_service_task;
-}
+/*
+Copyright 2018 olmanqj
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+of the Software, and to permit persons to whom the Software is furnished to do
+so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+ */
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+
+// CSP Includes
+#include <csp/csp.h>
+#include <csp/arch/csp_thread.h>
+#include <csp/arch/csp_queue.h>
+#include <csp/arch/csp_semaphore.h>
+
+// Framework Includes
+#include <sfsf.h>
+#include <sfsf_debug.h>
+#include <sfsf_storage.h>
+#include <sfsf_param.h>
+#include <sfsf_time.h>
+#include <sfsf_hk.h>
+
+
+// Frequency between beacons
+uint32_t beacon_period;
+// CSP Priority of Bacon packets
+uint8_t beacon_packet_prio;
+// CSP Destination Port of Bacon packets
+uint8_t beacon_dport;
+// CSP Source Port of Bacon packets
+uint8_t beacon_sport;
+// Packet to store Beacon
+csp_packet_t *beacon_packet;
+// Task handler
+csp_thread_handle_t handle_hk_service_task;
+// Beacon counter
+uint32_t beacon_counter;
+//For blocking Beacon Transmission
+uint8_t beacon_broadcast_padlock;
+//For blocking Beacon storage
+uint8_t beacon_storage_padlock;
+#define BEACON_BLOCKED	 0
+#define BEACON_UNBLOCKED 1
+// Pointer to the function that collects all telemetry data into a buffer,
+// should be set at init set_telemetry_collector()
+telemetry_collector_t telemetry_collector_fun;
+#if CONF_HK_SEGMENT_ARCHIVE != ENABLE || CONF_HK_DEBUG == ENABLE
+// Buffer to print binary beacons as hex
+char beacon_hex_buff[2*CONF_HK_FRAME_SIZE+1];
+#endif
+// Frame where the beacon is collected, split in segments if bigger than a packet
+uint8_t beacon_frame[CONF_HK_FRAME_SIZE];
+// Frame ID of the next segmented beacon
+uint16_t beacon_frame_id;
+// Data of a beacon in each segment
+#define BEACON_SEGMENT_DATA_SIZE	(CONF_CSP_BUFF_SIZE - sizeof(beacon_segment_header_t))
+// The amount of segments is a uint8_t, 5 is sizeof(beacon_segment_header_t)
+#if CONF_HK_FRAME_SIZE > 255 * (CONF_CSP_BUFF_SIZE - 5)
+#error CONF_HK_FRAME_SIZE needs more than 255 segments, use a smaller frame or bigger CSP buffers
+#endif
+
+// Telemetry streams, stream 0 is the beacon of telemetry_collector_fun every beacon_period
+typedef struct
+{
+	hk_stream_t def;
+	uint32_t deadline;				// time_since_boot_ms() of its next beacon
+	uint8_t active;
+} hk_stream_entry_t;
+hk_stream_entry_t hk_streams[CONF_HK_MAX_STREAMS];
+// Timer heap, ids of the active streams, the earliest deadline first
+uint8_t hk_heap[CONF_HK_MAX_STREAMS];
+uint8_t hk_heap_num;
+// Protects hk_streams and hk_heap
+csp_mutex_t hk_sched_mutex;
+// Wakes the HK task up when the streams change
+csp_queue_handle_t hk_sched_wake;
+#define HK_SCHED_IDLE_MS	1000
+// Archive of beacons, kept open and buffered in RAM
+storage_writer_t hk_archive;
+char hk_archive_buff[CONF_HK_ARCHIVE_BUFF_SIZE];
+#if CONF_HK_BEACONS_BUDGET > 0
+// The file of beacons, a circular file of CONF_HK_BEACONS_BUDGET bytes
+storage_ring_t hk_beacons_ring;
+#endif
+#if CONF_HK_SEGMENT_ARCHIVE == ENABLE
+// Segmented archive of beacons, instead of the text file
+storage_archive_t hk_segments;
+storage_segment_t hk_segment_table[CONF_HK_SEGMENTS];
+#endif
+// Writer of the stored beacons, of the text file or of the open segment, NULL if no storage
+storage_writer_t * hk_archive_writer;
+// Protects the archive, flushed and read from other tasks
+csp_mutex_t hk_archive_mutex;
+
+
+// Get the length of the beacon collected in buff, text or binary
+static uint16_t get_beacon_length(const uint8_t * buff, size_t buff_size)
+{
+	beacon_header_t header;
+	// Text beacons are null terminated strings
+	if(buff[0] != BEACON_BINARY_MARKER) return strnlen((const char *) buff, buff_size);
+	// Binary beacons have the length in the header
+	memcpy(&header, buff, sizeof(header));
+	if(sizeof(header) + csp_ntoh16(header.length) > buff_size) return buff_size;
+	return sizeof(header) + csp_ntoh16(header.length);
+}
+
+
+#if CONF_HK_SEGMENT_ARCHIVE != ENABLE || CONF_HK_DEBUG == ENABLE
+// Print a binary beacon as hex digits into beacon_hex_buff
+static const char * beacon_to_hex(const uint8_t * buff, uint16_t length)
+{
+	static const char hex_digits[] = "0123456789ABCDEF";
+	uint16_t i;
+	for(i = 0; i < length && i < CONF_HK_FRAME_SIZE; i++)
+	{
+		beacon_hex_buff[2*i] = hex_digits[buff[i] >> 4];
+		beacon_hex_buff[2*i+1] = hex_digits[buff[i] & 0x0F];
+	}
+	beacon_hex_buff[2*i] = '\0';
+	return beacon_hex_buff;
+}
+#endif
+
+
+
+// Check if a deadline is before another, in spite of the wrap of the ms counter
+static inline int hk_deadline_before(uint32_t a, uint32_t b)
+{
+	return (int32_t)(a - b) < 0;
+}
+
+
+// Move a stream of the heap up to its place
+static void hk_heap_up(int pos)
+{
+	uint8_t id = hk_heap[pos];
+	while(pos > 0 && hk_deadline_before(hk_streams[id].deadline, hk_streams[hk_heap[(pos - 1) / 2]].deadline))
+	{
+		hk_heap[pos] = hk_heap[(pos - 1) / 2];
+		pos = (pos - 1) / 2;
+	}
+	hk_heap[pos] = id;
+}
+
+
+// Move a stream of the heap down to its place
+static void hk_heap_down(int pos)
+{
+	int child;
+	uint8_t id = hk_heap[pos];
+	while((child = 2 * pos + 1) < hk_heap_num)
+	{
+		// The earliest of both children
+		if(child + 1 < hk_heap_num && hk_deadline_before(hk_streams[hk_heap[child + 1]].deadline, hk_streams[hk_heap[child]].deadline)) child++;
+		if(!hk_deadline_before(hk_streams[hk_heap[child]].deadline, hk_streams[id].deadline)) break;
+		hk_heap[pos] = hk_heap[child];
+		pos = child;
+	}
+	hk_heap[pos] = id;
+}
+
+
+// Remove the stream at a position of the heap
+static void hk_heap_remove(int pos)
+{
+	hk_heap[pos] = hk_heap[--hk_heap_num];
+	if(pos >= hk_heap_num) return;
+	hk_heap_down(pos);
+	hk_heap_up(pos);
+}
+
+
+// Period of a stream, stream 0 follows beacon_period
+static inline uint32_t hk_stream_period(int id)
+{
+	uint32_t period = (id == 0) ? beacon_period : hk_streams[id].def.period_ms;
+	return (period > 0) ? period : 1;
+}
+
+
+// Store a beacon in the archive
+static void hk_store_beacon(const uint8_t * data, uint16_t length)
+{
+	// If debug enabled, print storage action
+	#if	CONF_HK_DEBUG == ENABLE
+	print_debug("HK>\tStoring Beacon\n");
+	#endif
+	csp_mutex_lock(&hk_archive_mutex, CSP_MAX_DELAY);
+	#if CONF_HK_SEGMENT_ARCHIVE == ENABLE
+	storage_archive_append(&hk_segments, get_timestamp_s(), data, length);
+	#else
+	if(data[0] == BEACON_BINARY_MARKER)	// Write binary beacon in file as hex
+		storage_writer_write_line(hk_archive_writer, beacon_to_hex(data, length));
+	else storage_writer_write_line(hk_archive_writer, (const char *) data);	// Write beacon in file
+	#endif
+	csp_mutex_unlock(&hk_archive_mutex);
+}
+
+
+// Amount of packets of a beacon, 1 if sent as is
+uint8_t get_beacon_segments(uint16_t length)
+{
+	// Sent as is if it fits in a packet, with room for the null char of text beacons
+	if(length < CONF_CSP_BUFF_SIZE) return 1;
+	return (length + BEACON_SEGMENT_DATA_SIZE - 1) / BEACON_SEGMENT_DATA_SIZE;
+}
+
+
+// Write a packet of a beacon, the beacon itself or a segment with its header
+uint16_t get_beacon_segment(const uint8_t * frame, uint16_t length, uint16_t frame_id, uint8_t index, uint8_t * out_buff)
+{
+	uint16_t offset, size;
+	beacon_segment_header_t header;
+	uint8_t count = get_beacon_segments(length);
+	if(index >= count) return 0;
+	if(count == 1)
+	{
+		memcpy(out_buff, frame, length);
+		return length;
+	}
+	offset = index * BEACON_SEGMENT_DATA_SIZE;
+	size = length - offset;
+	if(size > BEACON_SEGMENT_DATA_SIZE) size = BEACON_SEGMENT_DATA_SIZE;
+	header.marker = BEACON_SEGMENT_MARKER;
+	header.frame_id = csp_hton16(frame_id);
+	header.index = index;
+	header.count = count;
+	memcpy(out_buff, &header, sizeof(header));
+	memcpy(out_buff + sizeof(header), frame + offset, size);
+	return sizeof(header) + size;
+}
+
+
+// Collect, store and broadcast a beacon of a stream
+static void hk_emit_beacon(int id, const hk_stream_t * stream)
+{
+	uint16_t length;
+	uint8_t index, count;
+	// Clear frame
+	bzero(beacon_frame, sizeof(beacon_frame));
+	// Collect telemetry data automatically with the telemetry_collector function, should be assigned at init
+	// Other streams collect their own params
+	if(id != 0) collect_params_bin(stream->params, stream->params_num, (char *) beacon_frame, sizeof(beacon_frame));
+	else if (telemetry_collector_fun != NULL) telemetry_collector_fun(beacon_frame, sizeof(beacon_frame));
+	length = get_beacon_length(beacon_frame, sizeof(beacon_frame));
+	count = get_beacon_segments(length);
+	// Store the whole Beacon in the archive if not blocked, written into file when the buffer fills or it gets old
+	if(beacon_storage_padlock == BEACON_UNBLOCKED) hk_store_beacon(beacon_frame, length);
+	// If debug enabled, print action
+	#if	CONF_HK_DEBUG == ENABLE
+	if(beacon_broadcast_padlock == BEACON_UNBLOCKED)
+	{
+		print_debug("HK>\tBroadcasting Beacon:");
+		if(beacon_frame[0] == BEACON_BINARY_MARKER) print_debug(beacon_to_hex(beacon_frame, length));
+		else print_debug((char *) beacon_frame);
+		print_debug("\n");
+	}
+	#endif
+	// One packet for each segment, all with the same frame ID
+	for(index = 0; index < count; index++)
+	{
+		// Get a new packet
+		beacon_packet = csp_buffer_get( CONF_CSP_BUFF_SIZE );
+		if( beacon_packet == NULL )
+		{
+			#if	CONF_HK_DEBUG == ENABLE
+			print_debug("HK>\tNo CSP buffer for the beacon\n");
+			#endif
+			break;
+		}
+		// Clear packet
+		bzero(beacon_packet->data,  CONF_CSP_BUFF_SIZE );
+		beacon_packet->length = get_beacon_segment(beacon_frame, length, beacon_frame_id, index, beacon_packet->data);
+		// Broadcast Beacon if not blocked
+		if( beacon_broadcast_padlock == BEACON_UNBLOCKED) 		// For blocking signals while Deploy
+		{
+			// Broadcast beacon, on the port of the stream
+			if(id != 0) send_stream_beacon(beacon_packet, stream->prio, stream->dport);
+			else send_beacon(beacon_packet);
+		}
+		// If the packet was not used, should be freed manually
+		else csp_buffer_free(beacon_packet);
+	}
+	// increment beacon counter
+	if( beacon_broadcast_padlock == BEACON_UNBLOCKED) beacon_counter++;
+	if(count > 1) beacon_frame_id++;
+}
+
+
+
+// Take the stream due at now and schedule its next beacon, returns its id or -1
+// if none is due, and the ms to wait for the earliest deadline in wait
+int hk_take_due_stream(uint32_t now, hk_stream_t * stream, int32_t * wait)
+{
+	int id = -1;
+	csp_mutex_lock(&hk_sched_mutex, CSP_MAX_DELAY);
+	*wait = HK_SCHED_IDLE_MS;
+	if(hk_heap_num > 0)
+	{
+		*wait = (int32_t)(hk_streams[hk_heap[0]].deadline - now);
+		if(*wait <= 0)
+		{
+			id = hk_heap[0];
+			*stream = hk_streams[id].def;
+			hk_streams[id].deadline += hk_stream_period(id);
+			// Do not try to catch up missed beacons
+			if(hk_deadline_before(hk_streams[id].deadline, now)) hk_streams[id].deadline = now + hk_stream_period(id);
+			hk_heap_down(0);
+		}
+	}
+	csp_mutex_unlock(&hk_sched_mutex);
+	return id;
+}
+
+
+
+// HK Service Task, serves all streams, sleeps until the earliest deadline
+CSP_DEFINE_TASK( hk_service_task )
+{
+	int id;
+	int32_t wait;
+	uint32_t due_ms;
+	uint8_t wake;
+	hk_stream_t stream;
+	while(1)
+	{
+		id = hk_take_due_stream(time_since_boot_ms(), &stream, &wait);
+		if(id >= 0) hk_emit_beacon(id, &stream);
+		// Flush the archive if its beacons got old, and wake up for the next flush
+		csp_mutex_lock(&hk_archive_mutex, CSP_MAX_DELAY);
+		storage_writer_poll(hk_archive_writer);
+		due_ms = storage_writer_due_ms(hk_archive_writer);
+		if(wait > 0 && due_ms < (uint32_t) wait) wait = (int32_t) due_ms;
+		csp_mutex_unlock(&hk_archive_mutex);
+		// Sleep until the next deadline, or until the streams change
+		if(id < 0 && wait > 0) csp_queue_dequeue(hk_sched_wake, (void*) &wake, wait);
+	}
+	return CSP_TASK_RETURN;
+}
+
+
+
+// Init HK Service for space segment
+// Note:  Beacons Transmission and Storage start blocked, App should resume it
+int init_hk_service(void)
+{
+	// Set Options
+	beacon_period = CONF_HK_BEACON_PERIOD_MS;
+	beacon_packet_prio = CONF_HK_BEACON_PACKET_PRIORITY;
+	beacon_dport = CONF_HK_DPORT;
+	beacon_sport = CONF_HK_SPORT;
+	// Scheduler, with the beacon of telemetry_collector_fun as stream 0
+	if(csp_mutex_create(&hk_sched_mutex) != CSP_MUTEX_OK) return EXIT_FAILURE;
+	if((hk_sched_wake = csp_queue_create(1, sizeof(uint8_t))) == NULL) return EXIT_FAILURE;
+	// Archive of beacons
+	if(csp_mutex_create(&hk_archive_mutex) != CSP_MUTEX_OK) return EXIT_FAILURE;
+	#if CONF_HK_SEGMENT_ARCHIVE == ENABLE
+	if(storage_archive_init(&hk_segments, CONF_HK_SEGMENT_PREFIX, CONF_HK_SEGMENT_SIZE, hk_segment_table, CONF_HK_SEGMENTS, hk_archive_buff, sizeof(hk_archive_buff), CONF_HK_ARCHIVE_FLUSH_MS, CONF_HK_ARCHIVE_SYNC_MS) != EXIT_SUCCESS) return EXIT_FAILURE;
+	hk_archive_writer = &hk_segments.writer;
+	#else
+	storage_writer_init(&hk_archive, CONF_HK_BEACONS_FILE, hk_archive_buff, sizeof(hk_archive_buff), CONF_HK_ARCHIVE_FLUSH_MS, CONF_HK_ARCHIVE_SYNC_MS);
+	hk_archive_writer = &hk_archive;
+	#if CONF_HK_BEACONS_BUDGET > 0
+	// Beacons are not stored if the circular file can not be opened
+	if(storage_ring_open(&hk_beacons_ring, CONF_HK_BEACONS_FILE, CONF_HK_BEACONS_BUDGET) != EXIT_SUCCESS || storage_writer_set_ring(&hk_archive, &hk_beacons_ring) != EXIT_SUCCESS)
+	{
+		hk_archive_writer = NULL;
+		#if	CONF_HK_DEBUG == ENABLE
+		print_debug("HK>\tFailed to open the beacons file, beacons will not be stored\n");
+		#endif
+	}
+	#endif
+	#endif
+	hk_streams[0].active = 1;
+	hk_streams[0].deadline = time_since_boot_ms() + hk_stream_period(0);
+	hk_heap[0] = 0;
+	hk_heap_num = 1;
+	//Create hk Service Task
+    return csp_thread_create(hk_service_task, "HK_TASK", CONF_HK_TASK_STACK_SIZE, NULL, CONF_HK_TASK_PRIORITY, &handle_hk_service_task);
+}
+
+
+
+
+void set_telemetry_collector( telemetry_collector_t telemetry_collector)
+{
+	telemetry_collector_fun = telemetry_collector;
+}
+
+
+
+
+int send_beacon(csp_packet_t * beacon_packet)
+{
+	return send_stream_beacon(beacon_packet, beacon_packet_prio, beacon_dport);
+}
+
+
+
+int send_stream_beacon(csp_packet_t * beacon_packet, uint8_t prio, uint8_t dport)
+{
+	 // Send a packet without previously opening a connection
+	 // @return -1 if error (you must free packet), 0 if OK (you must discard pointer)
+	if (csp_sendto( prio,						// @param prio CSP_PRIO_x
+	                CSP_BROADCAST_ADDR,         // @param dest destination node TODO Broadcast address
+	                dport,						// @param dport destination port
+	                beacon_sport,				// @param src_port source port
+	                CSP_O_NONE,                 // @param opts CSP_O_x
+	                beacon_packet,              // @param packet pointer to packet
+	                200							// timeout timeout used by interfaces with blocking send
+	                ) < 0)
+	{
+		// TODO Handle error
+		csp_buffer_free(beacon_packet);
+	    return EXIT_FAILURE;
+	}
+	return EXIT_SUCCESS;
+}
+
+
+
+void resume_hk_broadcast(void)
+{
+	// Resume Beacon Transmission
+	beacon_broadcast_padlock = BEACON_UNBLOCKED;
+}
+
+void stop_hk_broadcast(void)
+{
+	//Stop beacons
+	beacon_broadcast_padlock = BEACON_BLOCKED;
+}
+
+// Resume Beacons storage
+void resume_hk_storage(void)
+{
+	beacon_storage_padlock = BEACON_UNBLOCKED;
+}
+
+// Stop Beacons storage, the buffered beacons are written into file
+void stop_hk_storage(void)
+{
+	beacon_storage_padlock = BEACON_BLOCKED;
+	flush_hk_storage();
+}
+
+// Write the buffered beacons into file and sync it
+int flush_hk_storage(void)
+{
+	int ret;
+	if(hk_archive_writer == NULL) return EXIT_FAILURE;
+	csp_mutex_lock(&hk_archive_mutex, CSP_MAX_DELAY);
+	ret = storage_writer_flush(hk_archive_writer, 1);
+	csp_mutex_unlock(&hk_archive_mutex);
+	#if	CONF_HK_DEBUG == ENABLE
+	if(ret != EXIT_SUCCESS) print_debug("HK>\tFailed to write the beacons archive\n");
+	#endif
+	return ret;
+}
+
+
+// Find the first stored beacon of a time range
+int hk_replay_start(uint32_t from_s, uint32_t to_s, storage_archive_cursor_t * cursor)
+{
+	#if CONF_HK_SEGMENT_ARCHIVE == ENABLE
+	int ret;
+	if(hk_archive_writer == NULL) return EXIT_FAILURE;
+	csp_mutex_lock(&hk_archive_mutex, CSP_MAX_DELAY);
+	ret = storage_archive_seek(&hk_segments, from_s, to_s, cursor);
+	csp_mutex_unlock(&hk_archive_mutex);
+	return ret;
+	#else
+	(void) from_s;
+	(void) to_s;
+	(void) cursor;
+	return EXIT_FAILURE;
+	#endif
+}
+
+// Read the next stored beacon of a time range
+int hk_replay_next(storage_archive_cursor_t * cursor, uint32_t * time_s, void * buff, size_t buff_size)
+{
+	#if CONF_HK_SEGMENT_ARCHIVE == ENABLE
+	int ret;
+	csp_mutex_lock(&hk_archive_mutex, CSP_MAX_DELAY);
+	ret = storage_archive_next(&hk_segments, cursor, time_s, buff, buff_size);
+	csp_mutex_unlock(&hk_archive_mutex);
+	return ret;
+	#else
+	(void) cursor;
+	(void) time_s;
+	(void) buff;
+	(void) buff_size;
+	return -1;
+	#endif
+}
+
+// End a replay of stored beacons
+void hk_replay_stop(storage_archive_cursor_t * cursor)
+{
+	storage_archive_end(cursor);
+}
+
+
+// Add a telemetry stream, its first beacon after a period
+int hk_add_stream(const hk_stream_t * stream)
+{
+	int id;
+	uint8_t wake = 0;
+	if(stream == NULL || stream->period_ms == 0 || stream->params == NULL || stream->params_num == 0 || hk_sched_wake == NULL) return -1;
+	csp_mutex_lock(&hk_sched_mutex, CSP_MAX_DELAY);
+	// Take a free stream, 0 is the beacon of telemetry_collector_fun
+	for(id = 1; id < CONF_HK_MAX_STREAMS && hk_streams[id].active; id++);
+	if(id < CONF_HK_MAX_STREAMS)
+	{
+		hk_streams[id].def = *stream;
+		hk_streams[id].deadline = time_since_boot_ms() + stream->period_ms;
+		hk_streams[id].active = 1;
+		hk_heap[hk_heap_num++] = id;
+		hk_heap_up(hk_heap_num - 1);
+	}
+	csp_mutex_unlock(&hk_sched_mutex);
+	if(id >= CONF_HK_MAX_STREAMS) return -1;
+	// The task may be sleeping until a later deadline
+	csp_queue_enqueue(hk_sched_wake, (void*) &wake, 0);
+	#if	CONF_HK_DEBUG == ENABLE
+	print_debug("HK>\tStream added\n");
+	#endif
+	return id;
+}
+
+
+// Remove a telemetry stream
+int hk_remove_stream(int stream_id)
+{
+	int pos, exit_status = EXIT_FAILURE;
+	if(stream_id < 1 || stream_id >= CONF_HK_MAX_STREAMS || hk_sched_wake == NULL) return EXIT_FAILURE;
+	csp_mutex_lock(&hk_sched_mutex, CSP_MAX_DELAY);
+	for(pos = 0; hk_streams[stream_id].active && pos < hk_heap_num; pos++)
+	{
+		if(hk_heap[pos] != stream_id) continue;
+		hk_heap_remove(pos);
+		hk_streams[stream_id].active = 0;
+		exit_status = EXIT_SUCCESS;
+	}
+	csp_mutex_unlock(&hk_sched_mutex);
+	return exit_status;
+}
+
+
+uint32_t get_beacon_count(void)
+{
+	return beacon_counter;
+}
+
+
+csp_thread_handle_t get_hk_task_handle(void)
+{
+	return handle_hk_service_task;
+}
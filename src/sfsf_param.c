@@ -1,594 +1,2878 @@
-/*
-Copyright 2018 olmanqj
-Permission is hereby granted, free of charge, to any person obtaining a copy of
-this software and associated documentation files (the "Software"), to deal in
-the Software without restriction, including without limitation the rights to
-use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
-of the Software, and to permit persons to whom the Software is furnished to do
-so, subject to the following conditions:
-
-The above copyright notice and this permission notice shall be included in all
-copies or substantial portions of the Software.
-
-THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
-IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
-FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
-AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
-LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
-OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
-SOFTWARE.
- */
- 
-#include <stdlib.h>
-#include <stdio.h>
-
-// CSP Includes
-#include <csp/csp.h>
-#include <csp/arch/csp_thread.h>
-#include <csp/arch/csp_queue.h>
-#include <csp/arch/csp_semaphore.h>
-#include <csp/arch/csp_malloc.h>
-
-
-// Framework Includes
-#include <sfsf.h>
-#include <sfsf_debug.h>
-#include <sfsf_storage.h>
-#include <sfsf_param.h>
-
-
-// Task handler
-csp_thread_handle_t handle_param_service_task;
-// Period to store persistent parameters in non-volatile memory
-uint32_t param_persist_period;
-// How may params in table
-uint16_t param_table_size_v;
-// List of parameters handles, i.e. Parameters Table
-param_t * param_table_p;
-// Memory space with parameters values, has the size of the sum of all params sizes
-void * param_space_p;
-
-
-
-
-// Parameters Service Task
-int i;
-FILE *param_fd;	// parameters file Descritor
-char param_value_buff[CONF_PARAM_MAX_PARAM_SIZE]; // buffer for converting param values to str
-CSP_DEFINE_TASK( param_service_task )
-{
-	while(1)
-	{
-		csp_sleep_ms(param_persist_period);
-		// if debug enable print status
-		#if CONF_PARAM_DEBUG == ENABLE
-		print_debug("PARAM>\tStoring params\n");
-		#endif
-		 // Try to Open Parameter storage file
-		param_fd = fopen(CONF_PARAM_FILE_NAME, "w+");
-		if (!param_fd)
-		{
-			continue;	// TODO handle error
-		}
-		// Get next param handle
-		for(i = 0; i < param_table_size_v; i++ )
-		{
-			if(!(param_table_p[i].opts & PERSISTENT)) continue; // if param dos not has PERSISTENT option, continue
-			// Clear buffer
-			bzero(param_value_buff, sizeof(param_value_buff));
-			// Convert param value to str and store it in buff
-			param_to_str(&param_table_p[i], param_value_buff, sizeof(param_value_buff));
-			// Print param to file
-			fprintf(param_fd, "%s,%s\n", param_table_p[i].name, param_value_buff);
-		}
-		// Close file
-		fclose(param_fd);
-	}
-	return CSP_TASK_RETURN;
-}
-
-
-// Load parameters froma persistent file to the Parameter table, Table should exists
-int load_param_table(char* file_name)
-{
-    char *val_p;	// pointer where starts iin line the value of the parameter
-	param_handle_t param_h;
-	// Bufer to store a line from file
-	char line_buff[CONF_PARAM_NAME_SIZE+CONF_PARAM_MAX_PARAM_SIZE+3]; // Plus the comma separator, the new line char and terminating null-character
-
-	// Check if table already exists, if not impossible to load data from a file
-    if(param_table_p ==NULL || param_table_size_v < 1 ) return EXIT_FAILURE;
-	// Try to Open file
-	param_fd = fopen(file_name, "r");
-	if (!param_fd)  return EXIT_FAILURE;
-	// Read line by line
-	while( fgets( line_buff, sizeof(line_buff), param_fd )!= NULL)
-	{
-		// Fin the comma delimiter in line
-		val_p = line_buff;
-		strsep(&val_p, ",");
-		// If delimiter not found, continue
-		if (val_p == NULL) continue;
-        // Look if exists requested param
-		if((param_h =  get_param_handle_by_name(line_buff))==NULL) continue;
-        // Remove new line char '\n' from buffer (should be the last char)
-        if(val_p[strlen(val_p)-1] == '\n') val_p[strlen(val_p)-1] = '\0';
-        // Try set value in buff to param
-		str_to_param(param_h, val_p);
-    }
-    // Close file and fee pointer
-    fclose(param_fd);
-	return EXIT_SUCCESS;
-}
-
-
-int init_param_persistence(void)
-{
-	// Ckeck Param Table Exists
-	if(param_table_p ==NULL || param_table_size_v < 1 )
-	{
-		#if CONF_PARAM_DEBUG == ENABLE
-		print_debug("PARAM>\tInit Param Persistence Fails! Set Param Table befor init Param Persistence!\n");
-		#endif
-		return EXIT_FAILURE;
-	}
-	// Set Options
-	param_persist_period = CONF_PARAM_PERSIST_PERIOD;
-	//Create param Service Task
-	return csp_thread_create(param_service_task, "PARAM_TASK", CONF_PARAM_TASK_STACK_SIZE, NULL, CONF_PARAM_TASK_PRIORITY, &handle_param_service_task);
-}
-
-
-
-// Mount the Parameter Table
-int set_param_table(param_table_t* param_table, uint16_t param_table_size)
-{
-	int i, param_space_size, offset;
-	// Set Options
-	param_table_size_v = param_table_size;
-	param_table_p = (param_t*) param_table;
-	// Check Options
-	if(param_table_p ==NULL || param_table_size_v < 1 ) return EXIT_FAILURE;
-	// Check entries of table and calculate param space ( memory space to store param values)
-	param_space_size = 0;
-	for(i = 0; i < param_table_size_v; i++ )
-	{
-		// Check that each entry has a name an a size > 0
-		if(param_table_p[i].name[0] == '\0' || param_table_p[i].size < 1 ) return EXIT_FAILURE;
-		// Param space is equals to the sum of all param sizes, except if is a existing variable parameterized
-		// Check if is a variable parameterized
-		if(param_table_p[i].value != NULL ) continue;
-		// If not, the require memory shall be allocated, increment counter
-		param_space_size+=param_table_p[i].size;
-	}
-	//	Alloc memory for param values
-	if((param_space_p = csp_malloc(param_space_size))==NULL) return EXIT_FAILURE;
-	// Populate value pointers in table entries
-	offset = 0;
-	for(i = 0; i < param_table_size_v; i++ )
-	{
-		// Check if is a parameterized variable
-		// If is a parameterized variable the pointer shall not be changed, already contains the corresponding pointer
-		if(param_table_p[i].value != NULL ) continue;
-		// For each param in table, the value will be stored in param space + offset (size of previous params)
-		param_table_p[i].value = param_space_p + offset;
-		// Calculate offset for next param
-		offset+=param_table_p[i].size;
-	}
-	#if CONF_PARAM_DEBUG == ENABLE
-	print_debug("PARAM>\tParam Table OK!\n");
-	#endif
-	return EXIT_SUCCESS;
-}
-
-
-
-// Search into the table to find param with the name
-// Return the handle of a Parameter
-param_handle_t get_param_handle_by_name( const char * name)
-{
-	int i;
-	for(i = 0; i < param_table_size_v; i++ )
-	{
-		// if same name, found =), return pointer
-		if(strcmp( param_table_p[i].name, name) == 0 ) return &param_table_p[i];
-	}
-
-	// Returns NULL if not found
-	return NULL;
-}
-
-
-// Search into the table to find param with the name
-// Return the index of a Parameter
-param_index_t get_param_index( const char * name)				// TODO Make indexes start at 1, otherwise Null index would be valid
-{
-	int16_t i;
-	for(i = 0; i < param_table_size_v; i++ )
-	{
-		// if same name, found =), return pointer
-		if(strcmp( param_table_p[i].name, name) == 0 ) return i;
-	}
-
-	// Returns NULL if not found
-	return -1;
-}
-
-
-
-
-// Get the handle of a Parameter by the index
-param_handle_t get_param_handle_by_index(param_index_t index)		// TODO Make indexes start at 1, otherwise Null index would be valid
-{
-	if(index < 0 || index >= param_table_size_v) return NULL;
-	return &param_table_p[index];
-}
-
-
-
-
-
-
-// Set the value of a Parameter
-int set_param_val(param_handle_t param_h, void * in_p)
-{
-	if (param_h==NULL || param_h->value==NULL || in_p==NULL ) return EXIT_FAILURE;
-	// Check if param has READ_ONLY option
-	if(param_h->opts & READ_ONLY) return EXIT_SUCCESS;
-	// Write param value to mem position
-	memcpy( param_h->value, in_p, param_h->size);
-	return EXIT_SUCCESS;
-}
-
-
-
-// Get the value of a Parameter
-int get_param_val(param_handle_t param_h, void * out_p)
-{
-	if (param_h==NULL || param_h->value==NULL || out_p==NULL) return EXIT_FAILURE;
-	memcpy(out_p, param_h->value, param_h->size);
-	return EXIT_SUCCESS;
-}
-
-
-
-// Get amount of params stored id table
-uint16_t get_table_size(void)
-{
-	return param_table_size_v;
-}
-
-
-
-// Store the value of a param as string in a buffer
-int param_to_str(param_handle_t param_handle, char* out_buff, int buff_size)
-{
-	int exit_status;
-	// Check param_handle exists
-	if(param_handle == NULL || param_handle->value == NULL) return EXIT_FAILURE;
-	// Select the type of the param
-	switch(param_handle->type)
-	{
-		case UINT8_PARAM:
-		{
-			uint8_t param_value = 0;
-			get_param_val(param_handle, (void*)&param_value);
-			exit_status = snprintf(out_buff,  buff_size, "%"PRIu8"", param_value);
-			break;
-		}
-		case INT8_PARAM:
-		{
-			int8_t param_value = 0;
-			get_param_val(param_handle, (void*)&param_value);
-			exit_status = snprintf(out_buff,  buff_size, "%"PRIi8"", param_value);
-			break;
-		}
-		case UINT16_PARAM:
-		{
-			uint16_t param_value = 0;
-			get_param_val(param_handle, (void*)&param_value);
-			exit_status = snprintf(out_buff,  buff_size, "%"PRIu16"", param_value);
-			break;
-		}
-		case INT16_PARAM:
-		{
-			int16_t param_value = 0;
-			get_param_val(param_handle, (void*)&param_value);
-			exit_status = snprintf(out_buff,  buff_size, "%"PRIi16"", param_value);
-			break;
-		}
-		case UINT32_PARAM:
-		{
-			uint32_t param_value = 0;
-			get_param_val(param_handle, (void*)&param_value);
-			exit_status = snprintf(out_buff,  buff_size, "%"PRIu32"", param_value);
-			break;
-		}
-		case INT32_PARAM:
-		{
-			int32_t param_value = 0;
-			get_param_val(param_handle, (void*)&param_value);
-			exit_status = snprintf(out_buff,  buff_size, "%"PRIi32"", param_value);
-			break;
-		}
-		case UINT64_PARAM:
-		{
-			uint64_t param_value = 0;
-			get_param_val(param_handle, (void*)&param_value);
-			exit_status = snprintf(out_buff,  buff_size, "%"PRIu64"", param_value);
-			break;
-		}
-		case INT64_PARAM:
-		{
-			int64_t param_value = 0;
-			get_param_val(param_handle, (void*)&param_value);
-			exit_status = snprintf(out_buff,  buff_size, "%"PRIi64"", param_value);
-			break;
-		}
-		case FLOAT_PARAM:
-		{
-			float param_value = 0;
-			get_param_val(param_handle, (void*)&param_value);
-			exit_status = snprintf(out_buff,  buff_size, "%.3f", param_value);
-			break;
-		}
-		case DOUBLE_PARAM:
-		{
-			double param_value = 0;
-			get_param_val(param_handle, (void*)&param_value);
-			exit_status = snprintf(out_buff,  buff_size, "%.3lf", param_value);				// TODO fix precision issue
-			break;
-		}
-		case STRING_PARAM:
-		{
-			exit_status = snprintf(out_buff,  buff_size, "%s", (char*)param_handle->value);
-			break;
-		}
-		default:
-			snprintf(out_buff, buff_size, "unknown_type");
-			return EXIT_FAILURE;
-	}
-	// snprintf return > 1 if success
-	if(exit_status)	return EXIT_SUCCESS;
-	return EXIT_FAILURE;
-}
-
-
-
-
-// Convert a string to the type of the param, and store it in the param value space
-int str_to_param(param_handle_t param_handle, char* in_buff)
-{
-	// Check param_handle exists
-	if(param_handle == NULL || param_handle->value == NULL) return EXIT_FAILURE;
-	// Select the type of the param
-	switch(param_handle->type)
-	{
-		case UINT8_PARAM:
-		{
-			// Auxiliary var where the value of the param will be temporary stored
-			uint8_t param_value;
-			// Scan the source buffer for a uint, store the converted value in param_value
-			param_value = (uint8_t) atoi( in_buff );
-			// Set  param_value to the desired parameter
-			set_param_val(param_handle, (void*)&param_value);
-			break;
-		}
-		case INT8_PARAM:
-		{
-			int8_t param_value;
-			param_value = (int8_t) atoi( in_buff );
-			set_param_val(param_handle, (void*)&param_value);
-			break;
-		}
-		case UINT16_PARAM:
-		{
-			uint16_t param_value;
-			param_value = (uint16_t) atoi( in_buff );
-			set_param_val(param_handle, (void*)&param_value);
-			break;
-		}
-		case INT16_PARAM:
-		{
-			int16_t param_value;
-			param_value = (int16_t) atoi( in_buff );
-			set_param_val(param_handle, (void*)&param_value);
-			break;
-		}
-		case UINT32_PARAM:
-		{
-			uint32_t param_value;
-			param_value = (uint32_t) atoi( in_buff );
-			set_param_val(param_handle, (void*)&param_value);
-			break;
-		}
-		case INT32_PARAM:
-		{
-			int32_t param_value;
-			param_value = (int32_t) atoi( in_buff );
-			set_param_val(param_handle, (void*)&param_value);
-			break;
-		}
-		case UINT64_PARAM:
-		{
-			uint64_t param_value;
-			param_value = (uint64_t) atol( in_buff );
-			set_param_val(param_handle, (void*)&param_value);
-			break;
-		}
-		case INT64_PARAM:
-		{
-			int64_t param_value;
-			param_value = (int64_t) atol( in_buff );
-			set_param_val(param_handle, (void*)&param_value);
-			break;
-		}
-		case FLOAT_PARAM:
-		{
-			float param_value;
-			param_value = (float) atof( in_buff );
-			set_param_val(param_handle, (void*)&param_value);
-			break;
-		}
-		case DOUBLE_PARAM:
-		{
-			double param_value;
-			param_value = (double) atof( in_buff );
-			set_param_val(param_handle, (void*)&param_value);
-			break;
-		}
-		case STRING_PARAM:
-		{
-			snprintf((char*)param_handle->value, param_handle->size, "%s", in_buff);
-			break;
-		}
-		default:
-			return EXIT_FAILURE;
-	}
-	return EXIT_SUCCESS;
-}
-
-
-
-
-// Take an id and calculates the corresponding TAG, store the TAG in dest_buff
-// e.g.: 0 = A, 1 = B, 25 = AA, 26 = AB, ...
-void get_tag(int id, char* dest_buff, int buff_size)								// TODO fix issue, gives correct answers until 'YZ'
-{
-	#define ALPHA_DELTA  26 // Letters in alphabet
-	int buff_index,i;
-	char aux_buffer[buff_size];
-	buff_index = 0;
-	// While digits form id left, and buff not full
-	while(buff_index < buff_size)
-	{
-		// First char of TAG is ( id MOD 26 ) + 'A'
-		aux_buffer[buff_index] = ((id) % ALPHA_DELTA)+('A'- buff_index ) ;
-		// Increment buffer index
-		buff_index++;
-		// For the following id = id/26
-		id = id / ALPHA_DELTA;
-		// Repeat until id != 0
-		if(id == 0 ) break;
-	}
-	// Invert aux_buff an thats the TAG
-	for(i= 0; 0 < buff_index; i++)
-	{
-		buff_index--;
-		// Invert position on index
-		dest_buff[i] = aux_buffer[buff_index];
-	}
-
-	return;
-}
-
-//Collect all params with TEMELETRY option and store the value with a tag into dest_buff
-void collect_telemetry_params(char * dest_buff, size_t buff_size)
-{
-	int i, tag_id;
-	// buff to store the tag, start by A, max YZ
-	char tag_buff[3];
-	// buff to store param value as str
-	char param_buff[CONF_PARAM_MAX_PARAM_SIZE];
-	tag_id=0;
-	// get next param handle
-	for(i = 0; i < param_table_size_v; i++ )
-	{
-		// Check if param has TELEMTRY option
-		if(!(param_table_p[i].opts & TELEMETRY)) continue;
-		// Clear buffers
-		bzero(tag_buff, sizeof(tag_buff));
-		bzero(param_buff, sizeof(param_buff));
-		// Generate TAG
-		get_tag(tag_id, tag_buff, sizeof(tag_buff));
-		// Store the value from param as str
-		param_to_str(&param_table_p[i], param_buff, sizeof(param_buff));
-		// Check if enough space in dest_buff (enough for tag + param + ':' + ',')
-		if(strlen(dest_buff)+strlen(tag_buff)+strlen(param_buff)+2 >= buff_size) break;
-		// Separate by comma, except if first
-		if(strlen(dest_buff) != 0) strcat(dest_buff,   "," );
-		// Concatenate  TAG
-		strcat(dest_buff,  tag_buff );
-		// Concatenate ':' separator
-		strcat(dest_buff, ":");
-		// Concatenate param value
-		strcat(dest_buff, param_buff);
-		tag_id++;
-	}
-}
-
-
-
-
-
-
-// Collect the references between TAG and params with TELEMETRY option into dest_buff
-int collect_telemtry_header(char * dest_buff, int buff_size)
-{
-	int i, tag_id;
-	// buff to store the tag, start by A, max YZ
-	char tag_buff[3];
-	// buff to store param value as str
-	char name_buff[CONF_PARAM_NAME_SIZE];
-	tag_id=0;
-	// get next param handle
-	for(i = 0; i < param_table_size_v; i++ )
-	{
-		// Check if param has TELEMTRY option
-		if(!(param_table_p[i].opts & TELEMETRY)) continue;
-		// Clear buffers
-		bzero(tag_buff, sizeof(tag_buff));
-		bzero(name_buff, sizeof(name_buff));
-		// Generate TAG
-		get_tag(tag_id, tag_buff, sizeof(tag_buff));
-		// Store the value from param as str
-		param_to_str(&param_table_p[i], name_buff, sizeof(name_buff));
-		// Check if enough space in dest_buff (enough for tag + param + ':' + ',')
-		if(strlen(dest_buff)+strlen(tag_buff)+strlen(name_buff)+2 >= buff_size) break;
-		// Separate by comma, except if first
-		if(strlen(dest_buff) != 0) strcat(dest_buff,   "," );
-		// Concatenate  TAG
-		strcat(dest_buff,  tag_buff );
-		// Concatenate ':' separator
-		strcat(dest_buff, ":");
-		// Concatenate param value
-		strcat(dest_buff, name_buff);
-		tag_id++;
-	}
-	return EXIT_FAILURE;
-}
-
-
-
-
-// Print the param table, for debug
-void print_pram_table(void)
-{
-	int i;
-	char param_list_buff[CONF_PARAM_MAX_PARAM_SIZE];
-	print_debug("\n-----------------------------------------\n");
-	print_debug(" Param Name\t\t| Param Value\n");
-	print_debug("-----------------------------------------\n");
-	// get next param handle
-	for(i = 0; i < param_table_size_v; i++ )
-	{
-		// Clear buffer
-		bzero(param_list_buff, sizeof(param_list_buff));
-		// Print name
-		print_debug(param_table_p[i].name);
-		print_debug("\t\t| ");
-		// Convert param value to str and store it in buff
-		param_to_str(&param_table_p[i], param_list_buff, sizeof(param_list_buff));
-		// Print param value
-		print_debug(param_list_buff);
-		print_debug("\n");
-	}
-	print_debug("-----------------------------------------\n");
-
-}
-
-
-csp_thread_handle_t get_param_task_handle(void)
-{
-	return handle_param_service_task;
-}
+/*
+Copyright 2018 olmanqj
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+of the Software, and to permit persons to whom the Software is furnished to do
+so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+ */
+ 
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <stddef.h>
+
+// CSP Includes
+#include <csp/csp.h>
+#include <csp/arch/csp_thread.h>
+#include <csp/arch/csp_queue.h>
+#include <csp/arch/csp_semaphore.h>
+#include <csp/arch/csp_malloc.h>
+
+
+// Framework Includes
+#include <sfsf.h>
+#include <sfsf_debug.h>
+#include <sfsf_storage.h>
+#include <sfsf_param.h>
+#include <sfsf_hk.h>
+#include <sfsf_conv.h>
+#include <sfsf_time.h>
+
+
+// Blocks allocated for a mounted table: table copy, values, metadata, sequence counters, name index,
+// dirty flags, shadow, snapshot, statistics, delta values and param image
+#define PARAM_MAX_BLOCKS	11
+
+// Task handler
+csp_thread_handle_t handle_param_service_task;
+// Period to store persistent parameters in non-volatile memory
+uint32_t param_persist_period;
+// How may params in table
+uint16_t param_table_size_v;
+// List of parameters handles, i.e. Parameters Table
+param_t * param_table_p;
+// Memory space with parameters values, has the size of the sum of all params sizes
+void * param_space_p;
+// Size of param space
+uint32_t param_space_size_v;
+// RAM taken by the Param Service, values and metadata
+uint32_t param_ram_bytes;
+// Blocks allocated for the mounted table, freed when a table is mounted again
+void * param_blocks[PARAM_MAX_BLOCKS];
+uint8_t param_blocks_num;
+// Registered tables, one after the other in the Parameter Table
+param_table_info_t param_tables[CONF_PARAM_MAX_TABLES];
+// Amount of registered tables
+uint8_t param_tables_num;
+// Hot metadata of the params, parallel arrays indexed as the table, built by set_param_table()
+// Scans go through them and the index lists, not through the param_t entries with the inline names
+param_meta_t param_meta;
+// Name index, open addressing hash table with the table index of each param, -1 means empty slot
+param_index_t * param_name_index_p;
+// Amount of slots in the name index, always a power of two
+uint32_t param_name_index_slots;
+// Set if the name index was given with set_param_name_index(), checked instead of built
+uint8_t param_name_index_set;
+// Set if the name index was allocated by build_param_name_index(), freed when built again
+uint8_t param_name_index_built;
+// Hash of the TELEMETRY params definition, sent in binary beacons
+uint32_t telemetry_schema;
+// Sequence counters, one per param, odd while the value is being written
+volatile uint32_t * param_seq_p;
+// Sequence counter of the whole table, odd while a bulk set is being written
+volatile uint32_t param_bulk_seq;
+// Dirty flags, one per param, set when a PERSISTENT param changes and not yet stored
+uint8_t * param_dirty_p;
+// Set when any dirty flag is set
+volatile uint8_t param_dirty_any;
+// Last stored value of parameterized PERSISTENT variables, which are written without the Param Service
+uint8_t * param_shadow_p;
+// Dirty flag of a param being stored, a write sets it to 1 again
+#define PARAM_STORING		2
+// Records in the param file since last full rewrite
+uint32_t param_file_records;
+// Persistence counters
+uint32_t param_persist_bytes;
+uint32_t param_persist_skipped;
+uint32_t param_persist_failed;
+// Buffer with the values of an image of PERSISTENT params
+uint8_t * param_image_buff;
+// Size of the values in a param image
+uint32_t param_image_size;
+// Hash of the PERSISTENT params definition, stored in param images
+uint32_t param_image_schema;
+// Slot with the latest image (0 = A, 1 = B) and its sequence number
+uint8_t param_image_slot;
+uint32_t param_image_seq;
+
+// Point-in-time copy of the values, for telemetry and persistence
+param_snapshot_t param_snapshot;
+// Protects param_snapshot, between consumers
+csp_mutex_t param_snapshot_mutex;
+// Set once param_snapshot_mutex is created, mounting another table reuses it
+uint8_t param_snapshot_mutex_created;
+// Writes started through the service, to know if a snapshot was copied while writing
+volatile uint32_t param_write_count;
+
+// Access statistics, one per param
+param_stats_t * param_stats_p;
+// Names not found by the lookup functions
+uint32_t param_lookup_misses;
+
+// Last values sent in delta beacons, TELEMETRY params one after the other as collected
+uint8_t * telemetry_delta_p;
+// Delta beacons since the last keyframe, 0 means the next one is a keyframe
+uint16_t telemetry_delta_count;
+// Sequence number of the next delta beacon
+uint8_t telemetry_delta_seq;
+// Telemetry schema of the last keyframe, another one forces a keyframe
+uint32_t telemetry_delta_schema;
+// Deadbands of float params in delta beacons, a zero deadband is a free entry
+typedef struct
+{
+	param_index_t index;
+	double deadband;
+} param_deadband_t;
+param_deadband_t param_deadbands[CONF_PARAM_MAX_DEADBANDS];
+
+// Subscriptions to param changes, a NULL callback is a free entry
+typedef struct
+{
+	param_index_t index;
+	param_callback_t callback;
+	void * ctx;
+} param_subscription_t;
+param_subscription_t param_subscriptions[CONF_PARAM_MAX_SUBSCRIPTIONS];
+// Protects param_subscriptions
+csp_mutex_t param_subscriptions_mutex;
+// Queue of param_change_t, from writers to the notification task
+csp_queue_handle_t param_notify_queue;
+// Notification task handler
+csp_thread_handle_t handle_param_notify_task;
+// Events taken from the queue at once
+param_change_t param_notify_batch[CONF_PARAM_NOTIFY_BATCH_SIZE];
+// Subscriptions of the change being delivered, called without the mutex
+param_subscription_t param_notify_subscribers[CONF_PARAM_MAX_SUBSCRIPTIONS];
+// Events lost because the queue was full
+uint32_t param_notify_dropped;
+// Derived and hardware backed params, how each one is computed and invalidated, a NULL compute is a free entry
+typedef struct
+{
+	param_index_t index;
+	param_compute_t compute;			// Computes or fetches the value
+	param_store_t store;				// Writes the value through to the hardware, NULL if derived
+	void * ctx;
+	uint32_t ttl_ms;
+	const param_index_t * deps;
+	uint8_t deps_num;
+	volatile uint8_t valid;				// Cleared when a dependency is written
+	volatile uint8_t computing;			// Set while a reader computes it, others wait
+	uint32_t computed_ms;				// time_since_boot_ms() when computed
+} param_derived_t;
+param_derived_t param_derived[CONF_PARAM_MAX_DERIVED];
+
+// Header of a param image slot, in the byte order of the OBC
+#define PARAM_IMAGE_MAGIC		0x53465049	// "SFPI"
+typedef struct
+{
+	uint32_t magic;			// Always PARAM_IMAGE_MAGIC
+	uint32_t seq;			// Incremented with every image written
+	uint32_t schema;		// Hash of the PERSISTENT params definition
+	uint32_t length;		// Size of the values after the header
+	uint32_t crc;			// CRC-32 of the fields above and the values
+} param_image_header_t;
+
+// Max records appended to the param file before rewriting it
+#ifndef CONF_PARAM_FILE_MAX_RECORDS
+#define CONF_PARAM_FILE_MAX_RECORDS		100
+#endif
+
+// Times a reader or writer spins on a busy param before sleeping,
+// so a preempted lower priority writer can finish
+#ifndef CONF_PARAM_SEQ_SPINS
+#define CONF_PARAM_SEQ_SPINS			100
+#endif
+
+// Bytes of an array value copied at once on the stack, by text conversions and change checks.
+// Values parsed from text are staged whole, larger ones in an allocated buffer
+#define PARAM_CHUNK_SIZE	64
+
+// FNV-1a hash (32 bits)
+#define FNV_OFFSET_BASIS	2166136261u
+#define FNV_PRIME			16777619u
+
+static void * param_alloc(size_t size);
+static int build_param_meta(void);
+static int build_param_name_index(void);
+static uint32_t calc_params_schema(const param_index_t * list, uint16_t list_num);
+static uint32_t calc_telemetry_schema(void);
+static int next_param_pos(uint8_t opt, int pos);
+static int init_param_dirty_tracking(void);
+static int init_param_snapshot(void);
+static int init_param_stats(void);
+static int init_telemetry_delta(void);
+static void check_parameterized_changes(void);
+static void sync_parameterized_shadow(void);
+static void read_value(volatile uint32_t * seq, const void * value, size_t size, void * out_p);
+static void read_param_value(param_handle_t param_h, void * out_p);
+static void read_param_index(int index, void * out_p);
+static int param_index_to_str(int index, char* out_buff, int buff_size);
+static void write_param_index(int index, const void * in_p);
+static int refresh_derived_param(int index);
+static void invalidate_derived_params(int index);
+static int write_backed_param(param_handle_t param_h, size_t offset, size_t length, const void * in_p);
+static param_derived_t * get_param_derived(int index);
+static void take_backed_param(param_derived_t * derived);
+static inline void give_backed_param(param_derived_t * derived);
+static void publish_backed_param(int index, param_derived_t * derived, const void * value, int exit_status);
+
+
+// Name of a param, from the name pool
+static inline const char * param_name(int index)
+{
+	return param_meta.names + param_meta.name[index];
+}
+
+
+
+
+// Parameters Service Task
+int i;
+FILE *param_fd;	// parameters file Descritor
+char param_value_buff[CONF_PARAM_MAX_PARAM_SIZE]; // buffer for converting param values to str
+
+
+#if CONF_PARAM_PERSIST_FORMAT != PARAM_PERSIST_IMAGE
+// Store changed params in the param file, as text records
+static void store_params_text(void)
+{
+	int full_rewrite, written, index;
+	// Changed params are appended to the file, when it has too many records
+	// it is rewritten with only the latest values
+	full_rewrite = (param_file_records >= CONF_PARAM_FILE_MAX_RECORDS);
+	// if debug enable print status
+	#if CONF_PARAM_DEBUG == ENABLE
+	print_debug(full_rewrite ? "PARAM>\tStoring params\n" : "PARAM>\tStoring changed params\n");
+	#endif
+	 // Try to Open Parameter storage file
+	param_fd = fopen(CONF_PARAM_FILE_NAME, full_rewrite ? "w" : "a");
+	if (!param_fd)
+	{
+		param_dirty_any = 1;	// Try again next time
+		return;	// TODO handle error
+	}
+	if(full_rewrite) param_file_records = 0;
+	// Mark the params to store before reading the values, a write from now on sets the flag to 1 again
+	// Params of tables with PERSISTENT off stay dirty
+	for(i = next_param_pos(PERSISTENT, 0); i < param_meta.persistent_num; i = next_param_pos(PERSISTENT, i + 1))
+	{
+		index = param_meta.persistent[i];
+		if(full_rewrite || param_dirty_p[index]) param_dirty_p[index] = PARAM_STORING;
+	}
+	param_snapshot_take();
+	// Get next param with PERSISTENT option
+	for(i = next_param_pos(PERSISTENT, 0); i < param_meta.persistent_num; i = next_param_pos(PERSISTENT, i + 1))
+	{
+		index = param_meta.persistent[i];
+		if(!param_dirty_p[index]) continue;	// if param not changed, continue
+		// Clear buffer
+		bzero(param_value_buff, sizeof(param_value_buff));
+		// Convert param value to str and store it in buff, a value cut short would be loaded wrong
+		if(param_index_to_str(index, param_value_buff, sizeof(param_value_buff)) != EXIT_SUCCESS)
+		{
+			// Not stored, so it stays dirty
+			__sync_bool_compare_and_swap(&param_dirty_p[index], PARAM_STORING, 1);
+			param_persist_failed++;
+			#if CONF_PARAM_DEBUG == ENABLE
+			print_debug("PARAM>\tParam not stored, its value does not fit in CONF_PARAM_MAX_PARAM_SIZE: ");
+			print_debug(param_name(index));
+			print_debug("\n");
+			#endif
+			continue;
+		}
+		// Clear flag, unless written since marked
+		__sync_bool_compare_and_swap(&param_dirty_p[index], PARAM_STORING, 0);
+		// Print param to file
+		written = fprintf(param_fd, "%s,%s\n", param_name(index), param_value_buff);
+		if(written > 0) param_persist_bytes += written;
+		param_file_records++;
+	}
+	param_snapshot_release();
+	// Close file
+	fclose(param_fd);
+}
+#else
+
+
+// Store all PERSISTENT params as a binary image, in the slot not holding the latest image
+static void store_params_image(void)
+{
+	int offset, next, ok, written;
+	const char * slot_file;
+	param_image_header_t header;
+	FILE_T slot_fd;
+	if(param_image_buff == NULL) return;
+	#if CONF_PARAM_DEBUG == ENABLE
+	print_debug("PARAM>\tStoring param image\n");
+	#endif
+	// Clear flags before reading the values, a write from now on sets them again
+	for(i = 0; i < param_table_size_v; i++ ) param_dirty_p[i] = 0;
+	// Copy the values into the image
+	param_snapshot_take();
+	offset = 0;
+	next = next_param_pos(PERSISTENT, 0);
+	for(i = 0; i < param_meta.persistent_num; i++ )
+	{
+		// Params of tables with PERSISTENT off keep the value of the last image
+		if(i == next)
+		{
+			param_snapshot_get(param_meta.persistent[i], param_image_buff + offset);
+			next = next_param_pos(PERSISTENT, i + 1);
+		}
+		offset+=param_meta.size[param_meta.persistent[i]];
+	}
+	param_snapshot_release();
+	// Fill header, the CRC covers the header fields before it and the values
+	header.magic = PARAM_IMAGE_MAGIC;
+	header.seq = param_image_seq + 1;
+	header.schema = param_image_schema;
+	header.length = param_image_size;
+	header.crc = storage_crc32(0, &header, offsetof(param_image_header_t, crc));
+	header.crc = storage_crc32(header.crc, param_image_buff, param_image_size);
+	// Write the slot not holding the latest image, if this write is interrupted the other slot is still valid
+	slot_file = (param_image_slot == 0) ? CONF_PARAM_IMAGE_FILE_B : CONF_PARAM_IMAGE_FILE_A;
+	if(file_open(&slot_fd, slot_file, FILE_WRITE_CREATE) != 0)
+	{
+		param_dirty_any = 1;	// Try again next time
+		return;
+	}
+	// The slot is valid only once synced to the media, a power loss before leaves the other one
+	ok = (file_write_bin(&slot_fd, &header, sizeof(header)) == sizeof(header) &&
+	      (written = file_write_bin(&slot_fd, param_image_buff, param_image_size)) >= 0 &&
+	      (uint32_t) written == param_image_size &&
+	      file_sync(&slot_fd) == 0);
+	if(file_close(&slot_fd) == 0 && ok)
+	{
+		// This slot has now the latest image
+		param_image_slot = (param_image_slot == 0) ? 1 : 0;
+		param_image_seq = header.seq;
+		param_persist_bytes += sizeof(header) + param_image_size;
+	}
+	else param_dirty_any = 1;	// Try again next time
+}
+#endif
+
+
+CSP_DEFINE_TASK( param_service_task )
+{
+	while(1)
+	{
+		csp_sleep_ms(param_persist_period);
+		// Parameterized variables are written directly, compare them with the last stored value
+		check_parameterized_changes();
+		// If nothing changed since last time, there is nothing to store
+		if(!param_dirty_any)
+		{
+			param_persist_skipped++;
+			continue;
+		}
+		param_dirty_any = 0;
+		#if CONF_PARAM_PERSIST_FORMAT == PARAM_PERSIST_IMAGE
+		store_params_image();
+		#else
+		store_params_text();
+		#endif
+	}
+	return CSP_TASK_RETURN;
+}
+
+
+// Read a param image slot into param_image_buff, check it is valid
+static int read_param_image(const char * file_name, param_image_header_t * header)
+{
+	int exit_status = EXIT_FAILURE;
+	int read_len;
+	uint32_t crc;
+	FILE_T slot_fd;
+	if(file_open(&slot_fd, file_name, FILE_READ_ONLY) != 0) return EXIT_FAILURE;
+	// Header should match the current PERSISTENT params
+	if(file_read_bin(&slot_fd, header, sizeof(*header)) == sizeof(*header) &&
+	   header->magic == PARAM_IMAGE_MAGIC &&
+	   header->schema == param_image_schema &&
+	   header->length == param_image_size &&
+	   (read_len = file_read_bin(&slot_fd, param_image_buff, param_image_size)) >= 0 &&
+	   (uint32_t) read_len == param_image_size)
+	{
+		// Check the CRC
+		crc = storage_crc32(0, header, offsetof(param_image_header_t, crc));
+		crc = storage_crc32(crc, param_image_buff, param_image_size);
+		if(crc == header->crc) exit_status = EXIT_SUCCESS;
+	}
+	file_close(&slot_fd);
+	return exit_status;
+}
+
+
+// Load the latest valid param image
+int load_param_image(void)
+{
+	int i, offset, slot;
+	param_image_header_t header_a, header_b;
+	int valid_a, valid_b;
+	if(param_image_buff == NULL) return EXIT_FAILURE;
+	// Check both slots, the last one read stays in param_image_buff
+	valid_a = (read_param_image(CONF_PARAM_IMAGE_FILE_A, &header_a) == EXIT_SUCCESS);
+	valid_b = (read_param_image(CONF_PARAM_IMAGE_FILE_B, &header_b) == EXIT_SUCCESS);
+	if(!valid_a && !valid_b)
+	{
+		#if CONF_PARAM_DEBUG == ENABLE
+		print_debug("PARAM>\tNo valid param image\n");
+		#endif
+		return EXIT_FAILURE;
+	}
+	// Take the newest valid slot, sequence numbers may wrap
+	slot = (valid_a && (!valid_b || (int32_t)(header_a.seq - header_b.seq) > 0)) ? 0 : 1;
+	// Read again slot A if it is the newest, the buffer has what was read from slot B
+	if(slot == 0 && read_param_image(CONF_PARAM_IMAGE_FILE_A, &header_a) != EXIT_SUCCESS) return EXIT_FAILURE;
+	param_image_slot = slot;
+	param_image_seq = (slot == 0) ? header_a.seq : header_b.seq;
+	// Copy the values to the params
+	offset = 0;
+	for(i = 0; i < param_meta.persistent_num; i++ )
+	{
+		write_param_index(param_meta.persistent[i], param_image_buff + offset);
+		offset+=param_meta.size[param_meta.persistent[i]];
+	}
+	// Values are now the stored ones
+	for(i = 0; i < param_table_size_v; i++ ) param_dirty_p[i] = 0;
+	param_dirty_any = 0;
+	sync_parameterized_shadow();
+	#if CONF_PARAM_DEBUG == ENABLE
+	print_debug(slot == 0 ? "PARAM>\tParam image A loaded\n" : "PARAM>\tParam image B loaded\n");
+	#endif
+	return EXIT_SUCCESS;
+}
+
+
+// Load parameters froma persistent file to the Parameter table, Table should exists
+int load_param_table(char* file_name)
+{
+    char *val_p;	// pointer where starts iin line the value of the parameter
+	param_handle_t param_h;
+	// Bufer to store a line from file
+	char line_buff[PARAM_FULL_NAME_SIZE+CONF_PARAM_MAX_PARAM_SIZE+3]; // Plus the comma separator, the new line char and terminating null-character
+
+	// Check if table already exists, if not impossible to load data from a file
+    if(param_table_p ==NULL || param_table_size_v < 1 ) return EXIT_FAILURE;
+	// Try to Open file
+	param_fd = fopen(file_name, "r");
+	if (!param_fd)  return EXIT_FAILURE;
+	// Read line by line
+	while( fgets( line_buff, sizeof(line_buff), param_fd )!= NULL)
+	{
+		// Fin the comma delimiter in line
+		val_p = line_buff;
+		strsep(&val_p, ",");
+		// If delimiter not found, continue
+		if (val_p == NULL) continue;
+        // Look if exists requested param
+		if((param_h =  get_param_handle_by_name(line_buff))==NULL) continue;
+        // Remove new line char '\n' from buffer (should be the last char)
+        if(val_p[strlen(val_p)-1] == '\n') val_p[strlen(val_p)-1] = '\0';
+        // Try set value in buff to param
+		str_to_param(param_h, val_p);
+    }
+    // Close file and fee pointer
+    fclose(param_fd);
+	return EXIT_SUCCESS;
+}
+
+
+int init_param_persistence(void)
+{
+	#if CONF_PARAM_PERSIST_FORMAT == PARAM_PERSIST_IMAGE
+	int i;
+	#endif
+	// Ckeck Param Table Exists
+	if(param_table_p ==NULL || param_table_size_v < 1 )
+	{
+		#if CONF_PARAM_DEBUG == ENABLE
+		print_debug("PARAM>\tInit Param Persistence Fails! Set Param Table befor init Param Persistence!\n");
+		#endif
+		return EXIT_FAILURE;
+	}
+	// Set Options
+	param_persist_period = CONF_PARAM_PERSIST_PERIOD;
+	// Restore the stored params
+	#if CONF_PARAM_PERSIST_FORMAT == PARAM_PERSIST_IMAGE
+	// Size of the image and the hash to check it matches the table
+	// Already set by set_param_table_prebuilt()
+	if(param_image_buff == NULL)
+	{
+		param_image_schema = calc_params_schema(param_meta.persistent, param_meta.persistent_num);
+		param_image_size = 0;
+		for(i = 0; i < param_meta.persistent_num; i++ ) param_image_size+=param_meta.size[param_meta.persistent[i]];
+		if((param_image_buff = param_alloc(param_image_size > 0 ? param_image_size : 1)) == NULL) return EXIT_FAILURE;
+	}
+	// Without an image, start from the current values, as kept for tables with PERSISTENT off
+	if(load_param_image() != EXIT_SUCCESS)
+	{
+		uint32_t offset = 0;
+		for(i = 0; i < param_meta.persistent_num; i++ )
+		{
+			read_param_index(param_meta.persistent[i], param_image_buff + offset);
+			offset+=param_meta.size[param_meta.persistent[i]];
+		}
+	}
+	#else
+	load_param_table(CONF_PARAM_FILE_NAME);
+	#endif
+	//Create param Service Task
+	return csp_thread_create(param_service_task, "PARAM_TASK", CONF_PARAM_TASK_STACK_SIZE, NULL, CONF_PARAM_TASK_PRIORITY, &handle_param_service_task);
+}
+
+
+
+// Size of an element of each param_type_t, strings are arrays of chars
+static const uint8_t param_type_size[] =
+{
+	[UINT8_PARAM]	= UINT8_SIZE,
+	[INT8_PARAM]	= INT8_SIZE,
+	[UINT16_PARAM]	= UINT16_SIZE,
+	[INT16_PARAM]	= INT16_SIZE,
+	[UINT32_PARAM]	= UINT32_SIZE,
+	[INT32_PARAM]	= INT32_SIZE,
+	[UINT64_PARAM]	= UINT64_SIZE,
+	[INT64_PARAM]	= INT64_SIZE,
+	[FLOAT_PARAM]	= FLOAT_SIZE,
+	[DOUBLE_PARAM]	= DOUBLE_SIZE,
+	[STRING_PARAM]	= 1,
+};
+#define PARAM_TYPES_NUM		(sizeof(param_type_size) / sizeof(param_type_size[0]))
+
+
+uint16_t param_elem_size(param_handle_t param_h)
+{
+	if(param_h == NULL || (unsigned) param_h->type >= PARAM_TYPES_NUM) return 0;
+	return param_type_size[param_h->type];
+}
+
+
+uint16_t param_elem_count(param_handle_t param_h)
+{
+	uint16_t elem_size = param_elem_size(param_h);
+	if(elem_size == 0) return 0;
+	return param_h->size / elem_size;
+}
+
+
+// Natural alignment of a value, the size of its element up to 8 bytes, strings have none
+static inline int param_value_align(int index)
+{
+	int size = param_elem_size(&param_table_p[index]);
+	return (size < (int) sizeof(uint64_t)) ? size : (int) sizeof(uint64_t);
+}
+
+
+// Take memory for the mounted table, and count it
+static void * param_alloc(size_t size)
+{
+	void * block;
+	if(param_blocks_num >= PARAM_MAX_BLOCKS || (block = csp_malloc(size)) == NULL) return NULL;
+	param_blocks[param_blocks_num++] = block;
+	param_ram_bytes += size;
+	return block;
+}
+
+
+// Free a block of param_alloc() before the table is mounted again
+static void param_free(void * block)
+{
+	int i;
+	for(i = 0; i < param_blocks_num; i++ )
+	{
+		if(param_blocks[i] != block) continue;
+		param_blocks[i] = param_blocks[--param_blocks_num];
+		csp_free(block);
+		return;
+	}
+}
+
+
+// Free the blocks of the mounted table, and forget the pointers into them
+static void free_param_blocks(void)
+{
+	int i;
+	// A table mounted in place points into param space, its values are placed again when mounted
+	for(i = 0; param_blocks_num > 0 && param_space_p != NULL && i < param_table_size_v; i++ )
+	{
+		if((uint8_t *) param_table_p[i].value >= (uint8_t *) param_space_p &&
+		   (uint8_t *) param_table_p[i].value < (uint8_t *) param_space_p + param_space_size_v) param_table_p[i].value = NULL;
+	}
+	param_space_p = NULL;
+	while(param_blocks_num > 0) csp_free(param_blocks[--param_blocks_num]);
+	param_ram_bytes = 0;
+	if(param_name_index_built) param_name_index_p = NULL;
+	param_name_index_built = 0;
+	param_shadow_p = NULL;
+	param_image_buff = NULL;
+	bzero(&param_snapshot, sizeof(param_snapshot));
+	param_stats_p = NULL;
+	telemetry_delta_p = NULL;
+}
+
+
+// Create the snapshot mutex, once
+static int init_param_snapshot_mutex(void)
+{
+	if(param_snapshot_mutex_created) return EXIT_SUCCESS;
+	if(csp_mutex_create(&param_snapshot_mutex) != CSP_MUTEX_OK) return EXIT_FAILURE;
+	param_snapshot_mutex_created = 1;
+	return EXIT_SUCCESS;
+}
+
+
+// Mount a single table without prefix as the Parameter Table
+int set_param_table(param_table_t* param_table, uint16_t param_table_size)
+{
+	param_tables_num = 0;
+	if(register_param_table("", param_table, param_table_size) < 0) return EXIT_FAILURE;
+	return mount_param_tables();
+}
+
+
+// Register the table of a subsystem, mounted with the others by mount_param_tables()
+int register_param_table(const char * prefix, param_table_t * param_table, uint16_t param_table_size)
+{
+	param_table_info_t * info;
+	// Check Options
+	if(prefix == NULL || param_table == NULL || param_table_size < 1 || param_tables_num >= CONF_PARAM_MAX_TABLES) return -1;
+	// The prefix and the separator should fit, and prefixes should be unique
+	if(strlen(prefix) >= CONF_PARAM_PREFIX_SIZE || get_param_table_id(prefix) >= 0) return -1;
+	info = &param_tables[param_tables_num];
+	bzero(info, sizeof(*info));
+	info->prefix = prefix;
+	info->table = (param_t*) param_table;
+	info->size = param_table_size;
+	info->opts = TELEMETRY|PERSISTENT;
+	return param_tables_num++;
+}
+
+
+// Mount the registered tables as the Parameter Table
+int mount_param_tables(void)
+{
+	int i, t, param_space_size, offset, align;
+	uint32_t total;
+	if(param_tables_num == 0) return EXIT_FAILURE;
+	// Tables go one after the other
+	total = 0;
+	for(t = 0; t < param_tables_num; t++ )
+	{
+		if(param_tables[t].table == NULL) return EXIT_FAILURE;
+		param_tables[t].first = total;
+		total += param_tables[t].size;
+	}
+	// Indexes are 16 bits
+	if(total > INT16_MAX) return EXIT_FAILURE;
+	// Memory of the table mounted before
+	free_param_blocks();
+	param_table_size_v = total;
+	// A single table is used in place, several are copied into a new one
+	if(param_tables_num == 1) param_table_p = param_tables[0].table;
+	else
+	{
+		if((param_table_p = param_alloc(total * sizeof(param_t))) == NULL) return EXIT_FAILURE;
+		for(t = 0; t < param_tables_num; t++ )
+		{
+			memcpy(&param_table_p[param_tables[t].first], param_tables[t].table, param_tables[t].size * sizeof(param_t));
+		}
+	}
+	// Check entries of table and calculate param space ( memory space to store param values)
+	param_space_size = 0;
+	for(i = 0; i < param_table_size_v; i++ )
+	{
+		// Check that each entry has a name an a size > 0
+		if(param_table_p[i].name[0] == '\0' || param_table_p[i].size < 1 ) return EXIT_FAILURE;
+		// Check the type is known, and arrays have a whole number of elements
+		if(param_elem_size(&param_table_p[i]) == 0 || param_table_p[i].size % param_elem_size(&param_table_p[i]) != 0) return EXIT_FAILURE;
+		// Param space is equals to the sum of all param sizes, except if is a existing variable parameterized
+		// Check if is a variable parameterized
+		if(param_table_p[i].value != NULL ) continue;
+		// If not, the require memory shall be allocated, increment counter
+		param_space_size+=param_table_p[i].size;
+	}
+	//	Alloc memory for param values, all start as zero
+	if(param_space_size > 0 && (param_space_p = param_alloc(param_space_size))==NULL) return EXIT_FAILURE;
+	if(param_space_p != NULL) bzero(param_space_p, param_space_size);
+	param_space_size_v = param_space_size;
+	// Populate value pointers in table entries, widest alignment first: 8, 4, 2 and 1 byte
+	// Sizes are multiples of their alignment, so every value is naturally aligned without padding
+	offset = 0;
+	for(align = sizeof(uint64_t); align > 0; align >>= 1)
+	{
+		for(i = 0; i < param_table_size_v; i++ )
+		{
+			// Check if is a parameterized variable
+			// If is a parameterized variable the pointer shall not be changed, already contains the corresponding pointer
+			if(param_table_p[i].value != NULL || param_value_align(i) != align) continue;
+			// The value will be stored in param space + offset (size of previous params)
+			param_table_p[i].value = param_space_p + offset;
+			// Calculate offset for next param
+			offset+=param_table_p[i].size;
+		}
+	}
+	// Hot metadata, index lists and name pool, used by scans and lookups from now on
+	if(build_param_meta() != EXIT_SUCCESS) return EXIT_FAILURE;
+	// Sequence counters, all values start stable
+	if((param_seq_p = param_alloc(param_table_size_v * sizeof(uint32_t))) == NULL) return EXIT_FAILURE;
+	for(i = 0; i < param_table_size_v; i++ ) param_seq_p[i] = 0;
+	// Build the name index, unless a prebuilt one was set with set_param_name_index()
+	if(build_param_name_index() != EXIT_SUCCESS) return EXIT_FAILURE;
+	// Hash of the telemetry params, to identify binary beacons
+	telemetry_schema = calc_telemetry_schema();
+	// Dirty flags for persistence
+	if(init_param_dirty_tracking() != EXIT_SUCCESS) return EXIT_FAILURE;
+	// Snapshot for telemetry and persistence
+	if(init_param_snapshot() != EXIT_SUCCESS) return EXIT_FAILURE;
+	// Access statistics
+	if(init_param_stats() != EXIT_SUCCESS) return EXIT_FAILURE;
+	// Last values sent in delta beacons
+	if(init_telemetry_delta() != EXIT_SUCCESS) return EXIT_FAILURE;
+	#if CONF_PARAM_DEBUG == ENABLE
+	print_debug("PARAM>\tParam Table OK! Values: ");
+	print_debug_uint(param_space_size_v);
+	print_debug(" bytes, RAM used: ");
+	print_debug_uint(param_ram_bytes);
+	print_debug(" bytes\n");
+	#endif
+	return EXIT_SUCCESS;
+}
+
+
+// Mount a Parameter Table generated at build time, everything is already computed
+int set_param_table_prebuilt(const param_prebuilt_t * prebuilt)
+{
+	// Check Options
+	if(prebuilt == NULL || prebuilt->table == NULL || prebuilt->table_size < 1 || prebuilt->name_index == NULL ||
+	   prebuilt->seq == NULL || prebuilt->dirty == NULL || prebuilt->tables == NULL ||
+	   // The name index should be a power of two with at least one empty slot
+	   prebuilt->name_index_slots <= (uint32_t) prebuilt->table_size || (prebuilt->name_index_slots & (prebuilt->name_index_slots - 1)) != 0 ||
+	   prebuilt->tables_num < 1 || prebuilt->tables_num > CONF_PARAM_MAX_TABLES) return EXIT_FAILURE;
+	// Memory of a table mounted before
+	free_param_blocks();
+	// Tables are copied, their options can be changed
+	memcpy(param_tables, prebuilt->tables, prebuilt->tables_num * sizeof(param_table_info_t));
+	param_tables_num = prebuilt->tables_num;
+	param_table_p = prebuilt->table;
+	param_table_size_v = prebuilt->table_size;
+	param_space_p = prebuilt->space;
+	param_space_size_v = prebuilt->space_size;
+	param_meta = prebuilt->meta;
+	param_name_index_set = 0;
+	param_name_index_p = prebuilt->name_index;
+	param_name_index_slots = prebuilt->name_index_slots;
+	param_seq_p = prebuilt->seq;
+	param_dirty_p = prebuilt->dirty;
+	param_dirty_any = 0;
+	// A full rewrite first, so the file only has the latest values
+	param_file_records = CONF_PARAM_FILE_MAX_RECORDS;
+	param_shadow_p = prebuilt->shadow;
+	param_image_buff = prebuilt->image;
+	param_image_size = prebuilt->image_size;
+	telemetry_schema = prebuilt->telemetry_schema;
+	param_image_schema = prebuilt->image_schema;
+	param_ram_bytes = prebuilt->ram_bytes;
+	// Take the current values of parameterized PERSISTENT variables
+	sync_parameterized_shadow();
+	#if CONF_PARAM_SNAPSHOT == ENABLE
+	param_snapshot = prebuilt->snapshot;
+	if(param_snapshot.values == NULL || init_param_snapshot_mutex() != EXIT_SUCCESS) return EXIT_FAILURE;
+	#endif
+	#if CONF_PARAM_STATS == ENABLE
+	if((param_stats_p = prebuilt->stats) == NULL) return EXIT_FAILURE;
+	param_lookup_misses = 0;
+	#endif
+	#if CONF_PARAM_DELTA == ENABLE
+	if((telemetry_delta_p = prebuilt->delta) == NULL) return EXIT_FAILURE;
+	telemetry_delta_count = 0;
+	#endif
+	#if CONF_PARAM_DEBUG == ENABLE
+	print_debug("PARAM>\tPrebuilt Param Table OK! Values: ");
+	print_debug_uint(param_space_size_v);
+	print_debug(" bytes, RAM used: ");
+	print_debug_uint(param_ram_bytes);
+	print_debug(" bytes\n");
+	#endif
+	return EXIT_SUCCESS;
+}
+
+
+// Build the hot metadata arrays, the index lists and the name pool, in one allocation
+static int build_param_meta(void)
+{
+	int i, t;
+	size_t names_size, name_len, prefix_len;
+	param_table_info_t * info;
+	uint8_t * block;
+	// Count the members of the lists and the size of the pool
+	param_meta.telemetry_num = 0;
+	param_meta.persistent_num = 0;
+	names_size = 0;
+	for(i = 0; i < param_table_size_v; i++ )
+	{
+		if(param_table_p[i].opts & TELEMETRY) param_meta.telemetry_num++;
+		if(param_table_p[i].opts & PERSISTENT) param_meta.persistent_num++;
+		names_size += strnlen(param_table_p[i].name, CONF_PARAM_NAME_SIZE) + 1;
+	}
+	// Names of prefixed tables start with the prefix and the separator
+	for(t = 0; t < param_tables_num; t++ )
+	{
+		prefix_len = strlen(param_tables[t].prefix);
+		if(prefix_len > 0) names_size += param_tables[t].size * (prefix_len + 1);
+	}
+	// Widest members first, so all of them are aligned
+	block = param_alloc(param_table_size_v * (sizeof(void*) + sizeof(uint32_t) + sizeof(uint16_t) + 2 * sizeof(uint8_t)) +
+	                   (param_meta.telemetry_num + param_meta.persistent_num) * sizeof(param_index_t) + names_size);
+	if(block == NULL) return EXIT_FAILURE;
+	param_meta.value = (void**) block;
+	block += param_table_size_v * sizeof(void*);
+	param_meta.name = (uint32_t*) block;
+	block += param_table_size_v * sizeof(uint32_t);
+	param_meta.telemetry = (param_index_t*) block;
+	block += param_meta.telemetry_num * sizeof(param_index_t);
+	param_meta.persistent = (param_index_t*) block;
+	block += param_meta.persistent_num * sizeof(param_index_t);
+	param_meta.size = (uint16_t*) block;
+	block += param_table_size_v * sizeof(uint16_t);
+	param_meta.type = block;
+	block += param_table_size_v;
+	param_meta.opts = block;
+	block += param_table_size_v;
+	param_meta.names = (char*) block;
+	// Fill them, table by table to know where the lists of each table start
+	param_meta.telemetry_num = 0;
+	param_meta.persistent_num = 0;
+	names_size = 0;
+	for(t = 0; t < param_tables_num; t++ )
+	{
+		info = &param_tables[t];
+		info->telemetry_first = param_meta.telemetry_num;
+		info->persistent_first = param_meta.persistent_num;
+		prefix_len = strlen(info->prefix);
+		for(i = info->first; i < info->first + info->size; i++ )
+		{
+			param_meta.value[i] = param_table_p[i].value;
+			param_meta.type[i] = param_table_p[i].type;
+			param_meta.size[i] = param_table_p[i].size;
+			param_meta.opts[i] = param_table_p[i].opts;
+			if(param_table_p[i].opts & TELEMETRY) param_meta.telemetry[param_meta.telemetry_num++] = i;
+			if(param_table_p[i].opts & PERSISTENT) param_meta.persistent[param_meta.persistent_num++] = i;
+			// Name, "<prefix>.<name>" if the table has a prefix
+			param_meta.name[i] = names_size;
+			if(prefix_len > 0)
+			{
+				memcpy(param_meta.names + names_size, info->prefix, prefix_len);
+				param_meta.names[names_size + prefix_len] = PARAM_TABLE_SEPARATOR;
+				names_size += prefix_len + 1;
+			}
+			// Names in the table may fill CONF_PARAM_NAME_SIZE without null-character
+			name_len = strnlen(param_table_p[i].name, CONF_PARAM_NAME_SIZE);
+			memcpy(param_meta.names + names_size, param_table_p[i].name, name_len);
+			param_meta.names[names_size + name_len] = '\0';
+			names_size += name_len + 1;
+		}
+		info->telemetry_num = param_meta.telemetry_num - info->telemetry_first;
+		info->persistent_num = param_meta.persistent_num - info->persistent_first;
+	}
+	return EXIT_SUCCESS;
+}
+
+
+
+// Hash of a param name, FNV-1a over the name chars (max PARAM_FULL_NAME_SIZE)
+uint32_t param_name_hash(const char * name)
+{
+	int i;
+	uint32_t hash = FNV_OFFSET_BASIS;
+	for(i = 0; i < PARAM_FULL_NAME_SIZE && name[i] != '\0'; i++)
+	{
+		hash ^= (uint8_t) name[i];
+		hash *= FNV_PRIME;
+	}
+	return hash;
+}
+
+
+// Add the name, type and size of a param to a hash
+static uint32_t hash_param_def(uint32_t hash, int index)
+{
+	int j;
+	const char * name;
+	// Name, including the null-character to separate names
+	name = param_name(index);
+	for(j = 0; j < PARAM_FULL_NAME_SIZE; j++)
+	{
+		hash ^= (uint8_t) name[j];
+		hash *= FNV_PRIME;
+		if(name[j] == '\0') break;
+	}
+	hash ^= param_meta.type[index];
+	hash *= FNV_PRIME;
+	hash ^= param_meta.size[index] & 0xFF;
+	hash *= FNV_PRIME;
+	// High byte only for sizes over 255, so hashes of smaller params are as with 8 bit sizes
+	if(param_meta.size[index] > 0xFF)
+	{
+		hash ^= param_meta.size[index] >> 8;
+		hash *= FNV_PRIME;
+	}
+	return hash;
+}
+
+
+// Hash of the name, type and size of all params in an index list
+static uint32_t calc_params_schema(const param_index_t * list, uint16_t list_num)
+{
+	int i;
+	uint32_t hash = FNV_OFFSET_BASIS;
+	for(i = 0; i < list_num; i++ ) hash = hash_param_def(hash, list[i]);
+	return hash;
+}
+
+
+// Hash of the TELEMETRY params of the tables with TELEMETRY on, as collected
+static uint32_t calc_telemetry_schema(void)
+{
+	int i;
+	uint32_t hash = FNV_OFFSET_BASIS;
+	for(i = next_param_pos(TELEMETRY, 0); i < param_meta.telemetry_num; i = next_param_pos(TELEMETRY, i + 1))
+	{
+		hash = hash_param_def(hash, param_meta.telemetry[i]);
+	}
+	return hash;
+}
+
+
+// Find the index of a param by the name, in the name index
+// If there is no name index, fall back to scan the table
+static param_index_t lookup_param_index(const char * name)
+{
+	uint32_t slot, probes;
+	param_index_t index;
+	if(name == NULL || param_meta.names == NULL) return -1;
+	// No index, scan the table
+	if(param_name_index_p == NULL)
+	{
+		for(index = 0; index < param_table_size_v; index++ )
+		{
+			if(strncmp( param_name(index), name, PARAM_FULL_NAME_SIZE) == 0 ) return index;
+		}
+		return -1;
+	}
+	// Probe from the home slot until the name or an empty slot is found, at most every slot once
+	slot = param_name_hash(name) & (param_name_index_slots - 1);
+	for(probes = 0; probes < param_name_index_slots && (index = param_name_index_p[slot]) >= 0; probes++ )
+	{
+		if(strncmp( param_name(index), name, PARAM_FULL_NAME_SIZE) == 0 ) return index;
+		slot = (slot + 1) & (param_name_index_slots - 1);
+	}
+	return -1;
+}
+
+
+// Check that every param of the table is found in the current name index
+static int check_param_name_index(void)
+{
+	param_index_t i;
+	for(i = 0; i < param_table_size_v; i++ )
+	{
+		if(lookup_param_index(param_name(i)) != i) return EXIT_FAILURE;
+	}
+	return EXIT_SUCCESS;
+}
+
+
+// Create the name index for the current table
+static int build_param_name_index(void)
+{
+	param_index_t i;
+	uint32_t slot;
+	// If a prebuilt index was set, just check it match the table
+	if(param_name_index_set)
+	{
+		param_name_index_set = 0;
+		if(check_param_name_index() == EXIT_SUCCESS) return EXIT_SUCCESS;
+		#if CONF_PARAM_DEBUG == ENABLE
+		print_debug("PARAM>\tPrebuilt name index does not match Param Table!\n");
+		#endif
+		return EXIT_FAILURE;
+	}
+	// The index of a previous table does not match this one
+	if(param_name_index_built) param_free(param_name_index_p);
+	param_name_index_p = NULL;
+	param_name_index_built = 0;
+	// Keep the index at most half full, so probe sequences stay short
+	param_name_index_slots = 1;
+	while(param_name_index_slots < 2 * (uint32_t) param_table_size_v) param_name_index_slots <<= 1;
+	// If no memory for the index, lookups fall back to scan the table
+	if((param_name_index_p = param_alloc(param_name_index_slots * sizeof(param_index_t))) == NULL) return EXIT_SUCCESS;
+	param_name_index_built = 1;
+	// Mark all slots as empty
+	for(slot = 0; slot < param_name_index_slots; slot++) param_name_index_p[slot] = -1;
+	// Insert each param at the first free slot from its home slot
+	for(i = 0; i < param_table_size_v; i++ )
+	{
+		// Names should be unique, keep the first one as the table scan did
+		if(lookup_param_index(param_name(i)) >= 0)
+		{
+			#if CONF_PARAM_DEBUG == ENABLE
+			print_debug("PARAM>\tDuplicated param name: ");
+			print_debug(param_name(i));
+			print_debug("\n");
+			#endif
+			continue;
+		}
+		slot = param_name_hash(param_name(i)) & (param_name_index_slots - 1);
+		while(param_name_index_p[slot] >= 0) slot = (slot + 1) & (param_name_index_slots - 1);
+		param_name_index_p[slot] = i;
+	}
+	return EXIT_SUCCESS;
+}
+
+
+// Set a prebuilt name index, e.g. generated at build time
+int set_param_name_index(param_index_t * name_index, uint32_t slots)
+{
+	// Slots should be a power of two
+	if(name_index == NULL || slots == 0 || (slots & (slots - 1)) != 0) return EXIT_FAILURE;
+	if(param_name_index_built) param_free(param_name_index_p);
+	param_name_index_built = 0;
+	param_name_index_p = name_index;
+	param_name_index_slots = slots;
+	param_name_index_set = 1;
+	return EXIT_SUCCESS;
+}
+
+
+
+// Count a name lookup, found or not
+static inline void count_param_lookup(param_index_t index)
+{
+	#if CONF_PARAM_STATS == ENABLE
+	if(index < 0) param_lookup_misses++;
+	else param_stats_p[index].lookups++;
+	#else
+	(void) index;
+	#endif
+}
+
+
+// Look up the name index to find param with the name
+// Return the handle of a Parameter
+param_handle_t get_param_handle_by_name( const char * name)
+{
+	param_index_t index = lookup_param_index(name);
+	count_param_lookup(index);
+	// Returns NULL if not found
+	if(index < 0) return NULL;
+	return &param_table_p[index];
+}
+
+
+// Look up the name index to find param with the name
+// Return the index of a Parameter
+param_index_t get_param_index( const char * name)				// TODO Make indexes start at 1, otherwise Null index would be valid
+{
+	param_index_t index = lookup_param_index(name);
+	count_param_lookup(index);
+	// Returns -1 if not found
+	return index;
+}
+
+
+
+
+// Get the handle of a Parameter by the index
+param_handle_t get_param_handle_by_index(param_index_t index)		// TODO Make indexes start at 1, otherwise Null index would be valid
+{
+	if(index < 0 || index >= param_table_size_v) return NULL;
+	return &param_table_p[index];
+}
+
+
+
+// Get the id of a table by its prefix
+param_table_id_t get_param_table_id(const char * prefix)
+{
+	param_table_id_t t;
+	if(prefix == NULL) return -1;
+	for(t = 0; t < param_tables_num; t++ )
+	{
+		if(strcmp(param_tables[t].prefix, prefix) == 0) return t;
+	}
+	return -1;
+}
+
+
+// Get a table of the Parameter Table
+const param_table_info_t * get_param_table_info(param_table_id_t table_id)
+{
+	if(table_id < 0 || table_id >= param_tables_num) return NULL;
+	return &param_tables[table_id];
+}
+
+
+// Get the amount of tables
+uint8_t get_param_tables_num(void)
+{
+	return param_tables_num;
+}
+
+
+// Get the handle of a Parameter by its table and the index in that table
+param_handle_t get_param_handle_by_ref(param_table_id_t table_id, param_index_t index)
+{
+	if(table_id < 0 || table_id >= param_tables_num || param_table_p == NULL) return NULL;
+	if(index < 0 || index >= param_tables[table_id].size) return NULL;
+	return &param_table_p[param_tables[table_id].first + index];
+}
+
+
+// Turn telemetry and persistence of a table on or off
+int set_param_table_opts(param_table_id_t table_id, uint8_t opts)
+{
+	if(table_id < 0 || table_id >= param_tables_num) return EXIT_FAILURE;
+	param_tables[table_id].opts = opts & (TELEMETRY|PERSISTENT);
+	// Beacons carry only the params collected from now on
+	telemetry_schema = calc_telemetry_schema();
+	// Store what changed while it was off
+	if(opts & PERSISTENT) param_dirty_any = 1;
+	return EXIT_SUCCESS;
+}
+
+
+// Position in the TELEMETRY or PERSISTENT list of the next param from pos, of a table with the option on
+// Returns the size of the list if there is none
+static int next_param_pos(uint8_t opt, int pos)
+{
+	int t, first, num;
+	for(t = 0; t < param_tables_num; t++ )
+	{
+		first = (opt == TELEMETRY) ? param_tables[t].telemetry_first : param_tables[t].persistent_first;
+		num = (opt == TELEMETRY) ? param_tables[t].telemetry_num : param_tables[t].persistent_num;
+		if(pos >= first + num || !(param_tables[t].opts & opt)) continue;
+		return (pos > first) ? pos : first;
+	}
+	return (opt == TELEMETRY) ? param_meta.telemetry_num : param_meta.persistent_num;
+}
+
+
+
+
+
+
+// Check if a param is a parameterized variable, i.e. its value is not in param space
+static inline int is_parameterized(int index)
+{
+	return (param_meta.value[index] < param_space_p || param_meta.value[index] >= param_space_p + param_space_size_v);
+}
+
+
+// Mark a param to be stored by the persistence task
+static inline void mark_param_dirty(param_handle_t param_h)
+{
+	if(param_dirty_p == NULL) return;
+	param_dirty_p[param_h - param_table_p] = 1;
+	param_dirty_any = 1;
+}
+
+
+// Allocate the dirty flags and the copy of parameterized PERSISTENT variables
+static int init_param_dirty_tracking(void)
+{
+	int i, index, shadow_size;
+	if((param_dirty_p = param_alloc(param_table_size_v)) == NULL) return EXIT_FAILURE;
+	bzero(param_dirty_p, param_table_size_v);
+	param_dirty_any = 0;
+	// A full rewrite first, so the file only has the latest values
+	param_file_records = CONF_PARAM_FILE_MAX_RECORDS;
+	// Calculate the size of the copy
+	shadow_size = 0;
+	for(i = 0; i < param_meta.persistent_num; i++ )
+	{
+		index = param_meta.persistent[i];
+		if(is_parameterized(index)) shadow_size+=param_meta.size[index];
+	}
+	if(shadow_size == 0) return EXIT_SUCCESS;
+	if((param_shadow_p = param_alloc(shadow_size)) == NULL) return EXIT_FAILURE;
+	// Take the current values
+	sync_parameterized_shadow();
+	return EXIT_SUCCESS;
+}
+
+
+// Take the current value of parameterized PERSISTENT variables as the last stored value
+static void sync_parameterized_shadow(void)
+{
+	int i, index, offset;
+	if(param_shadow_p == NULL) return;
+	offset = 0;
+	for(i = 0; i < param_meta.persistent_num; i++ )
+	{
+		index = param_meta.persistent[i];
+		if(!is_parameterized(index)) continue;
+		read_param_index(index, param_shadow_p + offset);
+		offset+=param_meta.size[index];
+	}
+}
+
+
+// Allocate the snapshot, all params start as changed so the first snapshot copies them all
+static int init_param_snapshot(void)
+{
+	#if CONF_PARAM_SNAPSHOT == ENABLE
+	int i, words;
+	uint32_t vars_size;
+	uint8_t * block;
+	words = (param_table_size_v + 31) / 32;
+	// Parameterized variables go after the copy of param space
+	vars_size = 0;
+	for(i = 0; i < param_table_size_v; i++ )
+	{
+		if(is_parameterized(i)) vars_size+=param_meta.size[i];
+	}
+	// Widest members first, so all of them are aligned
+	block = param_alloc(param_table_size_v * sizeof(uint32_t) + 2 * words * sizeof(uint32_t) + param_space_size_v + vars_size);
+	if(block == NULL) return EXIT_FAILURE;
+	param_snapshot.offset = (uint32_t*) block;
+	block += param_table_size_v * sizeof(uint32_t);
+	param_snapshot.changed = (uint32_t*) block;
+	block += words * sizeof(uint32_t);
+	param_snapshot.vars = (uint32_t*) block;
+	block += words * sizeof(uint32_t);
+	param_snapshot.values = block;
+	bzero(param_snapshot.changed, 2 * words * sizeof(uint32_t));
+	vars_size = 0;
+	for(i = 0; i < param_table_size_v; i++ )
+	{
+		param_snapshot.changed[i >> 5] |= 1u << (i & 31);
+		if(!is_parameterized(i))
+		{
+			param_snapshot.offset[i] = (uint8_t *) param_meta.value[i] - (uint8_t *) param_space_p;
+			continue;
+		}
+		param_snapshot.offset[i] = param_space_size_v + vars_size;
+		param_snapshot.vars[i >> 5] |= 1u << (i & 31);
+		vars_size+=param_meta.size[i];
+	}
+	if(init_param_snapshot_mutex() != EXIT_SUCCESS) return EXIT_FAILURE;
+	#endif
+	return EXIT_SUCCESS;
+}
+
+
+// Mark a param as written since the last snapshot, and count the write
+static inline void mark_param_written(int index)
+{
+	#if CONF_PARAM_SNAPSHOT == ENABLE
+	__sync_fetch_and_add(&param_write_count, 1);
+	if(param_snapshot.changed != NULL) __sync_fetch_and_or(&param_snapshot.changed[index >> 5], 1u << (index & 31));
+	#endif
+}
+
+
+// Allocate the access statistics, all zeroed
+static int init_param_stats(void)
+{
+	#if CONF_PARAM_STATS == ENABLE
+	if((param_stats_p = param_alloc(param_table_size_v * sizeof(param_stats_t))) == NULL) return EXIT_FAILURE;
+	param_reset_stats();
+	#endif
+	return EXIT_SUCCESS;
+}
+
+
+// Allocate the last values sent in delta beacons, the first beacon is a keyframe
+static int init_telemetry_delta(void)
+{
+	#if CONF_PARAM_DELTA == ENABLE
+	int i;
+	uint32_t size = 0;
+	for(i = 0; i < param_meta.telemetry_num; i++) size += param_meta.size[param_meta.telemetry[i]];
+	if((telemetry_delta_p = param_alloc(size > 0 ? size : 1)) == NULL) return EXIT_FAILURE;
+	telemetry_delta_count = 0;
+	#endif
+	return EXIT_SUCCESS;
+}
+
+
+// Count a read of a param by the app
+static inline void count_param_read(int index)
+{
+	#if CONF_PARAM_STATS == ENABLE
+	param_stats_p[index].reads++;
+	#else
+	(void) index;
+	#endif
+}
+
+
+// Count a write of a param by the app, and take the time
+static inline void count_param_write(int index)
+{
+	#if CONF_PARAM_STATS == ENABLE
+	param_stats_p[index].writes++;
+	param_stats_p[index].last_write_s = get_timestamp_s();
+	#else
+	(void) index;
+	#endif
+}
+
+
+// Compare parameterized PERSISTENT variables with the last stored value, mark the changed ones
+static void check_parameterized_changes(void)
+{
+	int i, index, offset, done, length;
+	uint8_t chunk[PARAM_CHUNK_SIZE];
+	if(param_shadow_p == NULL) return;
+	offset = 0;
+	for(i = 0; i < param_meta.persistent_num; i++ )
+	{
+		index = param_meta.persistent[i];
+		if(!is_parameterized(index)) continue;
+		// Compare by chunks, arrays may be too large for the stack
+		for(done = 0; done < param_meta.size[index]; done += length)
+		{
+			length = param_meta.size[index] - done;
+			if(length > (int) sizeof(chunk)) length = sizeof(chunk);
+			read_value(&param_seq_p[index], (uint8_t *) param_meta.value[index] + done, length, chunk);
+			if(memcmp(param_shadow_p + offset + done, chunk, length) == 0) continue;
+			memcpy(param_shadow_p + offset + done, chunk, length);
+			mark_param_dirty(&param_table_p[index]);
+		}
+		offset+=param_meta.size[index];
+	}
+}
+
+
+// Get the sequence counter of a param, NULL if the handle is not in the table
+static inline volatile uint32_t * get_param_seq(param_handle_t param_h)
+{
+	if(param_seq_p == NULL || param_h < param_table_p || param_h >= param_table_p + param_table_size_v) return NULL;
+	return &param_seq_p[param_h - param_table_p];
+}
+
+
+// Wait while a param is busy, spin first and then sleep to let the writer run
+static inline void param_seq_wait(uint32_t * spins)
+{
+	if(++(*spins) < CONF_PARAM_SEQ_SPINS) return;
+	*spins = 0;
+	csp_sleep_ms(1);
+}
+
+
+// Begin writing a param, the counter becomes odd. Only waits for other writers
+static uint32_t param_write_begin(volatile uint32_t * seq)
+{
+	uint32_t start, spins = 0;
+	while(1)
+	{
+		start = *seq;
+		// Take the param if no other writer has it, the swap is a full barrier
+		if(!(start & 1) && __sync_bool_compare_and_swap(seq, start, start + 1)) return start;
+		param_seq_wait(&spins);
+	}
+}
+
+
+// End writing a param, the counter becomes even again
+static inline void param_write_end(volatile uint32_t * seq)
+{
+	__sync_fetch_and_add(seq, 1);
+}
+
+
+// Copy a value, retry if a writer changed it meanwhile
+static void read_value(volatile uint32_t * seq, const void * value, size_t size, void * out_p)
+{
+	uint32_t start, spins = 0;
+	if(seq == NULL)
+	{
+		memcpy(out_p, value, size);
+		return;
+	}
+	while(1)
+	{
+		start = *seq;
+		if(!(start & 1))
+		{
+			__sync_synchronize();
+			memcpy(out_p, value, size);
+			__sync_synchronize();
+			// Consistent if no writer started meanwhile
+			if(*seq == start) return;
+		}
+		param_seq_wait(&spins);
+	}
+}
+
+
+// Copy the value of a param
+static void read_param_value(param_handle_t param_h, void * out_p)
+{
+	read_value(get_param_seq(param_h), param_h->value, param_h->size, out_p);
+}
+
+
+// Copy the value of a param by the index, only with the hot metadata
+static void read_param_index(int index, void * out_p)
+{
+	read_value(&param_seq_p[index], param_meta.value[index], param_meta.size[index], out_p);
+}
+
+
+// Write the value of a param by the index, ignoring READ_ONLY option
+static void write_param_index(int index, const void * in_p)
+{
+	param_write_begin(&param_seq_p[index]);
+	memcpy(param_meta.value[index], in_p, param_meta.size[index]);
+	param_write_end(&param_seq_p[index]);
+	mark_param_written(index);
+	if(param_table_p[index].opts & DEPENDENCY) invalidate_derived_params(index);
+}
+
+
+// Write part of the value of a param, from offset, store and notify it if changed
+static int write_param_bytes(param_handle_t param_h, size_t offset, size_t length, const void * in_p)
+{
+	int changed, notify;
+	volatile uint32_t * seq;
+	param_change_t change;
+	// Check if param has READ_ONLY option
+	if(param_h->opts & READ_ONLY) return EXIT_SUCCESS;
+	// Hardware backed params are written through, derived params are computed
+	if(param_h->opts & BACKED) return write_backed_param(param_h, offset, length, in_p);
+	if(param_h->opts & DERIVED) return EXIT_SUCCESS;
+	notify = (param_h->opts & SUBSCRIBED) && param_notify_queue != NULL;
+	seq = get_param_seq(param_h);
+	if(seq != NULL) param_write_begin(seq);
+	// If the value does not change there is nothing to do
+	changed = (memcmp( (uint8_t *) param_h->value + offset, in_p, length) != 0);
+	if(changed)
+	{
+		// Keep the old value for subscribers, events carry the first bytes of the value
+		if(notify)
+		{
+			change.size = (param_h->size < CONF_PARAM_EVENT_VALUE_SIZE) ? param_h->size : CONF_PARAM_EVENT_VALUE_SIZE;
+			memcpy(change.old_value, param_h->value, change.size);
+		}
+		// Write param value to mem position
+		memcpy( (uint8_t *) param_h->value + offset, in_p, length);
+		if(notify) memcpy(change.new_value, param_h->value, change.size);
+	}
+	if(seq != NULL) param_write_end(seq);
+	if(!changed) return EXIT_SUCCESS;
+	// Copy it into the next snapshot
+	if(seq != NULL) mark_param_written(param_h - param_table_p);
+	// Mark the param to be stored
+	if(param_h->opts & PERSISTENT) mark_param_dirty(param_h);
+	// Derived params computed from it are computed again
+	if(param_h->opts & DEPENDENCY) invalidate_derived_params(param_h - param_table_p);
+	// Notify subscribers, never wait for the queue
+	if(notify)
+	{
+		change.index = param_h - param_table_p;
+		if(csp_queue_enqueue(param_notify_queue, (void*) &change, 0) != CSP_QUEUE_OK) param_notify_dropped++;
+	}
+	return EXIT_SUCCESS;
+}
+
+
+// Set the value of a Parameter
+int set_param_val(param_handle_t param_h, void * in_p)
+{
+	if (param_h==NULL || param_h->value==NULL || in_p==NULL ) return EXIT_FAILURE;
+	count_param_write(param_h - param_table_p);
+	return write_param_bytes(param_h, 0, param_h->size, in_p);
+}
+
+
+// Set some elements of an array Parameter
+int param_set_elems(param_handle_t param_h, uint16_t first, uint16_t count, const void * in_p)
+{
+	uint16_t elem_size = param_elem_size(param_h);
+	if (elem_size == 0 || param_h->value==NULL || in_p==NULL ) return EXIT_FAILURE;
+	if((uint32_t) first + count > param_h->size / elem_size) return EXIT_FAILURE;
+	count_param_write(param_h - param_table_p);
+	return write_param_bytes(param_h, (size_t) first * elem_size, (size_t) count * elem_size, in_p);
+}
+
+
+// Get some elements of an array Parameter, only the slice is copied
+int param_get_elems(param_handle_t param_h, uint16_t first, uint16_t count, void * out_p)
+{
+	int exit_status = param_get_elems_uncounted(param_h, first, count, out_p);
+	if(exit_status == EXIT_SUCCESS) count_param_read(param_h - param_table_p);
+	return exit_status;
+}
+
+
+// Get some elements of a Parameter, for the framework, not counted
+int param_get_elems_uncounted(param_handle_t param_h, uint16_t first, uint16_t count, void * out_p)
+{
+	int exit_status = EXIT_SUCCESS;
+	uint16_t elem_size = param_elem_size(param_h);
+	if (elem_size == 0 || param_h->value==NULL || out_p==NULL ) return EXIT_FAILURE;
+	if((uint32_t) first + count > param_h->size / elem_size) return EXIT_FAILURE;
+	if(param_h->opts & DERIVED) exit_status = refresh_derived_param(param_h - param_table_p);
+	read_value(get_param_seq(param_h), (uint8_t *) param_h->value + (size_t) first * elem_size, (size_t) count * elem_size, out_p);
+	return exit_status;
+}
+
+
+
+// Take a snapshot, copy the params written since the last one, again if written meanwhile
+int param_snapshot_take(void)
+{
+	#if CONF_PARAM_SNAPSHOT == ENABLE
+	int tries, word, words, index;
+	uint32_t bits, writes, bulk, spins = 0;
+	if(param_snapshot.values == NULL) return EXIT_FAILURE;
+	csp_mutex_lock(&param_snapshot_mutex, CSP_MAX_DELAY);
+	words = (param_table_size_v + 31) / 32;
+	for(tries = 0; tries < CONF_PARAM_SNAPSHOT_RETRIES; tries++)
+	{
+		// Wait for a bulk set to finish
+		while((bulk = param_bulk_seq) & 1) param_seq_wait(&spins);
+		writes = param_write_count;
+		__sync_synchronize();
+		for(word = 0; word < words; word++)
+		{
+			// Take the changed bits, a write from now on sets them again
+			bits = __sync_fetch_and_and(&param_snapshot.changed[word], 0) | param_snapshot.vars[word];
+			while(bits != 0)
+			{
+				index = (word << 5) + __builtin_ctz(bits);
+				bits &= bits - 1;
+				read_param_index(index, param_snapshot.values + param_snapshot.offset[index]);
+			}
+		}
+		__sync_synchronize();
+		// Point-in-time copy if no write nor bulk set happened meanwhile
+		if(param_write_count == writes && param_bulk_seq == bulk) return EXIT_SUCCESS;
+	}
+	#if CONF_PARAM_DEBUG == ENABLE
+	print_debug("PARAM>\tSnapshot taken while params were written\n");
+	#endif
+	return EXIT_SUCCESS;
+	#else
+	return EXIT_FAILURE;
+	#endif
+}
+
+
+// Get the value of a param from the snapshot, or from the param if no snapshot
+int param_snapshot_get(param_index_t index, void * out_p)
+{
+	if(index < 0 || index >= param_table_size_v || out_p == NULL) return EXIT_FAILURE;
+	if(param_snapshot.values == NULL) read_param_index(index, out_p);
+	else memcpy(out_p, param_snapshot.values + param_snapshot.offset[index], param_meta.size[index]);
+	return EXIT_SUCCESS;
+}
+
+
+void param_snapshot_release(void)
+{
+	#if CONF_PARAM_SNAPSHOT == ENABLE
+	if(param_snapshot.values != NULL) csp_mutex_unlock(&param_snapshot_mutex);
+	#endif
+}
+
+
+
+// Get the size of the values of several params
+int param_get_many_size(const param_index_t * indexes, uint16_t count)
+{
+	int i, size = 0;
+	if(indexes == NULL || param_table_p == NULL) return -1;
+	for(i = 0; i < count; i++)
+	{
+		if(indexes[i] < 0 || indexes[i] >= param_table_size_v) return -1;
+		size += param_meta.size[indexes[i]];
+	}
+	return size;
+}
+
+
+// Get the values of several params, retry if a bulk set changed them meanwhile
+int param_get_many(const param_index_t * indexes, uint16_t count, void * out_buff, size_t buff_size)
+{
+	int i, size, offset;
+	uint32_t start, spins = 0;
+	size = param_get_many_size(indexes, count);
+	if(size < 0 || out_buff == NULL || (size_t) size > buff_size) return -1;
+	for(i = 0; i < count; i++)
+	{
+		count_param_read(indexes[i]);
+		if(param_table_p[indexes[i]].opts & DERIVED) refresh_derived_param(indexes[i]);
+	}
+	while(1)
+	{
+		start = param_bulk_seq;
+		if(!(start & 1))
+		{
+			__sync_synchronize();
+			offset = 0;
+			for(i = 0; i < count; i++)
+			{
+				read_param_index(indexes[i], (uint8_t *) out_buff + offset);
+				offset += param_meta.size[indexes[i]];
+			}
+			__sync_synchronize();
+			// Consistent if no bulk set started meanwhile
+			if(param_bulk_seq == start) return size;
+		}
+		param_seq_wait(&spins);
+	}
+}
+
+
+// Set the values of several params, as a whole for param_get_many()
+// Hardware backed params are written through first, without locks, if one fails nothing is set
+int param_set_many(const param_index_t * indexes, uint16_t count, const void * in_buff, size_t in_size)
+{
+	int i, j, size, offset, exit_status;
+	param_derived_t * derived;
+	// Check everything before writing anything
+	size = param_get_many_size(indexes, count);
+	if(size < 0 || in_buff == NULL || (size_t) size != in_size) return EXIT_FAILURE;
+	for(i = 0; i < count; i++)
+	{
+		if((param_table_p[indexes[i]].opts & READ_ONLY) || (param_table_p[indexes[i]].opts & (DERIVED|BACKED)) == DERIVED) return EXIT_FAILURE;
+	}
+	// Write through the hardware backed params
+	offset = 0;
+	for(i = 0; i < count; i++)
+	{
+		if(param_table_p[indexes[i]].opts & BACKED)
+		{
+			if((derived = get_param_derived(indexes[i])) == NULL || derived->store == NULL) exit_status = EXIT_FAILURE;
+			else
+			{
+				take_backed_param(derived);
+				exit_status = derived->store(&param_table_p[indexes[i]], (uint8_t *) in_buff + offset, derived->ctx);
+				give_backed_param(derived);
+			}
+			// The hardware of the params stored before has the new value, fetch it on the next read
+			if(exit_status != EXIT_SUCCESS)
+			{
+				for(j = 0; j <= i; j++)
+				{
+					if((param_table_p[indexes[j]].opts & BACKED) && (derived = get_param_derived(indexes[j])) != NULL) derived->valid = 0;
+				}
+				return EXIT_FAILURE;
+			}
+		}
+		offset += param_meta.size[indexes[i]];
+	}
+	// Each value is written as with set_param_val(), to be stored and notified
+	param_write_begin(&param_bulk_seq);
+	offset = 0;
+	for(i = 0; i < count; i++)
+	{
+		if(param_table_p[indexes[i]].opts & BACKED)
+		{
+			count_param_write(indexes[i]);
+			publish_backed_param(indexes[i], get_param_derived(indexes[i]), (uint8_t *) in_buff + offset, EXIT_SUCCESS);
+		}
+		else set_param_val(&param_table_p[indexes[i]], (uint8_t *) in_buff + offset);
+		offset += param_meta.size[indexes[i]];
+	}
+	param_write_end(&param_bulk_seq);
+	return EXIT_SUCCESS;
+}
+
+
+
+// Call the subscribers of a param
+// Subscribers are copied first, so callbacks may subscribe and unsubscribe
+static void deliver_param_change(const param_change_t * change)
+{
+	int i, subscribers = 0;
+	param_handle_t param_h = get_param_handle_by_index(change->index);
+	if(param_h == NULL) return;
+	csp_mutex_lock(&param_subscriptions_mutex, CSP_MAX_DELAY);
+	for(i = 0; i < CONF_PARAM_MAX_SUBSCRIPTIONS; i++)
+	{
+		if(param_subscriptions[i].callback == NULL || param_subscriptions[i].index != change->index) continue;
+		param_notify_subscribers[subscribers++] = param_subscriptions[i];
+	}
+	csp_mutex_unlock(&param_subscriptions_mutex);
+	for(i = 0; i < subscribers; i++)
+	{
+		param_notify_subscribers[i].callback(param_h, change, param_notify_subscribers[i].ctx);
+	}
+}
+
+
+// Param Notification Task, delivers param changes in batches
+CSP_DEFINE_TASK( param_notify_task )
+{
+	int i, events;
+	param_handle_t param_h;
+	while(1)
+	{
+		// Sleep until a param changes
+		if(csp_queue_dequeue(param_notify_queue, (void*) &param_notify_batch[0], CSP_MAX_DELAY) != CSP_QUEUE_OK) continue;
+		events = 1;
+		// Take the other pending changes, merge changes of the same param
+		while(events < CONF_PARAM_NOTIFY_BATCH_SIZE && csp_queue_dequeue(param_notify_queue, (void*) &param_notify_batch[events], 0) == CSP_QUEUE_OK)
+		{
+			for(i = 0; i < events; i++)
+			{
+				if(param_notify_batch[i].index == param_notify_batch[events].index) break;
+			}
+			if(i < events) memcpy(param_notify_batch[i].new_value, param_notify_batch[events].new_value, param_notify_batch[events].size);
+			else events++;
+		}
+		for(i = 0; i < events; i++)
+		{
+			// Skip if the value ended as it was, only known if the event has the whole value
+			param_h = get_param_handle_by_index(param_notify_batch[i].index);
+			if(param_h != NULL && param_h->size == param_notify_batch[i].size &&
+			   memcmp(param_notify_batch[i].old_value, param_notify_batch[i].new_value, param_notify_batch[i].size) == 0) continue;
+			deliver_param_change(&param_notify_batch[i]);
+		}
+	}
+	return CSP_TASK_RETURN;
+}
+
+
+int init_param_notifications(void)
+{
+	if(param_notify_queue != NULL) return EXIT_SUCCESS;
+	if(csp_mutex_create(&param_subscriptions_mutex) != CSP_MUTEX_OK) return EXIT_FAILURE;
+	param_notify_queue = csp_queue_create(CONF_PARAM_NOTIFY_QUEUE_SIZE, sizeof(param_change_t));
+	if(param_notify_queue == NULL) return EXIT_FAILURE;
+	return csp_thread_create(param_notify_task, "PARAM_NOTIFY_TASK", CONF_PARAM_NOTIFY_TASK_STACK_SIZE, NULL, CONF_PARAM_NOTIFY_TASK_PRIORITY, &handle_param_notify_task);
+}
+
+
+int param_subscribe(param_handle_t param_h, param_callback_t callback, void * ctx)
+{
+	int i, exit_status = EXIT_FAILURE;
+	if(param_notify_queue == NULL || callback == NULL || get_param_seq(param_h) == NULL) return EXIT_FAILURE;
+	csp_mutex_lock(&param_subscriptions_mutex, CSP_MAX_DELAY);
+	// Take a free entry
+	for(i = 0; i < CONF_PARAM_MAX_SUBSCRIPTIONS; i++)
+	{
+		if(param_subscriptions[i].callback != NULL) continue;
+		param_subscriptions[i].index = param_h - param_table_p;
+		param_subscriptions[i].ctx = ctx;
+		param_subscriptions[i].callback = callback;
+		// Writers of the param now send changes
+		__sync_fetch_and_or(&param_h->opts, SUBSCRIBED);
+		exit_status = EXIT_SUCCESS;
+		break;
+	}
+	csp_mutex_unlock(&param_subscriptions_mutex);
+	return exit_status;
+}
+
+
+int param_unsubscribe(param_handle_t param_h, param_callback_t callback, void * ctx)
+{
+	int i, exit_status = EXIT_FAILURE, remaining = 0;
+	param_index_t index;
+	if(param_notify_queue == NULL || get_param_seq(param_h) == NULL) return EXIT_FAILURE;
+	index = param_h - param_table_p;
+	csp_mutex_lock(&param_subscriptions_mutex, CSP_MAX_DELAY);
+	for(i = 0; i < CONF_PARAM_MAX_SUBSCRIPTIONS; i++)
+	{
+		if(param_subscriptions[i].callback == NULL || param_subscriptions[i].index != index) continue;
+		if(exit_status != EXIT_SUCCESS && param_subscriptions[i].callback == callback && param_subscriptions[i].ctx == ctx)
+		{
+			param_subscriptions[i].callback = NULL;
+			exit_status = EXIT_SUCCESS;
+		}
+		else remaining++;
+	}
+	// Writers stop sending changes if nobody listens
+	if(remaining == 0) __sync_fetch_and_and(&param_h->opts, (uint8_t) ~SUBSCRIBED);
+	csp_mutex_unlock(&param_subscriptions_mutex);
+	return exit_status;
+}
+
+
+
+// Find how a derived param is computed, NULL if it is not derived
+static param_derived_t * get_param_derived(int index)
+{
+	int i;
+	for(i = 0; i < CONF_PARAM_MAX_DERIVED; i++)
+	{
+		if(param_derived[i].compute != NULL && param_derived[i].index == index) return &param_derived[i];
+	}
+	return NULL;
+}
+
+
+// Check if the cached value of a derived param can be read
+static inline int is_derived_fresh(const param_derived_t * derived)
+{
+	if(!derived->valid) return 0;
+	// Without TTL only a dependency invalidates it, without both it is computed on every read
+	if(derived->ttl_ms == 0) return derived->deps_num != 0;
+	return time_since_boot_ms() - derived->computed_ms < derived->ttl_ms;
+}
+
+
+// Buffer for a whole value, parsed or computed, the chunk on the stack if the value fits, allocated otherwise
+static inline uint8_t * get_param_staging(param_handle_t param_handle, uint8_t * chunk)
+{
+	if(param_handle->size <= PARAM_CHUNK_SIZE) return chunk;
+	return csp_malloc(param_handle->size);
+}
+
+
+// Free a buffer of get_param_staging()
+static inline void free_param_staging(uint8_t * staging, uint8_t * chunk)
+{
+	if(staging != chunk) csp_free(staging);
+}
+
+
+// Compute or fetch a derived param if the cached value is not fresh, other readers wait meanwhile
+// The value is computed without the sequence lock, and published under it at once
+// Returns -1 if it could not, the last value is kept
+// Only a value changed by a successful compute is marked as written, and dirty if PERSISTENT
+static int refresh_derived_param(int index)
+{
+	int exit_status, changed = 0;
+	uint8_t chunk[PARAM_CHUNK_SIZE] __attribute__((aligned(8)));
+	uint8_t * staging;
+	uint32_t spins = 0;
+	uint16_t size = param_meta.size[index];
+	param_derived_t * derived = get_param_derived(index);
+	if(derived == NULL || is_derived_fresh(derived)) return EXIT_SUCCESS;
+	// Another reader computes it, wait for its value
+	if(!__sync_bool_compare_and_swap(&derived->computing, 0, 1))
+	{
+		while(derived->computing) param_seq_wait(&spins);
+		return derived->valid ? EXIT_SUCCESS : EXIT_FAILURE;
+	}
+	if((staging = get_param_staging(&param_table_p[index], chunk)) == NULL)
+	{
+		derived->computing = 0;
+		return EXIT_FAILURE;
+	}
+	// Start from the last value, compute may keep part of it
+	read_param_index(index, staging);
+	// Valid from now, a dependency written while computing invalidates it again
+	derived->valid = 1;
+	__sync_synchronize();
+	exit_status = derived->compute(&param_table_p[index], staging, derived->ctx);
+	if(exit_status == EXIT_SUCCESS)
+	{
+		param_write_begin(&param_seq_p[index]);
+		changed = (memcmp(param_meta.value[index], staging, size) != 0);
+		if(changed) memcpy(param_meta.value[index], staging, size);
+		param_write_end(&param_seq_p[index]);
+		derived->computed_ms = time_since_boot_ms();
+	}
+	else derived->valid = 0;
+	free_param_staging(staging, chunk);
+	__sync_synchronize();
+	derived->computing = 0;
+	#if CONF_PARAM_DEBUG == ENABLE
+	if(exit_status != EXIT_SUCCESS)
+	{
+		print_debug("PARAM>\tCould not compute or fetch param: ");
+		print_debug(param_name(index));
+		print_debug("\n");
+	}
+	#endif
+	if(!changed) return exit_status;
+	mark_param_written(index);
+	if(param_table_p[index].opts & PERSISTENT) mark_param_dirty(&param_table_p[index]);
+	return exit_status;
+}
+
+
+// Take a hardware backed param, to fetch or store it alone. Waits for other readers and writers
+static void take_backed_param(param_derived_t * derived)
+{
+	uint32_t spins = 0;
+	while(!__sync_bool_compare_and_swap(&derived->computing, 0, 1)) param_seq_wait(&spins);
+}
+
+
+// Give a hardware backed param taken by take_backed_param()
+static inline void give_backed_param(param_derived_t * derived)
+{
+	__sync_synchronize();
+	derived->computing = 0;
+}
+
+
+// Publish the value written through by a store, if the hardware failed the cache is invalid
+// so the next read fetches what the hardware has
+static void publish_backed_param(int index, param_derived_t * derived, const void * value, int exit_status)
+{
+	if(exit_status == EXIT_SUCCESS)
+	{
+		param_write_begin(&param_seq_p[index]);
+		memcpy(param_meta.value[index], value, param_meta.size[index]);
+		param_write_end(&param_seq_p[index]);
+		// The value written is what the hardware has now
+		derived->computed_ms = time_since_boot_ms();
+		derived->valid = 1;
+		mark_param_written(index);
+		if(param_table_p[index].opts & PERSISTENT) mark_param_dirty(&param_table_p[index]);
+	}
+	else
+	{
+		derived->valid = 0;
+		#if CONF_PARAM_DEBUG == ENABLE
+		print_debug("PARAM>\tCould not write through param: ");
+		print_debug(param_name(index));
+		print_debug("\n");
+		#endif
+	}
+	if(param_table_p[index].opts & DEPENDENCY) invalidate_derived_params(index);
+}
+
+
+// Write part of a hardware backed param, the whole value is written through
+// The store is called without the sequence lock, readers get the cached value meanwhile
+static int write_backed_param(param_handle_t param_h, size_t offset, size_t length, const void * in_p)
+{
+	int exit_status, index = param_h - param_table_p;
+	uint8_t chunk[PARAM_CHUNK_SIZE] __attribute__((aligned(8)));
+	uint8_t * staging;
+	param_derived_t * derived = get_param_derived(index);
+	if(derived == NULL || derived->store == NULL) return EXIT_FAILURE;
+	if((staging = get_param_staging(param_h, chunk)) == NULL) return EXIT_FAILURE;
+	take_backed_param(derived);
+	// The whole value, with the part written
+	read_param_index(index, staging);
+	memcpy(staging + offset, in_p, length);
+	exit_status = derived->store(param_h, staging, derived->ctx);
+	publish_backed_param(index, derived, staging, exit_status);
+	give_backed_param(derived);
+	free_param_staging(staging, chunk);
+	return exit_status;
+}
+
+
+// Invalidate the derived params computed from a param
+static void invalidate_derived_params(int index)
+{
+	int i, dep;
+	for(i = 0; i < CONF_PARAM_MAX_DERIVED; i++)
+	{
+		if(param_derived[i].compute == NULL) continue;
+		for(dep = 0; dep < param_derived[i].deps_num; dep++)
+		{
+			if(param_derived[i].deps[dep] == index) param_derived[i].valid = 0;
+		}
+	}
+}
+
+
+// Check if a derived param is computed from a param
+static int is_param_dependency(int index)
+{
+	int i, dep;
+	for(i = 0; i < CONF_PARAM_MAX_DERIVED; i++)
+	{
+		if(param_derived[i].compute == NULL) continue;
+		for(dep = 0; dep < param_derived[i].deps_num; dep++)
+		{
+			if(param_derived[i].deps[dep] == index) return 1;
+		}
+	}
+	return 0;
+}
+
+
+// Clear the DEPENDENCY option of the params in deps no derived param is computed from anymore
+static void clear_unused_dependencies(const param_index_t * deps, uint8_t deps_num)
+{
+	int i;
+	for(i = 0; i < deps_num; i++)
+	{
+		if(!is_param_dependency(deps[i])) __sync_fetch_and_and(&param_table_p[deps[i]].opts, (uint8_t) ~DEPENDENCY);
+	}
+}
+
+
+// Compute the derived TELEMETRY params before a beacon is collected, only those of tables with TELEMETRY on
+static void refresh_derived_telemetry(void)
+{
+	int i;
+	for(i = next_param_pos(TELEMETRY, 0); i < param_meta.telemetry_num; i = next_param_pos(TELEMETRY, i + 1))
+	{
+		if(param_table_p[param_meta.telemetry[i]].opts & DERIVED) refresh_derived_param(param_meta.telemetry[i]);
+	}
+}
+
+
+// Set how a param is computed or fetched when read, and written through if store
+static int set_param_provider(param_handle_t param_h, param_compute_t compute, param_store_t store, void * ctx, uint32_t ttl_ms, const param_index_t * deps, uint8_t deps_num)
+{
+	int i, index;
+	const param_index_t * old_deps = NULL;
+	uint8_t old_deps_num = 0;
+	param_derived_t * derived;
+	if(get_param_seq(param_h) == NULL || (deps == NULL && deps_num != 0)) return EXIT_FAILURE;
+	index = param_h - param_table_p;
+	for(i = 0; i < deps_num; i++)
+	{
+		if(deps[i] < 0 || deps[i] >= param_table_size_v || deps[i] == index) return EXIT_FAILURE;
+	}
+	derived = get_param_derived(index);
+	// Make it a plain param again, keeps the last value
+	if(compute == NULL)
+	{
+		if(derived == NULL) return EXIT_SUCCESS;
+		__sync_fetch_and_and(&param_h->opts, (uint8_t) ~(DERIVED|BACKED));
+		derived->compute = NULL;
+		clear_unused_dependencies(derived->deps, derived->deps_num);
+		return EXIT_SUCCESS;
+	}
+	// Dependencies of the previous compute, if derived already
+	if(derived != NULL)
+	{
+		old_deps = derived->deps;
+		old_deps_num = derived->deps_num;
+	}
+	// Take a free entry if not derived yet
+	for(i = 0; derived == NULL && i < CONF_PARAM_MAX_DERIVED; i++)
+	{
+		if(param_derived[i].compute == NULL) derived = &param_derived[i];
+	}
+	if(derived == NULL) return EXIT_FAILURE;
+	derived->index = index;
+	derived->store = store;
+	derived->ctx = ctx;
+	derived->ttl_ms = ttl_ms;
+	derived->deps = deps;
+	derived->deps_num = deps_num;
+	derived->valid = 0;
+	derived->computing = 0;
+	__sync_synchronize();
+	derived->compute = compute;
+	// Writers of the dependencies now invalidate it, readers compute it
+	for(i = 0; i < deps_num; i++) __sync_fetch_and_or(&param_table_p[deps[i]].opts, DEPENDENCY);
+	clear_unused_dependencies(old_deps, old_deps_num);
+	// Writes go through store if any, otherwise are ignored
+	if(store != NULL) __sync_fetch_and_or(&param_h->opts, BACKED);
+	else __sync_fetch_and_and(&param_h->opts, (uint8_t) ~BACKED);
+	__sync_fetch_and_or(&param_h->opts, DERIVED);
+	return EXIT_SUCCESS;
+}
+
+
+int param_set_derived(param_handle_t param_h, param_compute_t compute, void * ctx, uint32_t ttl_ms, const param_index_t * deps, uint8_t deps_num)
+{
+	return set_param_provider(param_h, compute, NULL, ctx, ttl_ms, deps, deps_num);
+}
+
+
+int param_set_backed(param_handle_t param_h, param_compute_t fetch, param_store_t store, void * ctx, uint32_t max_age_ms)
+{
+	if(fetch == NULL && store != NULL) return EXIT_FAILURE;
+	return set_param_provider(param_h, fetch, store, ctx, max_age_ms, NULL, 0);
+}
+
+// Get the value of a Parameter
+int get_param_val(param_handle_t param_h, void * out_p)
+{
+	int exit_status = EXIT_SUCCESS;
+	if (param_h==NULL || param_h->value==NULL || out_p==NULL) return EXIT_FAILURE;
+	count_param_read(param_h - param_table_p);
+	if(param_h->opts & DERIVED) exit_status = refresh_derived_param(param_h - param_table_p);
+	read_param_value(param_h, out_p);
+	return exit_status;
+}
+
+
+
+// Get amount of params stored id table
+uint16_t get_table_size(void)
+{
+	return param_table_size_v;
+}
+
+
+
+// Conversion of an element of a param value to string and back, one pair of functions per type
+typedef struct
+{
+	int (*to_str)(const void * value, char* out_buff, int buff_size);	// Returns length of the string, -1 if error
+	int (*from_str)(const char* in_buff, void * value);				// Returns chars consumed, -1 if error
+} param_type_ops_t;
+
+
+// Skip white-space
+static const char * skip_space(const char * in_buff)
+{
+	while(*in_buff == ' ' || (*in_buff >= '\t' && *in_buff <= '\r')) in_buff++;
+	return in_buff;
+}
+
+// Define the conversions of an unsigned type, write_fun is the sfsf_conv.h function for the width
+#define PARAM_UINT_OPS(suffix, c_type, max, write_fun)										\
+static int suffix##_to_str(const void * value, char* out_buff, int buff_size)				\
+{																							\
+	c_type param_value;																		\
+	memcpy(&param_value, value, sizeof(param_value));										\
+	return write_fun(param_value, out_buff, buff_size);										\
+}																							\
+static int suffix##_from_str(const char* in_buff, void * value)							\
+{																							\
+	uint64_t parsed;																		\
+	c_type param_value;																		\
+	int consumed = conv_str_to_uint(in_buff, max, &parsed);									\
+	if(consumed < 0) return -1;																\
+	param_value = (c_type) parsed;															\
+	memcpy(value, &param_value, sizeof(param_value));										\
+	return consumed;																		\
+}
+
+// Define the conversions of a signed type
+#define PARAM_INT_OPS(suffix, c_type, min, max, write_fun)									\
+static int suffix##_to_str(const void * value, char* out_buff, int buff_size)				\
+{																							\
+	c_type param_value;																		\
+	memcpy(&param_value, value, sizeof(param_value));										\
+	return write_fun(param_value, out_buff, buff_size);										\
+}																							\
+static int suffix##_from_str(const char* in_buff, void * value)							\
+{																							\
+	int64_t parsed;																			\
+	c_type param_value;																		\
+	int consumed = conv_str_to_int(in_buff, min, max, &parsed);								\
+	if(consumed < 0) return -1;																\
+	param_value = (c_type) parsed;															\
+	memcpy(value, &param_value, sizeof(param_value));										\
+	return consumed;																		\
+}
+
+// Define the conversions of a floating point type
+#define PARAM_FLOAT_OPS(suffix, c_type, write_fun, parse_fun)								\
+static int suffix##_to_str(const void * value, char* out_buff, int buff_size)				\
+{																							\
+	c_type param_value;																		\
+	memcpy(&param_value, value, sizeof(param_value));										\
+	return write_fun(param_value, out_buff, buff_size);										\
+}																							\
+static int suffix##_from_str(const char* in_buff, void * value)							\
+{																							\
+	c_type param_value;																		\
+	int consumed = parse_fun(in_buff, &param_value);										\
+	if(consumed < 0) return -1;																\
+	memcpy(value, &param_value, sizeof(param_value));										\
+	return consumed;																		\
+}
+
+PARAM_UINT_OPS(u8,		uint8_t,	UINT8_MAX,				conv_u32_to_str)
+PARAM_INT_OPS(i8,		int8_t,		INT8_MIN,	INT8_MAX,	conv_i32_to_str)
+PARAM_UINT_OPS(u16,		uint16_t,	UINT16_MAX,				conv_u32_to_str)
+PARAM_INT_OPS(i16,		int16_t,	INT16_MIN,	INT16_MAX,	conv_i32_to_str)
+PARAM_UINT_OPS(u32,		uint32_t,	UINT32_MAX,				conv_u32_to_str)
+PARAM_INT_OPS(i32,		int32_t,	INT32_MIN,	INT32_MAX,	conv_i32_to_str)
+PARAM_UINT_OPS(u64,		uint64_t,	UINT64_MAX,				conv_u64_to_str)
+PARAM_INT_OPS(i64,		int64_t,	INT64_MIN,	INT64_MAX,	conv_i64_to_str)
+PARAM_FLOAT_OPS(float,	float,		conv_float_to_str,		conv_str_to_float)
+PARAM_FLOAT_OPS(double,	double,		conv_double_to_str,		conv_str_to_double)
+
+
+// Conversions indexed by param_type_t, strings are converted as a whole
+static const param_type_ops_t param_type_ops[] =
+{
+	[UINT8_PARAM]	= { u8_to_str,		u8_from_str },
+	[INT8_PARAM]	= { i8_to_str,		i8_from_str },
+	[UINT16_PARAM]	= { u16_to_str,		u16_from_str },
+	[INT16_PARAM]	= { i16_to_str,		i16_from_str },
+	[UINT32_PARAM]	= { u32_to_str,		u32_from_str },
+	[INT32_PARAM]	= { i32_to_str,		i32_from_str },
+	[UINT64_PARAM]	= { u64_to_str,		u64_from_str },
+	[INT64_PARAM]	= { i64_to_str,		i64_from_str },
+	[FLOAT_PARAM]	= { float_to_str,	float_from_str },
+	[DOUBLE_PARAM]	= { double_to_str,	double_from_str },
+};
+
+
+// Terminate a string value of length bytes copied in out_buff, it may fill the whole length without null-character
+// Returns the length of the string, -1 if the string and the null-character do not fit in buff_size
+static int terminate_string(char* out_buff, int length, int buff_size)
+{
+	int len = strnlen(out_buff, length);
+	if(len >= buff_size)
+	{
+		out_buff[buff_size - 1] = '\0';
+		return -1;
+	}
+	out_buff[len] = '\0';
+	return len;
+}
+
+
+// Copy a string param straight into out_buff, only the bytes that fit
+static int string_to_str(param_handle_t param_handle, char* out_buff, int buff_size)
+{
+	int length;
+	if(buff_size < 1) return -1;
+	length = (param_handle->size < buff_size) ? param_handle->size : buff_size;
+	if(param_get_elems_uncounted(param_handle, 0, length, out_buff) != EXIT_SUCCESS) return -1;
+	return terminate_string(out_buff, length, buff_size);
+}
+
+
+// Set a string param at once, readers never see part of the new string
+static int string_from_str(param_handle_t param_handle, char* in_buff)
+{
+	uint8_t chunk[PARAM_CHUNK_SIZE];
+	uint8_t * staging;
+	size_t len;
+	int exit_status;
+	// The value may fill the whole size, without null-character
+	len = strlen(in_buff);
+	if(len > param_handle->size) return EXIT_FAILURE;
+	if((staging = get_param_staging(param_handle, chunk)) == NULL) return EXIT_FAILURE;
+	// Clear the unused chars, so they do not count as a change
+	memcpy(staging, in_buff, len);
+	bzero(staging + len, param_handle->size - len);
+	exit_status = param_set_elems(param_handle, 0, param_handle->size, staging);
+	free_param_staging(staging, chunk);
+	return exit_status;
+}
+
+
+// Append elements of a param, from first, to out_buff at *len, separated by PARAM_ARRAY_SEPARATOR
+// Fails when an element does not fit, out_buff keeps the elements before it
+static int append_elems_str(param_handle_t param_handle, const uint8_t * elems, uint16_t first, uint16_t count, char* out_buff, int buff_size, int * len)
+{
+	uint16_t i, elem_size;
+	int written, sep;
+	elem_size = param_elem_size(param_handle);
+	for(i = 0; i < count; i++)
+	{
+		// Separator and element, or nothing if both do not fit
+		sep = (first + i > 0);
+		if(*len + sep >= buff_size) return EXIT_FAILURE;
+		if(sep) out_buff[*len] = PARAM_ARRAY_SEPARATOR;
+		written = param_type_ops[param_handle->type].to_str(elems + i * elem_size, out_buff + *len + sep, buff_size - *len - sep);
+		if(written < 0)
+		{
+			out_buff[*len] = '\0';
+			return EXIT_FAILURE;
+		}
+		*len += sep + written;
+	}
+	return EXIT_SUCCESS;
+}
+
+
+// Write the elements of a param, fails if not all fit in out_buff
+// Elements are read by chunks, arrays up to PARAM_CHUNK_SIZE bytes are read at once
+static int elems_to_str(param_handle_t param_handle, char* out_buff, int buff_size)
+{
+	uint8_t chunk[PARAM_CHUNK_SIZE] __attribute__((aligned(8)));
+	uint16_t count, chunk_elems, first;
+	int len = 0;
+	count = param_elem_count(param_handle);
+	chunk_elems = sizeof(chunk) / param_elem_size(param_handle);
+	for(first = 0; first < count; first += chunk_elems)
+	{
+		if(chunk_elems > count - first) chunk_elems = count - first;
+		param_get_elems_uncounted(param_handle, first, chunk_elems, chunk);
+		if(append_elems_str(param_handle, chunk, first, chunk_elems, out_buff, buff_size, &len) != EXIT_SUCCESS) return -1;
+	}
+	return len;
+}
+
+
+// Parse the elements of a param separated by PARAM_ARRAY_SEPARATOR into elems
+// Returns the count of elements, -1 if the string is not a valid value for the type
+static int elems_from_str(param_handle_t param_handle, const char* in_buff, uint8_t * elems)
+{
+	uint16_t elem_size, count, n;
+	int consumed;
+	elem_size = param_elem_size(param_handle);
+	count = param_elem_count(param_handle);
+	for(n = 0; n < count; n++)
+	{
+		consumed = param_type_ops[param_handle->type].from_str(in_buff, elems + n * elem_size);
+		if(consumed < 0) return -1;
+		in_buff = skip_space(in_buff + consumed);
+		if(*in_buff == '\0') return n + 1;
+		if(*in_buff != PARAM_ARRAY_SEPARATOR) return -1;
+		in_buff++;
+	}
+	// More elements than the param has
+	return -1;
+}
+
+
+
+// Store the value of a param as string in a buffer
+int param_to_str(param_handle_t param_handle, char* out_buff, int buff_size)
+{
+	int exit_status;
+	// Check param_handle exists
+	if(param_handle == NULL || param_handle->value == NULL) return EXIT_FAILURE;
+	if(param_handle->opts & DERIVED) refresh_derived_param(param_handle - param_table_p);
+	// Check the type is known
+	if(param_elem_size(param_handle) == 0)
+	{
+		snprintf(out_buff, buff_size, "unknown_type");
+		return EXIT_FAILURE;
+	}
+	if(param_handle->type == STRING_PARAM) exit_status = string_to_str(param_handle, out_buff, buff_size);
+	else exit_status = elems_to_str(param_handle, out_buff, buff_size);
+	// Conversions return the length of the string if success, an empty string is a valid value
+	if(exit_status >= 0)	return EXIT_SUCCESS;
+	return EXIT_FAILURE;
+}
+
+
+
+
+// Convert a string to the type of the param, and store it in the param value space
+int str_to_param(param_handle_t param_handle, char* in_buff)
+{
+	uint8_t chunk[PARAM_CHUNK_SIZE] __attribute__((aligned(8)));
+	uint8_t * staging;
+	int count, exit_status;
+	// Check param_handle exists
+	if(param_handle == NULL || param_handle->value == NULL) return EXIT_FAILURE;
+	// Check the type is known
+	if(param_elem_size(param_handle) == 0 || in_buff == NULL) return EXIT_FAILURE;
+	if(param_handle->type == STRING_PARAM) return string_from_str(param_handle, in_buff);
+	// Parse all elements before setting any, then set them at once
+	if((staging = get_param_staging(param_handle, chunk)) == NULL) return EXIT_FAILURE;
+	count = elems_from_str(param_handle, skip_space(in_buff), staging);
+	exit_status = (count > 0) ? param_set_elems(param_handle, 0, count, staging) : EXIT_FAILURE;
+	free_param_staging(staging, chunk);
+	return exit_status;
+}
+
+
+
+// Store the value of a param as string, from the snapshot if taken
+static int param_index_to_str(int index, char* out_buff, int buff_size)
+{
+	int len = 0;
+	param_handle_t param_handle = &param_table_p[index];
+	const uint8_t * value;
+	if(param_snapshot.values == NULL) return param_to_str(param_handle, out_buff, buff_size);
+	value = param_snapshot.values + param_snapshot.offset[index];
+	if(param_handle->type == STRING_PARAM)
+	{
+		if(buff_size < 1) return EXIT_FAILURE;
+		len = (param_handle->size < buff_size) ? param_handle->size : buff_size;
+		memcpy(out_buff, value, len);
+		len = terminate_string(out_buff, len, buff_size);
+	}
+	else if(append_elems_str(param_handle, value, 0, param_elem_count(param_handle), out_buff, buff_size, &len) != EXIT_SUCCESS) len = -1;
+	return (len >= 0) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+
+
+// Report a typed accessor used with a param of other type
+int param_type_mismatch(param_handle_t param_h, param_type_t type)
+{
+	#if CONF_PARAM_DEBUG == ENABLE
+	print_debug("PARAM>\tTyped accessor used with param of other type: ");
+	print_debug(param_h == NULL ? "NULL" : param_h->name);
+	print_debug(", expected type ");
+	print_debug_uint(type);
+	if(param_h != NULL)
+	{
+		print_debug(", param type ");
+		print_debug_uint(param_h->type);
+	}
+	print_debug("\n");
+	#else
+	(void) param_h;
+	(void) type;
+	#endif
+	return EXIT_FAILURE;
+}
+
+
+
+
+// Take an id and calculates the corresponding TAG, store the TAG in dest_buff
+// e.g.: 0 = A, 1 = B, 25 = Z, 26 = AA, 27 = AB, ..., 701 = ZZ, 702 = AAA, ...
+void get_tag(int id, char* dest_buff, int buff_size)
+{
+	#define ALPHA_DELTA  26 // Letters in alphabet
+	int buff_index,i;
+	char aux_buffer[buff_size];
+	buff_index = 0;
+	// While digits form id left, and room for the null char
+	while(buff_index < buff_size - 1)
+	{
+		// Last char of TAG is ( id MOD 26 ) + 'A'
+		aux_buffer[buff_index] = ((id) % ALPHA_DELTA) + 'A';
+		// Increment buffer index
+		buff_index++;
+		// For the following id = id/26 - 1, there is no zero digit, after Z goes AA
+		id = id / ALPHA_DELTA - 1;
+		// Repeat until no digits left
+		if(id < 0) break;
+	}
+	// Invert aux_buff an thats the TAG
+	for(i= 0; 0 < buff_index; i++)
+	{
+		buff_index--;
+		// Invert position on index
+		dest_buff[i] = aux_buffer[buff_index];
+	}
+	dest_buff[i] = '\0';
+
+	return;
+}
+
+//Collect all params with TEMELETRY option and store the value with a tag into dest_buff
+void collect_telemetry_params(char * dest_buff, size_t buff_size)
+{
+	int i, tag_id;
+	size_t dest_len, tag_len, value_pos;
+	// buff to store the tag, start by A, max ZZZ
+	char tag_buff[4];
+	tag_id=0;
+	// Keep the length of dest_buff, to append without scanning it again
+	dest_len = strlen(dest_buff);
+	// All values from the same point in time
+	refresh_derived_telemetry();
+	param_snapshot_take();
+	// get next param with TELEMETRY option, of the tables with TELEMETRY on
+	for(i = next_param_pos(TELEMETRY, 0); i < param_meta.telemetry_num; i = next_param_pos(TELEMETRY, i + 1))
+	{
+		// Clear buffer
+		bzero(tag_buff, sizeof(tag_buff));
+		// Generate TAG
+		get_tag(tag_id, tag_buff, sizeof(tag_buff));
+		tag_len = strlen(tag_buff);
+		// The value goes after the ',' separator (except if first), the TAG and ':'
+		value_pos = dest_len + (dest_len != 0) + tag_len + 1;
+		if(value_pos >= buff_size) break;
+		// Store the value from param as str straight in dest_buff, stop if it does not fit
+		if(param_index_to_str(param_meta.telemetry[i], dest_buff + value_pos, buff_size - value_pos) != EXIT_SUCCESS)
+		{
+			dest_buff[dest_len] = '\0';
+			break;
+		}
+		// Separate by comma, except if first
+		if(dest_len != 0) dest_buff[dest_len++] = ',';
+		// Append TAG
+		memcpy(dest_buff+dest_len, tag_buff, tag_len);
+		dest_len+=tag_len;
+		// Append ':' separator
+		dest_buff[dest_len++] = ':';
+		// The value is already in place
+		dest_len += strlen(dest_buff+dest_len);
+		tag_id++;
+	}
+	param_snapshot_release();
+}
+
+
+
+// Collect all params with TEMELETRY option into dest_buff as a binary beacon
+void collect_telemetry_params_bin(char * dest_buff, size_t buff_size)
+{
+	int i, index;
+	size_t offset;
+	uint16_t params_num;
+	beacon_header_t header;
+	const uint16_t endian_test = 1;
+	if(dest_buff == NULL || buff_size < sizeof(header)) return;
+	// Values go after the header
+	offset = sizeof(header);
+	params_num = 0;
+	// All values from the same point in time
+	refresh_derived_telemetry();
+	param_snapshot_take();
+	for(i = next_param_pos(TELEMETRY, 0); i < param_meta.telemetry_num; i = next_param_pos(TELEMETRY, i + 1))
+	{
+		index = param_meta.telemetry[i];
+		// Check if enough space in dest_buff for the value
+		if(offset + param_meta.size[index] > buff_size) break;
+		// Copy the value straight into the beacon
+		param_snapshot_get(index, dest_buff + offset);
+		offset+=param_meta.size[index];
+		params_num++;
+	}
+	param_snapshot_release();
+	// Fill the header
+	header.marker = BEACON_BINARY_MARKER;
+	header.flags = (*(const uint8_t *) &endian_test) ? BEACON_FLAG_LE : 0;
+	header.params_num = csp_hton16(params_num);
+	header.length = csp_hton16(offset - sizeof(header));
+	header.schema = csp_hton32(telemetry_schema);
+	memcpy(dest_buff, &header, sizeof(header));
+}
+
+
+
+// Collect some params into dest_buff as a binary beacon
+void collect_params_bin(const param_index_t * indexes, uint16_t count, char * dest_buff, size_t buff_size)
+{
+	int i, index;
+	size_t offset;
+	uint16_t params_num;
+	beacon_header_t header;
+	const uint16_t endian_test = 1;
+	if(dest_buff == NULL || buff_size < sizeof(header) || param_get_many_size(indexes, count) < 0) return;
+	offset = sizeof(header);
+	params_num = 0;
+	for(i = 0; i < count; i++)
+	{
+		if(param_table_p[indexes[i]].opts & DERIVED) refresh_derived_param(indexes[i]);
+	}
+	// All values from the same point in time
+	param_snapshot_take();
+	for(i = 0; i < count; i++)
+	{
+		index = indexes[i];
+		if(offset + param_meta.size[index] > buff_size) break;
+		param_snapshot_get(index, dest_buff + offset);
+		offset+=param_meta.size[index];
+		params_num++;
+	}
+	param_snapshot_release();
+	header.marker = BEACON_BINARY_MARKER;
+	header.flags = (*(const uint8_t *) &endian_test) ? BEACON_FLAG_LE : 0;
+	header.params_num = csp_hton16(params_num);
+	header.length = csp_hton16(offset - sizeof(header));
+	header.schema = csp_hton32(calc_params_schema(indexes, count));
+	memcpy(dest_buff, &header, sizeof(header));
+}
+
+
+#if CONF_PARAM_DELTA == ENABLE
+// Find the deadband of a float param, 0 if none
+static double get_param_deadband(int index)
+{
+	int i;
+	for(i = 0; i < CONF_PARAM_MAX_DEADBANDS; i++)
+	{
+		if(param_deadbands[i].deadband != 0 && param_deadbands[i].index == index) return param_deadbands[i].deadband;
+	}
+	return 0;
+}
+
+
+// Check if a TELEMETRY param should be sent in a delta beacon, its value against the last sent
+static int is_delta_changed(int index, const uint8_t * last, const uint8_t * value)
+{
+	int i;
+	float last_f, value_f;
+	double deadband, last_d, value_d;
+	if(memcmp(last, value, param_meta.size[index]) == 0) return 0;
+	if(param_meta.type[index] != FLOAT_PARAM && param_meta.type[index] != DOUBLE_PARAM) return 1;
+	if((deadband = get_param_deadband(index)) == 0) return 1;
+	// Changed if any element moved more than the deadband, values may be unaligned in the beacon
+	for(i = 0; i < param_meta.size[index]; i += param_type_size[param_meta.type[index]])
+	{
+		if(param_meta.type[index] == FLOAT_PARAM)
+		{
+			memcpy(&last_f, last + i, sizeof(last_f));
+			memcpy(&value_f, value + i, sizeof(value_f));
+			last_d = last_f;
+			value_d = value_f;
+		}
+		else
+		{
+			memcpy(&last_d, last + i, sizeof(last_d));
+			memcpy(&value_d, value + i, sizeof(value_d));
+		}
+		// NaN compares false, a NaN or from NaN is a change
+		if(!(value_d - last_d <= deadband && last_d - value_d <= deadband)) return 1;
+	}
+	return 0;
+}
+#endif
+
+
+// Collect the params with TELEMETRY option changed since the last delta beacon
+void collect_telemetry_params_delta(char * dest_buff, size_t buff_size)
+{
+	#if CONF_PARAM_DELTA == ENABLE
+	int i, index, keyframe, complete;
+	size_t offset, last_offset, bitmap_size;
+	uint16_t params_num;
+	uint8_t * bitmap;
+	beacon_header_t header;
+	const uint16_t endian_test = 1;
+	if(dest_buff == NULL || telemetry_delta_p == NULL) return;
+	// The bitmap has a bit for each TELEMETRY param of the tables with TELEMETRY on
+	params_num = 0;
+	for(i = next_param_pos(TELEMETRY, 0); i < param_meta.telemetry_num; i = next_param_pos(TELEMETRY, i + 1)) params_num++;
+	bitmap_size = (params_num + 7) / 8;
+	if(buff_size < sizeof(header) + 1 + bitmap_size) return;
+	bitmap = (uint8_t *) dest_buff + sizeof(header) + 1;
+	bzero(bitmap, bitmap_size);
+	// Keyframe periodically, or if the TELEMETRY params changed
+	keyframe = (telemetry_delta_count == 0 || telemetry_delta_schema != telemetry_schema);
+	telemetry_delta_schema = telemetry_schema;
+	// Values go after the bitmap
+	offset = sizeof(header) + 1 + bitmap_size;
+	last_offset = 0;
+	params_num = 0;
+	complete = 1;
+	// All values from the same point in time
+	refresh_derived_telemetry();
+	param_snapshot_take();
+	for(i = next_param_pos(TELEMETRY, 0); i < param_meta.telemetry_num; i = next_param_pos(TELEMETRY, i + 1), params_num++)
+	{
+		index = param_meta.telemetry[i];
+		// A value that does not fit is not sent, neither taken as sent
+		if(offset + param_meta.size[index] <= buff_size)
+		{
+			// Copy the value straight into the beacon, keep it only if it changed
+			param_snapshot_get(index, dest_buff + offset);
+			if(keyframe || is_delta_changed(index, telemetry_delta_p + last_offset, (uint8_t *) dest_buff + offset))
+			{
+				memcpy(telemetry_delta_p + last_offset, dest_buff + offset, param_meta.size[index]);
+				bitmap[params_num >> 3] |= 1 << (params_num & 7);
+				offset+=param_meta.size[index];
+			}
+		}
+		else complete = 0;
+		last_offset+=param_meta.size[index];
+	}
+	param_snapshot_release();
+	// A keyframe without all the values is not one, the next beacon is a keyframe again
+	if(keyframe && !complete)
+	{
+		keyframe = 0;
+		telemetry_delta_count = 0;
+	}
+	else if(++telemetry_delta_count >= CONF_PARAM_DELTA_KEYFRAME_PERIOD) telemetry_delta_count = 0;
+	// Fill the header and the sequence number
+	header.marker = BEACON_BINARY_MARKER;
+	header.flags = ((*(const uint8_t *) &endian_test) ? BEACON_FLAG_LE : 0) | BEACON_FLAG_DELTA | (keyframe ? BEACON_FLAG_KEYFRAME : 0);
+	header.params_num = csp_hton16(params_num);
+	header.length = csp_hton16(offset - sizeof(header));
+	header.schema = csp_hton32(telemetry_schema);
+	memcpy(dest_buff, &header, sizeof(header));
+	dest_buff[sizeof(header)] = telemetry_delta_seq++;
+	#else
+	(void) dest_buff;
+	(void) buff_size;
+	#endif
+}
+
+
+void param_delta_keyframe(void)
+{
+	telemetry_delta_count = 0;
+}
+
+
+int param_set_deadband(param_handle_t param_h, double deadband)
+{
+	int i, index, free_entry = -1;
+	if(get_param_seq(param_h) == NULL || (param_h->type != FLOAT_PARAM && param_h->type != DOUBLE_PARAM) || deadband < 0) return EXIT_FAILURE;
+	index = param_h - param_table_p;
+	for(i = 0; i < CONF_PARAM_MAX_DEADBANDS; i++)
+	{
+		// Change the deadband if it has one, 0 frees the entry
+		if(param_deadbands[i].deadband != 0 && param_deadbands[i].index == index)
+		{
+			param_deadbands[i].deadband = deadband;
+			return EXIT_SUCCESS;
+		}
+		if(param_deadbands[i].deadband == 0 && free_entry < 0) free_entry = i;
+	}
+	if(deadband == 0) return EXIT_SUCCESS;
+	if(free_entry < 0) return EXIT_FAILURE;
+	param_deadbands[free_entry].index = index;
+	param_deadbands[free_entry].deadband = deadband;
+	return EXIT_SUCCESS;
+}
+
+// Get the hash of the TELEMETRY params definition
+uint32_t get_telemetry_schema(void)
+{
+	return telemetry_schema;
+}
+
+
+
+// Collect the references between TAG and params with TELEMETRY option into dest_buff
+int collect_telemtry_header(char * dest_buff, int buff_size)
+{
+	int i, tag_id;
+	const char * name;
+	// buff to store the tag, start by A, max ZZZ
+	char tag_buff[4];
+	tag_id=0;
+	// get next param with TELEMETRY option, of the tables with TELEMETRY on
+	for(i = next_param_pos(TELEMETRY, 0); i < param_meta.telemetry_num; i = next_param_pos(TELEMETRY, i + 1))
+	{
+		// Clear buffers
+		bzero(tag_buff, sizeof(tag_buff));
+		// Generate TAG
+		get_tag(tag_id, tag_buff, sizeof(tag_buff));
+		// Name of the param, from the name pool
+		name = param_name(param_meta.telemetry[i]);
+		// Check if enough space in dest_buff (enough for tag + param + ':' + ',')
+		if(strlen(dest_buff)+strlen(tag_buff)+strlen(name)+2 >= buff_size) break;
+		// Separate by comma, except if first
+		if(strlen(dest_buff) != 0) strcat(dest_buff,   "," );
+		// Concatenate  TAG
+		strcat(dest_buff,  tag_buff );
+		// Concatenate ':' separator
+		strcat(dest_buff, ":");
+		// Concatenate param name
+		strcat(dest_buff, name);
+		tag_id++;
+	}
+	// Not all the references fit
+	if(i < param_meta.telemetry_num) return -1;
+	return strlen(dest_buff);
+}
+
+
+
+
+// Print the param table, for debug
+void print_pram_table(void)
+{
+	int i;
+	char param_list_buff[CONF_PARAM_MAX_PARAM_SIZE];
+	print_debug("\n-----------------------------------------\n");
+	print_debug(" Param Name\t\t| Param Value\n");
+	print_debug("-----------------------------------------\n");
+	// get next param handle
+	for(i = 0; i < param_table_size_v; i++ )
+	{
+		// Clear buffer
+		bzero(param_list_buff, sizeof(param_list_buff));
+		// Print name
+		print_debug(param_name(i));
+		print_debug("\t\t| ");
+		// Convert param value to str and store it in buff
+		param_to_str(&param_table_p[i], param_list_buff, sizeof(param_list_buff));
+		// Print param value
+		print_debug(param_list_buff);
+		print_debug("\n");
+	}
+	print_debug("-----------------------------------------\n");
+
+}
+
+
+// Print where the value of each param is, for debug
+void print_param_layout(void)
+{
+	int i;
+	print_debug("\n-----------------------------------------\n");
+	print_debug(" Param Name\t\t| Offset\t| Size\n");
+	print_debug("-----------------------------------------\n");
+	for(i = 0; i < param_table_size_v; i++ )
+	{
+		print_debug(param_name(i));
+		print_debug("\t\t| ");
+		// Parameterized variables are not in param space
+		if(is_parameterized(i)) print_debug("var");
+		else print_debug_uint((uint8_t *) param_meta.value[i] - (uint8_t *) param_space_p);
+		print_debug("\t| ");
+		print_debug_uint(param_meta.size[i]);
+		print_debug("\n");
+	}
+	print_debug("-----------------------------------------\n");
+	print_debug("Values: ");
+	print_debug_uint(param_space_size_v);
+	print_debug(" bytes, RAM used: ");
+	print_debug_uint(param_ram_bytes);
+	print_debug(" bytes\n");
+}
+
+
+// Get the access statistics of a param
+int param_get_stats(param_index_t index, param_stats_t * stats)
+{
+	#if CONF_PARAM_STATS == ENABLE
+	if(index < 0 || index >= param_table_size_v || stats == NULL || param_stats_p == NULL) return EXIT_FAILURE;
+	*stats = param_stats_p[index];
+	return EXIT_SUCCESS;
+	#else
+	(void) index;
+	(void) stats;
+	return EXIT_FAILURE;
+	#endif
+}
+
+
+// Get the names not found by the lookup functions
+uint32_t param_get_lookup_misses(void)
+{
+	#if CONF_PARAM_STATS == ENABLE
+	return param_lookup_misses;
+	#else
+	return 0;
+	#endif
+}
+
+
+// Clear the access statistics
+void param_reset_stats(void)
+{
+	#if CONF_PARAM_STATS == ENABLE
+	if(param_stats_p != NULL) bzero(param_stats_p, param_table_size_v * sizeof(param_stats_t));
+	param_lookup_misses = 0;
+	#endif
+}
+
+
+// Print the access statistics of each param, for debug
+void print_param_stats(void)
+{
+	#if CONF_PARAM_STATS == ENABLE
+	int i;
+	if(param_stats_p == NULL) return;
+	print_debug("\n-----------------------------------------\n");
+	print_debug(" Param Name\t\t| Reads\t| Writes\t| Last Write\t| Lookups\n");
+	print_debug("-----------------------------------------\n");
+	for(i = 0; i < param_table_size_v; i++ )
+	{
+		print_debug(param_name(i));
+		print_debug("\t\t| ");
+		print_debug_uint(param_stats_p[i].reads);
+		print_debug("\t| ");
+		print_debug_uint(param_stats_p[i].writes);
+		print_debug("\t| ");
+		print_debug_uint(param_stats_p[i].last_write_s);
+		print_debug("\t| ");
+		print_debug_uint(param_stats_p[i].lookups);
+		print_debug("\n");
+	}
+	print_debug("-----------------------------------------\n");
+	print_debug("Lookups not found: ");
+	print_debug_uint(param_lookup_misses);
+	print_debug("\n");
+	#else
+	print_debug("PARAM>\tAccess statistics disabled, see CONF_PARAM_STATS\n");
+	#endif
+}
+
+
+csp_thread_handle_t get_param_task_handle(void)
+{
+	return handle_param_service_task;
+}
@@ -1,61 +1,786 @@
-/*
-Copyright 2018 olmanqj
-Permission is hereby granted, free of charge, to any person obtaining a copy of
-this software and associated documentation files (the "Software"), to deal in
-the Software without restriction, including without limitation the rights to
-use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
-of the Software, and to permit persons to whom the Software is furnished to do
-so, subject to the following conditions:
-
-The above copyright notice and this permission notice shall be included in all
-copies or substantial portions of the Software.
-
-THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
-IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
-FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
-AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
-LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
-OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
-SOFTWARE.
- */
- 
-#include <stdlib.h>
-#include <sfsf_port.h>
-
-
-
-int file_open(FILE_T * fp, const char *path, FILE_MODE_T mode)
-{
-	extern int file_open_port(FILE_T * fp, const char *path, FILE_MODE_T mode) __attribute__((__weak__));
-	if(file_open_port) return file_open_port(fp, path, mode);
-	else return -1;
-}
-
-int file_close(FILE_T * fp)
-{
-	extern int file_close_port(FILE_T * fp) __attribute__((__weak__));
-	if(file_close_port) return file_close_port(fp);
-	else return -1;
-}
-
-char * file_read(FILE_T * fp, char * buff,  int len)
-{
-	extern char * file_read_port( FILE_T * fp, char * buff,  int len) __attribute__((__weak__));
-	if(file_read_port) return file_read_port(fp, buff,  len);
-	else return NULL;
-}
-
-int file_write( FILE_T* fp , const char* str )
-{
-	extern int file_write_port( FILE_T* fp, const char* str ) __attribute__((__weak__));
-	if(file_write_port) return file_write_port( fp, str );
-	else return -1;
-}
-
-
-int file_remove(const char *path)
-{
-	extern int file_remove_port( const char* path ) __attribute__((__weak__));
-	if(file_remove_port) return file_remove_port(  path );
-	else return -1;
-}
+/*
+Copyright 2018 olmanqj
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+of the Software, and to permit persons to whom the Software is furnished to do
+so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+ */
+ 
+#include <stdlib.h>
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+#include <stdio.h>
+#include <csp/csp.h>
+#include <sfsf_port.h>
+#include <sfsf_storage.h>
+#include <sfsf_time.h>
+
+
+
+int file_open(FILE_T * fp, const char *path, FILE_MODE_T mode)
+{
+	extern int file_open_port(FILE_T * fp, const char *path, FILE_MODE_T mode) __attribute__((__weak__));
+	if(file_open_port) return file_open_port(fp, path, mode);
+	else return -1;
+}
+
+int file_close(FILE_T * fp)
+{
+	extern int file_close_port(FILE_T * fp) __attribute__((__weak__));
+	if(file_close_port) return file_close_port(fp);
+	else return -1;
+}
+
+char * file_read(FILE_T * fp, char * buff,  int len)
+{
+	extern char * file_read_port( FILE_T * fp, char * buff,  int len) __attribute__((__weak__));
+	if(file_read_port) return file_read_port(fp, buff,  len);
+	else return NULL;
+}
+
+int file_write( FILE_T* fp , const char* str )
+{
+	extern int file_write_port( FILE_T* fp, const char* str ) __attribute__((__weak__));
+	if(file_write_port) return file_write_port( fp, str );
+	else return -1;
+}
+
+int file_write_bin( FILE_T* fp, const void* data, size_t len )
+{
+	extern int file_write_bin_port( FILE_T* fp, const void* data, size_t len ) __attribute__((__weak__));
+	if(file_write_bin_port) return file_write_bin_port( fp, data, len );
+	else return -1;
+}
+
+int file_read_bin( FILE_T* fp, void* buff, size_t len )
+{
+	extern int file_read_bin_port( FILE_T* fp, void* buff, size_t len ) __attribute__((__weak__));
+	if(file_read_bin_port) return file_read_bin_port( fp, buff, len );
+	else return -1;
+}
+
+int file_seek( FILE_T* fp, uint32_t offset )
+{
+	extern int file_seek_port( FILE_T* fp, uint32_t offset ) __attribute__((__weak__));
+	if(file_seek_port) return file_seek_port( fp, offset );
+	else return -1;
+}
+
+int file_sync( FILE_T* fp )
+{
+	extern int file_sync_port( FILE_T* fp ) __attribute__((__weak__));
+	if(file_sync_port) return file_sync_port( fp );
+	else return -1;
+}
+
+
+int file_remove(const char *path)
+{
+	extern int file_remove_port( const char* path ) __attribute__((__weak__));
+	if(file_remove_port) return file_remove_port(  path );
+	else return -1;
+}
+
+
+
+// CRC-32 (IEEE 802.3, same as zlib), with a table of 16 entries, one nibble at the time
+uint32_t storage_crc32(uint32_t crc, const void * data, size_t len)
+{
+	static const uint32_t crc_nibble_table[16] = {
+		0x00000000, 0x1DB71064, 0x3B6E20C8, 0x26D930AC, 0x76DC4190, 0x6B6B51F4, 0x4DB26158, 0x5005713C,
+		0xEDB88320, 0xF00F9344, 0xD6D6A3E8, 0xCB61B38C, 0x9B64C2B0, 0x86D3D2D4, 0xA00AE278, 0xBDBDF21C
+	};
+	const uint8_t * data_p = (const uint8_t *) data;
+	crc = ~crc;
+	while(len--)
+	{
+		crc = (crc >> 4) ^ crc_nibble_table[(crc ^ *data_p) & 0x0F];
+		crc = (crc >> 4) ^ crc_nibble_table[(crc ^ (*data_p >> 4)) & 0x0F];
+		data_p++;
+	}
+	return ~crc;
+}
+
+
+
+int storage_writer_init(storage_writer_t * writer, const char * path, char * buff, size_t buff_size, uint32_t flush_ms, uint32_t sync_ms)
+{
+	if(writer == NULL || path == NULL || buff == NULL || buff_size == 0) return EXIT_FAILURE;
+	memset(writer, 0, sizeof(*writer));
+	writer->path = path;
+	writer->buff = buff;
+	writer->buff_size = buff_size;
+	writer->flush_ms = flush_ms;
+	writer->sync_ms = sync_ms;
+	writer->synced_ms = time_since_boot_ms();
+	return EXIT_SUCCESS;
+}
+
+
+// Write bytes into the file, opened if not yet
+static int storage_writer_put(storage_writer_t * writer, const void * data, size_t len)
+{
+	// Into the circular file, a chunk
+	if(writer->ring != NULL)
+	{
+		if(len > UINT16_MAX) return EXIT_FAILURE;
+		writer->writes++;
+		writer->unsynced = 1;
+		return storage_ring_write(writer->ring, data, len);
+	}
+	if(!writer->opened)
+	{
+		if(file_open(&writer->fd, writer->path, FILE_APPEND) != 0) return EXIT_FAILURE;
+		writer->opened = 1;
+	}
+	writer->writes++;
+	writer->unsynced = 1;
+	if(file_write_bin(&writer->fd, data, len) != (int) len)
+	{
+		// Reopen it the next time, the file may be recovered
+		file_close(&writer->fd);
+		writer->opened = 0;
+		return EXIT_FAILURE;
+	}
+	return EXIT_SUCCESS;
+}
+
+
+// Sync the file, if asked or if the data written is older than sync_ms
+static int storage_writer_sync(storage_writer_t * writer, uint8_t sync)
+{
+	if(!writer->unsynced || !writer->opened) return EXIT_SUCCESS;
+	if(!sync && writer->sync_ms > 0 && time_since_boot_ms() - writer->synced_ms < writer->sync_ms) return EXIT_SUCCESS;
+	writer->syncs++;
+	writer->unsynced = 0;
+	writer->synced_ms = time_since_boot_ms();
+	if(writer->ring != NULL) return storage_ring_sync(writer->ring);
+	return (file_sync(&writer->fd) == 0) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+
+int storage_writer_flush(storage_writer_t * writer, uint8_t sync)
+{
+	int ret = EXIT_SUCCESS;
+	if(writer == NULL || writer->buff == NULL) return EXIT_FAILURE;
+	if(writer->used > 0)
+	{
+		ret = storage_writer_put(writer, writer->buff, writer->used);
+		// The buffer is emptied anyway, not to keep the records forever if the file can not be written
+		if(ret != EXIT_SUCCESS) writer->dropped++;
+		writer->used = 0;
+	}
+	if(storage_writer_sync(writer, sync) != EXIT_SUCCESS) ret = EXIT_FAILURE;
+	return ret;
+}
+
+
+int storage_writer_write(storage_writer_t * writer, const void * data, size_t len)
+{
+	if(writer == NULL || writer->buff == NULL || data == NULL) return EXIT_FAILURE;
+	// Flush if it does not fit
+	if(writer->used + len > writer->buff_size && writer->used > 0)
+	{
+		if(storage_writer_flush(writer, 0) != EXIT_SUCCESS) return EXIT_FAILURE;
+	}
+	// Bigger than the buffer, write it directly
+	if(len > writer->buff_size)
+	{
+		if(storage_writer_put(writer, data, len) != EXIT_SUCCESS)
+		{
+			writer->dropped++;
+			return EXIT_FAILURE;
+		}
+		return storage_writer_sync(writer, 0);
+	}
+	if(writer->used == 0) writer->oldest_ms = time_since_boot_ms();
+	memcpy(writer->buff + writer->used, data, len);
+	writer->used += len;
+	return EXIT_SUCCESS;
+}
+
+
+int storage_writer_write_line(storage_writer_t * writer, const char * str)
+{
+	if(str == NULL) return EXIT_FAILURE;
+	if(storage_writer_write(writer, str, strlen(str)) != EXIT_SUCCESS) return EXIT_FAILURE;
+	return storage_writer_write(writer, "\n", 1);
+}
+
+
+uint32_t storage_writer_due_ms(const storage_writer_t * writer)
+{
+	uint32_t due = UINT32_MAX;
+	uint32_t elapsed;
+	if(writer == NULL) return due;
+	if(writer->used > 0)
+	{
+		elapsed = time_since_boot_ms() - writer->oldest_ms;
+		due = (elapsed < writer->flush_ms) ? writer->flush_ms - elapsed : 0;
+	}
+	if(writer->unsynced && writer->opened)
+	{
+		elapsed = time_since_boot_ms() - writer->synced_ms;
+		if(elapsed >= writer->sync_ms) due = 0;
+		else if(writer->sync_ms - elapsed < due) due = writer->sync_ms - elapsed;
+	}
+	return due;
+}
+
+
+int storage_writer_poll(storage_writer_t * writer)
+{
+	if(writer == NULL) return EXIT_FAILURE;
+	if(writer->used > 0 && time_since_boot_ms() - writer->oldest_ms >= writer->flush_ms) return storage_writer_flush(writer, 0);
+	return storage_writer_sync(writer, 0);
+}
+
+
+int storage_writer_close(storage_writer_t * writer)
+{
+	int ret;
+	if(writer == NULL) return EXIT_FAILURE;
+	ret = storage_writer_flush(writer, 1);
+	// The circular file is closed by its owner
+	if(writer->opened && writer->ring == NULL)
+	{
+		if(file_close(&writer->fd) != 0) ret = EXIT_FAILURE;
+		writer->opened = 0;
+	}
+	return ret;
+}
+
+
+
+int storage_writer_set_ring(storage_writer_t * writer, storage_ring_t * ring)
+{
+	// A full buffer should fit in a chunk
+	if(writer == NULL || ring == NULL || !ring->opened || writer->buff_size > UINT16_MAX || sizeof(storage_ring_chunk_t) + writer->buff_size > ring->budget / 2) return EXIT_FAILURE;
+	writer->ring = ring;
+	writer->opened = 1;
+	return EXIT_SUCCESS;
+}
+
+
+
+// Offset of the data area in a circular file, after the two copies of the metadata
+#define RING_DATA_OFFSET			(2 * STORAGE_RING_META_SIZE)
+
+
+// Read or write bytes at an offset of the data area of a circular file, wrapping at its end
+static int ring_io(storage_ring_t * ring, uint32_t offset, void * data, uint32_t len, uint8_t write)
+{
+	uint32_t part;
+	while(len > 0)
+	{
+		offset %= ring->budget;
+		part = (len < ring->budget - offset) ? len : ring->budget - offset;
+		if(file_seek(&ring->fd, RING_DATA_OFFSET + offset) != 0) return EXIT_FAILURE;
+		if(write && file_write_bin(&ring->fd, data, part) != (int) part) return EXIT_FAILURE;
+		if(!write && file_read_bin(&ring->fd, data, part) != (int) part) return EXIT_FAILURE;
+		data = (uint8_t *) data + part;
+		offset += part;
+		len -= part;
+	}
+	return EXIT_SUCCESS;
+}
+
+
+// Write the metadata into the copy of its next sequence number, and sync the file
+static int ring_write_meta(storage_ring_t * ring)
+{
+	storage_ring_meta_t meta;
+	ring->seq++;
+	meta.magic = csp_hton32(STORAGE_RING_MAGIC);
+	meta.budget = csp_hton32(ring->budget);
+	meta.tail = csp_hton32(ring->tail);
+	meta.used = csp_hton32(ring->used);
+	meta.seq = csp_hton32(ring->seq);
+	meta.crc = csp_hton32(storage_crc32(0, &meta, offsetof(storage_ring_meta_t, crc)));
+	if(file_seek(&ring->fd, (ring->seq % 2) * STORAGE_RING_META_SIZE) != 0 || file_write_bin(&ring->fd, &meta, sizeof(meta)) != sizeof(meta)) return EXIT_FAILURE;
+	ring->dirty = 0;
+	return (file_sync(&ring->fd) == 0) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+
+// Read a copy of the metadata, -1 if not valid for this budget
+static int ring_read_meta(storage_ring_t * ring, uint8_t copy, storage_ring_meta_t * meta)
+{
+	if(file_seek(&ring->fd, copy * STORAGE_RING_META_SIZE) != 0 || file_read_bin(&ring->fd, meta, sizeof(*meta)) != sizeof(*meta)) return EXIT_FAILURE;
+	if(csp_ntoh32(meta->magic) != STORAGE_RING_MAGIC || csp_ntoh32(meta->crc) != storage_crc32(0, meta, offsetof(storage_ring_meta_t, crc))) return EXIT_FAILURE;
+	if(csp_ntoh32(meta->budget) != ring->budget || csp_ntoh32(meta->tail) >= ring->budget || csp_ntoh32(meta->used) > ring->budget) return EXIT_FAILURE;
+	return EXIT_SUCCESS;
+}
+
+
+int storage_ring_open(storage_ring_t * ring, const char * path, uint32_t budget)
+{
+	static const uint8_t zeros[256] = {0};
+	storage_ring_meta_t meta[2];
+	uint8_t valid[2];
+	uint32_t offset, part;
+	int copy;
+	if(ring == NULL || path == NULL || budget < 2 * sizeof(zeros)) return EXIT_FAILURE;
+	memset(ring, 0, sizeof(*ring));
+	ring->budget = budget;
+	// Existing file, take the newest valid copy of the metadata
+	if(file_open(&ring->fd, path, FILE_READ_WRITE) == 0)
+	{
+		ring->opened = 1;
+		valid[0] = (ring_read_meta(ring, 0, &meta[0]) == EXIT_SUCCESS);
+		valid[1] = (ring_read_meta(ring, 1, &meta[1]) == EXIT_SUCCESS);
+		if(valid[0] || valid[1])
+		{
+			if(valid[0] && valid[1]) copy = ((int32_t)(csp_ntoh32(meta[1].seq) - csp_ntoh32(meta[0].seq)) > 0) ? 1 : 0;
+			else copy = valid[1] ? 1 : 0;
+			ring->tail = csp_ntoh32(meta[copy].tail);
+			ring->used = csp_ntoh32(meta[copy].used);
+			ring->seq = csp_ntoh32(meta[copy].seq);
+			return EXIT_SUCCESS;
+		}
+		file_close(&ring->fd);
+		ring->opened = 0;
+	}
+	// New file, all its space allocated now
+	if(file_open(&ring->fd, path, FILE_READ_WRITE_CREATE) != 0) return EXIT_FAILURE;
+	ring->opened = 1;
+	for(offset = 0; offset < RING_DATA_OFFSET + budget; offset += part)
+	{
+		part = (RING_DATA_OFFSET + budget - offset < sizeof(zeros)) ? RING_DATA_OFFSET + budget - offset : sizeof(zeros);
+		if(file_write_bin(&ring->fd, zeros, part) != (int) part)
+		{
+			storage_ring_close(ring);
+			return EXIT_FAILURE;
+		}
+	}
+	return ring_write_meta(ring);
+}
+
+
+int storage_ring_write(storage_ring_t * ring, const void * data, uint16_t len)
+{
+	storage_ring_chunk_t chunk;
+	uint32_t size = sizeof(chunk) + len;
+	uint32_t reclaim, chunk_size;
+	if(ring == NULL || !ring->opened || data == NULL || len == 0 || size > ring->budget / 2) return EXIT_FAILURE;
+	// Reclaim the oldest chunks, a batch at a time, the metadata is synced before overwriting them
+	if(ring->used + size > ring->budget)
+	{
+		reclaim = ring->used + size - ring->budget;
+		if(reclaim < ring->budget / STORAGE_RING_RECLAIM_DIV) reclaim = ring->budget / STORAGE_RING_RECLAIM_DIV;
+		while(reclaim > 0 && ring->used > 0)
+		{
+			if(ring_io(ring, ring->tail, &chunk, sizeof(chunk), 0) != EXIT_SUCCESS) return EXIT_FAILURE;
+			chunk_size = sizeof(chunk) + csp_ntoh16(chunk.length);
+			// Corrupted chunk header, drop all
+			if(chunk_size > ring->used) chunk_size = ring->used;
+			ring->tail = (ring->tail + chunk_size) % ring->budget;
+			ring->used -= chunk_size;
+			ring->reclaimed += chunk_size;
+			reclaim = (chunk_size < reclaim) ? reclaim - chunk_size : 0;
+		}
+		if(ring_write_meta(ring) != EXIT_SUCCESS) return EXIT_FAILURE;
+	}
+	chunk.length = csp_hton16(len);
+	chunk.crc = csp_hton32(storage_crc32(0, data, len));
+	if(ring_io(ring, ring->tail + ring->used, &chunk, sizeof(chunk), 1) != EXIT_SUCCESS) return EXIT_FAILURE;
+	if(ring_io(ring, ring->tail + ring->used + sizeof(chunk), (void *) data, len, 1) != EXIT_SUCCESS) return EXIT_FAILURE;
+	ring->used += size;
+	ring->dirty = 1;
+	return EXIT_SUCCESS;
+}
+
+
+int storage_ring_sync(storage_ring_t * ring)
+{
+	if(ring == NULL || !ring->opened) return EXIT_FAILURE;
+	if(!ring->dirty) return EXIT_SUCCESS;
+	return ring_write_meta(ring);
+}
+
+
+int storage_ring_read(storage_ring_t * ring, uint32_t * pos, void * buff, size_t buff_size)
+{
+	storage_ring_chunk_t chunk;
+	uint16_t len;
+	if(ring == NULL || !ring->opened || pos == NULL || buff == NULL) return -1;
+	while(*pos + sizeof(chunk) <= ring->used)
+	{
+		if(ring_io(ring, ring->tail + *pos, &chunk, sizeof(chunk), 0) != EXIT_SUCCESS) return -1;
+		len = csp_ntoh16(chunk.length);
+		if(*pos + sizeof(chunk) + len > ring->used || len > buff_size) return -1;
+		if(ring_io(ring, ring->tail + *pos + sizeof(chunk), buff, len, 0) != EXIT_SUCCESS) return -1;
+		*pos += sizeof(chunk) + len;
+		// Written but not synced before a reset
+		if(storage_crc32(0, buff, len) != csp_ntoh32(chunk.crc)) continue;
+		return len;
+	}
+	return 0;
+}
+
+
+int storage_ring_close(storage_ring_t * ring)
+{
+	int ret;
+	if(ring == NULL || !ring->opened) return EXIT_FAILURE;
+	ret = storage_ring_sync(ring);
+	if(file_close(&ring->fd) != 0) ret = EXIT_FAILURE;
+	ring->opened = 0;
+	return ret;
+}
+
+
+
+// Offset of the footer in a segment file, the records end before it
+#define ARCHIVE_FOOTER_OFFSET(archive)		((archive)->segment_size - sizeof(storage_segment_footer_t))
+
+
+// Pathname of the segment file of a slot
+static void archive_segment_path(const storage_archive_t * archive, uint16_t slot, char * path)
+{
+	snprintf(path, STORAGE_ARCHIVE_PATH_SIZE, "%s%03u.seg", archive->prefix, slot);
+}
+
+
+// Copy a footer converting between host and network byte order, the same both ways
+static void archive_footer_order(storage_segment_footer_t * dest, const storage_segment_footer_t * src)
+{
+	int i;
+	for(i = 0; i < STORAGE_SEGMENT_INDEX_SIZE; i++)
+	{
+		dest->index[i].time_s = csp_hton32(src->index[i].time_s);
+		dest->index[i].offset = csp_hton32(src->index[i].offset);
+	}
+	dest->index_num = csp_hton16(src->index_num);
+	dest->seq = csp_hton32(src->seq);
+	dest->records = csp_hton32(src->records);
+	dest->first_s = csp_hton32(src->first_s);
+	dest->last_s = csp_hton32(src->last_s);
+	dest->end = csp_hton32(src->end);
+	dest->magic = csp_hton32(src->magic);
+	dest->crc = csp_hton32(src->crc);
+}
+
+
+// Read and check the footer of a segment file
+static int archive_read_footer(const storage_archive_t * archive, FILE_T * fd, storage_segment_footer_t * footer)
+{
+	storage_segment_footer_t raw;
+	if(file_seek(fd, ARCHIVE_FOOTER_OFFSET(archive)) != 0 || file_read_bin(fd, &raw, sizeof(raw)) != sizeof(raw)) return EXIT_FAILURE;
+	if(csp_ntoh32(raw.magic) != STORAGE_SEGMENT_MAGIC || csp_ntoh32(raw.crc) != storage_crc32(0, &raw, offsetof(storage_segment_footer_t, crc))) return EXIT_FAILURE;
+	archive_footer_order(footer, &raw);
+	if(footer->index_num > STORAGE_SEGMENT_INDEX_SIZE) return EXIT_FAILURE;
+	return EXIT_SUCCESS;
+}
+
+
+// Write the footer of a segment file, at the end of the segment
+static int archive_write_footer(const storage_archive_t * archive, const char * path, const storage_segment_footer_t * footer)
+{
+	int ret;
+	FILE_T fd;
+	storage_segment_footer_t raw;
+	archive_footer_order(&raw, footer);
+	raw.magic = csp_hton32(STORAGE_SEGMENT_MAGIC);
+	raw.crc = csp_hton32(storage_crc32(0, &raw, offsetof(storage_segment_footer_t, crc)));
+	if(file_open(&fd, path, FILE_READ_WRITE) != 0) return EXIT_FAILURE;
+	if(file_seek(&fd, ARCHIVE_FOOTER_OFFSET(archive)) == 0 && file_write_bin(&fd, &raw, sizeof(raw)) == sizeof(raw) && file_sync(&fd) == 0) ret = EXIT_SUCCESS;
+	else ret = EXIT_FAILURE;
+	file_close(&fd);
+	return ret;
+}
+
+
+// Add a record at offset to the footer of a segment, indexed if past next_index
+static void archive_add_record(const storage_archive_t * archive, storage_segment_footer_t * footer, uint32_t * next_index, uint32_t time_s, uint32_t offset, uint16_t len)
+{
+	if(offset >= *next_index && footer->index_num < STORAGE_SEGMENT_INDEX_SIZE)
+	{
+		footer->index[footer->index_num].time_s = time_s;
+		footer->index[footer->index_num].offset = offset;
+		footer->index_num++;
+		// An entry every 1/STORAGE_SEGMENT_INDEX_SIZE of the segment
+		*next_index = offset + (ARCHIVE_FOOTER_OFFSET(archive) - sizeof(storage_segment_header_t)) / STORAGE_SEGMENT_INDEX_SIZE;
+	}
+	if(footer->records == 0) footer->first_s = time_s;
+	footer->last_s = time_s;
+	footer->records++;
+	footer->end = offset + sizeof(storage_record_header_t) + len;
+}
+
+
+// Set the entry of the segment table of a segment
+static void archive_load_segment(storage_segment_t * segment, const storage_segment_footer_t * footer, uint8_t state)
+{
+	segment->seq = footer->seq;
+	segment->records = footer->records;
+	segment->first_s = footer->first_s;
+	segment->last_s = footer->last_s;
+	segment->end = footer->end;
+	segment->state = state;
+}
+
+
+// Rebuild the footer of a segment written until a reset, from its valid records
+static void archive_recover_segment(const storage_archive_t * archive, FILE_T * fd, uint32_t seq, storage_segment_footer_t * footer)
+{
+	storage_record_header_t header;
+	uint8_t chunk[64];
+	uint32_t offset, next_index, crc;
+	uint16_t len, left, size;
+	memset(footer, 0, sizeof(*footer));
+	footer->seq = seq;
+	footer->end = offset = next_index = sizeof(storage_segment_header_t);
+	while(offset + sizeof(header) <= ARCHIVE_FOOTER_OFFSET(archive))
+	{
+		if(file_seek(fd, offset) != 0 || file_read_bin(fd, &header, sizeof(header)) != sizeof(header)) return;
+		len = csp_ntoh16(header.length);
+		if(len == 0 || offset + sizeof(header) + len > ARCHIVE_FOOTER_OFFSET(archive)) return;
+		// The records after a bad CRC are lost, the last one may be half written
+		crc = 0;
+		for(left = len; left > 0; left -= size)
+		{
+			size = (left < sizeof(chunk)) ? left : sizeof(chunk);
+			if(file_read_bin(fd, chunk, size) != size) return;
+			crc = storage_crc32(crc, chunk, size);
+		}
+		if(crc != csp_ntoh32(header.crc)) return;
+		archive_add_record(archive, footer, &next_index, csp_ntoh32(header.time_s), offset, len);
+		offset = footer->end;
+	}
+}
+
+
+int storage_archive_init(storage_archive_t * archive, const char * prefix, uint32_t segment_size, storage_segment_t * segments, uint16_t segments_num, char * buff, size_t buff_size, uint32_t flush_ms, uint32_t sync_ms)
+{
+	uint16_t slot;
+	uint8_t found = 0;
+	FILE_T fd;
+	storage_segment_header_t header;
+	storage_segment_footer_t footer;
+	char path[STORAGE_ARCHIVE_PATH_SIZE];
+	if(archive == NULL || prefix == NULL || segments == NULL || segments_num == 0) return EXIT_FAILURE;
+	// Room for the header, the footer and at least a record per index entry
+	if(segment_size < sizeof(header) + sizeof(footer) + STORAGE_SEGMENT_INDEX_SIZE * (sizeof(storage_record_header_t) + 1)) return EXIT_FAILURE;
+	memset(archive, 0, sizeof(*archive));
+	archive->prefix = prefix;
+	archive->segment_size = segment_size;
+	archive->segments = segments;
+	archive->segments_num = segments_num;
+	// The first segment will be 0
+	archive->seq = UINT32_MAX;
+	if(storage_writer_init(&archive->writer, archive->path, buff, buff_size, flush_ms, sync_ms) != EXIT_SUCCESS) return EXIT_FAILURE;
+	memset(segments, 0, segments_num * sizeof(storage_segment_t));
+	// Load the segment table, reading the header and footer of each slot
+	for(slot = 0; slot < segments_num; slot++)
+	{
+		archive_segment_path(archive, slot, path);
+		if(file_open(&fd, path, FILE_READ_ONLY) != 0) continue;
+		if(file_read_bin(&fd, &header, sizeof(header)) != sizeof(header) || csp_ntoh32(header.magic) != STORAGE_SEGMENT_MAGIC || csp_ntoh32(header.seq) % segments_num != slot)
+		{
+			file_close(&fd);
+			continue;
+		}
+		if(archive_read_footer(archive, &fd, &footer) == EXIT_SUCCESS && footer.seq == csp_ntoh32(header.seq)) file_close(&fd);
+		else
+		{
+			// Reset while it was written, seal it with the records found
+			archive_recover_segment(archive, &fd, csp_ntoh32(header.seq), &footer);
+			file_close(&fd);
+			archive_write_footer(archive, path, &footer);
+		}
+		archive_load_segment(&segments[slot], &footer, (footer.records > 0) ? STORAGE_SEGMENT_SEALED : STORAGE_SEGMENT_EMPTY);
+		// The newest segment, the new ones follow it
+		if(!found || (int32_t)(footer.seq - archive->seq) > 0) archive->seq = footer.seq;
+		found = 1;
+	}
+	return EXIT_SUCCESS;
+}
+
+
+// Seal the open segment, writing its records and its footer
+static int archive_seal_segment(storage_archive_t * archive)
+{
+	int ret = storage_writer_close(&archive->writer);
+	if(archive_write_footer(archive, archive->path, &archive->footer) != EXIT_SUCCESS) ret = EXIT_FAILURE;
+	archive->segments[archive->seq % archive->segments_num].state = STORAGE_SEGMENT_SEALED;
+	archive->opened = 0;
+	return ret;
+}
+
+
+// Start a new segment, in the slot of the oldest one
+static int archive_open_segment(storage_archive_t * archive)
+{
+	storage_segment_header_t header;
+	archive->seq++;
+	archive_segment_path(archive, archive->seq % archive->segments_num, archive->path);
+	file_remove(archive->path);
+	memset(&archive->footer, 0, sizeof(archive->footer));
+	archive->footer.seq = archive->seq;
+	archive->footer.end = archive->next_index = sizeof(header);
+	archive_load_segment(&archive->segments[archive->seq % archive->segments_num], &archive->footer, STORAGE_SEGMENT_OPEN);
+	archive->opened = 1;
+	header.magic = csp_hton32(STORAGE_SEGMENT_MAGIC);
+	header.seq = csp_hton32(archive->seq);
+	return storage_writer_write(&archive->writer, &header, sizeof(header));
+}
+
+
+int storage_archive_append(storage_archive_t * archive, uint32_t time_s, const void * data, uint16_t len)
+{
+	storage_record_header_t header;
+	if(archive == NULL || archive->segments == NULL || data == NULL || len == 0) return EXIT_FAILURE;
+	if(sizeof(storage_segment_header_t) + sizeof(header) + len > ARCHIVE_FOOTER_OFFSET(archive)) return EXIT_FAILURE;
+	// Start a new segment if it does not fit in the open one
+	if(archive->opened && archive->footer.end + sizeof(header) + len > ARCHIVE_FOOTER_OFFSET(archive)) archive_seal_segment(archive);
+	if(!archive->opened && archive_open_segment(archive) != EXIT_SUCCESS) return EXIT_FAILURE;
+	header.time_s = csp_hton32(time_s);
+	header.length = csp_hton16(len);
+	header.crc = csp_hton32(storage_crc32(0, data, len));
+	archive_add_record(archive, &archive->footer, &archive->next_index, time_s, archive->footer.end, len);
+	archive_load_segment(&archive->segments[archive->seq % archive->segments_num], &archive->footer, STORAGE_SEGMENT_OPEN);
+	if(storage_writer_write(&archive->writer, &header, sizeof(header)) != EXIT_SUCCESS) return EXIT_FAILURE;
+	return storage_writer_write(&archive->writer, data, len);
+}
+
+
+// Entry of the segment table of the k-th segment from the oldest, NULL if not in the archive
+static const storage_segment_t * archive_segment_at(const storage_archive_t * archive, uint16_t k)
+{
+	uint32_t seq = archive->seq - (archive->segments_num - 1) + k;
+	const storage_segment_t * segment = &archive->segments[seq % archive->segments_num];
+	if(segment->state == STORAGE_SEGMENT_EMPTY || segment->seq != seq) return NULL;
+	return segment;
+}
+
+
+int storage_archive_seek(storage_archive_t * archive, uint32_t from_s, uint32_t to_s, storage_archive_cursor_t * cursor)
+{
+	uint16_t lo, hi, mid;
+	const storage_segment_t * segment;
+	storage_segment_footer_t footer;
+	const storage_segment_footer_t * footer_p;
+	char path[STORAGE_ARCHIVE_PATH_SIZE];
+	if(archive == NULL || archive->segments == NULL || cursor == NULL || from_s > to_s) return EXIT_FAILURE;
+	memset(cursor, 0, sizeof(*cursor));
+	cursor->from_s = from_s;
+	cursor->to_s = to_s;
+	// Binary search of the first segment with records at or after from_s
+	lo = 0;
+	hi = archive->segments_num;
+	while(lo < hi)
+	{
+		mid = lo + (hi - lo) / 2;
+		segment = archive_segment_at(archive, mid);
+		if(segment == NULL || segment->last_s < from_s) lo = mid + 1;
+		else hi = mid;
+	}
+	if(lo == archive->segments_num) return EXIT_FAILURE;
+	segment = archive_segment_at(archive, lo);
+	if(segment->first_s > to_s) return EXIT_FAILURE;
+	cursor->seq = segment->seq;
+	// The index of the open segment is in RAM, the one of a sealed segment in its footer
+	if(segment->state == STORAGE_SEGMENT_OPEN) footer_p = &archive->footer;
+	else
+	{
+		archive_segment_path(archive, segment->seq % archive->segments_num, path);
+		if(file_open(&cursor->fd, path, FILE_READ_ONLY) != 0) return EXIT_FAILURE;
+		cursor->opened = 1;
+		if(archive_read_footer(archive, &cursor->fd, &footer) != EXIT_SUCCESS)
+		{
+			storage_archive_end(cursor);
+			return EXIT_FAILURE;
+		}
+		footer_p = &footer;
+	}
+	// Binary search of the last index entry before from_s, the records are read from it
+	lo = 0;
+	hi = footer_p->index_num;
+	while(lo < hi)
+	{
+		mid = lo + (hi - lo) / 2;
+		if(footer_p->index[mid].time_s < from_s) lo = mid + 1;
+		else hi = mid;
+	}
+	cursor->offset = (lo > 0) ? footer_p->index[lo - 1].offset : sizeof(storage_segment_header_t);
+	return EXIT_SUCCESS;
+}
+
+
+int storage_archive_next(storage_archive_t * archive, storage_archive_cursor_t * cursor, uint32_t * time_s, void * buff, size_t buff_size)
+{
+	const storage_segment_t * segment;
+	storage_record_header_t header;
+	uint16_t len;
+	char path[STORAGE_ARCHIVE_PATH_SIZE];
+	if(archive == NULL || archive->segments == NULL || cursor == NULL || time_s == NULL || buff == NULL) return -1;
+	while(1)
+	{
+		segment = &archive->segments[cursor->seq % archive->segments_num];
+		// The segment was removed, its slot reused
+		if(segment->state == STORAGE_SEGMENT_EMPTY || segment->seq != cursor->seq) return 0;
+		// Go on with the next segment
+		if(cursor->offset >= segment->end)
+		{
+			if(cursor->seq == archive->seq) return 0;
+			storage_archive_end(cursor);
+			cursor->seq++;
+			cursor->offset = sizeof(storage_segment_header_t);
+			continue;
+		}
+		// The last records of the open segment may be in RAM, or not synced
+		if(segment->state == STORAGE_SEGMENT_OPEN && (archive->writer.used > 0 || archive->writer.unsynced)) storage_writer_flush(&archive->writer, 1);
+		if(!cursor->opened)
+		{
+			archive_segment_path(archive, cursor->seq % archive->segments_num, path);
+			if(file_open(&cursor->fd, path, FILE_READ_ONLY) != 0) return -1;
+			cursor->opened = 1;
+		}
+		if(file_seek(&cursor->fd, cursor->offset) != 0 || file_read_bin(&cursor->fd, &header, sizeof(header)) != sizeof(header)) return -1;
+		len = csp_ntoh16(header.length);
+		// Not a record, the rest of the segment was lost
+		if(len == 0)
+		{
+			cursor->offset = segment->end;
+			continue;
+		}
+		if(csp_ntoh32(header.time_s) > cursor->to_s) return 0;
+		cursor->offset += sizeof(header) + len;
+		// Before the range
+		if(csp_ntoh32(header.time_s) < cursor->from_s) continue;
+		// Too big for the buffer, the cursor is past it to go on with the next one
+		if(len > buff_size)
+		{
+			*time_s = csp_ntoh32(header.time_s);
+			return -1;
+		}
+		if(file_read_bin(&cursor->fd, buff, len) != len) return -1;
+		// Corrupted record
+		if(storage_crc32(0, buff, len) != csp_ntoh32(header.crc)) continue;
+		*time_s = csp_ntoh32(header.time_s);
+		return len;
+	}
+}
+
+
+void storage_archive_end(storage_archive_cursor_t * cursor)
+{
+	if(cursor == NULL || !cursor->opened) return;
+	file_close(&cursor->fd);
+	cursor->opened = 0;
+}
@@ -0,0 +1,253 @@
+/*
+Copyright 2018 olmanqj
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+of the Software, and to permit persons to whom the Software is furnished to do
+so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <locale.h>
+#include <time.h>
+
+// Framework Includes
+#include <sfsf.h>
+#include <sfsf_conv.h>
+
+#include "sfsf_test.h"
+
+// Tests of the number to string conversions used by the text telemetry and persistence, and their round trip
+
+// Values checked by the round trip tests
+#define TEST_ROUND_TRIPS	200000
+
+
+// Pseudo random bits, the same on every run
+static uint64_t test_random(void)
+{
+	static uint64_t state = 0x9E3779B97F4A7C15ULL;
+	state ^= state << 13;
+	state ^= state >> 7;
+	state ^= state << 17;
+	return state;
+}
+
+
+// Integers: limits of each type, values out of range rejected
+static int test_integers(void)
+{
+	char buff[32];
+	uint64_t u;
+	int64_t i;
+	TEST_CHECK(conv_u64_to_str(UINT64_MAX, buff, sizeof(buff)) == 20);
+	TEST_CHECK(strcmp(buff, "18446744073709551615") == 0);
+	TEST_CHECK(conv_str_to_uint(buff, UINT64_MAX, &u) == 20 && u == UINT64_MAX);
+	TEST_CHECK(conv_i64_to_str(INT64_MIN, buff, sizeof(buff)) == 20);
+	TEST_CHECK(strcmp(buff, "-9223372036854775808") == 0);
+	TEST_CHECK(conv_str_to_int(buff, INT64_MIN, INT64_MAX, &i) == 20 && i == INT64_MIN);
+	TEST_CHECK(conv_i32_to_str(-7, buff, sizeof(buff)) == 2 && strcmp(buff, "-7") == 0);
+	TEST_CHECK(conv_u32_to_str(0, buff, sizeof(buff)) == 1 && strcmp(buff, "0") == 0);
+	// Out of range, or no room
+	TEST_CHECK(conv_str_to_uint("256", UINT8_MAX, &u) == -1);
+	TEST_CHECK(conv_str_to_uint("18446744073709551616", UINT64_MAX, &u) == -1);
+	TEST_CHECK(conv_str_to_int("-129", INT8_MIN, INT8_MAX, &i) == -1);
+	TEST_CHECK(conv_str_to_int("x", INT8_MIN, INT8_MAX, &i) == -1);
+	TEST_CHECK(conv_u32_to_str(1000, buff, 4) == -1);
+	return EXIT_SUCCESS;
+}
+
+
+// Floats: any bit pattern reads back the same from its string
+static int test_float_round_trip(void)
+{
+	char buff[32];
+	uint32_t bits, bits_back;
+	float value, value_back;
+	int i, len;
+	for(i = 0; i < TEST_ROUND_TRIPS; i++)
+	{
+		bits = (uint32_t) test_random();
+		memcpy(&value, &bits, sizeof(value));
+		if(isnan(value)) continue;
+		len = conv_float_to_str(value, buff, sizeof(buff));
+		TEST_CHECK(len > 0);
+		TEST_CHECK(conv_str_to_float(buff, &value_back) == len);
+		memcpy(&bits_back, &value_back, sizeof(bits_back));
+		if(bits_back != bits) printf("%08x written as %s\n", bits, buff);
+		TEST_CHECK(bits_back == bits);
+	}
+	// The shortest string is used
+	TEST_CHECK(conv_float_to_str(0.1f, buff, sizeof(buff)) > 0 && strcmp(buff, "0.1") == 0);
+	return EXIT_SUCCESS;
+}
+
+
+// Doubles: any bit pattern reads back the same from its string
+static int test_double_round_trip(void)
+{
+	char buff[40];
+	uint64_t bits, bits_back;
+	double value, value_back;
+	int i, len;
+	for(i = 0; i < TEST_ROUND_TRIPS; i++)
+	{
+		bits = test_random();
+		memcpy(&value, &bits, sizeof(value));
+		if(isnan(value)) continue;
+		len = conv_double_to_str(value, buff, sizeof(buff));
+		TEST_CHECK(len > 0);
+		TEST_CHECK(conv_str_to_double(buff, &value_back) == len);
+		memcpy(&bits_back, &value_back, sizeof(bits_back));
+		if(bits_back != bits) printf("%016llx written as %s\n", (unsigned long long) bits, buff);
+		TEST_CHECK(bits_back == bits);
+	}
+	TEST_CHECK(conv_double_to_str(0.1, buff, sizeof(buff)) > 0 && strcmp(buff, "0.1") == 0);
+	return EXIT_SUCCESS;
+}
+
+
+// Non finite values: inf and nan read back, finite numbers that overflow rejected
+static int test_non_finite(void)
+{
+	char buff[32];
+	double value;
+	float value_f;
+	TEST_CHECK(conv_double_to_str(-HUGE_VAL, buff, sizeof(buff)) == 4);
+	TEST_CHECK(conv_str_to_double(buff, &value) == 4 && isinf(value) && value < 0);
+	TEST_CHECK(conv_str_to_double("nan", &value) == 3 && isnan(value));
+	TEST_CHECK(conv_str_to_float("Infinity", &value_f) == 8 && isinf(value_f));
+	TEST_CHECK(conv_str_to_double("1e400", &value) == -1);
+	TEST_CHECK(conv_str_to_double("-1.8e308", &value) == -1);
+	TEST_CHECK(conv_str_to_float("1e39", &value_f) == -1);
+	TEST_CHECK(conv_str_to_float("3.5e38", &value_f) == -1);
+	TEST_CHECK(conv_str_to_double("1.7976931348623157e308", &value) > 0 && value == 1.7976931348623157e308);
+	TEST_CHECK(conv_str_to_float("3.4028235e38", &value_f) > 0 && value_f == 3.4028235e38f);
+	TEST_CHECK(conv_str_to_double("in", &value) == -1);
+	return EXIT_SUCCESS;
+}
+
+
+// Locale: the decimal point is '.' whatever the locale, if another one is installed
+static int test_locale(void)
+{
+	static const char * const locales[] = {"de_DE.UTF-8", "de_DE", "fr_FR.UTF-8", "es_ES.UTF-8"};
+	char buff[32];
+	double value;
+	int i;
+	for(i = 0; i < (int)(sizeof(locales)/sizeof(*locales)); i++)
+	{
+		if(setlocale(LC_NUMERIC, locales[i]) != NULL) break;
+	}
+	if(i == (int)(sizeof(locales)/sizeof(*locales))) printf("No locale with ',' as decimal point, checking with \"C\"\n");
+	TEST_CHECK(conv_str_to_double("0.30000000000000004", &value) == 19 && value == 0.30000000000000004);
+	TEST_CHECK(conv_str_to_double("1.5e300", &value) == 7 && value == 1.5e300);
+	TEST_CHECK(conv_double_to_str(2.5e-300, buff, sizeof(buff)) > 0 && strcmp(buff, "2.5e-300") == 0);
+	setlocale(LC_NUMERIC, "C");
+	return EXIT_SUCCESS;
+}
+
+
+// Values of the benchmark, converted in rounds
+#define TEST_BENCH_VALUES	1000
+#define TEST_BENCH_ROUNDS	200
+static uint32_t bench_u32[TEST_BENCH_VALUES];
+static uint64_t bench_u64[TEST_BENCH_VALUES];
+static double bench_double[TEST_BENCH_VALUES];
+static char bench_u32_str[TEST_BENCH_VALUES][16];
+static char bench_double_str[TEST_BENCH_VALUES][32];
+static char bench_buff[40];
+// Results, so the calls are not optimized out
+static volatile uint64_t bench_sink;
+
+// A conversion of the benchmark, of value i
+typedef void (*bench_fun_t)(int i);
+static void libc_u32_write(int i) { bench_sink += snprintf(bench_buff, sizeof(bench_buff), "%u", bench_u32[i]); }
+static void conv_u32_write(int i) { bench_sink += conv_u32_to_str(bench_u32[i], bench_buff, sizeof(bench_buff)); }
+static void libc_u64_write(int i) { bench_sink += snprintf(bench_buff, sizeof(bench_buff), "%llu", (unsigned long long) bench_u64[i]); }
+static void conv_u64_write(int i) { bench_sink += conv_u64_to_str(bench_u64[i], bench_buff, sizeof(bench_buff)); }
+static void libc_u32_parse(int i) { bench_sink += strtoul(bench_u32_str[i], NULL, 10); }
+static void conv_u32_parse(int i) { uint64_t value; bench_sink += conv_str_to_uint(bench_u32_str[i], UINT32_MAX, &value) + value; }
+static void libc_double_write(int i) { bench_sink += snprintf(bench_buff, sizeof(bench_buff), "%.17g", bench_double[i]); }
+static void conv_double_write(int i) { bench_sink += conv_double_to_str(bench_double[i], bench_buff, sizeof(bench_buff)); }
+static void libc_double_parse(int i) { bench_sink += (strtod(bench_double_str[i], NULL) > 0); }
+static void conv_double_parse(int i) { double value; bench_sink += conv_str_to_double(bench_double_str[i], &value) + (value > 0); }
+
+
+// Time of a conversion in ns, the mean of all the values
+static double bench_ns(bench_fun_t fun)
+{
+	struct timespec start, end;
+	int round, i;
+	clock_gettime(CLOCK_MONOTONIC, &start);
+	for(round = 0; round < TEST_BENCH_ROUNDS; round++)
+	{
+		for(i = 0; i < TEST_BENCH_VALUES; i++) fun(i);
+	}
+	clock_gettime(CLOCK_MONOTONIC, &end);
+	return ((end.tv_sec - start.tv_sec) * 1e9 + (end.tv_nsec - start.tv_nsec)) / (TEST_BENCH_ROUNDS * TEST_BENCH_VALUES);
+}
+
+
+// Benchmark: time per call of libc and of this module, printed for reference, it does not fail
+static int test_benchmark(void)
+{
+	static const struct
+	{
+		const char * name;
+		bench_fun_t libc_fun, conv_fun;
+	} benchs[] = {
+		{"u32 write",		libc_u32_write,		conv_u32_write},
+		{"u64 write",		libc_u64_write,		conv_u64_write},
+		{"u32 parse",		libc_u32_parse,		conv_u32_parse},
+		{"double write",	libc_double_write,	conv_double_write},
+		{"double parse",	libc_double_parse,	conv_double_parse},
+	};
+	int i;
+	for(i = 0; i < TEST_BENCH_VALUES; i++)
+	{
+		bench_u32[i] = (uint32_t) test_random();
+		bench_u64[i] = test_random();
+		// Half with a few decimals as set from ground, half with all the digits as measured
+		if(i % 2 == 0) bench_double[i] = (int32_t) test_random() / 1000.0;
+		else bench_double[i] = (int32_t) test_random() / 3.0;
+		TEST_CHECK(conv_u32_to_str(bench_u32[i], bench_u32_str[i], sizeof(bench_u32_str[i])) > 0);
+		TEST_CHECK(conv_double_to_str(bench_double[i], bench_double_str[i], sizeof(bench_double_str[i])) > 0);
+	}
+	for(i = 0; i < (int)(sizeof(benchs)/sizeof(*benchs)); i++)
+	{
+		printf("%-14s libc %6.1f ns, conv %6.1f ns\n", benchs[i].name, bench_ns(benchs[i].libc_fun), bench_ns(benchs[i].conv_fun));
+	}
+	return EXIT_SUCCESS;
+}
+
+
+static const test_t tests[] = {
+	{"integers",			test_integers},
+	{"float_round_trip",	test_float_round_trip},
+	{"double_round_trip",	test_double_round_trip},
+	{"non_finite",			test_non_finite},
+	{"locale",				test_locale},
+	{"benchmark",			test_benchmark},
+};
+
+
+int main(void)
+{
+	return run_tests(tests, sizeof(tests)/sizeof(*tests));
+}
@@ -0,0 +1,176 @@
+/*
+Copyright 2018 olmanqj
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+of the Software, and to permit persons to whom the Software is furnished to do
+so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// CSP Includes
+#include <csp/csp.h>
+#include <csp/arch/csp_thread.h>
+
+// Framework Includes
+#include <sfsf.h>
+#include <sfsf_param.h>
+#include <sfsf_time.h>
+#include <sfsf_history.h>
+
+#include "sfsf_test.h"
+
+// Tests of the History Service, all on the same tables as the sampling task keeps running once started
+
+
+// The "counter" param is read once per sample, so sample n has value n
+static int counter_computes;
+static int compute_counter(param_handle_t param_h, void * out_p, void * ctx)
+{
+	float value = counter_computes++;
+	(void) param_h;
+	(void) ctx;
+	memcpy(out_p, &value, sizeof(value));
+	return EXIT_SUCCESS;
+}
+
+// Tables of the tests, the param with history is not in the first one
+static param_table_t eps_table = {
+	{.name="volt",		.type=FLOAT_PARAM,	.size=FLOAT_SIZE,	.opts=TELEMETRY},
+	{.name="curr",		.type=FLOAT_PARAM,	.size=FLOAT_SIZE,	.opts=TELEMETRY},
+};
+static param_table_t obc_table = {
+	{.name="mode",		.type=UINT8_PARAM,	.size=UINT8_SIZE},
+	{.name="counter",	.type=FLOAT_PARAM,	.size=FLOAT_SIZE,	.opts=HISTORY},
+	{.name="label",		.type=STRING_PARAM,	.size=8,			.opts=HISTORY},
+};
+
+// Buffer of the queries, its header and records
+static union
+{
+	uint8_t bytes[sizeof(history_header_t) + 256 * sizeof(float)];
+	struct __attribute__((__packed__))
+	{
+		history_header_t header;
+		union
+		{
+			float samples[256];
+			history_bucket_t buckets[64];
+		};
+	};
+} series;
+
+
+// Wait until the given amount of samples has been taken
+static void wait_samples(uint32_t count)
+{
+	while(history_sample_count < count) csp_sleep_ms(CONF_HISTORY_PERIOD_MS);
+}
+
+
+// Query the seconds before now into series, with the header in the byte order of the OBC
+static int query_last_seconds(param_handle_t param_h, uint32_t seconds)
+{
+	int len;
+	uint32_t now_s = get_timestamp_s();
+	len = param_history_query(param_h, now_s - seconds, now_s, &series, sizeof(series));
+	series.header.index = csp_ntoh16(series.header.index);
+	series.header.count = csp_ntoh16(series.header.count);
+	series.header.period_ms = csp_ntoh32(series.header.period_ms);
+	return len;
+}
+
+
+// Samples: the recent ones are returned in order, for the param given by its index
+static int test_samples(void)
+{
+	param_handle_t counter_h;
+	int i;
+	TEST_CHECK(register_param_table("eps", &eps_table, sizeof(eps_table)/sizeof(*eps_table)) >= 0);
+	TEST_CHECK(register_param_table("obc", &obc_table, sizeof(obc_table)/sizeof(*obc_table)) >= 0);
+	TEST_CHECK(mount_param_tables() == EXIT_SUCCESS);
+	counter_h = get_param_handle_by_name("obc.counter");
+	TEST_CHECK(param_set_derived(counter_h, compute_counter, NULL, 0, NULL, 0) == EXIT_SUCCESS);
+	TEST_CHECK(init_history_service() == EXIT_SUCCESS);
+	wait_samples(50);
+	TEST_CHECK(query_last_seconds(counter_h, 1) == (int)(sizeof(history_header_t) + series.header.count * sizeof(float)));
+	TEST_CHECK(series.header.format == HISTORY_FORMAT_SAMPLES && series.header.period_ms == CONF_HISTORY_PERIOD_MS);
+	TEST_CHECK(series.header.index == get_param_index("obc.counter"));
+	TEST_CHECK(series.header.count >= 50);
+	for(i = 0; i < series.header.count; i++) TEST_CHECK(series.samples[i] == series.samples[0] + i);
+	TEST_CHECK(series.samples[series.header.count - 1] < history_sample_count);
+	// Only single numeric params are sampled
+	TEST_CHECK(query_last_seconds(get_param_handle_by_name("obc.label"), 1) == -1);
+	TEST_CHECK(query_last_seconds(get_param_handle_by_name("obc.mode"), 1) == -1);
+	return EXIT_SUCCESS;
+}
+
+
+// Rollover: once the ring is full the newest samples replace the oldest ones
+static int test_rollover(void)
+{
+	uint32_t taken;
+	int i;
+	wait_samples(CONF_HISTORY_SAMPLES + 50);
+	taken = history_sample_count;
+	TEST_CHECK(query_last_seconds(get_param_handle_by_name("obc.counter"), 1) > 0);
+	TEST_CHECK(series.header.format == HISTORY_FORMAT_SAMPLES && series.header.count > 0);
+	for(i = 0; i < series.header.count; i++) TEST_CHECK(series.samples[i] == series.samples[0] + i);
+	// The newest samples, not the ones they replaced
+	TEST_CHECK(series.samples[series.header.count - 1] >= taken - 2);
+	TEST_CHECK(series.samples[0] >= taken - CONF_HISTORY_SAMPLES);
+	return EXIT_SUCCESS;
+}
+
+
+// Buckets: a range older than the samples returns the complete buckets, each the min, max and mean of its samples
+static int test_buckets(void)
+{
+	uint32_t taken;
+	int i;
+	taken = history_sample_count;
+	TEST_CHECK(query_last_seconds(get_param_handle_by_name("obc.counter"), 10) > 0);
+	TEST_CHECK(series.header.format == HISTORY_FORMAT_BUCKETS);
+	TEST_CHECK(series.header.period_ms == CONF_HISTORY_PERIOD_MS * CONF_HISTORY_BUCKET_SAMPLES);
+	TEST_CHECK(series.header.count > 0 && series.header.count <= CONF_HISTORY_BUCKETS);
+	for(i = 0; i < series.header.count; i++)
+	{
+		TEST_CHECK(series.buckets[i].min == series.buckets[0].min + i * CONF_HISTORY_BUCKET_SAMPLES);
+		TEST_CHECK(series.buckets[i].max == series.buckets[i].min + CONF_HISTORY_BUCKET_SAMPLES - 1);
+		TEST_CHECK(series.buckets[i].mean == series.buckets[i].min + (CONF_HISTORY_BUCKET_SAMPLES - 1) / 2.0f);
+	}
+	TEST_CHECK((uint32_t) series.buckets[0].min % CONF_HISTORY_BUCKET_SAMPLES == 0);
+	// Only complete buckets, and not older than the ring of buckets
+	TEST_CHECK(series.buckets[series.header.count - 1].max < history_sample_count);
+	TEST_CHECK(series.buckets[0].min >= (taken / CONF_HISTORY_BUCKET_SAMPLES - CONF_HISTORY_BUCKETS) * CONF_HISTORY_BUCKET_SAMPLES);
+	return EXIT_SUCCESS;
+}
+
+
+// Tests, run in order
+static const test_t tests[] = {
+	{"samples",		test_samples},
+	{"rollover",	test_rollover},
+	{"buckets",		test_buckets},
+};
+
+
+int main(void)
+{
+	return run_tests(tests, sizeof(tests)/sizeof(*tests));
+}
@@ -0,0 +1,43 @@
+/*
+Copyright 2018 olmanqj
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+of the Software, and to permit persons to whom the Software is furnished to do
+so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+ */
+
+#ifndef SFSF_TEST_HISTORY_CONFIG_H_
+#define SFSF_TEST_HISTORY_CONFIG_H_
+/**
+ * @file	sfsf_config.h
+ * @brief	Configuration of the history tests
+
+The configuration of the tests in "test/", with a fast sample period and small
+rings, so the tests see samples roll over and buckets complete in seconds.
+*/
+
+#include "../sfsf_config.h"
+
+#undef CONF_HISTORY_PERIOD_MS
+#undef CONF_HISTORY_SAMPLES
+#undef CONF_HISTORY_BUCKET_SAMPLES
+#undef CONF_HISTORY_BUCKETS
+#define CONF_HISTORY_PERIOD_MS				10				/**< Period between samples in ms. */
+#define CONF_HISTORY_SAMPLES				200				/**< Samples kept per param. */
+#define CONF_HISTORY_BUCKET_SAMPLES			10				/**< Samples reduced to a min/max/mean bucket. */
+#define CONF_HISTORY_BUCKETS				10				/**< Buckets kept per param. */
+
+#endif /* SFSF_TEST_HISTORY_CONFIG_H_ */
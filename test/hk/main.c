@@ -0,0 +1,194 @@
+/*
+Copyright 2018 olmanqj
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+of the Software, and to permit persons to whom the Software is furnished to do
+so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// CSP Includes
+#include <csp/csp.h>
+#include <csp/arch/csp_queue.h>
+#include <csp/arch/csp_semaphore.h>
+
+// Framework Includes
+#include <sfsf.h>
+#include <sfsf_time.h>
+#include <sfsf_hk.h>
+
+#include "sfsf_test.h"
+
+// Tests of the HK Service, through its public functions without the HK task
+
+// Data bytes of a segment, a packet without the segment header
+#define TEST_SEGMENT_DATA	(CONF_CSP_BUFF_SIZE - sizeof(beacon_segment_header_t))
+
+// Scheduler of the streams, internal to the HK Service, created by init_hk_service()
+extern csp_mutex_t hk_sched_mutex;
+extern csp_queue_handle_t hk_sched_wake;
+extern uint8_t hk_heap_num;
+extern int hk_take_due_stream(uint32_t now, hk_stream_t * stream, int32_t * wait);
+
+
+// A beacon of CONF_HK_FRAME_SIZE bytes, its bytes from their position
+static void fill_frame(uint8_t * frame)
+{
+	int i;
+	for(i = 0; i < CONF_HK_FRAME_SIZE; i++) frame[i] = (uint8_t)(i * 7 + 1);
+}
+
+
+// Beacons that fit in a packet are sent as is, bigger ones in segments
+static int test_segments_count(void)
+{
+	TEST_CHECK(get_beacon_segments(1) == 1);
+	TEST_CHECK(get_beacon_segments(CONF_CSP_BUFF_SIZE - 1) == 1);
+	TEST_CHECK(get_beacon_segments(CONF_CSP_BUFF_SIZE) == 2);
+	TEST_CHECK(get_beacon_segments(TEST_SEGMENT_DATA * 2) == 2);
+	TEST_CHECK(get_beacon_segments(TEST_SEGMENT_DATA * 2 + 1) == 3);
+	TEST_CHECK(get_beacon_segments(CONF_HK_FRAME_SIZE) == (CONF_HK_FRAME_SIZE + TEST_SEGMENT_DATA - 1) / TEST_SEGMENT_DATA);
+	return EXIT_SUCCESS;
+}
+
+
+// A beacon that fits in a packet is its only packet, without header
+static int test_segment_whole(void)
+{
+	static uint8_t frame[CONF_HK_FRAME_SIZE], packet[CONF_CSP_BUFF_SIZE];
+	fill_frame(frame);
+	TEST_CHECK(get_beacon_segment(frame, 100, 7, 0, packet) == 100);
+	TEST_CHECK(memcmp(packet, frame, 100) == 0);
+	TEST_CHECK(get_beacon_segment(frame, 100, 7, 1, packet) == 0);
+	return EXIT_SUCCESS;
+}
+
+
+// The segments of a beacon carry its frame ID, their index and count, and join into the beacon
+static int test_segments_join(void)
+{
+	static uint8_t frame[CONF_HK_FRAME_SIZE], joined[CONF_HK_FRAME_SIZE], packet[CONF_CSP_BUFF_SIZE];
+	beacon_segment_header_t header;
+	uint16_t lengths[] = {CONF_CSP_BUFF_SIZE, TEST_SEGMENT_DATA * 2, TEST_SEGMENT_DATA * 2 + 1, CONF_HK_FRAME_SIZE};
+	int i, size, offset;
+	uint8_t index, count;
+	fill_frame(frame);
+	for(i = 0; i < (int)(sizeof(lengths)/sizeof(*lengths)); i++)
+	{
+		count = get_beacon_segments(lengths[i]);
+		memset(joined, 0, sizeof(joined));
+		for(index = 0, offset = 0; index < count; index++, offset += size - sizeof(header))
+		{
+			size = get_beacon_segment(frame, lengths[i], 0x1234, index, packet);
+			TEST_CHECK(size > (int) sizeof(header) && size <= CONF_CSP_BUFF_SIZE);
+			memcpy(&header, packet, sizeof(header));
+			TEST_CHECK(header.marker == BEACON_SEGMENT_MARKER);
+			TEST_CHECK(csp_ntoh16(header.frame_id) == 0x1234);
+			TEST_CHECK(header.index == index && header.count == count);
+			TEST_CHECK(offset + size - sizeof(header) <= lengths[i]);
+			memcpy(joined + offset, packet + sizeof(header), size - sizeof(header));
+		}
+		TEST_CHECK(offset == lengths[i]);
+		TEST_CHECK(memcmp(joined, frame, lengths[i]) == 0);
+		TEST_CHECK(get_beacon_segment(frame, lengths[i], 0x1234, count, packet) == 0);
+	}
+	return EXIT_SUCCESS;
+}
+
+
+// Timer heap: streams fire in deadline order, each re-armed one period after its last beacon
+static int test_timer_heap(void)
+{
+	static const param_index_t params[] = {0};
+	static const uint32_t periods[] = {250, 100, 150, 400};
+	int i, id, ids[4], last[4], count[4], prev;
+	int32_t wait;
+	uint32_t start, now;
+	hk_stream_t stream = {.params = params, .params_num = 1, .dport = 12, .prio = CSP_PRIO_NORM};
+	TEST_CHECK(csp_mutex_create(&hk_sched_mutex) == CSP_MUTEX_OK);
+	TEST_CHECK((hk_sched_wake = csp_queue_create(1, sizeof(uint8_t))) != NULL);
+	// Nothing scheduled, the task sleeps the idle time
+	TEST_CHECK(hk_take_due_stream(time_since_boot_ms(), &stream, &wait) == -1 && wait > 0);
+	start = time_since_boot_ms();
+	for(i = 0; i < 4; i++)
+	{
+		stream.period_ms = periods[i];
+		TEST_CHECK((ids[i] = hk_add_stream(&stream)) > 0);
+		last[i] = -1;
+		count[i] = 0;
+	}
+	TEST_CHECK(hk_heap_num == 4);
+	// The earliest deadline is the stream of 100 ms
+	TEST_CHECK(hk_take_due_stream(start, &stream, &wait) == -1);
+	TEST_CHECK(wait >= 100 && wait <= 110);
+	// A second of beacons, in steps of 1 ms
+	for(prev = 0, now = start; now - start <= 1000; now++)
+	{
+		while((id = hk_take_due_stream(now, &stream, &wait)) >= 0)
+		{
+			for(i = 0; i < 4 && ids[i] != id; i++);
+			TEST_CHECK(i < 4 && stream.period_ms == periods[i]);
+			// Never before a beacon fired earlier
+			TEST_CHECK((int)(now - start) >= prev);
+			prev = now - start;
+			// Re-armed one period after the last beacon, without drift
+			if(last[i] >= 0) TEST_CHECK(prev - last[i] == (int) periods[i]);
+			last[i] = prev;
+			count[i]++;
+		}
+		TEST_CHECK(wait > 0);
+	}
+	for(i = 0; i < 4; i++) TEST_CHECK(count[i] >= (int)(1000 / periods[i]) - 1 && count[i] <= (int)(1000 / periods[i]));
+	// A removed stream does not fire, the rest keep their order
+	TEST_CHECK(hk_remove_stream(ids[1]) == EXIT_SUCCESS);
+	TEST_CHECK(hk_remove_stream(ids[1]) == EXIT_FAILURE);
+	TEST_CHECK(hk_heap_num == 3);
+	for(; now - start <= 2000; now++)
+	{
+		while((id = hk_take_due_stream(now, &stream, &wait)) >= 0)
+		{
+			TEST_CHECK(id != ids[1]);
+			for(i = 0; i < 4 && ids[i] != id; i++);
+			TEST_CHECK((int)(now - start) - last[i] == (int) periods[i]);
+			last[i] = now - start;
+		}
+	}
+	// Missed beacons are not caught up, the next one is a period after the late one
+	now += 5000;
+	for(i = 0; i < 3; i++) TEST_CHECK(hk_take_due_stream(now, &stream, &wait) >= 0);
+	TEST_CHECK(hk_take_due_stream(now, &stream, &wait) == -1);
+	TEST_CHECK(wait == 150);
+	for(i = 0; i < 4; i++) if(i != 1) TEST_CHECK(hk_remove_stream(ids[i]) == EXIT_SUCCESS);
+	TEST_CHECK(hk_heap_num == 0);
+	return EXIT_SUCCESS;
+}
+
+
+static const test_t tests[] = {
+	{"segments_count",		test_segments_count},
+	{"segment_whole",		test_segment_whole},
+	{"segments_join",		test_segments_join},
+	{"timer_heap",			test_timer_heap},
+};
+
+
+int main(void)
+{
+	return run_tests(tests, sizeof(tests)/sizeof(*tests));
+}
@@ -0,0 +1,905 @@
+/*
+Copyright 2018 olmanqj
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+of the Software, and to permit persons to whom the Software is furnished to do
+so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// CSP Includes
+#include <csp/csp.h>
+#include <csp/arch/csp_thread.h>
+
+// Framework Includes
+#include <sfsf.h>
+#include <sfsf_storage.h>
+#include <sfsf_param.h>
+#include <sfsf_hk.h>
+
+#include "sfsf_test.h"
+
+// Tests of the Param Service, each test mounts its own Parameter Table
+
+// Slot of the latest param image, internal to the Param Service
+extern uint8_t param_image_slot;
+// Sequence counters, internal to the Param Service
+extern volatile uint32_t * param_seq_p;
+// Sequence counter of bulk sets, internal to the Param Service
+extern volatile uint32_t param_bulk_seq;
+// Writes marked for the next snapshot, internal to the Param Service
+extern volatile uint32_t param_write_count;
+// Hot metadata, internal to the Param Service
+extern param_meta_t param_meta;
+// Blocks allocated for the mounted table, internal to the Param Service
+extern uint8_t param_blocks_num;
+// Snapshot, internal to the Param Service
+extern param_snapshot_t param_snapshot;
+// Storage of the values, internal to the Param Service
+extern void * param_space_p;
+extern uint32_t param_space_size_v;
+
+
+// Name index: every param found by its name, unknown names not found
+static int test_name_index(void)
+{
+	static param_table_t table = {
+		{.name="alpha",		.type=UINT8_PARAM,	.size=UINT8_SIZE},
+		{.name="beta",		.type=UINT16_PARAM,	.size=UINT16_SIZE},
+		{.name="gamma",		.type=UINT32_PARAM,	.size=UINT32_SIZE},
+		{.name="delta",		.type=FLOAT_PARAM,	.size=FLOAT_SIZE},
+		{.name="epsilon",	.type=STRING_PARAM,	.size=16},
+	};
+	static param_table_t other_table = {
+		{.name="zeta",		.type=UINT8_PARAM,	.size=UINT8_SIZE},
+		{.name="eta",		.type=UINT8_PARAM,	.size=UINT8_SIZE},
+	};
+	int i;
+	TEST_CHECK(set_param_table(&table, sizeof(table)/sizeof(*table)) == EXIT_SUCCESS);
+	for(i = 0; i < (int)(sizeof(table)/sizeof(*table)); i++)
+	{
+		TEST_CHECK(get_param_handle_by_name(table[i].name) == get_param_handle_by_index(i));
+	}
+	TEST_CHECK(get_param_handle_by_name("omega") == NULL);
+	TEST_CHECK(get_param_handle_by_name("") == NULL);
+	// A new table gets its own index
+	TEST_CHECK(set_param_table(&other_table, sizeof(other_table)/sizeof(*other_table)) == EXIT_SUCCESS);
+	TEST_CHECK(get_param_handle_by_name("zeta") == get_param_handle_by_index(0));
+	TEST_CHECK(get_param_handle_by_name("eta") == get_param_handle_by_index(1));
+	TEST_CHECK(get_param_handle_by_name("gamma") == NULL);
+	return EXIT_SUCCESS;
+}
+
+
+// Hot metadata: the parallel arrays match the table, the lists have the params with each option in table order
+static int test_meta(void)
+{
+	static uint32_t counter;
+	static param_table_t table = {
+		{.name="mode",		.type=UINT8_PARAM,	.size=UINT8_SIZE,	.opts=TELEMETRY},
+		{.name="period",	.type=UINT32_PARAM,	.size=UINT32_SIZE,	.opts=PERSISTENT},
+		{.name="volt",		.type=FLOAT_PARAM,	.size=FLOAT_SIZE,	.opts=TELEMETRY|PERSISTENT},
+		{.name="label",		.type=STRING_PARAM,	.size=12,			.opts=READ_ONLY},
+		{.name="counter",	.type=UINT32_PARAM,	.size=UINT32_SIZE,	.opts=TELEMETRY,	.value=&counter},
+		// Fills the name without null-character
+		{.name="sixteen_chars_nm",	.type=INT16_PARAM,	.size=2*INT16_SIZE,	.opts=PERSISTENT},
+	};
+	static const param_index_t telemetry[] = {0, 2, 4};
+	static const param_index_t persistent[] = {1, 2, 5};
+	param_handle_t param_h;
+	int i;
+	TEST_CHECK(set_param_table(&table, sizeof(table)/sizeof(*table)) == EXIT_SUCCESS);
+	for(i = 0; i < (int)(sizeof(table)/sizeof(*table)); i++)
+	{
+		param_h = get_param_handle_by_index(i);
+		TEST_CHECK(param_meta.type[i] == param_h->type && param_meta.size[i] == param_h->size && param_meta.opts[i] == param_h->opts);
+		TEST_CHECK(param_meta.value[i] == param_h->value);
+		TEST_CHECK(strncmp(param_meta.names + param_meta.name[i], table[i].name, CONF_PARAM_NAME_SIZE) == 0);
+		TEST_CHECK(strlen(param_meta.names + param_meta.name[i]) == strnlen(table[i].name, CONF_PARAM_NAME_SIZE));
+	}
+	TEST_CHECK(param_meta.value[4] == &counter);
+	TEST_CHECK(strcmp(param_meta.names + param_meta.name[5], "sixteen_chars_nm") == 0);
+	TEST_CHECK(get_param_handle_by_name("sixteen_chars_nm") == get_param_handle_by_index(5));
+	// Lists
+	TEST_CHECK(param_meta.telemetry_num == sizeof(telemetry)/sizeof(*telemetry));
+	TEST_CHECK(memcmp(param_meta.telemetry, telemetry, sizeof(telemetry)) == 0);
+	TEST_CHECK(param_meta.persistent_num == sizeof(persistent)/sizeof(*persistent));
+	TEST_CHECK(memcmp(param_meta.persistent, persistent, sizeof(persistent)) == 0);
+	return EXIT_SUCCESS;
+}
+
+
+// Layout: every value in param space is naturally aligned, without overlaps or padding
+static int test_layout(void)
+{
+	static param_table_t table = {
+		{.name="u8",		.type=UINT8_PARAM,	.size=UINT8_SIZE},
+		{.name="u32",		.type=UINT32_PARAM,	.size=UINT32_SIZE},
+		{.name="u16",		.type=UINT16_PARAM,	.size=UINT16_SIZE},
+		{.name="double",	.type=DOUBLE_PARAM,	.size=DOUBLE_SIZE},
+		{.name="u8s",		.type=UINT8_PARAM,	.size=3*UINT8_SIZE},
+		{.name="i64",		.type=INT64_PARAM,	.size=INT64_SIZE},
+		{.name="str",		.type=STRING_PARAM,	.size=5},
+		{.name="float",		.type=FLOAT_PARAM,	.size=FLOAT_SIZE},
+		{.name="u16s",		.type=UINT16_PARAM,	.size=3*UINT16_SIZE},
+	};
+	param_handle_t param_h, other_h;
+	uintptr_t align;
+	uint32_t total;
+	int i, j;
+	TEST_CHECK(set_param_table(&table, sizeof(table)/sizeof(*table)) == EXIT_SUCCESS);
+	total = 0;
+	for(i = 0; i < (int)(sizeof(table)/sizeof(*table)); i++)
+	{
+		param_h = get_param_handle_by_index(i);
+		total += param_h->size;
+		// Alignment of the element, up to 8 bytes
+		align = param_h->size / param_elem_count(param_h);
+		if(align > sizeof(uint64_t)) align = sizeof(uint64_t);
+		TEST_CHECK((uintptr_t) param_h->value % align == 0);
+		TEST_CHECK((uint8_t *) param_h->value >= (uint8_t *) param_space_p);
+		TEST_CHECK((uint8_t *) param_h->value + param_h->size <= (uint8_t *) param_space_p + param_space_size_v);
+		for(j = 0; j < i; j++)
+		{
+			other_h = get_param_handle_by_index(j);
+			TEST_CHECK((uint8_t *) param_h->value >= (uint8_t *) other_h->value + other_h->size ||
+			           (uint8_t *) other_h->value >= (uint8_t *) param_h->value + param_h->size);
+		}
+	}
+	TEST_CHECK(param_space_size_v == total);
+	return EXIT_SUCCESS;
+}
+
+
+// Tables: subsystem tables found by prefix, mounting again takes the same memory
+static int test_tables(void)
+{
+	static param_table_t core_table = {
+		{.name="mode",		.type=UINT8_PARAM,	.size=UINT8_SIZE},
+	};
+	static param_table_t eps_table = {
+		{.name="vbat",		.type=UINT16_PARAM,	.size=UINT16_SIZE},
+		{.name="mode",		.type=UINT8_PARAM,	.size=UINT8_SIZE},
+	};
+	static param_table_t obc_table = {
+		{.name="temp",		.type=FLOAT_PARAM,	.size=FLOAT_SIZE},
+	};
+	uint32_t ram_bytes;
+	uint8_t blocks;
+	int i;
+	// After the table without prefix
+	TEST_CHECK(set_param_table(&core_table, sizeof(core_table)/sizeof(*core_table)) == EXIT_SUCCESS);
+	TEST_CHECK(register_param_table("eps", &eps_table, sizeof(eps_table)/sizeof(*eps_table)) == 1);
+	TEST_CHECK(register_param_table("obc", &obc_table, sizeof(obc_table)/sizeof(*obc_table)) == 2);
+	TEST_CHECK(register_param_table("eps", &obc_table, sizeof(obc_table)/sizeof(*obc_table)) == -1);
+	TEST_CHECK(mount_param_tables() == EXIT_SUCCESS);
+	ram_bytes = param_ram_bytes;
+	blocks = param_blocks_num;
+	for(i = 0; i < 3; i++)
+	{
+		TEST_CHECK(get_table_size() == 4);
+		TEST_CHECK(get_param_handle_by_name("mode") == get_param_handle_by_index(0));
+		TEST_CHECK(get_param_handle_by_name("eps.vbat") == get_param_handle_by_index(1));
+		TEST_CHECK(get_param_handle_by_name("eps.mode") == get_param_handle_by_index(2));
+		TEST_CHECK(get_param_handle_by_name("obc.temp") == get_param_handle_by_index(3));
+		TEST_CHECK(get_param_handle_by_name("vbat") == NULL && get_param_handle_by_name("obc.vbat") == NULL);
+		TEST_CHECK(get_param_table_id("obc") == 2 && get_param_handle_by_ref(1, 1) == get_param_handle_by_index(2));
+		// Each param has its own value
+		TEST_CHECK(param_set_u8(get_param_handle_by_name("mode"), 1) == EXIT_SUCCESS);
+		TEST_CHECK(param_set_u8(get_param_handle_by_name("eps.mode"), 2) == EXIT_SUCCESS);
+		TEST_CHECK(param_get_u8(get_param_handle_by_name("mode")) == 1 && param_get_u8(get_param_handle_by_name("eps.mode")) == 2);
+		// Mounting again frees the memory of the tables mounted before
+		TEST_CHECK(mount_param_tables() == EXIT_SUCCESS);
+		TEST_CHECK(param_ram_bytes == ram_bytes && param_blocks_num == blocks);
+	}
+	return EXIT_SUCCESS;
+}
+
+
+// Typed accessors: values of each type, 0 or -1 on a type mismatch
+static int test_typed_accessors(void)
+{
+	static param_table_t table = {
+		{.name="u8",		.type=UINT8_PARAM,	.size=UINT8_SIZE},
+		{.name="i32",		.type=INT32_PARAM,	.size=INT32_SIZE},
+		{.name="u64",		.type=UINT64_PARAM,	.size=UINT64_SIZE},
+		{.name="float",		.type=FLOAT_PARAM,	.size=FLOAT_SIZE,	.opts=PERSISTENT},
+		{.name="double",	.type=DOUBLE_PARAM,	.size=DOUBLE_SIZE},
+	};
+	TEST_CHECK(set_param_table(&table, sizeof(table)/sizeof(*table)) == EXIT_SUCCESS);
+	TEST_CHECK(param_set_u8(get_param_handle_by_name("u8"), 200) == EXIT_SUCCESS);
+	TEST_CHECK(param_get_u8(get_param_handle_by_name("u8")) == 200);
+	TEST_CHECK(param_set_i32(get_param_handle_by_name("i32"), -123456) == EXIT_SUCCESS);
+	TEST_CHECK(param_get_i32(get_param_handle_by_name("i32")) == -123456);
+	TEST_CHECK(param_set_u64(get_param_handle_by_name("u64"), 0x123456789ABCDEF0ULL) == EXIT_SUCCESS);
+	TEST_CHECK(param_get_u64(get_param_handle_by_name("u64")) == 0x123456789ABCDEF0ULL);
+	TEST_CHECK(param_set_float(get_param_handle_by_name("float"), 1.5f) == EXIT_SUCCESS);
+	TEST_CHECK(param_get_float(get_param_handle_by_name("float")) == 1.5f);
+	TEST_CHECK(param_set_double(get_param_handle_by_name("double"), -0.25) == EXIT_SUCCESS);
+	TEST_CHECK(param_get_double(get_param_handle_by_name("double")) == -0.25);
+	// Other type, or no param
+	TEST_CHECK(param_get_u32(get_param_handle_by_name("i32")) == 0);
+	TEST_CHECK(param_set_u32(get_param_handle_by_name("i32"), 1) == EXIT_FAILURE);
+	TEST_CHECK(param_get_i32(get_param_handle_by_name("i32")) == -123456);
+	TEST_CHECK(param_get_u8(NULL) == 0);
+	return EXIT_SUCCESS;
+}
+
+
+// Arrays: typed accessors copy one element, text conversions fail if the value does not fit
+static int test_arrays(void)
+{
+	static param_table_t table = {
+		{.name="gyro_bias",	.type=DOUBLE_PARAM,	.size=3*DOUBLE_SIZE},
+		{.name="cal",		.type=INT16_PARAM,	.size=100*INT16_SIZE,	.opts=TELEMETRY},
+		{.name="label",		.type=STRING_PARAM,	.size=8},
+		{.name="log",		.type=STRING_PARAM,	.size=200},
+	};
+	param_handle_t bias_h, cal_h, label_h, log_h;
+	char buff[256];
+	char long_str[201];
+	char beacon[700];
+	int i;
+	TEST_CHECK(set_param_table(&table, sizeof(table)/sizeof(*table)) == EXIT_SUCCESS);
+	bias_h = get_param_handle_by_name("gyro_bias");
+	cal_h = get_param_handle_by_name("cal");
+	label_h = get_param_handle_by_name("label");
+	log_h = get_param_handle_by_name("log");
+	// Without _at the first element, the others untouched
+	TEST_CHECK(param_set_double_at(bias_h, 1, 2.5) == EXIT_SUCCESS);
+	TEST_CHECK(param_set_double_at(bias_h, 2, -3.5) == EXIT_SUCCESS);
+	TEST_CHECK(param_set_double(bias_h, 0.125) == EXIT_SUCCESS);
+	TEST_CHECK(param_get_double(bias_h) == 0.125);
+	TEST_CHECK(param_get_double_at(bias_h, 1) == 2.5 && param_get_double_at(bias_h, 2) == -3.5);
+	TEST_CHECK(param_set_double_at(bias_h, 3, 1) == EXIT_FAILURE && param_get_double_at(bias_h, 3) == 0);
+	// As text, elements separated by PARAM_ARRAY_SEPARATOR
+	TEST_CHECK(param_to_str(bias_h, buff, sizeof(buff)) == EXIT_SUCCESS && strcmp(buff, "0.125;2.5;-3.5") == 0);
+	TEST_CHECK(param_to_str(bias_h, buff, 10) == EXIT_FAILURE);
+	TEST_CHECK(str_to_param(bias_h, " 1 ; 2") == EXIT_SUCCESS);
+	TEST_CHECK(param_get_double_at(bias_h, 1) == 2 && param_get_double_at(bias_h, 2) == -3.5);
+	TEST_CHECK(str_to_param(bias_h, "1;2;3;4") == EXIT_FAILURE && str_to_param(bias_h, "1;x") == EXIT_FAILURE);
+	// Text longer than a chunk
+	for(i = 0; i < 100; i++) TEST_CHECK(param_set_i16_at(cal_h, i, -i) == EXIT_SUCCESS);
+	TEST_CHECK(param_to_str(cal_h, buff, sizeof(buff)) == EXIT_FAILURE);
+	TEST_CHECK(str_to_param(cal_h, "7;8;9") == EXIT_SUCCESS && param_get_i16_at(cal_h, 2) == 9 && param_get_i16_at(cal_h, 99) == -99);
+	beacon[0] = '\0';
+	collect_telemetry_params(beacon, sizeof(beacon));
+	TEST_CHECK(strncmp(beacon, "A:7;8;9;-3;", 11) == 0 && strcmp(beacon + strlen(beacon) - 4, ";-99") == 0);
+	beacon[0] = '\0';
+	collect_telemetry_params(beacon, 100);
+	TEST_CHECK(beacon[0] == '\0');
+	// Strings may fill the whole size, longer ones are not valid
+	TEST_CHECK(str_to_param(label_h, "12345678") == EXIT_SUCCESS);
+	TEST_CHECK(param_to_str(label_h, buff, sizeof(buff)) == EXIT_SUCCESS && strcmp(buff, "12345678") == 0);
+	TEST_CHECK(param_to_str(label_h, buff, 8) == EXIT_FAILURE);
+	TEST_CHECK(str_to_param(label_h, "123456789") == EXIT_FAILURE);
+	TEST_CHECK(str_to_param(label_h, "") == EXIT_SUCCESS);
+	TEST_CHECK(param_to_str(label_h, buff, sizeof(buff)) == EXIT_SUCCESS && strcmp(buff, "") == 0);
+	memset(long_str, 'x', 200);
+	long_str[200] = '\0';
+	TEST_CHECK(str_to_param(log_h, long_str) == EXIT_SUCCESS);
+	TEST_CHECK(str_to_param(log_h, "short") == EXIT_SUCCESS);
+	TEST_CHECK(param_to_str(log_h, buff, sizeof(buff)) == EXIT_SUCCESS && strcmp(buff, "short") == 0);
+	return EXIT_SUCCESS;
+}
+
+
+// Binary beacon: TELEMETRY values in table order with their native width, as many as fit
+static int test_telemetry_bin(void)
+{
+	static param_table_t table = {
+		{.name="mode",		.type=UINT8_PARAM,	.size=UINT8_SIZE,	.opts=TELEMETRY},
+		{.name="uptime",	.type=UINT32_PARAM,	.size=UINT32_SIZE,	.opts=TELEMETRY},
+		{.name="config",	.type=UINT16_PARAM,	.size=UINT16_SIZE},
+		{.name="volt",		.type=FLOAT_PARAM,	.size=FLOAT_SIZE,	.opts=TELEMETRY},
+	};
+	beacon_header_t header;
+	uint8_t beacon[64];
+	uint32_t uptime;
+	float volt;
+	const uint16_t endian_test = 1;
+	TEST_CHECK(set_param_table(&table, sizeof(table)/sizeof(*table)) == EXIT_SUCCESS);
+	TEST_CHECK(param_set_u8(get_param_handle_by_name("mode"), 3) == EXIT_SUCCESS);
+	TEST_CHECK(param_set_u32(get_param_handle_by_name("uptime"), 123456) == EXIT_SUCCESS);
+	TEST_CHECK(param_set_u16(get_param_handle_by_name("config"), 0xFFFF) == EXIT_SUCCESS);
+	TEST_CHECK(param_set_float(get_param_handle_by_name("volt"), 7.25f) == EXIT_SUCCESS);
+	collect_telemetry_params_bin((char *) beacon, sizeof(beacon));
+	memcpy(&header, beacon, sizeof(header));
+	TEST_CHECK(header.marker == BEACON_BINARY_MARKER);
+	TEST_CHECK(header.flags == ((*(const uint8_t *) &endian_test) ? BEACON_FLAG_LE : 0));
+	TEST_CHECK(csp_ntoh16(header.params_num) == 3 && csp_ntoh16(header.length) == UINT8_SIZE + UINT32_SIZE + FLOAT_SIZE);
+	TEST_CHECK(csp_ntoh32(header.schema) == get_telemetry_schema());
+	memcpy(&uptime, beacon + sizeof(header) + UINT8_SIZE, sizeof(uptime));
+	memcpy(&volt, beacon + sizeof(header) + UINT8_SIZE + UINT32_SIZE, sizeof(volt));
+	TEST_CHECK(beacon[sizeof(header)] == 3 && uptime == 123456 && volt == 7.25f);
+	// Not enough space for the last value, the header tells it is not there
+	collect_telemetry_params_bin((char *) beacon, sizeof(header) + UINT8_SIZE + UINT32_SIZE + 1);
+	memcpy(&header, beacon, sizeof(header));
+	TEST_CHECK(csp_ntoh16(header.params_num) == 2 && csp_ntoh16(header.length) == UINT8_SIZE + UINT32_SIZE);
+	return EXIT_SUCCESS;
+}
+
+
+// Access statistics: reads and writes of the app are counted, reads of the framework are not
+static int test_stats(void)
+{
+	static param_table_t table = {
+		{.name="temp",	.type=FLOAT_PARAM,	.size=2*FLOAT_SIZE,	.opts=TELEMETRY},
+		{.name="name",	.type=STRING_PARAM,	.size=16},
+	};
+	param_stats_t stats;
+	param_handle_t temp_h, name_h;
+	float temp[2];
+	char buff[64];
+	TEST_CHECK(set_param_table(&table, sizeof(table)/sizeof(*table)) == EXIT_SUCCESS);
+	param_reset_stats();
+	temp_h = get_param_handle_by_name("temp");
+	name_h = get_param_handle_by_name("name");
+	TEST_CHECK(param_set_float_at(temp_h, 1, 20.5f) == EXIT_SUCCESS);
+	TEST_CHECK(get_param_val(temp_h, temp) == EXIT_SUCCESS && temp[1] == 20.5f);
+	TEST_CHECK(param_get_float(temp_h) == 0);
+	TEST_CHECK(str_to_param(name_h, "obc") == EXIT_SUCCESS);
+	// Not counted
+	TEST_CHECK(param_to_str(temp_h, buff, sizeof(buff)) == EXIT_SUCCESS);
+	TEST_CHECK(param_to_str(name_h, buff, sizeof(buff)) == EXIT_SUCCESS && strcmp(buff, "obc") == 0);
+	buff[0] = '\0';
+	collect_telemetry_params(buff, sizeof(buff));
+	TEST_CHECK(strcmp(buff, "A:0;20.5") == 0);
+	TEST_CHECK(param_get_elems_uncounted(temp_h, 0, 2, temp) == EXIT_SUCCESS);
+	TEST_CHECK(param_get_stats(0, &stats) == EXIT_SUCCESS);
+	TEST_CHECK(stats.reads == 2 && stats.writes == 1 && stats.lookups == 1);
+	TEST_CHECK(param_get_stats(1, &stats) == EXIT_SUCCESS);
+	TEST_CHECK(stats.reads == 0 && stats.writes == 1);
+	return EXIT_SUCCESS;
+}
+
+
+// Compute of the derived test, the sum of the two first params, fails if the sum is negative
+// Counts the computes made while the param is being written, readers would wait for them
+static int derived_computes;
+static int derived_locked;
+static int compute_sum(param_handle_t param_h, void * out_p, void * ctx)
+{
+	int32_t sum = param_get_i32(get_param_handle_by_index(0)) + param_get_i32(get_param_handle_by_index(1));
+	(void) ctx;
+	derived_computes++;
+	if(param_seq_p[param_h - get_param_handle_by_index(0)] & 1) derived_locked++;
+	if(sum < 0) return EXIT_FAILURE;
+	memcpy(out_p, &sum, sizeof(sum));
+	return EXIT_SUCCESS;
+}
+
+
+// Derived params: computed when a dependency changes, marked as written only if the value changed
+static int test_derived(void)
+{
+	static param_table_t table = {
+		{.name="a",		.type=INT32_PARAM,	.size=INT32_SIZE},
+		{.name="b",		.type=INT32_PARAM,	.size=INT32_SIZE},
+		{.name="sum",	.type=INT32_PARAM,	.size=INT32_SIZE},
+	};
+	static const param_index_t deps[] = {0, 1};
+	static const param_index_t new_deps[] = {1};
+	param_handle_t a_h, b_h, sum_h;
+	uint32_t writes;
+	int32_t sum;
+	TEST_CHECK(set_param_table(&table, sizeof(table)/sizeof(*table)) == EXIT_SUCCESS);
+	a_h = get_param_handle_by_name("a");
+	b_h = get_param_handle_by_name("b");
+	sum_h = get_param_handle_by_name("sum");
+	TEST_CHECK(param_set_derived(sum_h, compute_sum, NULL, 0, deps, 2) == EXIT_SUCCESS);
+	TEST_CHECK(param_set_i32(a_h, 2) == EXIT_SUCCESS && param_set_i32(b_h, 3) == EXIT_SUCCESS);
+	// Computed once, then cached until a dependency is written
+	derived_computes = 0;
+	derived_locked = 0;
+	writes = param_write_count;
+	TEST_CHECK(param_get_i32(sum_h) == 5 && param_get_i32(sum_h) == 5);
+	TEST_CHECK(derived_computes == 1 && param_write_count == writes + 1 && derived_locked == 0);
+	// Computed again with the same value, not written
+	TEST_CHECK(param_set_i32(a_h, 4) == EXIT_SUCCESS && param_set_i32(b_h, 1) == EXIT_SUCCESS);
+	writes = param_write_count;
+	TEST_CHECK(param_get_i32(sum_h) == 5);
+	TEST_CHECK(derived_computes == 2 && param_write_count == writes);
+	// Writes are ignored, a failed compute keeps the last value and is not written
+	TEST_CHECK(param_set_i32(sum_h, 100) == EXIT_SUCCESS && param_get_i32(sum_h) == 5);
+	TEST_CHECK(param_set_i32(b_h, -10) == EXIT_SUCCESS);
+	writes = param_write_count;
+	TEST_CHECK(get_param_val(sum_h, &sum) == EXIT_FAILURE && sum == 5 && param_write_count == writes);
+	// Params no longer computed from are plain again
+	TEST_CHECK((a_h->opts & DEPENDENCY) && (b_h->opts & DEPENDENCY));
+	TEST_CHECK(param_set_derived(sum_h, compute_sum, NULL, 0, new_deps, 1) == EXIT_SUCCESS);
+	TEST_CHECK(!(a_h->opts & DEPENDENCY) && (b_h->opts & DEPENDENCY));
+	TEST_CHECK(param_set_derived(sum_h, NULL, NULL, 0, NULL, 0) == EXIT_SUCCESS);
+	TEST_CHECK(!(a_h->opts & DEPENDENCY) && !(b_h->opts & DEPENDENCY) && !(sum_h->opts & DERIVED));
+	return EXIT_SUCCESS;
+}
+
+
+// Device of the backed test, a 16 bits register
+static uint16_t backed_register;
+static int backed_fails;
+static int backed_fetches;
+static int backed_locked;
+static int fetch_register(param_handle_t param_h, void * out_p, void * ctx)
+{
+	(void) ctx;
+	backed_fetches++;
+	if(param_seq_p[param_h - get_param_handle_by_index(0)] & 1) backed_locked++;
+	memcpy(out_p, &backed_register, sizeof(backed_register));
+	return EXIT_SUCCESS;
+}
+static int store_register(param_handle_t param_h, const void * in_p, void * ctx)
+{
+	(void) ctx;
+	if(param_seq_p[param_h - get_param_handle_by_index(0)] & 1 || param_bulk_seq & 1) backed_locked++;
+	if(backed_fails) return EXIT_FAILURE;
+	memcpy(&backed_register, in_p, sizeof(backed_register));
+	return EXIT_SUCCESS;
+}
+
+
+// Hardware backed params: read and written through without locks, a failed store sets nothing
+static int test_backed(void)
+{
+	static param_table_t table = {
+		{.name="dac",	.type=UINT16_PARAM,	.size=UINT16_SIZE,	.opts=PERSISTENT},
+		{.name="mode",	.type=UINT32_PARAM,	.size=UINT32_SIZE},
+	};
+	static const param_index_t both[] = {0, 1};
+	param_handle_t dac_h, mode_h;
+	uint8_t buff[UINT16_SIZE + UINT32_SIZE];
+	uint16_t dac;
+	uint32_t mode;
+	TEST_CHECK(set_param_table(&table, sizeof(table)/sizeof(*table)) == EXIT_SUCCESS);
+	dac_h = get_param_handle_by_name("dac");
+	mode_h = get_param_handle_by_name("mode");
+	backed_register = 10;
+	backed_fails = 0;
+	backed_fetches = 0;
+	backed_locked = 0;
+	// Fetched on every read without max age
+	TEST_CHECK(param_set_backed(dac_h, fetch_register, store_register, NULL, 0) == EXIT_SUCCESS);
+	TEST_CHECK(param_get_u16(dac_h) == 10);
+	backed_register = 11;
+	TEST_CHECK(param_get_u16(dac_h) == 11 && backed_fetches == 2);
+	// Cached within the max age, a write is what the device has
+	TEST_CHECK(param_set_backed(dac_h, fetch_register, store_register, NULL, 60000) == EXIT_SUCCESS);
+	TEST_CHECK(param_get_u16(dac_h) == 11 && param_get_u16(dac_h) == 11 && backed_fetches == 3);
+	TEST_CHECK(param_set_u16(dac_h, 20) == EXIT_SUCCESS && backed_register == 20);
+	TEST_CHECK(param_get_u16(dac_h) == 20 && backed_fetches == 3);
+	// A failed store keeps the cached value, and the next read fetches what the device has
+	backed_fails = 1;
+	TEST_CHECK(param_set_u16(dac_h, 30) == EXIT_FAILURE && backed_register == 20);
+	TEST_CHECK(param_get_u16(dac_h) == 20 && backed_fetches == 4);
+	// A batch is not set if a store fails
+	dac = 40;
+	mode = 7;
+	memcpy(buff, &dac, sizeof(dac));
+	memcpy(buff + sizeof(dac), &mode, sizeof(mode));
+	TEST_CHECK(param_set_many(both, 2, buff, sizeof(buff)) == EXIT_FAILURE);
+	TEST_CHECK(param_get_u32(mode_h) == 0 && backed_register == 20);
+	backed_fails = 0;
+	TEST_CHECK(param_set_many(both, 2, buff, sizeof(buff)) == EXIT_SUCCESS);
+	TEST_CHECK(backed_register == 40 && param_get_u32(mode_h) == 7);
+	TEST_CHECK(param_get_u16(dac_h) == 40 && backed_fetches == 4);
+	TEST_CHECK(backed_locked == 0);
+	TEST_CHECK(param_set_backed(dac_h, NULL, NULL, NULL, 0) == EXIT_SUCCESS);
+	return EXIT_SUCCESS;
+}
+
+
+// Delta beacons: only the values changed since the last one sent, floats past their deadband
+static int test_delta(void)
+{
+	static param_table_t table = {
+		{.name="count",	.type=UINT32_PARAM,	.size=UINT32_SIZE,	.opts=TELEMETRY},
+		{.name="mode",	.type=UINT8_PARAM,	.size=UINT8_SIZE},
+		{.name="temp",	.type=FLOAT_PARAM,	.size=2*FLOAT_SIZE,	.opts=TELEMETRY},
+		{.name="label",	.type=STRING_PARAM,	.size=10,			.opts=TELEMETRY},
+	};
+	uint8_t beacon[100];
+	beacon_header_t header;
+	uint8_t * values = beacon + sizeof(header) + 2;
+	uint32_t count;
+	float temp;
+	param_handle_t count_h, temp_h;
+	TEST_CHECK(set_param_table(&table, sizeof(table)/sizeof(*table)) == EXIT_SUCCESS);
+	count_h = get_param_handle_by_name("count");
+	temp_h = get_param_handle_by_name("temp");
+	TEST_CHECK(param_set_deadband(temp_h, 0.5) == EXIT_SUCCESS);
+	TEST_CHECK(param_set_deadband(count_h, 0.5) == EXIT_FAILURE);
+	param_delta_keyframe();
+	// Keyframe with all the values, after the header the sequence number and the bitmap
+	collect_telemetry_params_delta((char *) beacon, sizeof(beacon));
+	memcpy(&header, beacon, sizeof(header));
+	TEST_CHECK(header.marker == BEACON_BINARY_MARKER && (header.flags & BEACON_FLAG_DELTA) && (header.flags & BEACON_FLAG_KEYFRAME));
+	TEST_CHECK(csp_ntoh16(header.params_num) == 3 && csp_ntoh16(header.length) == 2 + UINT32_SIZE + 2*FLOAT_SIZE + 10);
+	TEST_CHECK(beacon[sizeof(header) + 1] == 0x07);
+	// Nothing changed
+	collect_telemetry_params_delta((char *) beacon, sizeof(beacon));
+	memcpy(&header, beacon, sizeof(header));
+	TEST_CHECK(!(header.flags & BEACON_FLAG_KEYFRAME) && beacon[sizeof(header) + 1] == 0 && csp_ntoh16(header.length) == 2);
+	// Only the changed value
+	TEST_CHECK(param_set_u32(count_h, 7) == EXIT_SUCCESS);
+	collect_telemetry_params_delta((char *) beacon, sizeof(beacon));
+	memcpy(&header, beacon, sizeof(header));
+	memcpy(&count, values, sizeof(count));
+	TEST_CHECK(beacon[sizeof(header) + 1] == 0x01 && csp_ntoh16(header.length) == 2 + UINT32_SIZE && count == 7);
+	// Float moves within the deadband are not sent, but add up
+	TEST_CHECK(param_set_float_at(temp_h, 1, 0.25f) == EXIT_SUCCESS);
+	collect_telemetry_params_delta((char *) beacon, sizeof(beacon));
+	TEST_CHECK(beacon[sizeof(header) + 1] == 0);
+	TEST_CHECK(param_set_float_at(temp_h, 1, 0.75f) == EXIT_SUCCESS);
+	collect_telemetry_params_delta((char *) beacon, sizeof(beacon));
+	memcpy(&temp, values + FLOAT_SIZE, sizeof(temp));
+	TEST_CHECK(beacon[sizeof(header) + 1] == 0x02 && temp == 0.75f);
+	// A keyframe on request
+	param_delta_keyframe();
+	collect_telemetry_params_delta((char *) beacon, sizeof(beacon));
+	memcpy(&header, beacon, sizeof(header));
+	TEST_CHECK((header.flags & BEACON_FLAG_KEYFRAME) && beacon[sizeof(header) + 1] == 0x07);
+	// A keyframe without room for all the values is not one, the next beacon is
+	param_delta_keyframe();
+	collect_telemetry_params_delta((char *) beacon, sizeof(header) + 2 + UINT32_SIZE + 2*FLOAT_SIZE);
+	memcpy(&header, beacon, sizeof(header));
+	TEST_CHECK(!(header.flags & BEACON_FLAG_KEYFRAME) && beacon[sizeof(header) + 1] == 0x03);
+	collect_telemetry_params_delta((char *) beacon, sizeof(beacon));
+	memcpy(&header, beacon, sizeof(header));
+	TEST_CHECK((header.flags & BEACON_FLAG_KEYFRAME) && beacon[sizeof(header) + 1] == 0x07);
+	return EXIT_SUCCESS;
+}
+
+
+// Writer of the seqlock tests, fills the string with a single char, another each time
+// As a value or as text, the null-character of the text is the last char of the value
+static volatile int seqlock_writing;
+static int seqlock_text;
+static param_handle_t seqlock_h;
+CSP_DEFINE_TASK( seqlock_writer_task )
+{
+	char value[4096];
+	char c = 'a';
+	while(seqlock_writing)
+	{
+		memset(value, c, sizeof(value));
+		if(seqlock_text)
+		{
+			value[sizeof(value) - 1] = '\0';
+			str_to_param(seqlock_h, value);
+		}
+		else set_param_val(seqlock_h, value);
+		c = (c == 'z') ? 'a' : c + 1;
+	}
+	seqlock_writing = -1;
+	return CSP_TASK_RETURN;
+}
+
+
+// Read the value while the writer runs, returns the reads until one is torn
+static int read_while_writing(int text)
+{
+	char value[4096];
+	int i, j, length;
+	csp_thread_handle_t handle;
+	length = text ? (int) sizeof(value) - 1 : (int) sizeof(value);
+	seqlock_text = text;
+	seqlock_writing = 1;
+	if(csp_thread_create(seqlock_writer_task, "WRITER", CONF_MINIMAL_STACK_SIZE, NULL, 1, &handle) != 0) return 0;
+	for(i = 0; i < 20000; i++)
+	{
+		if(get_param_val(seqlock_h, value) != EXIT_SUCCESS) break;
+		for(j = 1; j < length; j++) if(value[j] != value[0]) break;
+		if(j < length) break;
+	}
+	seqlock_writing = 0;
+	while(seqlock_writing == 0) csp_sleep_ms(1);
+	return i;
+}
+
+
+// Sequence locks: a value read while another task writes it is never torn
+static int test_seqlock(void)
+{
+	static param_table_t table = {
+		{.name="text",	.type=STRING_PARAM,	.size=4096},
+	};
+	char value[4096];
+	TEST_CHECK(set_param_table(&table, sizeof(table)/sizeof(*table)) == EXIT_SUCCESS);
+	seqlock_h = get_param_handle_by_name("text");
+	memset(value, 'a', sizeof(value));
+	TEST_CHECK(set_param_val(seqlock_h, value) == EXIT_SUCCESS);
+	TEST_CHECK(read_while_writing(0) == 20000);
+	return EXIT_SUCCESS;
+}
+
+
+// Sequence locks: a value set from text larger than a chunk is written at once, never torn
+static int test_seqlock_text(void)
+{
+	static param_table_t table = {
+		{.name="text",	.type=STRING_PARAM,	.size=4096},
+		{.name="array",	.type=UINT32_PARAM,	.size=100*UINT32_SIZE},
+	};
+	char text[4096];
+	param_stats_t before, after;
+	param_handle_t array_h;
+	uint32_t values[100];
+	int i, len;
+	TEST_CHECK(set_param_table(&table, sizeof(table)/sizeof(*table)) == EXIT_SUCCESS);
+	seqlock_h = get_param_handle_by_name("text");
+	memset(text, 'a', sizeof(text) - 1);
+	text[sizeof(text) - 1] = '\0';
+	TEST_CHECK(str_to_param(seqlock_h, text) == EXIT_SUCCESS);
+	TEST_CHECK(read_while_writing(1) == 20000);
+	// An array from text is one write
+	array_h = get_param_handle_by_name("array");
+	len = 0;
+	for(i = 0; i < 100; i++) len += sprintf(text + len, "%s%d", i ? ";" : "", 1000 + i);
+	TEST_CHECK(param_get_stats(1, &before) == EXIT_SUCCESS);
+	TEST_CHECK(str_to_param(array_h, text) == EXIT_SUCCESS);
+	TEST_CHECK(param_get_stats(1, &after) == EXIT_SUCCESS);
+	TEST_CHECK(after.writes == before.writes + 1);
+	TEST_CHECK(get_param_val(array_h, values) == EXIT_SUCCESS);
+	for(i = 0; i < 100; i++) TEST_CHECK(values[i] == 1000u + i);
+	// Nothing set if an element is not valid
+	text[len - 1] = 'x';
+	TEST_CHECK(str_to_param(array_h, text) == EXIT_FAILURE);
+	TEST_CHECK(param_get_stats(1, &before) == EXIT_SUCCESS);
+	TEST_CHECK(before.writes == after.writes);
+	return EXIT_SUCCESS;
+}
+
+
+// A UINT32 param of the snapshot test
+#define SNAPSHOT_PARAM(n)	{.name="p" #n,	.type=UINT32_PARAM,	.size=UINT32_SIZE}
+
+// Snapshot: only params written since the last snapshot are copied, parameterized variables always
+static int test_snapshot(void)
+{
+	static uint32_t var;
+	// Two words of changed bits, the variable in the second
+	static param_table_t table = {
+		SNAPSHOT_PARAM(0), SNAPSHOT_PARAM(1), SNAPSHOT_PARAM(2), SNAPSHOT_PARAM(3), SNAPSHOT_PARAM(4),
+		SNAPSHOT_PARAM(5), SNAPSHOT_PARAM(6), SNAPSHOT_PARAM(7), SNAPSHOT_PARAM(8), SNAPSHOT_PARAM(9),
+		SNAPSHOT_PARAM(10), SNAPSHOT_PARAM(11), SNAPSHOT_PARAM(12), SNAPSHOT_PARAM(13), SNAPSHOT_PARAM(14),
+		SNAPSHOT_PARAM(15), SNAPSHOT_PARAM(16), SNAPSHOT_PARAM(17), SNAPSHOT_PARAM(18), SNAPSHOT_PARAM(19),
+		SNAPSHOT_PARAM(20), SNAPSHOT_PARAM(21), SNAPSHOT_PARAM(22), SNAPSHOT_PARAM(23), SNAPSHOT_PARAM(24),
+		SNAPSHOT_PARAM(25), SNAPSHOT_PARAM(26), SNAPSHOT_PARAM(27), SNAPSHOT_PARAM(28), SNAPSHOT_PARAM(29),
+		SNAPSHOT_PARAM(30), SNAPSHOT_PARAM(31), SNAPSHOT_PARAM(32), SNAPSHOT_PARAM(33),
+		{.name="var",	.type=UINT32_PARAM,	.size=UINT32_SIZE,	.value=&var},
+	};
+	uint32_t value;
+	int i;
+	TEST_CHECK(set_param_table(&table, sizeof(table)/sizeof(*table)) == EXIT_SUCCESS);
+	// A new table is copied whole on the first snapshot
+	for(i = 0; i < 35; i++) TEST_CHECK(param_snapshot.changed[i >> 5] & (1u << (i & 31)));
+	TEST_CHECK(param_snapshot.vars[0] == 0 && param_snapshot.vars[1] == (1u << 2));
+	for(i = 0; i < 34; i++) TEST_CHECK(param_set_u32(get_param_handle_by_index(i), 100 + i) == EXIT_SUCCESS);
+	var = 7;
+	TEST_CHECK(param_snapshot_take() == EXIT_SUCCESS);
+	TEST_CHECK(param_snapshot.changed[0] == 0 && param_snapshot.changed[1] == 0);
+	for(i = 0; i < 34; i++) TEST_CHECK(param_snapshot_get(i, &value) == EXIT_SUCCESS && value == 100u + i);
+	TEST_CHECK(param_snapshot_get(34, &value) == EXIT_SUCCESS && value == 7);
+	param_snapshot_release();
+	// Only written params set their bit, writing the same value is not a change
+	TEST_CHECK(param_set_u32(get_param_handle_by_index(3), 3) == EXIT_SUCCESS);
+	TEST_CHECK(param_set_u32(get_param_handle_by_index(33), 33) == EXIT_SUCCESS);
+	TEST_CHECK(param_set_u32(get_param_handle_by_index(5), 105) == EXIT_SUCCESS);
+	TEST_CHECK(param_snapshot.changed[0] == (1u << 3) && param_snapshot.changed[1] == (1u << 1));
+	// Written without the Param Service, not copied until marked
+	value = 999;
+	memcpy(get_param_handle_by_index(10)->value, &value, sizeof(value));
+	var = 8;
+	TEST_CHECK(param_snapshot_take() == EXIT_SUCCESS);
+	TEST_CHECK(param_snapshot.changed[0] == 0 && param_snapshot.changed[1] == 0);
+	TEST_CHECK(param_snapshot_get(3, &value) == EXIT_SUCCESS && value == 3);
+	TEST_CHECK(param_snapshot_get(33, &value) == EXIT_SUCCESS && value == 33);
+	TEST_CHECK(param_snapshot_get(10, &value) == EXIT_SUCCESS && value == 110);
+	TEST_CHECK(param_snapshot_get(34, &value) == EXIT_SUCCESS && value == 8);
+	param_snapshot_release();
+	return EXIT_SUCCESS;
+}
+
+
+// Writer of the bulk test, sets the quaternion to all ones or all twos
+static volatile int bulk_writing;
+static const param_index_t bulk_quaternion[] = {0, 1, 2, 3};
+CSP_DEFINE_TASK( bulk_writer_task )
+{
+	float q[4];
+	int i;
+	float value = 1;
+	while(bulk_writing)
+	{
+		for(i = 0; i < 4; i++) q[i] = value;
+		param_set_many(bulk_quaternion, 4, q, sizeof(q));
+		value = (value == 1) ? 2 : 1;
+	}
+	bulk_writing = -1;
+	return CSP_TASK_RETURN;
+}
+
+
+// Bulk access: values packed in order, a bad set writes nothing, a get never sees part of a set
+static int test_bulk(void)
+{
+	static param_table_t table = {
+		{.name="q0",		.type=FLOAT_PARAM,	.size=FLOAT_SIZE},
+		{.name="q1",		.type=FLOAT_PARAM,	.size=FLOAT_SIZE},
+		{.name="q2",		.type=FLOAT_PARAM,	.size=FLOAT_SIZE},
+		{.name="q3",		.type=FLOAT_PARAM,	.size=FLOAT_SIZE},
+		{.name="mode",		.type=UINT16_PARAM,	.size=UINT16_SIZE},
+		{.name="serial",	.type=UINT8_PARAM,	.size=UINT8_SIZE,	.opts=READ_ONLY},
+	};
+	const param_index_t mixed[] = {4, 0};
+	const param_index_t with_read_only[] = {0, 5};
+	const param_index_t not_valid[] = {0, 6};
+	uint8_t buff[16];
+	uint16_t mode = 0x1234;
+	float q[4] = {0.5f, -0.5f, 0.25f, -0.25f};
+	float q_back[4];
+	int i;
+	csp_thread_handle_t handle;
+	TEST_CHECK(set_param_table(&table, sizeof(table)/sizeof(*table)) == EXIT_SUCCESS);
+	TEST_CHECK(param_get_many_size(bulk_quaternion, 4) == sizeof(q));
+	TEST_CHECK(param_get_many_size(not_valid, 2) == -1);
+	TEST_CHECK(param_set_many(bulk_quaternion, 4, q, sizeof(q)) == EXIT_SUCCESS);
+	TEST_CHECK(param_get_many(bulk_quaternion, 4, q_back, sizeof(q_back)) == sizeof(q_back));
+	TEST_CHECK(memcmp(q, q_back, sizeof(q)) == 0);
+	// Packed in the order of the indexes
+	memcpy(buff, &mode, sizeof(mode));
+	memcpy(buff + sizeof(mode), &q[3], sizeof(float));
+	TEST_CHECK(param_set_many(mixed, 2, buff, sizeof(mode) + sizeof(float)) == EXIT_SUCCESS);
+	TEST_CHECK(param_get_u16(get_param_handle_by_name("mode")) == 0x1234);
+	TEST_CHECK(param_get_float(get_param_handle_by_name("q0")) == -0.25f);
+	// Nothing written if a param is READ_ONLY, wrong size or buffer too small
+	TEST_CHECK(param_set_many(with_read_only, 2, buff, sizeof(float) + 1) == EXIT_FAILURE);
+	TEST_CHECK(param_set_many(bulk_quaternion, 4, q, sizeof(q) - 1) == EXIT_FAILURE);
+	TEST_CHECK(param_get_float(get_param_handle_by_name("q0")) == -0.25f);
+	TEST_CHECK(param_get_many(bulk_quaternion, 4, q_back, sizeof(q_back) - 1) == -1);
+	// All or nothing while another task sets them
+	for(i = 0; i < 4; i++) q[i] = 1;
+	TEST_CHECK(param_set_many(bulk_quaternion, 4, q, sizeof(q)) == EXIT_SUCCESS);
+	bulk_writing = 1;
+	TEST_CHECK(csp_thread_create(bulk_writer_task, "WRITER", CONF_MINIMAL_STACK_SIZE, NULL, 1, &handle) == 0);
+	for(i = 0; i < 100000; i++)
+	{
+		TEST_CHECK(param_get_many(bulk_quaternion, 4, q_back, sizeof(q_back)) == sizeof(q_back));
+		if(q_back[0] != q_back[1] || q_back[0] != q_back[2] || q_back[0] != q_back[3]) break;
+	}
+	bulk_writing = 0;
+	while(bulk_writing == 0) csp_sleep_ms(1);
+	TEST_CHECK(i == 100000);
+	return EXIT_SUCCESS;
+}
+
+
+// Subscribers of the subscriptions test, the first one hands over to the second
+static volatile int first_changes, second_changes;
+static void second_subscriber(param_handle_t param_h, const param_change_t * change, void * ctx)
+{
+	(void) param_h;
+	(void) change;
+	(void) ctx;
+	second_changes++;
+}
+static void first_subscriber(param_handle_t param_h, const param_change_t * change, void * ctx)
+{
+	(void) change;
+	first_changes++;
+	param_unsubscribe(param_h, first_subscriber, ctx);
+	param_subscribe(param_h, second_subscriber, ctx);
+}
+
+
+// Subscriptions: callbacks get the changes, and may subscribe and unsubscribe
+static int test_subscriptions(void)
+{
+	static param_table_t table = {
+		{.name="mode",	.type=UINT8_PARAM,	.size=UINT8_SIZE},
+	};
+	param_handle_t param_h;
+	TEST_CHECK(set_param_table(&table, sizeof(table)/sizeof(*table)) == EXIT_SUCCESS);
+	TEST_CHECK(init_param_notifications() == EXIT_SUCCESS);
+	param_h = get_param_handle_by_name("mode");
+	TEST_CHECK(param_subscribe(param_h, first_subscriber, NULL) == EXIT_SUCCESS);
+	TEST_CHECK(param_set_u8(param_h, 1) == EXIT_SUCCESS);
+	csp_sleep_ms(200);
+	TEST_CHECK(first_changes == 1 && second_changes == 0);
+	TEST_CHECK(param_set_u8(param_h, 2) == EXIT_SUCCESS);
+	csp_sleep_ms(200);
+	TEST_CHECK(first_changes == 1 && second_changes == 1);
+	// Same value, no change
+	TEST_CHECK(param_set_u8(param_h, 2) == EXIT_SUCCESS);
+	csp_sleep_ms(200);
+	TEST_CHECK(second_changes == 1);
+	TEST_CHECK(param_unsubscribe(param_h, second_subscriber, NULL) == EXIT_SUCCESS);
+	TEST_CHECK(param_unsubscribe(param_h, second_subscriber, NULL) == EXIT_FAILURE);
+	return EXIT_SUCCESS;
+}
+
+
+// A/B image: each store goes to the other slot, a broken newest slot falls back to the older one
+// Runs last, the persistence task keeps running
+static int test_param_image(void)
+{
+	static param_table_t table = {
+		{.name="counter",	.type=UINT32_PARAM,	.size=UINT32_SIZE,	.opts=PERSISTENT},
+		{.name="volatile",	.type=UINT32_PARAM,	.size=UINT32_SIZE},
+	};
+	param_handle_t counter_h;
+	uint32_t value;
+	FILE_T fd;
+	file_remove(CONF_PARAM_IMAGE_FILE_A);
+	file_remove(CONF_PARAM_IMAGE_FILE_B);
+	TEST_CHECK(set_param_table(&table, sizeof(table)/sizeof(*table)) == EXIT_SUCCESS);
+	counter_h = get_param_handle_by_name("counter");
+	TEST_CHECK(init_param_persistence() == EXIT_SUCCESS);
+	param_persist_period = 50;
+	// First store goes to slot B, the second to slot A
+	value = 1;
+	TEST_CHECK(set_param_val(counter_h, &value) == EXIT_SUCCESS);
+	csp_sleep_ms(CONF_PARAM_PERSIST_PERIOD + 200);
+	TEST_CHECK(param_image_slot == 1);
+	value = 2;
+	TEST_CHECK(set_param_val(counter_h, &value) == EXIT_SUCCESS);
+	csp_sleep_ms(200);
+	TEST_CHECK(param_image_slot == 0);
+	// The newest image is loaded
+	value = 0;
+	TEST_CHECK(set_param_val(counter_h, &value) == EXIT_SUCCESS);
+	TEST_CHECK(load_param_image() == EXIT_SUCCESS);
+	TEST_CHECK(get_param_val(counter_h, &value) == EXIT_SUCCESS && value == 2);
+	// A store interrupted in slot A, the image of slot B is loaded
+	param_persist_period = 60000;
+	csp_sleep_ms(200);
+	TEST_CHECK(file_open(&fd, CONF_PARAM_IMAGE_FILE_A, FILE_WRITE_CREATE) == 0 && file_write_bin(&fd, "SFSF", 4) == 4 && file_close(&fd) == 0);
+	TEST_CHECK(load_param_image() == EXIT_SUCCESS);
+	TEST_CHECK(get_param_val(counter_h, &value) == EXIT_SUCCESS && value == 1);
+	TEST_CHECK(param_image_slot == 1);
+	return EXIT_SUCCESS;
+}
+
+
+// Tests, run in order
+static const test_t tests[] = {
+	{"name_index",		test_name_index},
+	{"meta",			test_meta},
+	{"layout",			test_layout},
+	{"tables",			test_tables},
+	{"typed_accessors",	test_typed_accessors},
+	{"arrays",			test_arrays},
+	{"telemetry_bin",	test_telemetry_bin},
+	{"stats",			test_stats},
+	{"derived",			test_derived},
+	{"backed",			test_backed},
+	{"delta",			test_delta},
+	{"seqlock",			test_seqlock},
+	{"seqlock_text",		test_seqlock_text},
+	{"snapshot",		test_snapshot},
+	{"bulk",			test_bulk},
+	{"subscriptions",	test_subscriptions},
+	{"param_image",		test_param_image},
+};
+
+
+int main(void)
+{
+	return run_tests(tests, sizeof(tests)/sizeof(*tests));
+}
@@ -0,0 +1,121 @@
+/*
+Copyright 2018 olmanqj
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+of the Software, and to permit persons to whom the Software is furnished to do
+so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// CSP Includes
+#include <csp/csp.h>
+#include <csp/arch/csp_thread.h>
+
+// Framework Includes
+#include <sfsf.h>
+#include <sfsf_storage.h>
+#include <sfsf_param.h>
+#include <sfsf_hk.h>
+
+#include "sfsf_test.h"
+
+// Generated from param_table.def of this folder
+#include <param_table_gen.h>
+
+// Tests of the Parameter Table generated at build time
+
+
+// Lookups: every param of the generated table found by its name, at its PARAM_IDX_* index
+static int test_lookups(void)
+{
+	static const struct {
+		const char * name;
+		param_index_t index;
+	} params[] = {
+		{"mode",		PARAM_IDX_MODE},
+		{"label",		PARAM_IDX_LABEL},
+		{"gyro_bias",	PARAM_IDX_GYRO_BIAS},
+		{"eps.vbat",	PARAM_IDX_EPS_VBAT},
+		{"eps.uptime",	PARAM_IDX_EPS_UPTIME},
+		{"obc.temp",	PARAM_IDX_OBC_TEMP},
+		{"obc.mode",	PARAM_IDX_OBC_MODE},
+	};
+	int i;
+	TEST_CHECK(set_param_table_prebuilt(&mission_param_prebuilt) == EXIT_SUCCESS);
+	TEST_CHECK(get_table_size() == PARAM_TABLE_SIZE && PARAM_TABLE_SIZE == sizeof(params)/sizeof(*params));
+	for(i = 0; i < (int)(sizeof(params)/sizeof(*params)); i++)
+	{
+		TEST_CHECK(get_param_handle_by_name(params[i].name) == get_param_handle_by_index(params[i].index));
+	}
+	// Names of the tables have their prefix
+	TEST_CHECK(get_param_handle_by_name("vbat") == NULL);
+	TEST_CHECK(get_param_handle_by_name("eps.temp") == NULL);
+	TEST_CHECK(get_param_handle_by_name("") == NULL);
+	// By table and index in the table
+	TEST_CHECK(get_param_table_id("eps") == PARAM_TABLE_EPS);
+	TEST_CHECK(get_param_table_id("obc") == PARAM_TABLE_OBC);
+	TEST_CHECK(get_param_handle_by_ref(PARAM_TABLE_OBC, 1) == get_param_handle_by_index(PARAM_IDX_OBC_MODE));
+	// Values in the generated storage
+	TEST_CHECK(param_set_u16(get_param_handle_by_index(PARAM_IDX_EPS_VBAT), 7400) == EXIT_SUCCESS);
+	TEST_CHECK(param_get_u16(get_param_handle_by_name("eps.vbat")) == 7400);
+	TEST_CHECK(str_to_param(get_param_handle_by_name("label"), "generated") == EXIT_SUCCESS);
+	TEST_CHECK(strcmp((char *) get_param_handle_by_index(PARAM_IDX_LABEL)->value, "generated") == 0);
+	return EXIT_SUCCESS;
+}
+
+
+// Full index: a name index without empty slots, a missing name is not found after probing every slot
+static int test_full_index(void)
+{
+	static param_table_t table = {
+		{.name="alpha",		.type=UINT8_PARAM,	.size=UINT8_SIZE},
+		{.name="beta",		.type=UINT8_PARAM,	.size=UINT8_SIZE},
+		{.name="gamma",		.type=UINT8_PARAM,	.size=UINT8_SIZE},
+		{.name="delta",		.type=UINT8_PARAM,	.size=UINT8_SIZE},
+	};
+	// With every slot used, probing from any home slot reaches every param
+	static param_index_t full_index[] = {0, 1, 2, 3};
+	param_prebuilt_t prebuilt;
+	int i;
+	TEST_CHECK(set_param_name_index(full_index, sizeof(full_index)/sizeof(*full_index)) == EXIT_SUCCESS);
+	TEST_CHECK(set_param_table(&table, sizeof(table)/sizeof(*table)) == EXIT_SUCCESS);
+	for(i = 0; i < (int)(sizeof(table)/sizeof(*table)); i++)
+	{
+		TEST_CHECK(get_param_handle_by_name(table[i].name) == get_param_handle_by_index(i));
+	}
+	TEST_CHECK(get_param_handle_by_name("omega") == NULL);
+	// A prebuilt table with a full index is rejected
+	prebuilt = mission_param_prebuilt;
+	prebuilt.name_index_slots = PARAM_TABLE_SIZE;
+	TEST_CHECK(set_param_table_prebuilt(&prebuilt) == EXIT_FAILURE);
+	return EXIT_SUCCESS;
+}
+
+
+// Tests, run in order
+static const test_t tests[] = {
+	{"lookups",			test_lookups},
+	{"full_index",		test_full_index},
+};
+
+
+int main(void)
+{
+	return run_tests(tests, sizeof(tests)/sizeof(*tests));
+}
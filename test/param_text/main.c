@@ -0,0 +1,152 @@
+/*
+Copyright 2018 olmanqj
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+of the Software, and to permit persons to whom the Software is furnished to do
+so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// CSP Includes
+#include <csp/csp.h>
+#include <csp/arch/csp_thread.h>
+
+// Framework Includes
+#include <sfsf.h>
+#include <sfsf_storage.h>
+#include <sfsf_param.h>
+#include <sfsf_hk.h>
+
+#include "sfsf_test.h"
+
+// Tests of the text persistence of the Param Service, all on the same table
+// as the persistence task keeps running once started
+
+// Dirty flags, internal to the Param Service
+extern uint8_t * param_dirty_p;
+
+// Params of the tests, "log" as text does not fit in CONF_PARAM_MAX_PARAM_SIZE
+static param_table_t table = {
+	{.name="counter",	.type=UINT32_PARAM,	.size=UINT32_SIZE,	.opts=PERSISTENT},
+	{.name="volatile",	.type=UINT32_PARAM,	.size=UINT32_SIZE},
+	{.name="name",		.type=STRING_PARAM,	.size=16,			.opts=PERSISTENT},
+	{.name="log",		.type=STRING_PARAM,	.size=100,			.opts=PERSISTENT},
+};
+
+
+// Read the param file into buff, 0 if it can not be read
+static int read_param_file(char * buff, int buff_size)
+{
+	FILE * fd;
+	int len;
+	if((fd = fopen(CONF_PARAM_FILE_NAME, "r")) == NULL) return 0;
+	len = fread(buff, 1, buff_size - 1, fd);
+	buff[len] = '\0';
+	fclose(fd);
+	return len;
+}
+
+
+// Text records: the first store writes all PERSISTENT params, they are loaded back
+static int test_text_store(void)
+{
+	char file[512];
+	remove(CONF_PARAM_FILE_NAME);
+	TEST_CHECK(set_param_table(&table, sizeof(table)/sizeof(*table)) == EXIT_SUCCESS);
+	TEST_CHECK(init_param_persistence() == EXIT_SUCCESS);
+	param_persist_period = 50;
+	TEST_CHECK(param_set_u32(get_param_handle_by_name("counter"), 7) == EXIT_SUCCESS);
+	TEST_CHECK(str_to_param(get_param_handle_by_name("name"), "obc") == EXIT_SUCCESS);
+	csp_sleep_ms(CONF_PARAM_PERSIST_PERIOD + 200);
+	TEST_CHECK(read_param_file(file, sizeof(file)) > 0);
+	TEST_CHECK(strcmp(file, "counter,7\nname,obc\nlog,\n") == 0);
+	// Loaded back
+	TEST_CHECK(param_set_u32(get_param_handle_by_name("counter"), 0) == EXIT_SUCCESS);
+	TEST_CHECK(str_to_param(get_param_handle_by_name("name"), "") == EXIT_SUCCESS);
+	TEST_CHECK(load_param_table(CONF_PARAM_FILE_NAME) == EXIT_SUCCESS);
+	TEST_CHECK(param_get_u32(get_param_handle_by_name("counter")) == 7);
+	TEST_CHECK(param_to_str(get_param_handle_by_name("name"), file, sizeof(file)) == EXIT_SUCCESS && strcmp(file, "obc") == 0);
+	return EXIT_SUCCESS;
+}
+
+
+// Dirty tracking: nothing written without changes, only the changed params appended
+static int test_dirty_tracking(void)
+{
+	uint32_t bytes, skipped;
+	char file[512];
+	csp_sleep_ms(200);
+	bytes = param_persist_bytes;
+	skipped = param_persist_skipped;
+	// Without changes, or changes of params without PERSISTENT
+	csp_sleep_ms(200);
+	TEST_CHECK(param_persist_skipped > skipped && param_persist_bytes == bytes);
+	TEST_CHECK(param_set_u32(get_param_handle_by_name("volatile"), 1) == EXIT_SUCCESS);
+	TEST_CHECK(param_set_u32(get_param_handle_by_name("counter"), 7) == EXIT_SUCCESS);
+	csp_sleep_ms(200);
+	TEST_CHECK(param_persist_bytes == bytes);
+	// Only the changed param
+	TEST_CHECK(param_set_u32(get_param_handle_by_name("counter"), 8) == EXIT_SUCCESS);
+	csp_sleep_ms(200);
+	TEST_CHECK(param_persist_bytes == bytes + strlen("counter,8\n"));
+	TEST_CHECK(read_param_file(file, sizeof(file)) > 0);
+	TEST_CHECK(strlen(file) > strlen("counter,8\n") && strcmp(file + strlen(file) - strlen("counter,8\n"), "counter,8\n") == 0);
+	TEST_CHECK(param_dirty_p[0] == 0);
+	return EXIT_SUCCESS;
+}
+
+
+// A value not fitting in a record is not stored and stays dirty
+static int test_oversized(void)
+{
+	char value[81];
+	char file[512];
+	uint32_t failed;
+	param_handle_t log_h;
+	log_h = get_param_handle_by_name("log");
+	failed = param_persist_failed;
+	memset(value, 'x', 80);
+	value[80] = '\0';
+	TEST_CHECK(str_to_param(log_h, value) == EXIT_SUCCESS);
+	csp_sleep_ms(200);
+	TEST_CHECK(param_persist_failed == failed + 1);
+	TEST_CHECK(param_dirty_p[log_h - get_param_handle_by_index(0)] != 0);
+	TEST_CHECK(read_param_file(file, sizeof(file)) > 0 && strstr(file, "xxx") == NULL);
+	// Stored once it fits
+	TEST_CHECK(str_to_param(log_h, "short") == EXIT_SUCCESS);
+	csp_sleep_ms(200);
+	TEST_CHECK(param_persist_failed == failed + 1);
+	TEST_CHECK(param_dirty_p[log_h - get_param_handle_by_index(0)] == 0);
+	TEST_CHECK(read_param_file(file, sizeof(file)) > 0 && strcmp(file + strlen(file) - strlen("log,short\n"), "log,short\n") == 0);
+	return EXIT_SUCCESS;
+}
+
+
+// Tests, run in order
+static const test_t tests[] = {
+	{"text_store",		test_text_store},
+	{"dirty_tracking",	test_dirty_tracking},
+	{"oversized",		test_oversized},
+};
+
+
+int main(void)
+{
+	return run_tests(tests, sizeof(tests)/sizeof(*tests));
+}
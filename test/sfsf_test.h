@@ -0,0 +1,85 @@
+/*
+Copyright 2018 olmanqj
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+of the Software, and to permit persons to whom the Software is furnished to do
+so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+ */
+
+#ifndef SFSF_TEST_H_
+#define SFSF_TEST_H_
+
+#include <stdio.h>
+#include <stdlib.h>
+
+/**
+ * @file	sfsf_test.h
+ * @brief	Checks and runner shared by the tests
+
+Tests
+=====
+Each folder in "test/" is a test program of a service, built with the
+configuration in "test/sfsf_config.h", or with the sfsf_config.h of the folder
+if it has one, which includes it and changes some options. Its main.c has a table of tests, run in
+order by run_tests(). A test checks the behavior of the service through its
+public functions with TEST_CHECK(). Build with "./waf configure --with-port
+linux --enable-tests build" and run with "./waf test".
+*/
+
+/**
+ * @brief	Check a condition, if false print it and fail the test
+ */
+#define TEST_CHECK(cond)	do { if(!(cond)) { printf("FAIL %s:%d: %s\n", __FILE__, __LINE__, #cond); return EXIT_FAILURE; } } while(0)
+
+/**
+ * @typedef	test_fun_t
+ * @brief	A test, returns 0 if OK, -1 if fails
+ */
+typedef int (*test_fun_t)(void);
+
+/**
+ * @struct	test_t
+ * @brief	A test and its name
+ */
+typedef struct
+{
+	const char * name;		/**< Name printed with the result. */
+	test_fun_t fun;			/**< The test. */
+} test_t;
+
+/**
+ * @brief	Run tests in order, print the result of each one and a summary
+ * @param	tests				Tests to run
+ * @param	tests_num			Amount of tests
+ * @return	0 if all pass, 1 if any fails, as exit status of the program
+ */
+static inline int run_tests(const test_t * tests, int tests_num)
+{
+	int i, failed = 0;
+	for(i = 0; i < tests_num; i++)
+	{
+		if(tests[i].fun() == EXIT_SUCCESS) printf("PASS %s\n", tests[i].name);
+		else
+		{
+			printf("FAIL %s\n", tests[i].name);
+			failed++;
+		}
+	}
+	printf("%d of %d tests failed\n", failed, tests_num);
+	return (failed == 0) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+#endif /* SFSF_TEST_H_ */
@@ -0,0 +1,275 @@
+/*
+Copyright 2018 olmanqj
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+of the Software, and to permit persons to whom the Software is furnished to do
+so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// CSP Includes
+#include <csp/csp.h>
+#include <csp/arch/csp_thread.h>
+
+// Framework Includes
+#include <sfsf.h>
+#include <sfsf_storage.h>
+
+#include "sfsf_test.h"
+
+// Tests of the Storage Service, each test creates its own files named "test_..."
+
+// Segments of the archive tests
+#define TEST_SEGMENT_SIZE	1024
+#define TEST_SEGMENTS		4
+
+
+// Record of the archive tests, its bytes from its timestamp
+static void fill_record(uint32_t time_s, uint8_t * data, uint16_t len)
+{
+	uint16_t i;
+	for(i = 0; i < len; i++) data[i] = (uint8_t)(time_s + i);
+}
+
+
+// Remove the segment files of the archive tests
+static void remove_segments(void)
+{
+	char path[STORAGE_ARCHIVE_PATH_SIZE];
+	int slot;
+	for(slot = 0; slot < TEST_SEGMENTS; slot++)
+	{
+		snprintf(path, sizeof(path), "test_arc%03d.seg", slot);
+		file_remove(path);
+	}
+}
+
+
+// Read the records of a time range, check their data and that their timestamps go up by one
+// Returns the amount read, -1 if a record is wrong
+static int read_range(storage_archive_t * archive, uint32_t from_s, uint32_t to_s, uint32_t * first_s)
+{
+	storage_archive_cursor_t cursor;
+	uint8_t data[64], expected[64];
+	uint32_t time_s, last_s = 0;
+	int len, records = 0;
+	if(storage_archive_seek(archive, from_s, to_s, &cursor) != EXIT_SUCCESS) return 0;
+	while((len = storage_archive_next(archive, &cursor, &time_s, data, sizeof(data))) > 0)
+	{
+		fill_record(time_s, expected, len);
+		if(memcmp(data, expected, len) != 0 || time_s < from_s || time_s > to_s) break;
+		if(records == 0) *first_s = time_s;
+		else if(time_s != last_s + 1) break;
+		last_s = time_s;
+		records++;
+	}
+	storage_archive_end(&cursor);
+	return (len == 0) ? records : -1;
+}
+
+
+// Segmented archive: records found by time, the oldest segments reused, kept after a reset
+static int test_archive(void)
+{
+	static char buff[256];
+	static storage_segment_t segments[TEST_SEGMENTS];
+	storage_archive_t archive;
+	uint8_t data[64];
+	uint32_t time_s, first_s;
+	int records;
+	remove_segments();
+	TEST_CHECK(storage_archive_init(&archive, "test_arc", TEST_SEGMENT_SIZE, segments, TEST_SEGMENTS, buff, sizeof(buff), 60000, 0) == EXIT_SUCCESS);
+	for(time_s = 1; time_s <= 200; time_s++)
+	{
+		fill_record(time_s, data, 20);
+		TEST_CHECK(storage_archive_append(&archive, time_s, data, 20) == EXIT_SUCCESS);
+	}
+	// The oldest records were removed with their segment
+	records = read_range(&archive, 0, UINT32_MAX, &first_s);
+	TEST_CHECK(records > 0 && records < 200 && first_s > 1 && first_s + records - 1 == 200);
+	// A range in the middle
+	TEST_CHECK(read_range(&archive, 150, 160, &first_s) == 11 && first_s == 150);
+	TEST_CHECK(read_range(&archive, 300, 400, &first_s) == 0);
+	// Still there after a reset, the open segment is sealed
+	TEST_CHECK(storage_archive_init(&archive, "test_arc", TEST_SEGMENT_SIZE, segments, TEST_SEGMENTS, buff, sizeof(buff), 60000, 0) == EXIT_SUCCESS);
+	TEST_CHECK(read_range(&archive, 150, 160, &first_s) == 11 && first_s == 150);
+	fill_record(201, data, 20);
+	TEST_CHECK(storage_archive_append(&archive, 201, data, 20) == EXIT_SUCCESS);
+	TEST_CHECK(read_range(&archive, 195, 201, &first_s) == 7 && first_s == 195);
+	return EXIT_SUCCESS;
+}
+
+
+// Segmented archive: a record bigger than the buffer is an error, the next one is read after it
+static int test_archive_big_record(void)
+{
+	static char buff[256];
+	static storage_segment_t segments[TEST_SEGMENTS];
+	storage_archive_t archive;
+	storage_archive_cursor_t cursor;
+	uint8_t data[64];
+	uint32_t time_s;
+	remove_segments();
+	TEST_CHECK(storage_archive_init(&archive, "test_arc", TEST_SEGMENT_SIZE, segments, TEST_SEGMENTS, buff, sizeof(buff), 60000, 0) == EXIT_SUCCESS);
+	fill_record(10, data, 60);
+	TEST_CHECK(storage_archive_append(&archive, 10, data, 60) == EXIT_SUCCESS);
+	fill_record(11, data, 8);
+	TEST_CHECK(storage_archive_append(&archive, 11, data, 8) == EXIT_SUCCESS);
+	TEST_CHECK(storage_archive_seek(&archive, 0, 100, &cursor) == EXIT_SUCCESS);
+	TEST_CHECK(storage_archive_next(&archive, &cursor, &time_s, data, 32) == -1 && time_s == 10);
+	TEST_CHECK(storage_archive_next(&archive, &cursor, &time_s, data, 32) == 8 && time_s == 11);
+	TEST_CHECK(storage_archive_next(&archive, &cursor, &time_s, data, 32) == 0);
+	storage_archive_end(&cursor);
+	return EXIT_SUCCESS;
+}
+
+
+// Circular file: the oldest chunks overwritten, chunks kept after closing it
+static int test_ring(void)
+{
+	storage_ring_t ring;
+	uint8_t data[30];
+	uint32_t pos, chunk, first = 0, last = 0;
+	int len, chunks;
+	file_remove("test_ring.bin");
+	TEST_CHECK(storage_ring_open(&ring, "test_ring.bin", 1024) == EXIT_SUCCESS);
+	for(chunk = 1; chunk <= 100; chunk++)
+	{
+		memset(data, 0, sizeof(data));
+		memcpy(data, &chunk, sizeof(chunk));
+		TEST_CHECK(storage_ring_write(&ring, data, sizeof(data)) == EXIT_SUCCESS);
+	}
+	TEST_CHECK(storage_ring_write(&ring, data, 600) == EXIT_FAILURE);
+	TEST_CHECK(storage_ring_close(&ring) == EXIT_SUCCESS);
+	TEST_CHECK(storage_ring_open(&ring, "test_ring.bin", 1024) == EXIT_SUCCESS);
+	// From the oldest chunk kept, in order up to the last one
+	pos = 0;
+	chunks = 0;
+	while((len = storage_ring_read(&ring, &pos, data, sizeof(data))) > 0)
+	{
+		TEST_CHECK(len == sizeof(data));
+		memcpy(&chunk, data, sizeof(chunk));
+		if(chunks == 0) first = chunk;
+		else TEST_CHECK(chunk == last + 1);
+		last = chunk;
+		chunks++;
+	}
+	TEST_CHECK(len == 0 && chunks > 0 && first > 1 && last == 100);
+	// Another budget creates it again
+	TEST_CHECK(storage_ring_close(&ring) == EXIT_SUCCESS);
+	TEST_CHECK(storage_ring_open(&ring, "test_ring.bin", 2048) == EXIT_SUCCESS);
+	pos = 0;
+	TEST_CHECK(storage_ring_read(&ring, &pos, data, sizeof(data)) == 0);
+	TEST_CHECK(storage_ring_close(&ring) == EXIT_SUCCESS);
+	return EXIT_SUCCESS;
+}
+
+
+// Buffered writer into a circular file: each flush is a chunk
+static int test_writer_ring(void)
+{
+	static char buff[64];
+	storage_ring_t ring;
+	storage_writer_t writer;
+	char data[64];
+	uint32_t pos = 0;
+	file_remove("test_ring_writer.bin");
+	TEST_CHECK(storage_ring_open(&ring, "test_ring_writer.bin", 1024) == EXIT_SUCCESS);
+	TEST_CHECK(storage_writer_init(&writer, "test_ring_writer.bin", buff, sizeof(buff), 60000, 0) == EXIT_SUCCESS);
+	TEST_CHECK(storage_writer_set_ring(&writer, &ring) == EXIT_SUCCESS);
+	TEST_CHECK(storage_writer_write_line(&writer, "A:1") == EXIT_SUCCESS);
+	TEST_CHECK(storage_writer_write_line(&writer, "A:2") == EXIT_SUCCESS);
+	TEST_CHECK(storage_writer_flush(&writer, 1) == EXIT_SUCCESS);
+	TEST_CHECK(storage_writer_write_line(&writer, "A:3") == EXIT_SUCCESS);
+	TEST_CHECK(storage_writer_close(&writer) == EXIT_SUCCESS);
+	TEST_CHECK(storage_ring_read(&ring, &pos, data, sizeof(data)) == 8 && memcmp(data, "A:1\nA:2\n", 8) == 0);
+	TEST_CHECK(storage_ring_read(&ring, &pos, data, sizeof(data)) == 4 && memcmp(data, "A:3\n", 4) == 0);
+	TEST_CHECK(storage_ring_read(&ring, &pos, data, sizeof(data)) == 0);
+	TEST_CHECK(storage_ring_close(&ring) == EXIT_SUCCESS);
+	return EXIT_SUCCESS;
+}
+
+
+// Buffered writer: flushed when full or when its oldest record is flush_ms old, synced every sync_ms
+static int test_writer_flush(void)
+{
+	static char buff[32];
+	storage_writer_t writer;
+	char data[64], read[64];
+	FILE * file;
+	memset(data, 'x', sizeof(data));
+	file_remove("test_writer.txt");
+	TEST_CHECK(storage_writer_init(&writer, "test_writer.txt", buff, sizeof(buff), 50, 200) == EXIT_SUCCESS);
+	TEST_CHECK(storage_writer_due_ms(&writer) == UINT32_MAX);
+	// Kept in RAM until flush_ms
+	TEST_CHECK(storage_writer_write(&writer, data, 10) == EXIT_SUCCESS);
+	TEST_CHECK(storage_writer_due_ms(&writer) > 0 && storage_writer_due_ms(&writer) <= 50);
+	TEST_CHECK(storage_writer_poll(&writer) == EXIT_SUCCESS);
+	TEST_CHECK(writer.writes == 0 && writer.used == 10);
+	// Size threshold: a record that does not fit flushes the buffer first
+	TEST_CHECK(storage_writer_write(&writer, data, 30) == EXIT_SUCCESS);
+	TEST_CHECK(writer.writes == 1 && writer.used == 30);
+	// Written but not synced before sync_ms
+	TEST_CHECK(writer.syncs == 0 && writer.unsynced);
+	// Flush interval: flushed by the poll once the oldest record is flush_ms old
+	csp_sleep_ms(60);
+	TEST_CHECK(storage_writer_due_ms(&writer) == 0);
+	TEST_CHECK(storage_writer_poll(&writer) == EXIT_SUCCESS);
+	TEST_CHECK(writer.writes == 2 && writer.used == 0 && writer.syncs == 0);
+	TEST_CHECK(storage_writer_due_ms(&writer) > 0 && storage_writer_due_ms(&writer) <= 200 - 60);
+	// sync_ms: synced by the poll once the data written is sync_ms old
+	csp_sleep_ms(150);
+	TEST_CHECK(storage_writer_due_ms(&writer) == 0);
+	TEST_CHECK(storage_writer_poll(&writer) == EXIT_SUCCESS);
+	TEST_CHECK(writer.syncs == 1 && !writer.unsynced);
+	TEST_CHECK(storage_writer_due_ms(&writer) == UINT32_MAX);
+	// A record bigger than the buffer is written directly
+	TEST_CHECK(storage_writer_write(&writer, data, sizeof(data)) == EXIT_SUCCESS);
+	TEST_CHECK(writer.writes == 3 && writer.used == 0);
+	// A forced flush syncs at once
+	TEST_CHECK(storage_writer_flush(&writer, 1) == EXIT_SUCCESS);
+	TEST_CHECK(writer.syncs == 2 && writer.dropped == 0);
+	TEST_CHECK(storage_writer_close(&writer) == EXIT_SUCCESS);
+	TEST_CHECK((file = fopen("test_writer.txt", "rb")) != NULL);
+	TEST_CHECK(fread(read, 1, sizeof(read), file) == sizeof(read) && fread(read, 1, sizeof(read), file) == 40);
+	fclose(file);
+	// With sync_ms 0 every flush is synced
+	file_remove("test_writer.txt");
+	TEST_CHECK(storage_writer_init(&writer, "test_writer.txt", buff, sizeof(buff), 50, 0) == EXIT_SUCCESS);
+	TEST_CHECK(storage_writer_write(&writer, data, 10) == EXIT_SUCCESS);
+	TEST_CHECK(storage_writer_flush(&writer, 0) == EXIT_SUCCESS);
+	TEST_CHECK(writer.writes == 1 && writer.syncs == 1 && !writer.unsynced);
+	TEST_CHECK(storage_writer_close(&writer) == EXIT_SUCCESS);
+	return EXIT_SUCCESS;
+}
+
+
+static const test_t tests[] = {
+	{"archive",				test_archive},
+	{"archive_big_record",	test_archive_big_record},
+	{"ring",				test_ring},
+	{"writer_ring",			test_writer_ring},
+	{"writer_flush",		test_writer_flush},
+};
+
+
+int main(void)
+{
+	return run_tests(tests, sizeof(tests)/sizeof(*tests));
+}
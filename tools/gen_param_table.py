@@ -0,0 +1,419 @@
+#!/usr/bin/env python
+# encoding: utf-8
+
+# The MIT License (MIT)
+#
+# Copyright 2020 olmanqj
+#
+# Permission is hereby granted, free of charge, to any person obtaining a copy
+# of this software and associated documentation files (the "Software"), to deal
+# in the Software without restriction, including without limitation the rights
+# to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+# copies of the Software, and to permit persons to whom the Software is
+# furnished to do so, subject to the following conditions:
+#
+# The above copyright notice and this permission notice shall be included in all
+# copies or substantial portions of the Software.
+#
+# THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+# IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+# FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+# AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+# LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+# OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+# SOFTWARE.
+
+"""
+Parameter Table generator.
+
+Reads a mission parameter definition and writes a header with the PARAM_IDX_*
+constants, and a C file with the Parameter Table, its statically allocated
+value storage and everything set_param_table() computes at boot: the layout,
+the hot metadata, the TELEMETRY and PERSISTENT lists, the name index, the
+schema hashes, the snapshot and the access statistics. Register it with
+set_param_table_prebuilt(), see sfsf_param.h.
+
+Usage: gen_param_table.py <definition> [<definition> ...] <output header> <output c file>
+
+Definition format, one param per line, '#' starts a comment:
+
+    %include <sfsf_hk.h>
+    # NAME          TYPE            SIZE    OPTIONS                     VARIABLE
+    example         UINT8_PARAM     -       TELEMETRY|PERSISTENT
+    time_stamp      STRING_PARAM    20      TELEMETRY|PERSISTENT
+    gyro_bias       FLOAT_PARAM[3]  -       TELEMETRY|PERSISTENT
+    beacon_period   UINT32_PARAM    -       PERSISTENT                  beacon_period
+
+TYPE[N] is an array of N elements. SIZE is in bytes, '-' takes the size of the
+type times the elements, OPTIONS '-' means no options. VARIABLE is
+optional, to parameterize an existing variable, %include lines make it visible.
+
+A line "%table <prefix>" starts a table, as register_param_table(): the params
+after it are named "<prefix>.<name>". Params before any %table line go to a
+table without prefix. Several definition files, e.g. one per subsystem, are
+read one after the other as a single definition.
+The generated code is the same as what set_param_table() computes, keep both
+in sync.
+"""
+
+import os
+import re
+import sys
+
+
+# Same order as param_type_t, the value is the size of an element
+PARAM_TYPES = [
+    ('UINT8_PARAM', 1), ('INT8_PARAM', 1), ('UINT16_PARAM', 2), ('INT16_PARAM', 2),
+    ('UINT32_PARAM', 4), ('INT32_PARAM', 4), ('UINT64_PARAM', 8), ('INT64_PARAM', 8),
+    ('FLOAT_PARAM', 4), ('DOUBLE_PARAM', 8), ('STRING_PARAM', 1)
+]
+TYPE_IDS = dict((name, i) for i, (name, size) in enumerate(PARAM_TYPES))
+TYPE_SIZES = dict(PARAM_TYPES)
+# Same values as param_opts_t
+PARAM_OPTS = {'TELEMETRY': 0x01, 'PERSISTENT': 0x02, 'READ_ONLY': 0x04, 'HISTORY': 0x08}
+
+FNV_OFFSET_BASIS = 2166136261
+FNV_PRIME = 16777619
+
+
+def fail(def_file, line_num, message):
+    sys.exit('%s:%d: %s' % (def_file, line_num, message))
+
+
+def fnv1a(hash, data):
+    for byte in data:
+        hash = ((hash ^ byte) * FNV_PRIME) & 0xFFFFFFFF
+    return hash
+
+
+def read_definition(def_files):
+    params = []
+    includes = []
+    tables = [{'prefix': '', 'first': 0}]
+    for def_file in def_files:
+        read_definition_file(def_file, params, includes, tables)
+    if not params:
+        fail(def_files[0], 0, 'no params defined')
+    # Tables are one after the other, the one without prefix is left out if empty
+    for i, table in enumerate(tables):
+        table['size'] = (tables[i + 1]['first'] if i + 1 < len(tables) else len(params)) - table['first']
+    tables = [t for t in tables if t['size'] > 0 or t['prefix']]
+    return includes, params, tables
+
+
+def read_definition_file(def_file, params, includes, tables):
+    with open(def_file) as f:
+        for line_num, line in enumerate(f, 1):
+            line = line.split('#', 1)[0].strip() if not line.startswith('%include') else line.strip()
+            if not line:
+                continue
+            if line.startswith('%include'):
+                includes.append(line[len('%include'):].strip())
+                continue
+            if line.startswith('%table'):
+                prefix = line[len('%table'):].strip()
+                if not re.match(r'^\w+$', prefix):
+                    fail(def_file, line_num, 'expected %table PREFIX')
+                if prefix in [t['prefix'] for t in tables]:
+                    fail(def_file, line_num, 'duplicated table prefix "%s"' % prefix)
+                tables.append({'prefix': prefix, 'first': len(params)})
+                continue
+            cols = line.split()
+            if len(cols) not in (4, 5):
+                fail(def_file, line_num, 'expected NAME TYPE SIZE OPTIONS [VARIABLE]')
+            name, type_name, size, opts = cols[:4]
+            full = tables[-1]['prefix'] + '.' + name if tables[-1]['prefix'] else name
+            if full in [p['full'] for p in params]:
+                fail(def_file, line_num, 'duplicated param name "%s"' % full)
+            array = re.match(r'^(\w+)\[(\d+)\]$', type_name)
+            elems = int(array.group(2)) if array else 1
+            type_name = array.group(1) if array else type_name
+            if type_name not in TYPE_IDS:
+                fail(def_file, line_num, 'unknown type "%s"' % type_name)
+            if size == '-':
+                if type_name == 'STRING_PARAM':
+                    fail(def_file, line_num, 'STRING_PARAM needs a size')
+                size = TYPE_SIZES[type_name] * elems
+            elif not size.isdigit():
+                fail(def_file, line_num, 'size should be a number of bytes')
+            if not 0 < int(size) < 65536:
+                fail(def_file, line_num, 'size should be 1 to 65535')
+            if int(size) % TYPE_SIZES[type_name] != 0 or (array and int(size) != TYPE_SIZES[type_name] * elems):
+                fail(def_file, line_num, 'size should be the size of the type times the elements')
+            opts_value = 0
+            if opts != '-':
+                for opt in opts.split('|'):
+                    if opt not in PARAM_OPTS:
+                        fail(def_file, line_num, 'unknown option "%s"' % opt)
+                    opts_value |= PARAM_OPTS[opt]
+            params.append({'name': name, 'full': full, 'type': type_name, 'size': int(size), 'opts': opts,
+                           'opts_value': opts_value, 'variable': cols[4] if len(cols) == 5 else None})
+
+
+# Natural alignment of a value, the size of its element, as param_value_align() in sfsf_param.c
+def value_align(param):
+    return min(TYPE_SIZES[param['type']], 8)
+
+
+# Offsets in param space, as set_param_table() lays them out: by alignment, widest first
+def layout(params):
+    offset = 0
+    for align in (8, 4, 2, 1):
+        for param in params:
+            if param['variable'] is None and value_align(param) == align:
+                param['offset'] = offset
+                offset += param['size']
+    return offset
+
+
+# Name index, as build_param_name_index() in sfsf_param.c
+def name_index(params):
+    slots = 1
+    while slots < 2 * len(params):
+        slots <<= 1
+    index = [-1] * slots
+    for i, param in enumerate(params):
+        slot = fnv1a(FNV_OFFSET_BASIS, param['full'].encode()) & (slots - 1)
+        while index[slot] >= 0:
+            slot = (slot + 1) & (slots - 1)
+        index[slot] = i
+    # lookup_param_index() stops at an empty slot, a full index would be probed to the end on a miss
+    if -1 not in index:
+        sys.exit('name index of %d slots is full' % slots)
+    return index
+
+
+# Hash of the name, type and size of the params in a list, as calc_params_schema() in sfsf_param.c
+def schema(params, indexes):
+    hash = FNV_OFFSET_BASIS
+    for i in indexes:
+        hash = fnv1a(hash, params[i]['full'].encode() + b'\0')
+        size = params[i]['size']
+        hash = fnv1a(hash, [TYPE_IDS[params[i]['type']], size & 0xFF] + ([size >> 8] if size > 0xFF else []))
+    return hash
+
+
+def idx_macro(name):
+    return 'PARAM_IDX_' + re.sub(r'[^A-Za-z0-9]', '_', name).upper()
+
+
+def c_list(values, per_line=16):
+    values = [str(v) for v in values]
+    return ',\n\t'.join(', '.join(values[i:i + per_line]) for i in range(0, len(values), per_line))
+
+
+def def_names(def_files):
+    return ', '.join(os.path.basename(f) for f in def_files)
+
+
+def write_header(header_file, def_files, params, tables):
+    guard = re.sub(r'[^A-Za-z0-9]', '_', os.path.basename(header_file)).upper() + '_'
+    out = []
+    out.append('// Generated by tools/gen_param_table.py from %s, do not edit.' % def_names(def_files))
+    out.append('#ifndef %s' % guard)
+    out.append('#define %s' % guard)
+    out.append('')
+    out.append('#include <sfsf.h>')
+    out.append('#include <sfsf_param.h>')
+    out.append('')
+    out.append('// Indexes of the params in the table')
+    width = max(len(idx_macro(p['full'])) for p in params) + 4
+    for i, param in enumerate(params):
+        out.append('#define %s%d' % (idx_macro(param['full']).ljust(width), i))
+    out.append('#define %s%d' % ('PARAM_TABLE_SIZE'.ljust(width), len(params)))
+    if any(t['prefix'] for t in tables):
+        out.append('')
+        out.append('// Ids of the tables, see get_param_handle_by_ref()')
+        for i, table in enumerate(tables):
+            if table['prefix']:
+                out.append('#define %s%d' % (('PARAM_TABLE_' + table['prefix'].upper()).ljust(width), i))
+    out.append('')
+    out.append('// The Parameter Table, and everything set_param_table() computes, register it with set_param_table_prebuilt()')
+    out.append('extern param_table_t mission_param_table;')
+    out.append('extern const param_prebuilt_t mission_param_prebuilt;')
+    out.append('')
+    out.append('#endif /* %s */' % guard)
+    with open(header_file, 'w') as f:
+        f.write('\n'.join(out) + '\n')
+
+
+def write_source(source_file, header_file, def_files, includes, params, tables):
+    space_size = layout(params)
+    index = name_index(params)
+    telemetry = [i for i, p in enumerate(params) if p['opts_value'] & PARAM_OPTS['TELEMETRY']]
+    persistent = [i for i, p in enumerate(params) if p['opts_value'] & PARAM_OPTS['PERSISTENT']]
+    shadow_size = sum(params[i]['size'] for i in persistent if params[i]['variable'] is not None)
+    image_size = sum(params[i]['size'] for i in persistent)
+    names = []
+    name_offsets = []
+    names_size = 0
+    for param in params:
+        name_offsets.append(names_size)
+        names.append('"%s\\0"' % param['full'])
+        names_size += len(param['full']) + 1
+    longest = max((p['name'] for p in params), key=len)
+    longest_prefix = max((t['prefix'] for t in tables), key=len)
+    n = len(params)
+
+    def value_of(i):
+        if params[i]['variable'] is not None:
+            return 'parameterize(%s)' % params[i]['variable']
+        return '(void*)&param_space_gen[%d]' % params[i]['offset']
+
+    out = []
+    out.append('// Generated by tools/gen_param_table.py from %s, do not edit.' % def_names(def_files))
+    out.append('#include <sfsf.h>')
+    out.append('#include <sfsf_param.h>')
+    out.extend('#include %s' % inc for inc in includes)
+    out.append('#include <%s>' % os.path.basename(header_file))
+    out.append('')
+    out.append('// Names should leave room for the null-character')
+    out.append('_Static_assert(sizeof("%s") <= CONF_PARAM_NAME_SIZE, "Param name too long");' % longest)
+    out.append('_Static_assert(sizeof("%s") <= CONF_PARAM_PREFIX_SIZE, "Table prefix too long");' % longest_prefix)
+    out.append('_Static_assert(%d <= CONF_PARAM_MAX_TABLES, "Too many tables");' % len(tables))
+    out.append('')
+    out.append('// Values, by alignment, widest first')
+    out.append('static uint8_t param_space_gen[%d] __attribute__((aligned(8)));' % max(space_size, 1))
+    out.append('')
+    out.append('param_table_t mission_param_table = {')
+    out.append('\t//\tNAME\t\t\t\tTYPE\t\t\t\tSize\tOptions\t\t\t\t\t\tValue')
+    rows = []
+    for i, p in enumerate(params):
+        rows.append('\t{.name="%s",\t.type=%s,\t.size=%d,\t.opts=%s,\t.value=%s}' % (
+            p['name'], p['type'], p['size'], p['opts'] if p['opts'] != '-' else '0', value_of(i)))
+    out.append(',\n'.join(rows))
+    out.append('};')
+    out.append('')
+    out.append('// Hot metadata')
+    out.append('static void * param_value_gen[%d] = {\n\t%s\n};' % (n, c_list([value_of(i) for i in range(n)], 4)))
+    out.append('static uint32_t param_name_gen[%d] = {\n\t%s\n};' % (n, c_list(name_offsets)))
+    out.append('static param_index_t param_telemetry_gen[%d] = {\n\t%s\n};' % (max(len(telemetry), 1), c_list(telemetry or [0])))
+    out.append('static param_index_t param_persistent_gen[%d] = {\n\t%s\n};' % (max(len(persistent), 1), c_list(persistent or [0])))
+    out.append('static uint8_t param_type_gen[%d] = {\n\t%s\n};' % (n, c_list([p['type'] for p in params], 4)))
+    out.append('static uint16_t param_size_gen[%d] = {\n\t%s\n};' % (n, c_list([p['size'] for p in params])))
+    out.append('static uint8_t param_opts_gen[%d] = {\n\t%s\n};' % (n, c_list([p['opts'] if p['opts'] != '-' else '0' for p in params], 4)))
+    out.append('static char param_names_gen[] =\n\t%s;' % '\n\t'.join(names))
+    out.append('// Name index, as build_param_name_index() builds it')
+    out.append('static param_index_t param_name_index_gen[%d] = {\n\t%s\n};' % (len(index), c_list(index)))
+    out.append('// State')
+    out.append('static volatile uint32_t param_seq_gen[%d];' % n)
+    out.append('static uint8_t param_dirty_gen[%d];' % n)
+    if shadow_size:
+        out.append('static uint8_t param_shadow_gen[%d];' % shadow_size)
+    out.append('#if CONF_PARAM_PERSIST_FORMAT == PARAM_PERSIST_IMAGE')
+    out.append('static uint8_t param_image_gen[%d];' % max(image_size, 1))
+    out.append('#define PARAM_IMAGE_GEN\t\tparam_image_gen')
+    out.append('#define PARAM_IMAGE_GEN_SIZE\t%d' % image_size)
+    out.append('#else')
+    out.append('#define PARAM_IMAGE_GEN\t\tNULL')
+    out.append('#define PARAM_IMAGE_GEN_SIZE\t0')
+    out.append('#endif')
+    # Snapshot, parameterized variables after the copy of param space, as init_param_snapshot()
+    words = (n + 31) // 32
+    snapshot_offsets = []
+    vars_size = 0
+    vars_bits = [0] * words
+    for i, p in enumerate(params):
+        if p['variable'] is None:
+            snapshot_offsets.append(p['offset'])
+            continue
+        snapshot_offsets.append(space_size + vars_size)
+        vars_size += p['size']
+        vars_bits[i // 32] |= 1 << (i % 32)
+    changed_bits = [0xFFFFFFFF] * words
+    if n % 32:
+        changed_bits[-1] = (1 << (n % 32)) - 1
+    out.append('#if CONF_PARAM_SNAPSHOT == ENABLE')
+    out.append('static uint8_t param_snapshot_values_gen[%d];' % max(space_size + vars_size, 1))
+    out.append('static uint32_t param_snapshot_offset_gen[%d] = {\n\t%s\n};' % (n, c_list(snapshot_offsets)))
+    out.append('static uint32_t param_snapshot_changed_gen[%d] = {\n\t%s\n};' % (words, c_list(['0x%08Xu' % b for b in changed_bits], 4)))
+    out.append('static uint32_t param_snapshot_vars_gen[%d] = {\n\t%s\n};' % (words, c_list(['0x%08Xu' % b for b in vars_bits], 4)))
+    out.append('#define PARAM_SNAPSHOT_GEN\t\t{param_snapshot_values_gen, param_snapshot_offset_gen, param_snapshot_changed_gen, param_snapshot_vars_gen}')
+    out.append('#define PARAM_SNAPSHOT_GEN_SIZE\t(sizeof(param_snapshot_values_gen) + sizeof(param_snapshot_offset_gen) + 2 * sizeof(param_snapshot_vars_gen))')
+    out.append('#else')
+    out.append('#define PARAM_SNAPSHOT_GEN\t\t{NULL, NULL, NULL, NULL}')
+    out.append('#define PARAM_SNAPSHOT_GEN_SIZE\t0')
+    out.append('#endif')
+    out.append('')
+    out.append('#if CONF_PARAM_STATS == ENABLE')
+    out.append('static param_stats_t param_stats_gen[%d];' % n)
+    out.append('#define PARAM_STATS_GEN\t\t\tparam_stats_gen')
+    out.append('#define PARAM_STATS_GEN_SIZE\tsizeof(param_stats_gen)')
+    out.append('#else')
+    out.append('#define PARAM_STATS_GEN\t\t\tNULL')
+    out.append('#define PARAM_STATS_GEN_SIZE\t0')
+    out.append('#endif')
+    out.append('')
+    out.append('#if CONF_PARAM_DELTA == ENABLE')
+    out.append('static uint8_t param_delta_gen[%d];' % max(sum(params[i]['size'] for i in telemetry), 1))
+    out.append('#define PARAM_DELTA_GEN\t\t\tparam_delta_gen')
+    out.append('#define PARAM_DELTA_GEN_SIZE\tsizeof(param_delta_gen)')
+    out.append('#else')
+    out.append('#define PARAM_DELTA_GEN\t\t\tNULL')
+    out.append('#define PARAM_DELTA_GEN_SIZE\t0')
+    out.append('#endif')
+    out.append('')
+    # Tables, with where their TELEMETRY and PERSISTENT lists start, as build_param_meta()
+    rows = []
+    for table in tables:
+        last = table['first'] + table['size']
+        tlm = [i for i in telemetry if i < table['first']]
+        tlm_num = len([i for i in telemetry if table['first'] <= i < last])
+        per = [i for i in persistent if i < table['first']]
+        per_num = len([i for i in persistent if table['first'] <= i < last])
+        rows.append('\t{.prefix="%s",\t.table=NULL,\t.first=%d,\t.size=%d,\t.telemetry_first=%d,\t.telemetry_num=%d,\t'
+                    '.persistent_first=%d,\t.persistent_num=%d,\t.opts=TELEMETRY|PERSISTENT}'
+                    % (table['prefix'], table['first'], table['size'], len(tlm), tlm_num, len(per), per_num))
+    out.append('static const param_table_info_t param_tables_gen[%d] = {' % len(tables))
+    out.append(',\n'.join(rows))
+    out.append('};')
+    out.append('')
+    out.append('const param_prebuilt_t mission_param_prebuilt = {')
+    fields = [
+        ('table', 'mission_param_table'),
+        ('table_size', '%d' % n),
+        ('space', 'param_space_gen'),
+        ('space_size', '%d' % space_size),
+        ('meta', '{\n\t\t.value = param_value_gen,\n\t\t.name = param_name_gen,\n'
+                 '\t\t.telemetry = param_telemetry_gen,\n\t\t.persistent = param_persistent_gen,\n'
+                 '\t\t.type = param_type_gen,\n\t\t.size = param_size_gen,\n\t\t.opts = param_opts_gen,\n'
+                 '\t\t.names = param_names_gen,\n\t\t.telemetry_num = %d,\n\t\t.persistent_num = %d\n\t}'
+                 % (len(telemetry), len(persistent))),
+        ('name_index', 'param_name_index_gen'),
+        ('name_index_slots', '%d' % len(index)),
+        ('seq', 'param_seq_gen'),
+        ('dirty', 'param_dirty_gen'),
+        ('shadow', 'param_shadow_gen' if shadow_size else 'NULL'),
+        ('image', 'PARAM_IMAGE_GEN'),
+        ('image_size', 'PARAM_IMAGE_GEN_SIZE'),
+        ('telemetry_schema', '0x%08Xu' % schema(params, telemetry)),
+        ('image_schema', '0x%08Xu' % schema(params, persistent)),
+        ('snapshot', 'PARAM_SNAPSHOT_GEN'),
+        ('stats', 'PARAM_STATS_GEN'),
+        ('delta', 'PARAM_DELTA_GEN'),
+        ('tables', 'param_tables_gen'),
+        ('tables_num', '%d' % len(tables)),
+        ('ram_bytes', 'sizeof(param_space_gen) + sizeof(param_value_gen) + sizeof(param_name_gen) + '
+                      'sizeof(param_telemetry_gen) + sizeof(param_persistent_gen) + sizeof(param_type_gen) + sizeof(param_size_gen) + '
+                      'sizeof(param_opts_gen) + sizeof(param_names_gen) + '
+                      'sizeof(param_name_index_gen) + sizeof(param_seq_gen) + sizeof(param_dirty_gen) + %d + PARAM_IMAGE_GEN_SIZE + '
+                      'PARAM_SNAPSHOT_GEN_SIZE + PARAM_STATS_GEN_SIZE + PARAM_DELTA_GEN_SIZE'
+                      % shadow_size),
+    ]
+    out.append(',\n'.join('\t.%s = %s' % field for field in fields))
+    out.append('};')
+    with open(source_file, 'w') as f:
+        f.write('\n'.join(out) + '\n')
+
+
+def main(argv):
+    if len(argv) < 4:
+        sys.exit('Usage: %s <definition> [<definition> ...] <output header> <output c file>' % argv[0])
+    def_files, header_file, source_file = argv[1:-2], argv[-2], argv[-1]
+    includes, params, tables = read_definition(def_files)
+    write_header(header_file, def_files, params, tables)
+    write_source(source_file, header_file, def_files, includes, params, tables)
+
+
+if __name__ == '__main__':
+    main(sys.argv)
@@ -0,0 +1,88 @@
+#!/usr/bin/env python
+# encoding: utf-8
+
+# The MIT License (MIT)
+#
+# Copyright 2020 olmanqj
+#
+# Permission is hereby granted, free of charge, to any person obtaining a copy
+# of this software and associated documentation files (the "Software"), to deal
+# in the Software without restriction, including without limitation the rights
+# to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+# copies of the Software, and to permit persons to whom the Software is
+# furnished to do so, subject to the following conditions:
+#
+# The above copyright notice and this permission notice shall be included in all
+# copies or substantial portions of the Software.
+#
+# THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+# IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+# FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+# AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+# LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+# OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+# SOFTWARE.
+
+"""
+Circular file reader.
+
+Prints the chunks of a circular file written by the Storage Service, e.g. the
+beacons file or the Log file when CONF_HK_BEACONS_BUDGET or
+CONF_LOG_FILE_BUDGET are not 0, from the oldest to the newest. See the
+Circular File of sfsf_storage.h.
+
+Usage: read_ring.py <circular file>
+"""
+
+import struct
+import sys
+import zlib
+
+RING_MAGIC = 0x52494E47
+RING_META_SIZE = 512
+META_FORMAT = '>IIIIII'
+CHUNK_FORMAT = '>HI'
+
+
+def read_meta(image, copy):
+    meta = image[copy * RING_META_SIZE:copy * RING_META_SIZE + struct.calcsize(META_FORMAT)]
+    magic, budget, tail, used, seq, crc = struct.unpack(META_FORMAT, meta)
+    if magic != RING_MAGIC or crc != zlib.crc32(meta[:-4]) & 0xFFFFFFFF:
+        return None
+    if tail >= budget or used > budget:
+        return None
+    return budget, tail, used, seq
+
+
+def read_chunks(image):
+    metas = [m for m in (read_meta(image, 0), read_meta(image, 1)) if m]
+    if not metas:
+        raise ValueError('no valid metadata')
+    # The newest copy, in spite of the wrap of the sequence number
+    budget, tail, used, seq = max(metas, key=lambda m: (m[3] - metas[0][3] + 2**31) % 2**32)
+    data = image[2 * RING_META_SIZE:2 * RING_META_SIZE + budget]
+    # Unwrap the ring, from the oldest chunk
+    ring = (data[tail:] + data[:tail])[:used]
+    pos = 0
+    chunk_size = struct.calcsize(CHUNK_FORMAT)
+    while pos + chunk_size <= used:
+        length, crc = struct.unpack(CHUNK_FORMAT, ring[pos:pos + chunk_size])
+        chunk = ring[pos + chunk_size:pos + chunk_size + length]
+        pos += chunk_size + length
+        # Written but not synced before a reset
+        if len(chunk) == length and zlib.crc32(chunk) & 0xFFFFFFFF == crc:
+            yield chunk
+
+
+def main():
+    if len(sys.argv) != 2:
+        sys.exit('Usage: read_ring.py <circular file>')
+    with open(sys.argv[1], 'rb') as ring_file:
+        image = ring_file.read()
+    out = getattr(sys.stdout, 'buffer', sys.stdout)
+    for chunk in read_chunks(image):
+        out.write(chunk)
+
+
+if __name__ == '__main__':
+    main()